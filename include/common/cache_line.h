@@ -0,0 +1,29 @@
+// Copyright (c) 2025 Michael Dello
+//
+// This software is provided under the MIT License.
+// See LICENSE file for details.
+
+#ifndef INCLUDE_CACHE_LINE_H__
+#define INCLUDE_CACHE_LINE_H__
+//------------------------------------------------------------------------------
+//
+// This header provides the cache line size that the concurrency primitives
+// align to, so data written by different threads is kept on separate lines
+// rather than bouncing one line between cores (false sharing).
+//
+//------------------------------------------------------------------------------
+
+#include <cstddef>
+
+namespace Concurrency
+{
+    //--------------------------------------------------------------------------
+    // Constants
+    //--------------------------------------------------------------------------
+    // Fixed rather than std::hardware_destructive_interference_size, which
+    // GCC warns is not ABI stable
+    constexpr size_t CACHE_LINE_BYTES = 64;
+
+} // namespace Concurrency
+
+#endif // INCLUDE_CACHE_LINE_H__
@@ -0,0 +1,166 @@
+// Copyright (c) 2025 Michael Dello
+//
+// This software is provided under the MIT License.
+// See LICENSE file for details.
+
+#ifndef INCLUDE_LATENCY_HISTOGRAM_H__
+#define INCLUDE_LATENCY_HISTOGRAM_H__
+//------------------------------------------------------------------------------
+//
+// This header provides a fixed-size, log-linear (HDR-style) histogram for
+// recording latencies in nanoseconds.
+//
+// Notable usage features and characteristics:
+//
+//     1. Values below 2^SUB_BUCKET_BITS are counted exactly, larger values
+//        fall into one of 2^SUB_BUCKET_BITS linear sub-buckets per power of
+//        two, bounding the relative error to 1 / 2^SUB_BUCKET_BITS (6.25%)
+//     2. Recording is a handful of integer operations with no allocation or
+//        branching on the data, cheap enough to leave always on
+//     3. Values beyond the trackable range are clamped into the last bucket
+//     4. Histograms are mergeable, so per-connection or per-thread instances
+//        can be combined into totals
+//     5. Not thread-safe: each instance is meant to have a single writer
+//
+//------------------------------------------------------------------------------
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstdint>
+#include <limits>
+
+namespace Metrics
+{
+    //--------------------------------------------------------------------------
+    // Class: LatencyHistogram
+    //
+    // Description:
+    //    Counts nanosecond latencies in log-linear buckets and answers count,
+    //    min, max, mean and percentile queries.
+    //
+    class LatencyHistogram
+    {
+    public:
+        //----------------------------------------------------------------------
+        // Constants
+        //----------------------------------------------------------------------
+        // Linear sub-buckets per power of two
+        static constexpr unsigned SUB_BUCKET_BITS = 4;
+        static constexpr uint64_t SUB_BUCKETS = uint64_t{1} << SUB_BUCKET_BITS;
+        // Largest trackable value is 2^MAX_VALUE_BITS - 1 ns (about 68 s)
+        static constexpr unsigned MAX_VALUE_BITS = 36;
+        static constexpr uint64_t MAX_VALUE =
+            (uint64_t{1} << MAX_VALUE_BITS) - 1;
+        static constexpr size_t NUM_BUCKETS =
+            (MAX_VALUE_BITS - SUB_BUCKET_BITS + 1) * SUB_BUCKETS;
+
+        //----------------------------------------------------------------------
+        void record(uint64_t valueNs) noexcept
+        {
+            valueNs = std::min(valueNs, MAX_VALUE);
+            ++counts[bucketIndex(valueNs)];
+            ++totalCount;
+            totalNs += valueNs;
+            minNs = std::min(minNs, valueNs);
+            maxNs = std::max(maxNs, valueNs);
+        }
+
+        //----------------------------------------------------------------------
+        void merge(const LatencyHistogram& other) noexcept
+        {
+            for (size_t i = 0; i < NUM_BUCKETS; ++i)
+            {
+                counts[i] += other.counts[i];
+            }
+            totalCount += other.totalCount;
+            totalNs += other.totalNs;
+            minNs = std::min(minNs, other.minNs);
+            maxNs = std::max(maxNs, other.maxNs);
+        }
+
+        //----------------------------------------------------------------------
+        void reset() noexcept
+        {
+            *this = LatencyHistogram{};
+        }
+
+        //----------------------------------------------------------------------
+        uint64_t count() const noexcept { return totalCount; }
+        uint64_t min() const noexcept { return totalCount ? minNs : 0; }
+        uint64_t max() const noexcept { return maxNs; }
+
+        //----------------------------------------------------------------------
+        double mean() const noexcept
+        {
+            return totalCount ? double(totalNs) / double(totalCount) : 0.0;
+        }
+
+        //----------------------------------------------------------------------
+        // Highest value equivalent to the bucket holding the given percentile
+        // (0 - 100), never more than the largest value recorded
+        uint64_t percentile(double percent) const noexcept
+        {
+            if (totalCount == 0)
+            {
+                return 0;
+            }
+
+            percent = std::clamp(percent, 0.0, 100.0);
+            uint64_t rank = std::max<uint64_t>(
+                1,
+                static_cast<uint64_t>(
+                    percent / 100.0 * double(totalCount) + 0.5));
+            uint64_t seen = 0;
+            for (size_t i = 0; i < NUM_BUCKETS; ++i)
+            {
+                seen += counts[i];
+                if (seen >= rank)
+                {
+                    return std::min(bucketHighestValue(i), maxNs);
+                }
+            }
+            return maxNs;
+        }
+
+        //----------------------------------------------------------------------
+        static constexpr size_t bucketIndex(uint64_t valueNs) noexcept
+        {
+            // Position of the most significant bit selects the power of two,
+            // the next SUB_BUCKET_BITS bits select the linear sub-bucket.
+            // Values below 2 * SUB_BUCKETS get a shift of 0, which maps them
+            // to themselves, so exact small values need no branch.
+            unsigned shift =
+                std::max(
+                    static_cast<unsigned>(std::bit_width(valueNs)),
+                    SUB_BUCKET_BITS + 1) -
+                1 - SUB_BUCKET_BITS;
+            return static_cast<size_t>(
+                (shift + 1) * SUB_BUCKETS +
+                ((valueNs >> shift) - SUB_BUCKETS));
+        }
+
+        //----------------------------------------------------------------------
+        static constexpr uint64_t bucketHighestValue(size_t index) noexcept
+        {
+            uint64_t group = index / SUB_BUCKETS;
+            uint64_t subBucket = index % SUB_BUCKETS;
+            if (group == 0)
+            {
+                return subBucket;
+            }
+            uint64_t shift = group - 1;
+            return ((SUB_BUCKETS + subBucket + 1) << shift) - 1;
+        }
+
+    private:
+        std::array<uint32_t, NUM_BUCKETS> counts{};
+        uint64_t totalCount{0};
+        uint64_t totalNs{0};
+        uint64_t minNs{std::numeric_limits<uint64_t>::max()};
+        uint64_t maxNs{0};
+    };
+
+} // namespace Metrics
+
+#endif // INCLUDE_LATENCY_HISTOGRAM_H__
@@ -0,0 +1,96 @@
+// Copyright (c) 2025 Michael Dello
+//
+// This software is provided under the MIT License.
+// See LICENSE file for details.
+
+#ifndef INCLUDE_MPSC_QUEUE_H__
+#define INCLUDE_MPSC_QUEUE_H__
+//------------------------------------------------------------------------------
+//
+// This header provides a lock-free, intrusive, Multiple Producer Single
+// Consumer (MPSC) queue.
+//
+// Notable usage features and characteristics:
+//
+//     1. Nodes are owned by the producers, the queue only links them through
+//        the node's own pNext member, so pushing never allocates
+//     2. Any number of threads may push concurrently
+//     3. A single consumer detaches every queued node at once with drain(),
+//        which returns them in the order they were pushed (FIFO)
+//     4. A header-only implementation to avoid required explicit instantiation
+//        for different node types
+//
+//------------------------------------------------------------------------------
+
+#include <atomic>
+#include <concepts>
+
+namespace Concurrency
+{
+    //--------------------------------------------------------------------------
+    // Compile-time Checks
+    //--------------------------------------------------------------------------
+
+    // Compile-time constraint to ensure a node type carries its own link
+    template <typename Node>
+    concept IntrusiveNode = requires(Node& node)
+    {
+        { node.pNext } -> std::convertible_to<Node*>;
+    };
+
+    //--------------------------------------------------------------------------
+    // Class: MpscQueue
+    //
+    // Description:
+    //    Producers push onto a lock-free stack. The consumer takes the whole
+    //    stack in one atomic exchange and reverses it to restore FIFO order.
+    //
+    template <IntrusiveNode Node>
+    class MpscQueue
+    {
+    public:
+        //----------------------------------------------------------------------
+        // Any thread: the node must stay alive until the consumer drains it
+        void push(Node* pNode) noexcept
+        {
+            Node* pHead = head.load(std::memory_order_relaxed);
+            do
+            {
+                pNode->pNext = pHead;
+            }
+            while (!head.compare_exchange_weak(
+                pHead, pNode,
+                std::memory_order_release, std::memory_order_relaxed));
+        }
+
+        //----------------------------------------------------------------------
+        // Single consumer: detach all queued nodes, oldest first, or nullptr
+        // if the queue is empty
+        Node* drain() noexcept
+        {
+            Node* pNode = head.exchange(nullptr, std::memory_order_acquire);
+            Node* pOldest = nullptr;
+            while (pNode != nullptr)
+            {
+                Node* pNext = pNode->pNext;
+                pNode->pNext = pOldest;
+                pOldest = pNode;
+                pNode = pNext;
+            }
+            return pOldest;
+        }
+
+        //----------------------------------------------------------------------
+        bool empty() const noexcept
+        {
+            return head.load(std::memory_order_relaxed) == nullptr;
+        }
+
+    private:
+        // Most recently pushed node
+        std::atomic<Node*> head{nullptr};
+    };
+
+} // namespace Concurrency
+
+#endif // INCLUDE_MPSC_QUEUE_H__
@@ -0,0 +1,227 @@
+// Copyright (c) 2025 Michael Dello
+//
+// This software is provided under the MIT License.
+// See LICENSE file for details.
+
+#ifndef INCLUDE_SPSC_RING_H__
+#define INCLUDE_SPSC_RING_H__
+//------------------------------------------------------------------------------
+//
+// This header provides a lock-free, bounded, Single Producer Single Consumer
+// (SPSC) ring buffer for trivially copyable elements.
+//
+// Notable usage features and characteristics:
+//
+//     1. Capacity is rounded up to a power of two so indices wrap with a mask
+//     2. Producer and consumer indices live on separate cache lines, and each
+//        side caches the other's index, so the shared lines are only touched
+//        when the cached view runs out of room or elements
+//     3. Elements move in batches: push() and pop() copy as many as fit or
+//        are available in at most two contiguous copies
+//     4. A consumer may block in popWait() until elements arrive, the timeout
+//        expires or the ring is closed. The producer only takes the lock when
+//        a consumer is actually waiting.
+//     5. A header-only implementation to avoid required explicit instantiation
+//        for different element types
+//
+//------------------------------------------------------------------------------
+
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <span>
+#include <type_traits>
+
+#include "common/cache_line.h"
+
+namespace Concurrency
+{
+    //--------------------------------------------------------------------------
+    // Class: SpscRing
+    //
+    // Description:
+    //    One producer thread pushes and one consumer thread pops. Indices
+    //    increase monotonically, the masked value addresses the slot.
+    //
+    template <typename T>
+        requires std::is_trivially_copyable_v<T> &&
+                 std::is_default_constructible_v<T>
+    class SpscRing
+    {
+    public:
+        //----------------------------------------------------------------------
+        explicit SpscRing(size_t minCapacity)
+        : mask{std::bit_ceil(std::max<size_t>(minCapacity, 2)) - 1},
+          slots{std::make_unique<T[]>(mask + 1)}
+        {
+            // No Body
+        }
+
+        SpscRing(const SpscRing&) = delete;
+        SpscRing& operator=(const SpscRing&) = delete;
+
+        //----------------------------------------------------------------------
+        size_t capacity() const noexcept { return mask + 1; }
+
+        //----------------------------------------------------------------------
+        // Either thread: a snapshot, exact only when the other side is idle
+        size_t size() const noexcept
+        {
+            return producer.index.load(std::memory_order_acquire) -
+                consumer.index.load(std::memory_order_acquire);
+        }
+
+        //----------------------------------------------------------------------
+        // Producer: how many elements the next push() can take at least, the
+        // consumer can only free more in the meantime
+        size_t freeSpace() noexcept
+        {
+            size_t tail = producer.index.load(std::memory_order_relaxed);
+            producer.cachedOther =
+                consumer.index.load(std::memory_order_acquire);
+            return capacity() - (tail - producer.cachedOther);
+        }
+
+        //----------------------------------------------------------------------
+        // Producer: copy in as many elements as fit, returning how many
+        size_t push(std::span<const T> elements)
+        {
+            size_t tail = producer.index.load(std::memory_order_relaxed);
+            size_t space = capacity() - (tail - producer.cachedOther);
+            if (space < elements.size())
+            {
+                producer.cachedOther =
+                    consumer.index.load(std::memory_order_acquire);
+                space = capacity() - (tail - producer.cachedOther);
+            }
+
+            size_t count = std::min(space, elements.size());
+            if (count == 0)
+            {
+                return 0;
+            }
+            copyIn(tail, elements.first(count));
+            // Pairs with the waiting flag store in popWait(), so either the
+            // consumer sees the new elements or the producer sees it waiting
+            producer.index.store(tail + count, std::memory_order_seq_cst);
+            if (bConsumerWaiting.load(std::memory_order_seq_cst))
+            {
+                std::lock_guard lock(waitMutex);
+                available.notify_one();
+            }
+            return count;
+        }
+
+        //----------------------------------------------------------------------
+        // Consumer: copy out as many elements as are available, returning how
+        // many, without blocking
+        size_t pop(std::span<T> elements)
+        {
+            size_t head = consumer.index.load(std::memory_order_relaxed);
+            size_t ready = consumer.cachedOther - head;
+            if (ready < elements.size())
+            {
+                consumer.cachedOther =
+                    producer.index.load(std::memory_order_acquire);
+                ready = consumer.cachedOther - head;
+            }
+
+            size_t count = std::min(ready, elements.size());
+            if (count == 0)
+            {
+                return 0;
+            }
+            copyOut(head, elements.first(count));
+            consumer.index.store(head + count, std::memory_order_release);
+            return count;
+        }
+
+        //----------------------------------------------------------------------
+        // Consumer: like pop(), but wait up to timeout for at least one
+        // element. Returns 0 on timeout or once closed and drained.
+        size_t popWait(std::span<T> elements, std::chrono::nanoseconds timeout)
+        {
+            size_t count = pop(elements);
+            if (count > 0 || elements.empty())
+            {
+                return count;
+            }
+
+            std::unique_lock lock(waitMutex);
+            bConsumerWaiting.store(true, std::memory_order_seq_cst);
+            available.wait_for(lock, timeout, [this]()
+            {
+                return bClosed.load(std::memory_order_acquire) ||
+                    producer.index.load(std::memory_order_seq_cst) !=
+                        consumer.index.load(std::memory_order_relaxed);
+            });
+            bConsumerWaiting.store(false, std::memory_order_relaxed);
+            lock.unlock();
+
+            return pop(elements);
+        }
+
+        //----------------------------------------------------------------------
+        // Any thread: wake a waiting consumer for good, elements already
+        // pushed can still be popped
+        void close()
+        {
+            std::lock_guard lock(waitMutex);
+            bClosed.store(true, std::memory_order_release);
+            available.notify_all();
+        }
+
+        //----------------------------------------------------------------------
+        bool closed() const noexcept
+        {
+            return bClosed.load(std::memory_order_acquire);
+        }
+
+    private:
+        // One side's index and its cached view of the other side's index
+        struct alignas(CACHE_LINE_BYTES) sSide
+        {
+            std::atomic<size_t> index{0};
+            size_t cachedOther{0};
+        };
+
+        //----------------------------------------------------------------------
+        void copyIn(size_t index, std::span<const T> elements)
+        {
+            size_t offset = index & mask;
+            size_t firstPart = std::min(elements.size(), capacity() - offset);
+            std::copy_n(elements.begin(), firstPart, &slots[offset]);
+            std::copy(
+                elements.begin() + firstPart, elements.end(), &slots[0]);
+        }
+
+        //----------------------------------------------------------------------
+        void copyOut(size_t index, std::span<T> elements) const
+        {
+            size_t offset = index & mask;
+            size_t firstPart = std::min(elements.size(), capacity() - offset);
+            std::copy_n(&slots[offset], firstPart, elements.begin());
+            std::copy_n(
+                &slots[0], elements.size() - firstPart,
+                elements.begin() + firstPart);
+        }
+
+        // Data Members
+        const size_t mask;
+        const std::unique_ptr<T[]> slots;
+        sSide producer;
+        sSide consumer;
+        alignas(CACHE_LINE_BYTES) std::atomic<bool> bConsumerWaiting{false};
+        std::atomic<bool> bClosed{false};
+        std::mutex waitMutex;
+        std::condition_variable available;
+    };
+
+} // namespace Concurrency
+
+#endif // INCLUDE_SPSC_RING_H__
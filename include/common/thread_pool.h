@@ -0,0 +1,201 @@
+// Copyright (c) 2025 Michael Dello
+//
+// This software is provided under the MIT License.
+// See LICENSE file for details.
+
+#ifndef INCLUDE_THREAD_POOL_H__
+#define INCLUDE_THREAD_POOL_H__
+//------------------------------------------------------------------------------
+//
+// This header provides a fixed-size thread pool for data-parallel loops: a
+// number of independent tasks, run once each across the pool, with the
+// caller waiting for all of them.
+//
+// Notable usage features and characteristics:
+//
+//     1. The calling thread works too, as worker 0, so a pool of one thread
+//        starts no threads and runs every task inline
+//     2. Tasks are handed out one at a time from a shared atomic counter, so
+//        uneven tasks balance across the workers
+//     3. Each task is told which worker runs it, so per-worker scratch state
+//        can be indexed without locking
+//     4. The first exception thrown by a task is rethrown to the caller once
+//        every worker has stopped; tasks not yet started are skipped
+//     5. Workers are started once and sleep between runs
+//
+//------------------------------------------------------------------------------
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace Concurrency
+{
+    //--------------------------------------------------------------------------
+    // Class: ThreadPool
+    //
+    // Description:
+    //    Runs numTasks calls of task(taskIndex, workerIndex) across size()
+    //    workers. One run at a time: run() is not reentrant and must not be
+    //    called from several threads at once.
+    //
+    class ThreadPool
+    {
+    public:
+        using Task = std::function<void(size_t taskIndex, size_t workerIndex)>;
+
+        //----------------------------------------------------------------------
+        // At least one worker, the caller
+        explicit ThreadPool(
+            size_t numThreads = std::thread::hardware_concurrency())
+        : pTask{nullptr},
+          numTasks{0},
+          nextTask{0},
+          busyWorkers{0},
+          generation{0},
+          bStopping{false}
+        {
+            numThreads = std::max<size_t>(numThreads, 1);
+            workers.reserve(numThreads - 1);
+            for (size_t i = 1; i < numThreads; ++i)
+            {
+                workers.emplace_back(&ThreadPool::workerEntry, this, i);
+            }
+        }
+
+        //----------------------------------------------------------------------
+        ~ThreadPool()
+        {
+            {
+                std::lock_guard lock(mutex);
+                bStopping = true;
+            }
+            wake.notify_all();
+            for (auto& worker : workers)
+            {
+                worker.join();
+            }
+        }
+
+        ThreadPool(const ThreadPool&) = delete;
+        ThreadPool& operator=(const ThreadPool&) = delete;
+
+        //----------------------------------------------------------------------
+        size_t size() const noexcept { return workers.size() + 1; }
+
+        //----------------------------------------------------------------------
+        // Run every task and wait for them to finish
+        void run(size_t taskCount, const Task& task)
+        {
+            if (taskCount == 0)
+            {
+                return;
+            }
+            {
+                std::lock_guard lock(mutex);
+                pTask = &task;
+                numTasks = taskCount;
+                nextTask.store(0, std::memory_order_relaxed);
+                busyWorkers = workers.size();
+                error = nullptr;
+                ++generation;
+            }
+            wake.notify_all();
+
+            work(0);
+
+            std::unique_lock lock(mutex);
+            done.wait(lock, [this] { return busyWorkers == 0; });
+            pTask = nullptr;
+            if (error)
+            {
+                std::rethrow_exception(std::exchange(error, nullptr));
+            }
+        }
+
+    private:
+        // Methods
+        //----------------------------------------------------------------------
+        void workerEntry(size_t workerIndex)
+        {
+            uint64_t seen = 0;
+            while (true)
+            {
+                {
+                    std::unique_lock lock(mutex);
+                    wake.wait(lock, [&]
+                    {
+                        return bStopping || generation != seen;
+                    });
+                    if (bStopping)
+                    {
+                        return;
+                    }
+                    seen = generation;
+                }
+
+                work(workerIndex);
+
+                std::lock_guard lock(mutex);
+                if (--busyWorkers == 0)
+                {
+                    done.notify_one();
+                }
+            }
+        }
+
+        //----------------------------------------------------------------------
+        // Take tasks until there are none left. pTask and numTasks were set
+        // under the mutex before the worker was woken.
+        void work(size_t workerIndex)
+        {
+            while (true)
+            {
+                size_t taskIndex =
+                    nextTask.fetch_add(1, std::memory_order_relaxed);
+                if (taskIndex >= numTasks)
+                {
+                    return;
+                }
+                try
+                {
+                    (*pTask)(taskIndex, workerIndex);
+                }
+                catch (...)
+                {
+                    std::lock_guard lock(mutex);
+                    if (!error)
+                    {
+                        error = std::current_exception();
+                    }
+                    nextTask.store(numTasks, std::memory_order_relaxed);
+                }
+            }
+        }
+
+        // Data Members
+        std::mutex mutex;
+        std::condition_variable wake;
+        std::condition_variable done;
+        const Task* pTask;
+        size_t numTasks;
+        std::atomic<size_t> nextTask;
+        // Pool threads still working on the current run
+        size_t busyWorkers;
+        uint64_t generation;
+        bool bStopping;
+        std::exception_ptr error;
+        std::vector<std::thread> workers;
+    };
+
+} // namespace Concurrency
+
+#endif // INCLUDE_THREAD_POOL_H__
@@ -0,0 +1,189 @@
+// Copyright (c) 2025 Michael Dello
+//
+// This software is provided under the MIT License.
+// See LICENSE file for details.
+
+#ifndef INCLUDE_TSC_CLOCK_H__
+#define INCLUDE_TSC_CLOCK_H__
+//------------------------------------------------------------------------------
+//
+// This header provides a monotonic nanosecond clock read from the CPU's time
+// stamp counter (TSC), calibrated against std::chrono::steady_clock.
+//
+// Notable usage features and characteristics:
+//
+//     1. Reading the TSC is a single instruction, several times cheaper than
+//        a steady_clock call, so every acquired block can be timestamped
+//     2. Calibrated once, on first use, by timing a short sleep with both
+//        clocks. Timestamps start on steady_clock's epoch, but the rate error
+//        of so short a calibration accumulates, drifting them away from it
+//        over a long run: compare timestamps with each other, not with
+//        steady_clock readings.
+//     3. The TSC is used only when the CPU reports it invariant (constant
+//        rate, running in all power states), otherwise every reading falls
+//        back to steady_clock
+//     4. Thread-safe: the calibration is immutable once made
+//
+//------------------------------------------------------------------------------
+
+#include <chrono>
+#include <cstdint>
+#include <thread>
+
+// The TSC needs GCC/Clang intrinsics on an x86 CPU
+#if (defined(__GNUC__) || defined(__clang__)) && \
+    (defined(__x86_64__) || defined(__i386__))
+#define COMMON_TSC_CLOCK_X86 1
+#include <cpuid.h>
+#include <x86intrin.h>
+#else
+#define COMMON_TSC_CLOCK_X86 0
+#endif
+
+namespace Metrics
+{
+    //--------------------------------------------------------------------------
+    // Class: TscClock
+    //
+    // Description:
+    //    Static, calibrated TSC timestamps in nanoseconds.
+    //
+    class TscClock
+    {
+    public:
+        //----------------------------------------------------------------------
+        // Constants
+        //----------------------------------------------------------------------
+        static constexpr std::chrono::milliseconds CALIBRATION_TIME{10};
+
+        //----------------------------------------------------------------------
+        // Nanoseconds on the steady_clock epoch
+        static uint64_t nowNs() noexcept
+        {
+            const sCalibration& calibration = calibrated();
+            if (!calibration.bTsc)
+            {
+                return steadyNs();
+            }
+
+            // Signed, another core's counter may lag the calibration point
+            int64_t deltaTicks = int64_t(ticks() - calibration.baseTicks);
+            if (deltaTicks >= 0)
+            {
+                return calibration.baseNs +
+                    scale(uint64_t(deltaTicks), calibration.nsPerTickQ32);
+            }
+            return calibration.baseNs -
+                scale(uint64_t(-deltaTicks), calibration.nsPerTickQ32);
+        }
+
+        //----------------------------------------------------------------------
+        // Whether readings come from the TSC rather than steady_clock
+        static bool usesTsc() noexcept { return calibrated().bTsc; }
+
+        //----------------------------------------------------------------------
+        // Measured TSC rate, 0 when not in use
+        static double ticksPerNs() noexcept
+        {
+            const sCalibration& calibration = calibrated();
+            return calibration.bTsc ?
+                double(uint64_t{1} << 32) / double(calibration.nsPerTickQ32) :
+                0.0;
+        }
+
+    private:
+        struct sCalibration
+        {
+            bool bTsc{false};
+            uint64_t baseTicks{0};
+            uint64_t baseNs{0};
+            // Nanoseconds per tick, 32.32 fixed point
+            uint64_t nsPerTickQ32{0};
+        };
+
+        //----------------------------------------------------------------------
+        static const sCalibration& calibrated() noexcept
+        {
+            static const sCalibration calibration = calibrate();
+            return calibration;
+        }
+
+        //----------------------------------------------------------------------
+        static sCalibration calibrate() noexcept
+        {
+            sCalibration calibration;
+            if (!invariantTsc())
+            {
+                return calibration;
+            }
+
+            uint64_t startNs = steadyNs();
+            uint64_t startTicks = ticks();
+            std::this_thread::sleep_for(CALIBRATION_TIME);
+            uint64_t endNs = steadyNs();
+            uint64_t endTicks = ticks();
+            if (endTicks <= startTicks)
+            {
+                return calibration;
+            }
+
+            calibration.bTsc = true;
+            calibration.baseTicks = endTicks;
+            calibration.baseNs = endNs;
+            calibration.nsPerTickQ32 = uint64_t(
+                (static_cast<unsigned __int128>(endNs - startNs) << 32) /
+                (endTicks - startTicks));
+            return calibration;
+        }
+
+        //----------------------------------------------------------------------
+        static bool invariantTsc() noexcept
+        {
+#if COMMON_TSC_CLOCK_X86
+            unsigned eax = 0;
+            unsigned ebx = 0;
+            unsigned ecx = 0;
+            unsigned edx = 0;
+            // Advanced power management leaf, EDX bit 8: invariant TSC
+            if (__get_cpuid(0x80000007, &eax, &ebx, &ecx, &edx) == 0)
+            {
+                return false;
+            }
+            return (edx & (1u << 8)) != 0;
+#else
+            return false;
+#endif
+        }
+
+        //----------------------------------------------------------------------
+        static uint64_t ticks() noexcept
+        {
+#if COMMON_TSC_CLOCK_X86
+            return __rdtsc();
+#else
+            return 0;
+#endif
+        }
+
+        //----------------------------------------------------------------------
+        static uint64_t scale(uint64_t deltaTicks, uint64_t nsPerTickQ32)
+            noexcept
+        {
+            return uint64_t(
+                (static_cast<unsigned __int128>(deltaTicks) * nsPerTickQ32) >>
+                32);
+        }
+
+        //----------------------------------------------------------------------
+        static uint64_t steadyNs() noexcept
+        {
+            return uint64_t(
+                std::chrono::duration_cast<std::chrono::nanoseconds>(
+                    std::chrono::steady_clock::now().time_since_epoch())
+                    .count());
+        }
+    };
+
+} // namespace Metrics
+
+#endif // INCLUDE_TSC_CLOCK_H__
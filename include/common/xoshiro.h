@@ -0,0 +1,142 @@
+// Copyright (c) 2025 Michael Dello
+//
+// This software is provided under the MIT License.
+// See LICENSE file for details.
+
+#ifndef INCLUDE_XOSHIRO_H__
+#define INCLUDE_XOSHIRO_H__
+//------------------------------------------------------------------------------
+//
+// This header provides the xoshiro256++ pseudo-random number generator by
+// David Blackman and Sebastiano Vigna (public domain reference at
+// https://prng.di.unimi.it).
+//
+// Notable usage features and characteristics:
+//
+//     1. 256 bits of state and a handful of shifts, rotates and adds per
+//        64-bit output, several times faster than std::mt19937 with a far
+//        smaller state
+//     2. Seeded from a single 64-bit value through splitmix64, as the authors
+//        recommend, so equal seeds give equal sequences on every platform
+//     3. jump() advances the state by 2^128 outputs, giving non-overlapping
+//        streams for parallel instances seeded alike
+//     4. Meets the UniformRandomBitGenerator requirements, so it works with
+//        the <random> distributions
+//     5. Not thread-safe: meant to be owned per instance or per thread
+//
+//------------------------------------------------------------------------------
+
+#include <array>
+#include <bit>
+#include <cstdint>
+#include <limits>
+
+namespace Random
+{
+    //--------------------------------------------------------------------------
+    // splitmix64: advances state by a constant and returns it well mixed.
+    // Also usable as a fast counter-based hash.
+    constexpr uint64_t splitmix64(uint64_t& state) noexcept
+    {
+        state += 0x9e3779b97f4a7c15;
+        uint64_t z = state;
+        z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9;
+        z = (z ^ (z >> 27)) * 0x94d049bb133111eb;
+        return z ^ (z >> 31);
+    }
+
+    //--------------------------------------------------------------------------
+    // Class: Xoshiro256pp
+    //
+    // Description:
+    //    A small, fast, seedable 64-bit generator.
+    //
+    class Xoshiro256pp
+    {
+    public:
+        using result_type = uint64_t;
+
+        //----------------------------------------------------------------------
+        explicit Xoshiro256pp(uint64_t seed = 1) noexcept
+        {
+            // splitmix64 spreads the seed over the whole state, which must
+            // never be all zero
+            for (uint64_t& word : state)
+            {
+                word = splitmix64(seed);
+            }
+        }
+
+        //----------------------------------------------------------------------
+        // From a raw state, for checking against the reference implementation
+        static Xoshiro256pp fromState(
+            const std::array<uint64_t, 4>& rawState) noexcept
+        {
+            Xoshiro256pp generator;
+            generator.state = rawState;
+            return generator;
+        }
+
+        //----------------------------------------------------------------------
+        static constexpr result_type min() noexcept { return 0; }
+        static constexpr result_type max() noexcept
+        {
+            return std::numeric_limits<result_type>::max();
+        }
+
+        //----------------------------------------------------------------------
+        result_type operator()() noexcept
+        {
+            uint64_t result = std::rotl(state[0] + state[3], 23) + state[0];
+            uint64_t shifted = state[1] << 17;
+            state[2] ^= state[0];
+            state[3] ^= state[1];
+            state[1] ^= state[2];
+            state[0] ^= state[3];
+            state[2] ^= shifted;
+            state[3] = std::rotl(state[3], 45);
+            return result;
+        }
+
+        //----------------------------------------------------------------------
+        // Uniform in [0, 1), from the top 53 bits
+        double nextDouble() noexcept
+        {
+            return double((*this)() >> 11) * 0x1.0p-53;
+        }
+
+        //----------------------------------------------------------------------
+        // Equivalent to 2^128 calls, for non-overlapping parallel streams
+        void jump() noexcept
+        {
+            constexpr uint64_t JUMP[] =
+            {
+                0x180ec6d33cfd0aba, 0xd5a61266f0c9392c,
+                0xa9582618e03fc9aa, 0x39abdc4529b1661c
+            };
+
+            std::array<uint64_t, 4> jumped{};
+            for (uint64_t jumpWord : JUMP)
+            {
+                for (int bit = 0; bit < 64; ++bit)
+                {
+                    if (jumpWord & (uint64_t{1} << bit))
+                    {
+                        for (size_t i = 0; i < state.size(); ++i)
+                        {
+                            jumped[i] ^= state[i];
+                        }
+                    }
+                    (*this)();
+                }
+            }
+            state = jumped;
+        }
+
+    private:
+        std::array<uint64_t, 4> state;
+    };
+
+} // namespace Random
+
+#endif // INCLUDE_XOSHIRO_H__
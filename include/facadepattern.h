@@ -16,8 +16,43 @@
 // The SignalData class simplifies the interaction between the client and
 // the signal data sources. This design pattern decouples the complexity of
 // a multi-class subsytem from the client who needs its services. The SignalData
-// class also implements the Singleton design pattern to enforce a single entry
-// point to the signal data sources.
+// class also implements the Singleton design pattern to provide a default
+// entry point to the signal data sources.
+//
+// Besides single samples, the subsystem supports bulk acquisition: drivers
+// and HALs fill a whole block per call, and the ADC is started once per block
+// rather than once per sample.
+//
+// Scanning converters sample a configured list of channels per scan. A scan
+// block is a run of frames, each holding one sample per configured channel
+// in list order, transferred DMA-style in blocks rather than one virtual call
+// per channel. Converters that do not scan support channel 0 only, through
+// the same API.
+//
+// For an uninterrupted sample stream, SignalData also has a streaming mode: a
+// dedicated acquisition thread keeps the ADC started and pushes samples into
+// a lock-free Single Producer Single Consumer ring, from which one consumer
+// thread reads batches, blocking or not. Samples produced while the ring is
+// full are dropped and counted as overruns.
+//
+// SignalData instances are independent acquisition engines: each owns its
+// drivers, streaming thread and ring, and can pin its streaming thread to a
+// CPU, so independent pipelines can run side by side, one per core.
+// getInstance() remains as the process-wide default engine for existing
+// clients.
+//
+// Acquisitions are timestamped with Metrics::TscClock, a monotonic
+// nanosecond clock on the steady_clock epoch: batch reads return the
+// timestamp of their first sample, and streamed samples can be read with
+// the timestamp of the first one. Every engine also keeps live histograms
+// of the interval between blocks and per sample, and of the driver read
+// time per block, for proving timing stability under load.
+//
+// Threads that only need the current value of the signal, such as displays
+// and control loops, read the latest sample from a seqlock cell that every
+// acquisition publishes to, rather than acquiring themselves: any number of
+// them get a consistent snapshot without locks, without driver calls and
+// without disturbing the streaming consumer.
 //
 // Additional design principles, patterns, and modern C++ features used:
 //
@@ -25,7 +60,8 @@
 //       hardware abstractions. These can be used in place of the
 //       Hardware Driver implementations depending on context.
 //
-//    2. Singleton - Ensure only a single instance of the Facade is used
+//    2. Singleton - Provide a single default instance of the Facade, for
+//       clients that need only one
 //
 //    3. Liskov's Substitution - Allow child class substitutions in client
 //       code based on context without the client needing to know
@@ -40,12 +76,30 @@
 //
 //------------------------------------------------------------------------------
 
+#include <atomic>
+#include <chrono>
+#include <cstddef>
 #include <cstdint>
+#include <future>
 #include <memory>
+#include <mutex>
 #include <optional>
+#include <span>
+#include <string>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+#include "common/latency_histogram.h"
+#include "common/seqlock.h"
+#include "common/spsc_ring.h"
+#include "common/xoshiro.h"
 
 namespace SignalDataFacade
 {
+    // Struct-of-arrays sample container, see facadepattern_sampleblock.h
+    class SampleBlock;
+
     //==========================================================================
     // ADC
     //==========================================================================
@@ -66,6 +120,16 @@ namespace SignalDataFacade
         virtual void start() = 0;
         virtual void stop() = 0;
         virtual std::optional<uint16_t> read() = 0;
+        // Fill samples while started, returning how many were read before
+        // the first missing sample. Defaults to one read() per sample, so
+        // drivers override it when they can transfer a block at once.
+        virtual size_t readBlock(std::span<uint16_t> samples);
+        // Select the channels every scan converts, in order. Returns false if
+        // the list is not supported. Defaults to supporting only channel 0.
+        virtual bool configureScan(std::span<const uint8_t> channels);
+        // Fill whole frames of the configured channels while started,
+        // returning how many frames were read. Defaults to readBlock().
+        virtual size_t scan(std::span<uint16_t> frames);
     };
 
     //--------------------------------------------------------------------------
@@ -79,10 +143,25 @@ namespace SignalDataFacade
     {
     private:
         std::unique_ptr<IA2DConverter> upADC;
+        size_t numScanChannels;
     public:
         // Avoid implicit conversion by using explicit
         explicit A2DConverterHAL(std::unique_ptr<IA2DConverter> adcImpl);
         std::optional<uint16_t> read() const;
+        // Start the ADC once, fill every sample, then stop. Samples that
+        // could not be read are zeroed (no signal). Returns how many were read.
+        size_t readBlock(std::span<uint16_t> samples) const;
+        // Keep the ADC running across many blocks, for streaming
+        void start() const;
+        void stop() const;
+        // Like readBlock(), but the ADC must already be started
+        size_t readBlockStarted(std::span<uint16_t> samples) const;
+        // Select the scanned channels, keeping the previous list on failure
+        bool configureScan(std::span<const uint8_t> channels);
+        size_t scanChannels() const;
+        // Start the ADC once, fill every frame, then stop. Frames that could
+        // not be read are zeroed (no signal). Returns how many were read.
+        size_t scan(std::span<uint16_t> frames) const;
     };
 
     //--------------------------------------------------------------------------
@@ -94,13 +173,26 @@ namespace SignalDataFacade
     //
     class ADCDrv: public IA2DConverter
     {
+    public:
+        // Input channels of the simulated converter
+        static constexpr size_t NUM_CHANNELS = 32;
+        // Frames per simulated DMA transfer
+        static constexpr size_t DMA_BLOCK_FRAMES = 64;
     private:
         bool bStarted;
+        std::vector<uint8_t> scanList;
+        // Simulated DMA target, filled by the converter one block at a time
+        std::vector<uint16_t> dmaBuffer;
+        // Per instance, so drivers on different threads share no state
+        Random::Xoshiro256pp rng;
     public:
         ADCDrv();
         void start() override;
         void stop() override;
         std::optional<uint16_t> read() override;
+        size_t readBlock(std::span<uint16_t> samples) override;
+        bool configureScan(std::span<const uint8_t> channels) override;
+        size_t scan(std::span<uint16_t> frames) override;
     };
 
     //==========================================================================
@@ -121,6 +213,9 @@ namespace SignalDataFacade
     public:
         virtual ~IGPIO() = default;
         virtual std::optional<uint16_t> read() = 0;
+        // Fill samples, returning how many were read before the first missing
+        // sample. Defaults to one read() per sample.
+        virtual size_t readBlock(std::span<uint16_t> samples);
     };
 
     //--------------------------------------------------------------------------
@@ -138,6 +233,9 @@ namespace SignalDataFacade
         // Avoid implicit conversion by using explicit
         explicit GPIOHAL(std::unique_ptr<IGPIO> gpioImpl);
         std::optional<uint16_t> read() const;
+        // Fill every sample, zeroing those that could not be read (no
+        // signal). Returns how many were read.
+        size_t readBlock(std::span<uint16_t> samples) const;
     };
 
     //--------------------------------------------------------------------------
@@ -149,8 +247,12 @@ namespace SignalDataFacade
     //
     class GPIODrv: public IGPIO
     {
+    private:
+        Random::Xoshiro256pp rng;
     public:
+        GPIODrv();
         std::optional<uint16_t> read() override;
+        size_t readBlock(std::span<uint16_t> samples) override;
     };
 
     //=========================================================================
@@ -169,42 +271,212 @@ namespace SignalDataFacade
     //
     class SignalData
     {
+    public:
+        // Data Accessor
+        // A plain aggregate, trivially copyable so arrays of samples can be
+        // memcpy'd, zero-initialized cheaply and vectorized
+        struct sAggregateData
+        {
+            uint16_t analog;
+            uint16_t digital;
+        };
+
+        // Acquisition timing since construction or resetTiming(), in ns
+        struct sAcquisitionTiming
+        {
+            uint64_t numBlocks{0};
+            uint64_t numSamples{0};
+            // Between the starts of consecutive blocks, and that divided by
+            // the samples in the earlier block
+            Metrics::LatencyHistogram blockInterval;
+            Metrics::LatencyHistogram sampleInterval;
+            // In the ADC and GPIO drivers, per block
+            Metrics::LatencyHistogram readTime;
+        };
+
+        // The most recent sample acquired, see latest()
+        struct sLatestSample
+        {
+            sAggregateData sample;
+            // When its acquisition read completed
+            uint64_t timestampNs;
+            // Samples acquired by the engine up to and including this one
+            uint64_t numAcquired;
+        };
+
+        //----------------------------------------------------------------------
+        // Constants
+        //----------------------------------------------------------------------
+        static constexpr size_t DEFAULT_STREAM_CAPACITY = 1 << 16;
+        // Samples acquired per block by the streaming thread
+        static constexpr size_t STREAM_BLOCK_SIZE = 256;
+
     private:
         std::unique_ptr<A2DConverterHAL> adc;
         std::unique_ptr<GPIOHAL> gpio;
 
+        // Streaming mode
+        std::unique_ptr<Concurrency::SpscRing<sAggregateData>> upStreamRing;
+        std::thread streamThread;
+        std::atomic<bool> bStreaming;
+        std::atomic<uint64_t> overruns;
+        // Timestamp of each pushed block, by index of its first sample
+        struct sStreamMark
+        {
+            uint64_t firstSampleIndex;
+            uint64_t timestampNs;
+        };
+        std::unique_ptr<Concurrency::SpscRing<sStreamMark>> upMarkRing;
+        // Consumer side position and marks around it
+        uint64_t consumedSamples;
+        sStreamMark currentMark;
+        std::optional<sStreamMark> nextMark;
+        double samplePeriodNs;
+        uint64_t lastStreamTimestampNs;
+
+        // Timing instrumentation, recorded from const acquisitions too
+        mutable std::mutex timingMutex;
+        mutable sAcquisitionTiming timing;
+        mutable uint64_t lastBlockStartNs;
+        mutable uint64_t lastBlockSamples;
+
+        // Staging columns of acquireBatch() into sAggregateData, reused
+        // across calls so a batch does not allocate
+        mutable std::mutex batchMutex;
+        mutable std::vector<uint16_t> batchAnalog;
+        mutable std::vector<uint16_t> batchDigital;
+
+        // Latest sample, published by whichever thread acquires. The
+        // SeqLock takes one writer at a time, so publishers hold
+        // publishMutex; readers never take it.
+        mutable std::mutex publishMutex;
+        mutable Concurrency::SeqLock<sLatestSample> latestSample;
+        mutable std::atomic<uint64_t> acquiredSamples;
+
         //----------------------------------------------------------------------
-        // Singleton pattern:
-        // Disallow clients to create an instance of this class
-        SignalData(
-            std::unique_ptr<A2DConverterHAL> adcImpl,
-            std::unique_ptr<GPIOHAL> gpioImpl);
+        // Streaming thread entry point, reporting through started once
+        // pinned and ready to push
+        void streamEntry(
+            size_t ringCapacity,
+            std::optional<unsigned> cpu,
+            std::promise<void> started);
+        // Timestamp of a sample about to be read from the stream
+        uint64_t streamTimestampOf(uint64_t sampleIndex);
+        // Add one acquired block to the timing histograms
+        void recordBlock(
+            uint64_t startNs,
+            uint64_t endNs,
+            size_t numSamples) const;
+        // Publish the last of numSamples samples just acquired
+        void publishLatest(
+            sAggregateData sample,
+            uint64_t timestampNs,
+            size_t numSamples) const;
+
+    public:
+        //----------------------------------------------------------------------
+        // Independent engine, owning its HALs. Missing HALs default to the
+        // simulated hardware drivers.
+        explicit SignalData(
+            std::unique_ptr<A2DConverterHAL> adcImpl = nullptr,
+            std::unique_ptr<GPIOHAL> gpioImpl = nullptr);
         //----------------------------------------------------------------------
         // Delete copy and assignment operators
         SignalData(const SignalData&) = delete;
         SignalData& operator=(const SignalData&) = delete;
         //----------------------------------------------------------------------
 
-    public:
+        // Stops streaming, if running
+        ~SignalData();
+
         //----------------------------------------------------------------------
         // Singleton pattern:
-        // Single Instance Accessor
+        // Default Instance Accessor, kept for compatibility. The HALs are only
+        // used by the first call, later calls warn and ignore them, so code
+        // needing its own drivers should construct a SignalData instead.
         static SignalData& getInstance(
             std::unique_ptr<A2DConverterHAL> adcImpl = nullptr,
             std::unique_ptr<GPIOHAL> gpioImpl = nullptr);
 
-        // Data Accessor
-        struct sAggregateData
-        {
-            uint16_t analog;
-            uint16_t digital;
-            sAggregateData(uint16_t analogData, uint16_t digitalData);
-        };
-
         // Client's interface for obtaining data acquisition results
         sAggregateData acquire() const;
+
+        // Client's interface for obtaining a batch of results at once, filling
+        // every element of samples with a single block read per source.
+        // Returns the timestamp of the first sample.
+        uint64_t acquireBatch(std::span<sAggregateData> samples) const;
+
+        // Struct-of-arrays variants, appending to the block with the drivers
+        // writing straight into its columns
+        void acquire(SampleBlock& block) const;
+        uint64_t acquireBatch(SampleBlock& block, size_t count) const;
+
+        //----------------------------------------------------------------------
+        // Multi-channel frames:
+        // Select the ADC channels of every frame, returning false if the
+        // converter does not support the list
+        bool configureScan(std::span<const uint8_t> channels);
+        size_t scanChannels() const;
+        // Fill analogFrames with channel-interleaved frames of the scanned
+        // channels, and digital with the GPIO sample taken with each frame.
+        // Returns the number of frames, the smaller of what both hold.
+        size_t acquireFrames(
+            std::span<uint16_t> analogFrames,
+            std::span<uint16_t> digital) const;
+
+        //----------------------------------------------------------------------
+        // Streaming mode:
+        // Start and stop are for a controlling thread, reads are for a single
+        // consumer thread. Samples left in the ring after stopping can still
+        // be read, until streaming is started again with a fresh ring. The
+        // streaming thread owns the drivers, so acquire() and acquireBatch()
+        // must not be used while streaming. With a cpu, the streaming thread
+        // is pinned to it; failure to pin throws and leaves streaming stopped.
+        void startStreaming(
+            size_t ringCapacity = DEFAULT_STREAM_CAPACITY,
+            std::optional<unsigned> cpu = {});
+        void stopStreaming();
+        bool isStreaming() const;
+        // Read what is available without blocking, returning how many
+        size_t readStream(std::span<sAggregateData> samples);
+        // Wait up to timeout for at least one sample, returning how many.
+        // Returns 0 on timeout, or once stopped and drained.
+        size_t readStream(
+            std::span<sAggregateData> samples,
+            std::chrono::milliseconds timeout);
+        // Also returns the timestamp of the first sample read, interpolated
+        // between the timestamps of the blocks around it
+        size_t readStream(
+            std::span<sAggregateData> samples,
+            std::chrono::milliseconds timeout,
+            uint64_t& firstTimestampNs);
+        // Samples dropped because the ring was full, since streaming started
+        uint64_t streamOverruns() const;
+
+        //----------------------------------------------------------------------
+        // Latest value:
+        // The last sample of the most recent single channel acquisition or
+        // streamed block, empty before the first. Safe to call from any
+        // number of threads at any time: it never calls the drivers, never
+        // takes a lock and never consumes from the stream.
+        std::optional<sLatestSample> latest() const;
+        // Acquisitions published so far, to skip unchanged snapshots
+        uint64_t latestVersion() const;
+
+        //----------------------------------------------------------------------
+        // Timing instrumentation:
+        // Safe to call from any thread while acquiring
+        sAcquisitionTiming timingSnapshot() const;
+        void resetTiming();
+        // Human readable percentiles of the snapshot
+        std::string timingReport() const;
     };
 
+    static_assert(std::is_trivially_copyable_v<SignalData::sAggregateData>);
+    static_assert(std::is_trivial_v<SignalData::sAggregateData>);
+    static_assert(sizeof(SignalData::sAggregateData) == 2 * sizeof(uint16_t));
+    static_assert(std::is_trivially_copyable_v<SignalData::sLatestSample>);
+
 } // namespace SignalDataFacade
 
 #endif // INCLUDE_FACADEPATTERN_H_
\ No newline at end of file
@@ -0,0 +1,168 @@
+// Copyright (c) 2025 Michael Dello
+//
+// This software is provided under the MIT License.
+// See LICENSE file for details.
+
+#ifndef INCLUDE_FACADEPATTERN_BITPLANE_H_
+#define INCLUDE_FACADEPATTERN_BITPLANE_H_
+//------------------------------------------------------------------------------
+//
+// This header provides bit-plane packed storage for the digital (GPIO) samples
+// acquired through the Facade Design Pattern example, with kernels for edge
+// detection, duty cycle and toggle counts, and run-length encoding.
+//
+// A GPIO sample is a 16-bit word, one bit per line. Stored as words, every
+// line costs 16 bits per sample, and asking about one line means touching
+// all of them. Bit planes store each line as its own bitset, 64 samples per
+// uint64_t, and only the lines selected by a mask are kept: one line costs 1
+// bit per sample, a 16x saving over the words. Per-line questions then run
+// over 64 samples per word:
+//
+//    edges      - bit i set when the line changed into sample i: rising is
+//                 w & ~prev, falling ~w & prev, any w ^ prev, with prev the
+//                 plane shifted by one sample
+//    duty cycle - popcount of the plane over the sample count
+//    toggles    - popcount of the any-edge plane
+//    runs       - lengths of stable periods, found by jumping from edge to
+//                 edge, so long stable periods cost nothing to scan
+//
+// Additional design principles, patterns, and modern C++ features used:
+//
+//    1. Runtime CPU Dispatch - As for the statistics kernels, AVX2 and SSE
+//       paths are compiled with per-function target attributes and picked
+//       from what the CPU supports, with a portable scalar fallback
+//
+//    2. Struct-of-Arrays - Each line is a contiguous bitset, so a per-line
+//       query streams through exactly the memory it needs
+//
+//------------------------------------------------------------------------------
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+#include "facadepattern_stats.h"
+
+namespace SignalDataFacade
+{
+    //--------------------------------------------------------------------------
+    // Types
+    //--------------------------------------------------------------------------
+    enum class eEdge: uint8_t
+    {
+        RISING,
+        FALLING,
+        ANY
+    };
+
+    const char* toString(eEdge edge);
+
+    //--------------------------------------------------------------------------
+    // PODs
+    //--------------------------------------------------------------------------
+
+    // A line as alternating stable periods, starting at initialLevel
+    struct sLineRuns
+    {
+        bool bInitialLevel{false};
+        std::vector<uint64_t> lengths;
+    };
+
+    //--------------------------------------------------------------------------
+    // Classes
+    //--------------------------------------------------------------------------
+    // Class: GpioBitPlanes
+    //
+    // Description:
+    //    Digital samples stored as one bitset per selected GPIO line. Sample
+    //    i of a line is bit i % 64 of word i / 64 of its plane, bits past the
+    //    last sample are zero. Not thread-safe.
+    //
+    class GpioBitPlanes
+    {
+    public:
+        //----------------------------------------------------------------------
+        // Constants
+        //----------------------------------------------------------------------
+        static constexpr size_t MAX_LINES = 16;
+        static constexpr size_t BITS_PER_WORD = 64;
+        // Whole range for the count arguments below
+        static constexpr size_t ALL = static_cast<size_t>(-1);
+
+        //----------------------------------------------------------------------
+        // Keep the lines set in lineMask. Kernels use the given level, or
+        // the best supported one below it.
+        explicit GpioBitPlanes(
+            uint16_t lineMask = 0xFFFF,
+            eSimdLevel level = detectedSimdLevel());
+
+        //----------------------------------------------------------------------
+        // Append GPIO words, transposing the selected lines into their planes
+        void append(std::span<const uint16_t> words);
+        void reserve(size_t numSamples);
+        void clear();
+
+        //----------------------------------------------------------------------
+        size_t size() const { return numSamples; }
+        uint16_t lineMask() const { return mask; }
+        bool hasLine(size_t line) const;
+        eSimdLevel simdLevel() const { return kernelLevel; }
+        // Heap bytes held by the planes
+        size_t memoryBytes() const;
+
+        //----------------------------------------------------------------------
+        // Throw std::out_of_range for a line not kept or a sample past size()
+        std::span<const uint64_t> plane(size_t line) const;
+        bool bit(size_t line, size_t index) const;
+        // Words of samples [first, first + words.size()), lines not kept zero
+        void unpack(size_t first, std::span<uint16_t> words) const;
+
+        //----------------------------------------------------------------------
+        // Edge plane of a line: bit i set when the line changed into sample i
+        std::vector<uint64_t> edges(size_t line, eEdge edge) const;
+
+        //----------------------------------------------------------------------
+        // Over samples [first, first + count), count clipped to size()
+        uint64_t countHigh(
+            size_t line,
+            size_t first = 0,
+            size_t count = ALL) const;
+        // Fraction of the samples that are high, 0 for no samples
+        double dutyCycle(
+            size_t line,
+            size_t first = 0,
+            size_t count = ALL) const;
+        // Transitions between consecutive samples of the range
+        uint64_t countEdges(
+            size_t line,
+            eEdge edge,
+            size_t first = 0,
+            size_t count = ALL) const;
+        uint64_t countToggles(
+            size_t line,
+            size_t first = 0,
+            size_t count = ALL) const;
+
+        //----------------------------------------------------------------------
+        // Run-length encoding of a whole line, and back to a plane
+        sLineRuns encodeRuns(size_t line) const;
+        static std::vector<uint64_t> decodeRuns(const sLineRuns& runs);
+
+    private:
+        // Methods
+        const std::vector<uint64_t>& planeOf(size_t line) const;
+        // Clip a range to the stored samples
+        size_t clippedCount(size_t first, size_t count) const;
+
+        // Data Members
+        uint16_t mask;
+        eSimdLevel kernelLevel;
+        size_t numSamples;
+        std::array<std::vector<uint64_t>, MAX_LINES> planes;
+    };
+
+} // namespace SignalDataFacade
+
+#endif // INCLUDE_FACADEPATTERN_BITPLANE_H_
@@ -0,0 +1,205 @@
+// Copyright (c) 2025 Michael Dello
+//
+// This software is provided under the MIT License.
+// See LICENSE file for details.
+
+#ifndef INCLUDE_FACADEPATTERN_CALIBRATION_H_
+#define INCLUDE_FACADEPATTERN_CALIBRATION_H_
+//------------------------------------------------------------------------------
+//
+// This header provides per-channel calibration of the raw codes acquired
+// through the Facade Design Pattern example into engineering units (volts,
+// amps, degrees, ...), so consumers share one conversion rather than each
+// applying its own.
+//
+// A calibration is a polynomial in the raw code (gain and offset being the
+// linear case) or a measured value for every code. Either way it is turned
+// into a 65,536-entry lookup table when loaded, so converting a sample is a
+// single load whatever the model, in floating point or fixed point
+// (round(value * fixedScale), for integer-only consumers).
+//
+// Bulk conversions work a block column at a time. A linear calibration is
+// computed rather than looked up, 8 (AVX2) or 4 (SSE) samples per
+// instruction, other ones gather 8 table entries at once on AVX2.
+//
+// Tables are immutable once built. A ChannelCalibration holds one per
+// channel behind an atomic shared pointer: a new calibration is built off
+// the acquisition path and swapped in with a pointer exchange, while
+// conversions in flight finish with the table they started with, so
+// acquisition never pauses for a recalibration.
+//
+// Additional design principles, patterns, and modern C++ features used:
+//
+//    1. Immutable Shared State - Tables are shared read-only by every
+//       converting thread and replaced whole, never modified in place
+//
+//    2. Runtime CPU Dispatch - As for the statistics kernels, SIMD paths are
+//       compiled with per-function target attributes and picked from what
+//       the CPU supports, with a portable scalar fallback
+//
+//------------------------------------------------------------------------------
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <span>
+#include <vector>
+
+#include "facadepattern_capture.h"
+#include "facadepattern_stats.h"
+
+namespace SignalDataFacade
+{
+    //--------------------------------------------------------------------------
+    // PODs
+    //--------------------------------------------------------------------------
+    struct sCalibration_t
+    {
+        // value = c[0] + c[1] * code + c[2] * code^2 + ..., so {offset, gain}
+        // for a linear converter
+        std::vector<double> coefficients{0.0, 1.0};
+        // Measured value of every code, used instead of the coefficients
+        // when not empty
+        std::vector<double> table;
+        // Fixed-point outputs are round(value * fixedScale), saturated to
+        // the int32_t range: 65536 for Q16.16, 1e6 for micro-units
+        double fixedScale{65536.0};
+    };
+
+    //--------------------------------------------------------------------------
+    // Functions
+    //--------------------------------------------------------------------------
+
+    //--------------------------------------------------------------------------
+    // The gain and offset recorded for a capture file channel
+    sCalibration_t calibrationOf(const sCaptureChannel_t& channel);
+
+    //--------------------------------------------------------------------------
+    // Classes
+    //--------------------------------------------------------------------------
+    // Class: CalibrationTable
+    //
+    // Description:
+    //    The value of every raw code of one channel, in floating and fixed
+    //    point. Immutable, so one instance can serve any number of threads.
+    //
+    class CalibrationTable
+    {
+    public:
+        static constexpr size_t NUM_CODES = 65536;
+
+        //----------------------------------------------------------------------
+        // Throws std::invalid_argument for no coefficients, a table of other
+        // than NUM_CODES values, a fixed scale that is not positive, or any
+        // value that is not finite. Kernels use the given level, or the best
+        // supported one below it.
+        explicit CalibrationTable(
+            const sCalibration_t& calibration = {},
+            eSimdLevel level = detectedSimdLevel());
+
+        //----------------------------------------------------------------------
+        float value(uint16_t code) const { return values[code]; }
+        int32_t fixedValue(uint16_t code) const { return fixedValues[code]; }
+
+        //----------------------------------------------------------------------
+        // Convert codes into the first codes.size() outputs. Throws
+        // std::invalid_argument when there are fewer outputs than codes.
+        // Linear conversions are computed, and may differ from value() in
+        // the last bit.
+        void convert(
+            std::span<const uint16_t> codes,
+            std::span<float> outputs) const;
+        void convert(
+            std::span<const uint16_t> codes,
+            std::span<int32_t> outputs) const;
+
+        //----------------------------------------------------------------------
+        // A polynomial of degree one or less
+        bool isLinear() const { return bLinear; }
+        double fixedScale() const { return scale; }
+        eSimdLevel simdLevel() const { return kernelLevel; }
+
+    private:
+        // Data Members
+        eSimdLevel kernelLevel;
+        bool bLinear;
+        // Of a linear calibration
+        float gain;
+        float offset;
+        double scale;
+        std::vector<float> values;
+        std::vector<int32_t> fixedValues;
+    };
+
+    //--------------------------------------------------------------------------
+    // Class: ChannelCalibration
+    //
+    // Description:
+    //    The calibration tables of a fixed number of channels, initially the
+    //    identity. Thread-safe: tables can be loaded or swapped from any
+    //    thread while others convert.
+    //
+    class ChannelCalibration
+    {
+    public:
+        //----------------------------------------------------------------------
+        explicit ChannelCalibration(
+            size_t numChannels,
+            eSimdLevel level = detectedSimdLevel());
+
+        ChannelCalibration(const ChannelCalibration&) = delete;
+        ChannelCalibration& operator=(const ChannelCalibration&) = delete;
+
+        //----------------------------------------------------------------------
+        // Build a table for the channel, then swap it in. Throws
+        // std::out_of_range for a channel that does not exist, and whatever
+        // CalibrationTable throws, leaving the current table in place.
+        void load(size_t channel, const sCalibration_t& calibration);
+        // Swap in a prebuilt table, which may be shared between channels
+        void setTable(
+            size_t channel,
+            std::shared_ptr<const CalibrationTable> spTable);
+        // The current table, kept alive for as long as the caller holds it
+        std::shared_ptr<const CalibrationTable> table(size_t channel) const;
+
+        //----------------------------------------------------------------------
+        // Convert a column of one channel with a single table, even if
+        // another is swapped in meanwhile
+        void convert(
+            size_t channel,
+            std::span<const uint16_t> codes,
+            std::span<float> outputs) const;
+        void convert(
+            size_t channel,
+            std::span<const uint16_t> codes,
+            std::span<int32_t> outputs) const;
+        // Convert channel-interleaved frames of every channel, as produced
+        // by SignalData::acquireFrames(), into interleaved outputs equal to
+        // those of convert() on each channel's column. Throws
+        // std::invalid_argument for a partial frame or too few outputs.
+        void convertFrames(
+            std::span<const uint16_t> frames,
+            std::span<float> outputs) const;
+
+        //----------------------------------------------------------------------
+        size_t numChannels() const { return channelCount; }
+        // Tables swapped in since construction, over all channels
+        uint64_t numSwaps() const { return swaps.load(); }
+
+    private:
+        // Methods
+        std::atomic<std::shared_ptr<const CalibrationTable>>& slot(
+            size_t channel) const;
+
+        // Data Members
+        size_t channelCount;
+        eSimdLevel kernelLevel;
+        std::unique_ptr<std::atomic<std::shared_ptr<const CalibrationTable>>[]>
+            tables;
+        std::atomic<uint64_t> swaps;
+    };
+
+} // namespace SignalDataFacade
+
+#endif // INCLUDE_FACADEPATTERN_CALIBRATION_H_
@@ -0,0 +1,386 @@
+// Copyright (c) 2025 Michael Dello
+//
+// This software is provided under the MIT License.
+// See LICENSE file for details.
+
+#ifndef INCLUDE_FACADEPATTERN_CAPTURE_H_
+#define INCLUDE_FACADEPATTERN_CAPTURE_H_
+//------------------------------------------------------------------------------
+//
+// This header provides a chunked binary capture file format for archiving the
+// signal data acquired through the Facade Design Pattern example, with a
+// writer for the acquisition side and a memory-mapped reader.
+//
+// File layout (native byte order):
+//
+//    File header - CAPTURE_HEADER_BYTES, see sCaptureFileHeader: channel
+//                  layout with per-channel calibration, sample rate, chunk
+//                  geometry and the number of committed chunks
+//    Chunk 0..N  - fixed size slots of chunkBytes each, see
+//                  sCaptureChunkHeader, followed by one 64-byte aligned
+//                  column slot per channel, holding chunkSamples uint16_t
+//                  (encoding 0) or a codec frame (encoding 1)
+//
+// A channel can be stored compressed with one of the codecs of
+// facadepattern_codec.h, chosen per channel. Compressed columns still sit in
+// fixed size slots, so chunks stay strided, but only the frame is written:
+// the rest of each slot is never touched, and on file systems with sparse
+// files takes no disk space. A frame that would not be smaller than the raw
+// samples is stored as a RAW frame, which the reader maps zero-copy. Frames
+// start CAPTURE_FRAME_OFFSET bytes into their slot, so their samples are
+// aligned like raw columns.
+//
+// Files with a compressed channel are version 2. Files without keep the
+// version 1 layout, raw column slots and a channel table without codecs, so
+// they stay readable by version 1 readers, and both versions can be read
+// and appended to.
+//
+// Every chunk header records the index and timestamp of its first sample,
+// and chunks are written in time order, so the chunk headers form a strided
+// timestamp index that the reader binary searches for O(log n) time-range
+// seeks. Samples within a chunk are evenly spaced at the sample rate. A gap
+// in time (for example after a streaming overrun) starts a new chunk.
+//
+// Appending survives a crash of the writing process at chunk granularity: a
+// chunk is written in full before the committedChunks count in the file
+// header is advanced, and readers never look past that count. A writer
+// interrupted mid-chunk leaves the previously committed data intact, and
+// reopening the file for append continues after the last committed chunk.
+// The kernel may write the pages of the file back in any order, though, so
+// the same holds across a power loss or OS crash only for files created with
+// bSyncChunks, whose chunks are flushed to storage before being committed.
+//
+// Additional design principles, patterns, and modern C++ features used:
+//
+//    1. Memory Mapping - The reader maps the file, so reopening hours of
+//       capture costs a page fault per touched page rather than a full read,
+//       and sample columns are handed out as zero-copy std::span views
+//
+//    2. RAII - File descriptors and mappings are released by their owners
+//
+//------------------------------------------------------------------------------
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <span>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "facadepattern.h"
+#include "facadepattern_codec.h"
+#include "facadepattern_sampleblock.h"
+
+namespace SignalDataFacade
+{
+    //--------------------------------------------------------------------------
+    // Constants
+    //--------------------------------------------------------------------------
+    constexpr char CAPTURE_MAGIC[8] = {'S', 'D', 'C', 'A', 'P', 'T', 'U', 'R'};
+    constexpr uint32_t CAPTURE_VERSION = 2;
+    // Version of files with no compressed channel
+    constexpr uint32_t CAPTURE_VERSION_RAW = 1;
+    constexpr size_t CAPTURE_HEADER_BYTES = 4096;
+    constexpr size_t CAPTURE_MAX_CHANNELS = 64;
+    constexpr size_t CAPTURE_CHANNEL_NAME_BYTES = 16;
+    // Alignment of every chunk column within the file
+    constexpr size_t CAPTURE_COLUMN_ALIGNMENT = 64;
+    // Offset of a codec frame within its column slot, aligning its samples
+    constexpr size_t CAPTURE_FRAME_OFFSET =
+        CAPTURE_COLUMN_ALIGNMENT - sizeof(sCodecFrameHeader);
+    // Chunk encodings
+    constexpr uint32_t CAPTURE_ENCODING_RAW = 0;
+    constexpr uint32_t CAPTURE_ENCODING_FRAMES = 1;
+    // File header flags
+    constexpr uint32_t CAPTURE_FLAG_SYNC_CHUNKS = 1;
+
+    //--------------------------------------------------------------------------
+    // PODs
+    //--------------------------------------------------------------------------
+
+    // Calibrated value = gain * raw + offset
+    struct sCaptureChannel_t
+    {
+        std::string sName;
+        double gain{1.0};
+        double offset{0.0};
+        eCodec codec{eCodec::RAW};
+    };
+
+    struct sCaptureConfig_t
+    {
+        // Defaults to the two signals of an sAggregateData sample
+        std::vector<sCaptureChannel_t> channels{{"analog"}, {"digital"}};
+        double sampleRateHz{1'000'000.0};
+        // Timestamp of the first sample
+        uint64_t startTimeNs{0};
+        uint32_t chunkSamples{65536};
+        // Flush each chunk to storage before advancing the commit point, at
+        // the cost of a flush per chunk. Kept by writers appending later.
+        bool bSyncChunks{false};
+    };
+
+    //--------------------------------------------------------------------------
+    // On-disk Layout
+    //--------------------------------------------------------------------------
+    struct sCaptureFileChannel
+    {
+        char name[CAPTURE_CHANNEL_NAME_BYTES];
+        double gain;
+        double offset;
+        eCodec codec;
+        uint32_t reserved;
+    };
+
+    // Channel table entry of version 1 files, whose channels are all RAW
+    struct sCaptureFileChannelV1
+    {
+        char name[CAPTURE_CHANNEL_NAME_BYTES];
+        double gain;
+        double offset;
+    };
+
+    struct sCaptureFileHeader
+    {
+        char magic[sizeof(CAPTURE_MAGIC)];
+        uint32_t version;
+        uint32_t numChannels;
+        uint32_t chunkSamples;
+        // CAPTURE_FLAG_* bits
+        uint32_t flags;
+        uint64_t chunkBytes;
+        double sampleRateHz;
+        uint64_t startTimeNs;
+        // Commit point, advanced only after a chunk is fully written
+        uint64_t committedChunks;
+        // sCaptureFileChannelV1 entries in version 1 files
+        sCaptureFileChannel channels[CAPTURE_MAX_CHANNELS];
+    };
+    static_assert(sizeof(sCaptureFileHeader) <= CAPTURE_HEADER_BYTES);
+
+    struct alignas(CAPTURE_COLUMN_ALIGNMENT) sCaptureChunkHeader
+    {
+        uint64_t firstSampleIndex;
+        uint64_t firstTimestampNs;
+        uint32_t numSamples;
+        // CAPTURE_ENCODING_RAW or CAPTURE_ENCODING_FRAMES
+        uint32_t encoding;
+    };
+
+    //--------------------------------------------------------------------------
+    // Classes
+    //--------------------------------------------------------------------------
+    // Class: CaptureWriter
+    //
+    // Description:
+    //    Appends samples to a capture file, one chunk at a time. Samples are
+    //    staged in memory until a chunk fills up or commit() is called.
+    //    Not thread-safe: meant to be fed by a single consumer, such as the
+    //    reader of SignalData's streaming mode.
+    //
+    class CaptureWriter
+    {
+    public:
+        // Called with the columns of every chunk as it is committed, one
+        // per channel, on the thread committing it
+        using CommitCallback =
+            std::function<void(std::span<const std::span<const uint16_t>>)>;
+
+        // Create (or truncate) a capture file
+        CaptureWriter(const std::string& sPath, const sCaptureConfig_t& config);
+        // Append to an existing capture file after its last committed chunk
+        explicit CaptureWriter(const std::string& sPath);
+        // Commits any staged samples
+        ~CaptureWriter();
+
+        CaptureWriter(const CaptureWriter&) = delete;
+        CaptureWriter& operator=(const CaptureWriter&) = delete;
+
+        //----------------------------------------------------------------------
+        // Append two-channel samples. Without a timestamp they follow the
+        // previous sample at the sample rate, with one that does not, a new
+        // chunk starts there.
+        void append(
+            std::span<const SignalData::sAggregateData> samples,
+            std::optional<uint64_t> firstTimestampNs = {});
+        void append(
+            const sSampleBlockView& block,
+            std::optional<uint64_t> firstTimestampNs = {});
+        // Append one column per channel, all of the same length
+        void appendColumns(
+            std::span<const std::span<const uint16_t>> columns,
+            std::optional<uint64_t> firstTimestampNs = {});
+        // Append channel-interleaved frames of one sample per channel, as
+        // produced by SignalData::acquireFrames()
+        void appendFrames(
+            std::span<const uint16_t> frames,
+            std::optional<uint64_t> firstTimestampNs = {});
+
+        //----------------------------------------------------------------------
+        // Write the staged samples as a (possibly partial) chunk and advance
+        // the commit point, so readers can see them. A partial chunk still
+        // takes a whole chunk slot of the file, and the next samples start
+        // a new one: commit (or sync) as rarely as the data loss allowed
+        // on a crash permits.
+        void commit();
+
+        //----------------------------------------------------------------------
+        // Commit, then flush the file to storage
+        void sync();
+
+        //----------------------------------------------------------------------
+        // Replace the commit callback, an empty one removing it. Indexes of
+        // the capture, such as its pyramids, are kept up to date this way.
+        void setCommitCallback(CommitCallback callback);
+
+        //----------------------------------------------------------------------
+        size_t numChannels() const { return header.numChannels; }
+        // Including staged samples
+        uint64_t samplesWritten() const { return nextSampleIndex + numStaged; }
+        uint64_t chunksCommitted() const { return header.committedChunks; }
+        // Committed sample bytes over the bytes of their columns, 1 before
+        // the first commit and for uncompressed channels
+        double compressionRatio() const;
+
+    private:
+        // Methods
+        // Start a new chunk first if firstTimestampNs breaks the sample clock
+        void beginAppend(std::optional<uint64_t> firstTimestampNs);
+        void requireChannels(size_t numChannels) const;
+        uint16_t* stagedColumn(size_t channelIndex);
+        uint64_t timestampAfterStaged() const;
+
+        // Data Members
+        int fd;
+        sCaptureFileHeader header;
+        // One chunk of columns, chunkSamples per channel
+        std::vector<uint16_t> staged;
+        // Codec frame of the column being committed, sized once for the
+        // largest one
+        std::vector<std::byte> encoded;
+        uint64_t rawBytesCommitted;
+        uint64_t storedBytesCommitted;
+        uint32_t numStaged;
+        // Timestamp and index of the first staged sample
+        uint64_t stagedTimestampNs;
+        uint64_t nextSampleIndex;
+        CommitCallback onCommit;
+    };
+
+    //--------------------------------------------------------------------------
+    // Class: CaptureReader
+    //
+    // Description:
+    //    Maps a capture file read-only and exposes its committed chunks as
+    //    zero-copy views. Views stay valid until refresh() or destruction.
+    //    Compressed columns are decoded on access, and only the last
+    //    DECODED_COLUMNS_KEPT are kept: views of a decoded column stay
+    //    valid until as many others have been decoded, except in the spans
+    //    of range(), which hold on to their columns. decodeColumn() decodes
+    //    without keeping them.
+    //
+    class CaptureReader
+    {
+    public:
+        static constexpr size_t DECODED_COLUMNS_KEPT = 8;
+
+        // A run of consecutive samples within one chunk
+        struct sCaptureSpan
+        {
+            size_t chunkIndex;
+            uint64_t firstSampleIndex;
+            uint64_t firstTimestampNs;
+            sSampleBlockView samples;
+            // Keeps decoded columns alive, empty for mapped ones
+            std::array<std::shared_ptr<const std::vector<uint16_t>>, 2>
+                spDecoded;
+        };
+
+        explicit CaptureReader(const std::string& sPath);
+        ~CaptureReader();
+
+        CaptureReader(const CaptureReader&) = delete;
+        CaptureReader& operator=(const CaptureReader&) = delete;
+
+        //----------------------------------------------------------------------
+        // Remap the file to pick up chunks committed since opening
+        void refresh();
+
+        //----------------------------------------------------------------------
+        double sampleRateHz() const { return header.sampleRateHz; }
+        size_t numChannels() const { return header.numChannels; }
+        sCaptureChannel_t channel(size_t channelIndex) const;
+        size_t numChunks() const { return numCommitted; }
+        uint64_t numSamples() const;
+
+        //----------------------------------------------------------------------
+        // Throws std::runtime_error for a chunk claiming more samples than
+        // its columns hold
+        const sCaptureChunkHeader& chunkHeader(size_t chunkIndex) const;
+        std::span<const uint16_t> column(
+            size_t chunkIndex,
+            size_t channelIndex) const;
+        // Copy (or decode) a column into samples, resized to fit
+        void decodeColumn(
+            size_t chunkIndex,
+            size_t channelIndex,
+            std::vector<uint16_t>& samples) const;
+        // The first two channels as an analog/digital block
+        sSampleBlockView chunkView(size_t chunkIndex) const;
+        uint64_t timestampOf(size_t chunkIndex, size_t sampleInChunk) const;
+
+        //----------------------------------------------------------------------
+        // O(log n): the last chunk starting at or before timestampNs, or 0
+        // when it is earlier than every chunk
+        size_t findChunk(uint64_t timestampNs) const;
+
+        //----------------------------------------------------------------------
+        // The samples timestamped in [beginNs, endNs), one span per chunk
+        std::vector<sCaptureSpan> range(uint64_t beginNs, uint64_t endNs) const;
+
+    private:
+        // Methods
+        void map();
+        void unmap();
+        // First sample of a chunk at or after timestampNs
+        size_t sampleAtOrAfter(size_t chunkIndex, uint64_t timestampNs) const;
+        // A column's slot, and its samples when they can be mapped as is
+        std::span<const std::byte> columnSlot(
+            size_t chunkIndex,
+            size_t channelIndex) const;
+        std::optional<std::span<const uint16_t>> mappedColumn(
+            size_t chunkIndex,
+            size_t channelIndex) const;
+        // A compressed column, decoded or taken from the recently decoded
+        std::shared_ptr<const std::vector<uint16_t>> decoded(
+            size_t chunkIndex,
+            size_t channelIndex) const;
+        // A column, mapped or decoded, with spDecoded holding the latter
+        std::span<const uint16_t> holdColumn(
+            size_t chunkIndex,
+            size_t channelIndex,
+            std::shared_ptr<const std::vector<uint16_t>>& spDecoded) const;
+
+        // Data Members
+        std::string sPath;
+        const std::byte* pMapped;
+        size_t mappedBytes;
+        // Read from the mapping, in the version 2 layout whatever the file's
+        sCaptureFileHeader header;
+        size_t numCommitted;
+        // Recently decoded compressed columns by chunk and channel, most
+        // recent first
+        mutable std::mutex decodedMutex;
+        mutable std::vector<
+            std::pair<size_t, std::shared_ptr<const std::vector<uint16_t>>>>
+            decodedColumns;
+    };
+
+} // namespace SignalDataFacade
+
+#endif // INCLUDE_FACADEPATTERN_CAPTURE_H_
@@ -0,0 +1,181 @@
+// Copyright (c) 2025 Michael Dello
+//
+// This software is provided under the MIT License.
+// See LICENSE file for details.
+
+#ifndef INCLUDE_FACADEPATTERN_CODEC_H_
+#define INCLUDE_FACADEPATTERN_CODEC_H_
+//------------------------------------------------------------------------------
+//
+// This header provides a block-based lossless codec for the sample streams
+// acquired through the Facade Design Pattern example, for use inline in the
+// streaming path and in capture files.
+//
+// Samples are encoded as self-contained frames: an sCodecFrameHeader naming
+// the codec, sample count and payload size, followed by the payload. Frames
+// can be concatenated into a stream and decoded one after another.
+//
+//    DELTA_BITPACK - For analog signals. Each sample is replaced by its
+//                    (wrapping) difference from the previous one, zigzag
+//                    mapped so small negative differences become small
+//                    numbers, and blocks of 128 are bit-packed at the width
+//                    of their largest value. A block is 8 lanes of 16 rows:
+//                    sample i sits in lane i % 8, so one row is one SSE
+//                    register, and each lane's 16 values pack into exactly
+//                    width 16-bit words.
+//    RLE           - For digital signals, which hold for long stretches:
+//                    runs of equal words as the word and a varint length.
+//    RAW           - The samples as they are. An encoder falls back to it
+//                    whenever a codec would not make a frame smaller, so a
+//                    frame never exceeds maxFrameBytes().
+//
+// Frames use native byte order, like capture files.
+//
+// Additional design principles, patterns, and modern C++ features used:
+//
+//    1. Runtime CPU Dispatch - As for the statistics kernels, SIMD paths are
+//       compiled with per-function target attributes and picked from what
+//       the CPU supports. Every level writes the same bytes.
+//
+//    2. Strategy - The codec is chosen per frame, so each channel can use the
+//       one suited to its signal
+//
+//------------------------------------------------------------------------------
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+#include "facadepattern.h"
+#include "facadepattern_stats.h"
+
+namespace SignalDataFacade
+{
+    //--------------------------------------------------------------------------
+    // Types
+    //--------------------------------------------------------------------------
+    enum class eCodec: uint32_t
+    {
+        RAW,
+        DELTA_BITPACK,
+        RLE
+    };
+
+    const char* toString(eCodec codec);
+
+    //--------------------------------------------------------------------------
+    // PODs
+    //--------------------------------------------------------------------------
+    struct sCodecFrameHeader
+    {
+        eCodec codec;
+        uint32_t numSamples;
+        uint32_t payloadBytes;
+        uint32_t reserved;
+    };
+
+    //--------------------------------------------------------------------------
+    // Functions
+    //--------------------------------------------------------------------------
+
+    //--------------------------------------------------------------------------
+    // Upper bound of an encoded frame, whatever the codec
+    constexpr size_t maxFrameBytes(size_t numSamples)
+    {
+        return sizeof(sCodecFrameHeader) + numSamples * sizeof(uint16_t);
+    }
+
+    //--------------------------------------------------------------------------
+    // Write a frame of samples to the start of out, returning its size. Out
+    // must hold maxFrameBytes() or throws std::out_of_range, and only the
+    // frame is written, so a buffer can be reused for every frame. Kernels
+    // use the given level, or the best supported one below it.
+    size_t encodeFrame(
+        eCodec codec,
+        std::span<const uint16_t> samples,
+        std::span<std::byte> out,
+        eSimdLevel level = detectedSimdLevel());
+
+    //--------------------------------------------------------------------------
+    // Append a frame of samples to out, returning its size
+    size_t encodeFrame(
+        eCodec codec,
+        std::span<const uint16_t> samples,
+        std::vector<std::byte>& out,
+        eSimdLevel level = detectedSimdLevel());
+
+    //--------------------------------------------------------------------------
+    // Header of the frame at the start of bytes. Throws std::runtime_error
+    // when it is truncated or corrupt.
+    sCodecFrameHeader peekFrame(std::span<const std::byte> bytes);
+
+    //--------------------------------------------------------------------------
+    // Decode the frame at the start of bytes into the first numSamples of
+    // samples, returning the frame size. Throws std::out_of_range when
+    // samples is too short, and std::runtime_error for a corrupt frame.
+    size_t decodeFrame(
+        std::span<const std::byte> bytes,
+        std::span<uint16_t> samples,
+        eSimdLevel level = detectedSimdLevel());
+
+    //--------------------------------------------------------------------------
+    // Decode the frame at the start of bytes, appending its samples
+    size_t decodeFrame(
+        std::span<const std::byte> bytes,
+        std::vector<uint16_t>& samples,
+        eSimdLevel level = detectedSimdLevel());
+
+    //--------------------------------------------------------------------------
+    // Classes
+    //--------------------------------------------------------------------------
+    // Class: SampleStreamCodec
+    //
+    // Description:
+    //    Encodes batches of streamed samples, such as those returned by
+    //    SignalData::readStream(), as an analog DELTA_BITPACK frame followed
+    //    by a digital RLE frame, and decodes them back. Keeps running totals
+    //    for the compression ratio and throughput. Not thread-safe.
+    //
+    class SampleStreamCodec
+    {
+    public:
+        explicit SampleStreamCodec(eSimdLevel level = detectedSimdLevel());
+
+        //----------------------------------------------------------------------
+        // Append the encoded batch to out, returning its size
+        size_t encode(
+            std::span<const SignalData::sAggregateData> samples,
+            std::vector<std::byte>& out);
+
+        //----------------------------------------------------------------------
+        // Decode the batch at the start of bytes, appending its samples and
+        // returning its size
+        size_t decode(
+            std::span<const std::byte> bytes,
+            std::vector<SignalData::sAggregateData>& samples);
+
+        //----------------------------------------------------------------------
+        // Raw over encoded bytes, 1 before any, and raw bytes per second
+        // each way
+        double compressionRatio() const;
+        double encodeGBps() const;
+        double decodeGBps() const;
+        void resetTotals();
+
+    private:
+        // Data Members
+        eSimdLevel kernelLevel;
+        // Deinterleaved columns, reused across batches
+        std::vector<uint16_t> analog;
+        std::vector<uint16_t> digital;
+        uint64_t rawBytesEncoded;
+        uint64_t encodedBytes;
+        uint64_t encodeNs;
+        uint64_t rawBytesDecoded;
+        uint64_t decodeNs;
+    };
+
+} // namespace SignalDataFacade
+
+#endif // INCLUDE_FACADEPATTERN_CODEC_H_
@@ -0,0 +1,259 @@
+// Copyright (c) 2025 Michael Dello
+//
+// This software is provided under the MIT License.
+// See LICENSE file for details.
+
+#ifndef INCLUDE_FACADEPATTERN_DERIVED_H_
+#define INCLUDE_FACADEPATTERN_DERIVED_H_
+//------------------------------------------------------------------------------
+//
+// This header provides derived channels: signals computed from the sample
+// columns acquired through the Facade Design Pattern example (a scaled
+// analog signal, analog masked by a GPIO line, moving averages, differences
+// between channels), declared once as an expression graph and evaluated
+// block by block as new samples arrive.
+//
+// Evaluation is lazy: setting a block only invalidates the channels that
+// depend on the columns that changed, and a channel is computed when it is
+// first read, then cached until its inputs change again. Identical
+// subexpressions are declared once, so channels sharing one share its
+// cached values too.
+//
+// Element-wise operations are fused: a channel and the element-wise chain
+// under it are compiled into one short program that runs over tiles of a
+// few hundred samples, each operation a SIMD kernel over a tile that stays
+// in L1, rather than one full pass and one full intermediate column per
+// operation. Moving averages carry their window from one block to the next,
+// and a channel feeding several others would be recomputed by each of their
+// programs, so both are materialized and act as inputs to the programs above
+// them.
+//
+// Additional design principles, patterns, and modern C++ features used:
+//
+//    1. Interpreter - Each evaluation runs a small stack program, compiled
+//       from the graph, over every tile of the block
+//
+//    2. Flyweight - Declaring an expression that exists returns the
+//       existing channel, so equal subexpressions are stored and evaluated
+//       once
+//
+//    3. Runtime CPU Dispatch - As for the statistics kernels, SIMD paths are
+//       compiled with per-function target attributes and picked from what
+//       the CPU supports, with a portable scalar fallback
+//
+//------------------------------------------------------------------------------
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+#include "facadepattern_sampleblock.h"
+#include "facadepattern_stats.h"
+
+namespace SignalDataFacade
+{
+    //--------------------------------------------------------------------------
+    // Types
+    //--------------------------------------------------------------------------
+    enum class eDerivedOp: uint8_t
+    {
+        // A raw source column, as float
+        SOURCE,
+        // gain * x + offset
+        SCALED,
+        // x where a GPIO line has the given level, 0 elsewhere
+        MASKED,
+        // Mean of the last window values of x, across blocks
+        MOVING_AVERAGE,
+        // x - y
+        DIFFERENCE
+    };
+
+    const char* toString(eDerivedOp op);
+
+    // Handle of a channel declared in a DerivedChannels graph
+    using DerivedChannel = uint32_t;
+
+    //--------------------------------------------------------------------------
+    // Classes
+    //--------------------------------------------------------------------------
+    // Class: DerivedChannels
+    //
+    // Description:
+    //    An expression graph of derived channels over a fixed number of raw
+    //    source columns, sources 0 and 1 being the analog and digital
+    //    columns of a SampleBlock. Channels can be declared at any time and
+    //    are never removed. Not thread-safe: meant to run on the consumer of
+    //    the samples.
+    //
+    class DerivedChannels
+    {
+    public:
+        //----------------------------------------------------------------------
+        // Constants
+        //----------------------------------------------------------------------
+        static constexpr size_t ANALOG_SOURCE = 0;
+        static constexpr size_t DIGITAL_SOURCE = 1;
+        static constexpr size_t MAX_SOURCES = 64;
+        // Samples per tile of a fused evaluation
+        static constexpr size_t TILE_SAMPLES = 512;
+
+        //----------------------------------------------------------------------
+        // Throws std::invalid_argument for no sources or more than
+        // MAX_SOURCES. Kernels use the given level, or the best supported
+        // one below it.
+        explicit DerivedChannels(
+            size_t numSources = 2,
+            eSimdLevel level = detectedSimdLevel());
+
+        DerivedChannels(const DerivedChannels&) = delete;
+        DerivedChannels& operator=(const DerivedChannels&) = delete;
+
+        //----------------------------------------------------------------------
+        // Declaring channels. An expression declared before returns the same
+        // channel. Throws std::out_of_range for a source or channel that does
+        // not exist, and std::invalid_argument for a line above 15 or a
+        // window of 0.
+        DerivedChannel source(size_t sourceIndex);
+        DerivedChannel scaled(
+            DerivedChannel x,
+            float gain,
+            float offset = 0.0f);
+        DerivedChannel masked(
+            DerivedChannel x,
+            size_t gpioSource,
+            uint8_t line,
+            bool bWhenHigh = true);
+        DerivedChannel movingAverage(DerivedChannel x, size_t window);
+        DerivedChannel difference(DerivedChannel x, DerivedChannel y);
+
+        //----------------------------------------------------------------------
+        // The next block of every source, one column each. Columns are not
+        // copied: they must stay valid until replaced. Moving averages that
+        // were not read during the block being replaced are brought up to
+        // date first, so they see every sample of the stream. Throws
+        // std::invalid_argument for a column count other than numSources().
+        void setSources(std::span<const std::span<const uint16_t>> columns);
+        // The analog and digital columns, for a graph of two sources
+        void setBlock(const sSampleBlockView& block);
+        // Replace one source alone, such as a reference updated at its own
+        // pace: only the channels depending on it are invalidated. Moving
+        // averages are not brought up to date, so over a stream use
+        // setSources(). Throws std::out_of_range for a source that does not
+        // exist.
+        void setSource(size_t sourceIndex, std::span<const uint16_t> column);
+
+        //----------------------------------------------------------------------
+        // The channel over the current block, computed if its inputs changed
+        // since it was last read. Valid until the next block is set or
+        // channel declared. Throws std::invalid_argument when its sources
+        // have different lengths, and std::out_of_range for a channel that
+        // does not exist.
+        std::span<const float> read(DerivedChannel channel);
+
+        //----------------------------------------------------------------------
+        // Forget moving average history, as at the start of a new stream
+        // beginning with the next block
+        void reset();
+
+        //----------------------------------------------------------------------
+        size_t numSources() const { return sources.size(); }
+        size_t numChannels() const { return nodes.size(); }
+        eDerivedOp op(DerivedChannel channel) const;
+        // Channels computed so far, each fused program counting once
+        uint64_t evaluations() const { return numEvaluations; }
+        eSimdLevel simdLevel() const { return kernelLevel; }
+
+    private:
+        // One declared channel and its cached values
+        struct sNode
+        {
+            eDerivedOp op;
+            DerivedChannel x;
+            DerivedChannel y;
+            // SOURCE column, or MASKED GPIO column
+            size_t sourceIndex;
+            float gain;
+            float offset;
+            uint8_t line;
+            bool bWhenHigh;
+            size_t window;
+            // Sources the channel depends on, one bit each
+            uint64_t sourceMask;
+            // Channels declared on top of this one. One feeding several is
+            // materialized rather than fused into each of their programs.
+            size_t numConsumers;
+
+            // Cached values, valid while cachedKey matches keyOf()
+            std::vector<float> values;
+            uint64_t cachedKey;
+            bool bCached;
+            // MOVING_AVERAGE: the last window input values, oldest first,
+            // and how many inputs have been seen
+            std::vector<float> history;
+            uint64_t numSeen;
+        };
+
+        // One step of a fused program
+        struct sInstruction
+        {
+            enum class eCode: uint8_t
+            {
+                // Push a source column, scaled
+                LOAD_SOURCE,
+                // Push a materialized channel
+                LOAD_CHANNEL,
+                // Scale the top
+                SCALE,
+                // Mask the top by a GPIO line
+                MASK,
+                // Replace the top two with their difference
+                SUBTRACT
+            };
+            eCode code;
+            size_t index{0};
+            float gain{1.0f};
+            float offset{0.0f};
+            uint16_t bit{0};
+            bool bWhenHigh{true};
+        };
+
+        // Methods
+        DerivedChannel declare(const sNode& node);
+        const sNode& nodeAt(DerivedChannel channel) const;
+        // Sum of the generations of the sources the node depends on, which
+        // changes whenever one of them does
+        uint64_t keyOf(const sNode& node) const;
+        bool isCached(const sNode& node) const;
+        size_t lengthOf(const sNode& node) const;
+        void evaluate(DerivedChannel channel);
+        // Evaluate the moving averages left behind by the current block
+        void catchUp();
+        void evaluateMovingAverage(sNode& node, size_t length);
+        // Append the program computing the channel, returning the stack depth
+        // it needs. Materialized inputs, moving averages and channels shared
+        // by several others, are evaluated first.
+        size_t compile(
+            DerivedChannel channel,
+            bool bRoot,
+            std::vector<sInstruction>& program);
+        void run(
+            const std::vector<sInstruction>& program,
+            size_t depth,
+            std::span<float> out);
+
+        // Data Members
+        eSimdLevel kernelLevel;
+        std::vector<std::span<const uint16_t>> sources;
+        std::vector<uint64_t> sourceGenerations;
+        std::vector<sNode> nodes;
+        // Reused by every evaluation: tile stack and moving average input
+        std::vector<float> stack;
+        std::vector<float> windowed;
+        uint64_t numEvaluations;
+    };
+
+} // namespace SignalDataFacade
+
+#endif // INCLUDE_FACADEPATTERN_DERIVED_H_
@@ -0,0 +1,231 @@
+// Copyright (c) 2025 Michael Dello
+//
+// This software is provided under the MIT License.
+// See LICENSE file for details.
+
+#ifndef INCLUDE_FACADEPATTERN_GENERATOR_H_
+#define INCLUDE_FACADEPATTERN_GENERATOR_H_
+//------------------------------------------------------------------------------
+//
+// This header provides deterministic synthetic signal sources for the Facade
+// Design Pattern example: a block waveform generator, and ADC and GPIO
+// drivers built on it for load testing the acquisition path.
+//
+// ADCDrv and GPIODrv return uniform noise from a generator seeded by
+// std::random_device, so no two runs are alike. The synthetic drivers here
+// instead produce known waveforms (sine, square, chirp, noise, steps, with
+// optional additive noise and glitches) from a seed, so a run, and any
+// failure it uncovers, can be reproduced sample for sample.
+//
+// Periodic waveforms use direct digital synthesis: a 64-bit phase
+// accumulator whose top bits index a precomputed, already scaled, table.
+// The phase of every sample in a block follows in closed form from the start
+// of the block, even for a chirp, so no sample depends on the previous one
+// and the compiler can vectorise the loops. Noise is counter-based, a hash of
+// the seed and the sample index, so it vectorises too and a stream does not
+// depend on the block sizes it is read in.
+//
+// Additional design principles, patterns, and modern C++ features used:
+//
+//    1. Dependency Inversion - The synthetic drivers implement the same
+//       IA2DConverter and IGPIO interfaces as the hardware drivers, and
+//       plug into the HALs unchanged
+//
+//    2. Determinism - All randomness is derived from the configured seed by
+//       per-instance generators, so equal configurations give equal sample
+//       streams and instances on different threads share no state
+//
+//------------------------------------------------------------------------------
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <span>
+#include <vector>
+
+#include "common/xoshiro.h"
+#include "facadepattern.h"
+
+namespace SignalDataFacade
+{
+    //--------------------------------------------------------------------------
+    // Types
+    //--------------------------------------------------------------------------
+    enum class eWaveform: uint8_t
+    {
+        SINE,
+        SQUARE,
+        // Linear frequency sweep, restarting after every sweep
+        CHIRP,
+        // Uniform noise about the center
+        NOISE,
+        // Random levels, held for a fixed time each
+        STEPS
+    };
+
+    const char* toString(eWaveform waveform);
+
+    //--------------------------------------------------------------------------
+    // PODs
+    //--------------------------------------------------------------------------
+    struct sWaveformConfig_t
+    {
+        eWaveform waveform{eWaveform::SINE};
+        double sampleRateHz{1'000'000.0};
+        // SINE and SQUARE frequency, CHIRP start frequency, STEPS level
+        // changes per second. Periodic waveforms must stay below Nyquist.
+        double frequencyHz{1'000.0};
+        // CHIRP frequency reached at the end of each sweep
+        double chirpEndHz{10'000.0};
+        double sweepSeconds{0.01};
+        // SQUARE fraction of the period spent high
+        double dutyCycle{0.5};
+        // Output spans center +/- amplitude, clamped to the uint16_t range
+        uint16_t center{32768};
+        uint16_t amplitude{16384};
+        // STEPS number of evenly spaced levels
+        uint32_t numLevels{8};
+        // Uniform noise of up to +/- noiseAmplitude added to any waveform
+        uint16_t noiseAmplitude{0};
+        // Chance per sample of a glitch: one random full-scale sample
+        double glitchProbability{0.0};
+        uint64_t seed{1};
+    };
+
+    // Line i drives bit i of the GPIO word, as a square wave
+    struct sGpioLineConfig_t
+    {
+        double frequencyHz{1'000.0};
+        double dutyCycle{0.5};
+    };
+
+    struct sGpioGeneratorConfig_t
+    {
+        double sampleRateHz{1'000'000.0};
+        // Up to 16 lines, bits of missing lines stay low
+        std::vector<sGpioLineConfig_t> lines{{}};
+        // Chance per sample of a glitch: one random line inverted
+        double glitchProbability{0.0};
+        uint64_t seed{1};
+    };
+
+    //--------------------------------------------------------------------------
+    // Classes
+    //--------------------------------------------------------------------------
+    // Class: SignalGenerator
+    //
+    // Description:
+    //    Generates a configured waveform as uint16_t samples, continuing
+    //    seamlessly from one block to the next. Not thread-safe: one instance
+    //    per producer.
+    //
+    class SignalGenerator
+    {
+    public:
+        // Throws std::invalid_argument for an unusable configuration
+        explicit SignalGenerator(const sWaveformConfig_t& config);
+
+        //----------------------------------------------------------------------
+        void generate(std::span<uint16_t> samples);
+        uint16_t next();
+
+        //----------------------------------------------------------------------
+        // Restart from the first sample
+        void reset();
+
+        const sWaveformConfig_t& config() const { return waveformConfig; }
+
+    private:
+        // Methods
+        void generateChirp(std::span<uint16_t> samples);
+        void generateSteps(std::span<uint16_t> samples);
+        void addGlitches(std::span<uint16_t> samples);
+        // Uniform noise from the sample index, offset by low, scaled to range
+        void fillNoise(
+            std::span<uint16_t> samples,
+            int32_t low,
+            uint32_t range,
+            bool bAdd) const;
+        uint64_t samplesUntilGlitch();
+
+        // Data Members
+        sWaveformConfig_t waveformConfig;
+        // Separate streams for step levels and glitches, so their draws do
+        // not interleave differently with different block sizes
+        Random::Xoshiro256pp rng;
+        Random::Xoshiro256pp glitchRng;
+        uint64_t noiseKey;
+        // Index of the next sample since the last reset
+        uint64_t sampleIndex;
+        // SINE and CHIRP period, scaled to output codes
+        std::vector<uint16_t> sineTable;
+        // Output codes of the STEPS levels, or the SQUARE low and high
+        std::vector<uint16_t> levels;
+        // A full period is 2^64
+        uint64_t phase;
+        uint64_t phaseIncrement;
+        uint64_t startIncrement;
+        // CHIRP increment change per sample, two's complement
+        uint64_t chirpStep;
+        uint64_t sweepSamples;
+        uint64_t sweepPosition;
+        // SQUARE phase below which the output is high
+        uint64_t dutyPhase;
+        // STEPS
+        uint64_t samplesPerStep;
+        uint64_t stepRemaining;
+        uint16_t stepLevel;
+        uint64_t glitchCountdown;
+    };
+
+    //--------------------------------------------------------------------------
+    // Class: SyntheticADCDrv
+    //
+    // Description:
+    //    An ADC driver producing a generated waveform. Scans produce the same
+    //    waveform on every channel.
+    //
+    class SyntheticADCDrv: public IA2DConverter
+    {
+    private:
+        bool bStarted;
+        size_t numScanChannels;
+        SignalGenerator generator;
+    public:
+        explicit SyntheticADCDrv(const sWaveformConfig_t& config);
+        void start() override;
+        void stop() override;
+        std::optional<uint16_t> read() override;
+        size_t readBlock(std::span<uint16_t> samples) override;
+        bool configureScan(std::span<const uint8_t> channels) override;
+        size_t scan(std::span<uint16_t> frames) override;
+    };
+
+    //--------------------------------------------------------------------------
+    // Class: SyntheticGPIODrv
+    //
+    // Description:
+    //    A GPIO driver producing square waves on its lines.
+    //
+    class SyntheticGPIODrv: public IGPIO
+    {
+    public:
+        static constexpr size_t MAX_LINES = 16;
+    private:
+        sGpioGeneratorConfig_t gpioConfig;
+        Random::Xoshiro256pp rng;
+        std::array<uint64_t, MAX_LINES> phases;
+        std::array<uint64_t, MAX_LINES> increments;
+        std::array<uint64_t, MAX_LINES> dutyPhases;
+        uint64_t glitchCountdown;
+    public:
+        // Throws std::invalid_argument for an unusable configuration
+        explicit SyntheticGPIODrv(const sGpioGeneratorConfig_t& config);
+        std::optional<uint16_t> read() override;
+        size_t readBlock(std::span<uint16_t> samples) override;
+    };
+
+} // namespace SignalDataFacade
+
+#endif // INCLUDE_FACADEPATTERN_GENERATOR_H_
@@ -0,0 +1,187 @@
+// Copyright (c) 2025 Michael Dello
+//
+// This software is provided under the MIT License.
+// See LICENSE file for details.
+
+#ifndef INCLUDE_FACADEPATTERN_HISTOGRAM_H_
+#define INCLUDE_FACADEPATTERN_HISTOGRAM_H_
+//------------------------------------------------------------------------------
+//
+// This header provides streaming value distributions for the signal data
+// acquired through the Facade Design Pattern example, for monitoring
+// quantiles such as p1/p50/p99 of a channel without sorting its samples.
+//
+// Two summaries are provided:
+//
+//    SampleHistogram - one counter per uint16_t code, 65,536 bins. Exact for
+//                      any number of samples, adding a block is one counter
+//                      increment per sample, and a quantile query is a scan
+//                      of the bins. Fixed size (512 KiB), whatever the window.
+//    QuantileSketch  - a KLL sketch of double values (raw codes or calibrated
+//                      ones). Keeps O(k log(n / k)) samples, each standing
+//                      for a power-of-two number of originals, and answers
+//                      quantiles with a normalized rank error of about
+//                      1.7 / k, so a few KiB summarise hours of samples.
+//
+// Both are mergeable: summaries built over separate threads, channels' shards
+// or time windows combine into the summary of all of their samples. Merged
+// histograms are identical to one built over every sample, merged sketches
+// keep the same error bound as one built that way.
+//
+// Additional design principles, patterns, and modern C++ features used:
+//
+//    1. Bulk Updates - Samples are added a block column at a time, as
+//       produced by SampleBlock or SignalData::readStream(), rather than one
+//       call per sample
+//
+//    2. Deterministic Randomness - The sketch's compactions flip a coin from
+//       a seeded xoshiro256++ generator, so a run can be reproduced exactly
+//
+//------------------------------------------------------------------------------
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+#include "common/xoshiro.h"
+
+namespace SignalDataFacade
+{
+    //--------------------------------------------------------------------------
+    // Classes
+    //--------------------------------------------------------------------------
+    // Class: SampleHistogram
+    //
+    // Description:
+    //    Exact distribution of uint16_t samples, one bin per code. Not
+    //    thread-safe: each thread fills its own instance and they are merged.
+    //
+    class SampleHistogram
+    {
+    public:
+        static constexpr size_t NUM_BINS = 65536;
+
+        SampleHistogram();
+
+        //----------------------------------------------------------------------
+        void add(uint16_t sample)
+        {
+            ++bins[sample];
+            ++totalCount;
+        }
+        void add(std::span<const uint16_t> samples);
+        void merge(const SampleHistogram& other);
+        void reset();
+
+        //----------------------------------------------------------------------
+        uint64_t count() const { return totalCount; }
+        uint64_t countOf(uint16_t sample) const { return bins[sample]; }
+        // Samples at or below the given code
+        uint64_t rank(uint16_t sample) const;
+        // Zero when empty
+        uint16_t min() const;
+        uint16_t max() const;
+        double mean() const;
+
+        //----------------------------------------------------------------------
+        // Smallest code with at least ceil(q * count) samples at or below it,
+        // for q in [0, 1], so 0 gives the minimum and 1 the maximum. Zero when
+        // empty, std::invalid_argument for q outside [0, 1].
+        uint16_t quantile(double q) const;
+        // Several quantiles, in the order asked, in a single scan of the bins
+        std::vector<uint16_t> quantiles(std::span<const double> qs) const;
+
+    private:
+        // Data Members
+        std::vector<uint64_t> bins;
+        uint64_t totalCount;
+    };
+
+    //--------------------------------------------------------------------------
+    // Class: QuantileSketch
+    //
+    // Description:
+    //    KLL quantile sketch. Samples go into a stack of compactors, level h
+    //    holding samples of weight 2^h. When the sketch is full, a level over
+    //    its capacity is sorted and every other sample, starting at a random
+    //    one of the first two, moves up a level with double the weight; level
+    //    capacities shrink by 2/3 per level below the top, so the bulk of the
+    //    memory goes to the highest weights. Not thread-safe: each thread
+    //    fills its own instance and they are merged.
+    //
+    class QuantileSketch
+    {
+    public:
+        static constexpr uint32_t DEFAULT_K = 200;
+        static constexpr uint32_t MIN_K = 8;
+
+        //----------------------------------------------------------------------
+        // k trades memory for accuracy, std::invalid_argument below MIN_K
+        explicit QuantileSketch(uint32_t k = DEFAULT_K, uint64_t seed = 1);
+
+        //----------------------------------------------------------------------
+        void add(double value);
+        void add(std::span<const uint16_t> samples);
+        void add(std::span<const double> values);
+        // Every sample of an exact histogram, for example one per second
+        // folded into a sketch of the day, at the cost of a pass over the
+        // bins rather than of compacting every sample
+        void add(const SampleHistogram& histogram);
+        // std::invalid_argument when the sketches have different k
+        void merge(const QuantileSketch& other);
+        void reset();
+
+        //----------------------------------------------------------------------
+        uint64_t count() const { return totalCount; }
+        // Zero when empty
+        double min() const;
+        double max() const;
+        // Estimated fraction of samples at or below value
+        double rank(double value) const;
+
+        //----------------------------------------------------------------------
+        // Estimated value with a fraction q of the samples at or below it, for
+        // q in [0, 1], exact for 0 and 1. Zero when empty, and
+        // std::invalid_argument for q outside [0, 1].
+        double quantile(double q) const;
+        // Several quantiles, in the order asked, sorting the sketch once
+        std::vector<double> quantiles(std::span<const double> qs) const;
+
+        //----------------------------------------------------------------------
+        uint32_t k() const { return kParameter; }
+        size_t numRetained() const { return retained; }
+        size_t numLevels() const { return levels.size(); }
+
+    private:
+        // A retained sample and the number of samples it stands for
+        struct sWeightedValue
+        {
+            double value;
+            uint64_t weight;
+        };
+
+        // Methods
+        void addLevel();
+        // Compact the lowest level over capacity until the sketch fits
+        void compress();
+        // Retained samples sorted by value
+        std::vector<sWeightedValue> sortedValues() const;
+
+        // Data Members
+        uint32_t kParameter;
+        uint64_t coinSeed;
+        Random::Xoshiro256pp coin;
+        std::vector<std::vector<double>> levels;
+        std::vector<size_t> capacities;
+        // Samples retained over all levels, and the sum of level capacities
+        size_t retained;
+        size_t maxRetained;
+        uint64_t totalCount;
+        double minValue;
+        double maxValue;
+    };
+
+} // namespace SignalDataFacade
+
+#endif // INCLUDE_FACADEPATTERN_HISTOGRAM_H_
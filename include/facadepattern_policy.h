@@ -0,0 +1,189 @@
+// Copyright (c) 2025 Michael Dello
+//
+// This software is provided under the MIT License.
+// See LICENSE file for details.
+
+#ifndef INCLUDE_FACADEPATTERN_POLICY_H_
+#define INCLUDE_FACADEPATTERN_POLICY_H_
+//------------------------------------------------------------------------------
+//
+// This header provides a compile-time, policy-based variant of the Facade
+// Design Pattern example's SignalData class.
+//
+// SignalData reaches its drivers through std::unique_ptr to abstract
+// interfaces, so every sample costs virtual calls and std::optional
+// unwrapping. BasicSignalData<AdcPolicy, GpioPolicy> takes its drivers as
+// template parameters instead: the calls are resolved, and usually inlined,
+// at compile time, which matters in tight acquisition loops where the
+// indirection costs more than the work. The runtime-polymorphic singleton
+// remains for code that selects drivers at run time.
+//
+// Additional design principles, patterns, and modern C++ features used:
+//
+//    1. Policy-based Design - The drivers are policies, checked by C++20
+//       concepts, so a policy only needs the members the facade uses
+//
+//    2. Static Polymorphism - Test and hardware drivers are substituted at
+//       compile time rather than through a vtable
+//
+//    3. Value Semantics - Unlike the singleton, instances own their drivers
+//       by value, empty policies take no space
+//
+//------------------------------------------------------------------------------
+
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <random>
+#include <span>
+#include <utility>
+
+#include "common/xoshiro.h"
+#include "facadepattern.h"
+#include "facadepattern_sampleblock.h"
+
+namespace SignalDataFacade
+{
+    //--------------------------------------------------------------------------
+    // Compile-time Checks
+    //--------------------------------------------------------------------------
+
+    // An ADC driver: read() is only valid between start() and stop(), and
+    // returns 0 for no signal rather than an empty std::optional
+    template <typename T>
+    concept AdcPolicy = requires(T& adc)
+    {
+        adc.start();
+        adc.stop();
+        { adc.read() } -> std::same_as<uint16_t>;
+    };
+
+    // A GPIO driver: read() returns 0 for no signal
+    template <typename T>
+    concept GpioPolicy = requires(T& gpio)
+    {
+        { gpio.read() } -> std::same_as<uint16_t>;
+    };
+
+    //--------------------------------------------------------------------------
+    // Policies
+    //--------------------------------------------------------------------------
+    // Class: SimulatedAdcPolicy
+    //
+    // Description:
+    //    Inline counterpart of ADCDrv, returning random values simulating
+    //    real hardware.
+    //
+    class SimulatedAdcPolicy
+    {
+    public:
+        void start() { bStarted = true; }
+        void stop() { bStarted = false; }
+        uint16_t read() { return bStarted ? uint16_t(rng() >> 48) : 0; }
+
+    private:
+        bool bStarted{false};
+        Random::Xoshiro256pp rng{std::random_device{}()};
+    };
+
+    //--------------------------------------------------------------------------
+    // Class: SimulatedGpioPolicy
+    //
+    // Description:
+    //    Inline counterpart of GPIODrv, returning random values simulating
+    //    real hardware.
+    //
+    class SimulatedGpioPolicy
+    {
+    public:
+        uint16_t read() { return uint16_t(rng() >> 48); }
+
+    private:
+        Random::Xoshiro256pp rng{std::random_device{}()};
+    };
+
+    //--------------------------------------------------------------------------
+    // Classes
+    //--------------------------------------------------------------------------
+    // Class: BasicSignalData
+    //
+    // Description:
+    //    The SignalData facade with its drivers bound at compile time. Offers
+    //    the same acquisition interface, without virtual dispatch.
+    //
+    template <AdcPolicy Adc, GpioPolicy Gpio>
+    class BasicSignalData
+    {
+    public:
+        using sAggregateData = SignalData::sAggregateData;
+
+        //----------------------------------------------------------------------
+        BasicSignalData() = default;
+        BasicSignalData(Adc adcImpl, Gpio gpioImpl)
+        : adc{std::move(adcImpl)}, gpio{std::move(gpioImpl)}
+        {
+            // No Body
+        }
+
+        //----------------------------------------------------------------------
+        // Client's interface for obtaining data acquisition results
+        sAggregateData acquire()
+        {
+            adc.start();
+            uint16_t analogDataValue = adc.read();
+            adc.stop();
+            return {analogDataValue, gpio.read()};
+        }
+
+        //----------------------------------------------------------------------
+        // Fill every element of samples, with the ADC started once
+        void acquireBatch(std::span<sAggregateData> samples)
+        {
+            adc.start();
+            for (sAggregateData& sample : samples)
+            {
+                sample.analog = adc.read();
+                sample.digital = gpio.read();
+            }
+            adc.stop();
+        }
+
+        //----------------------------------------------------------------------
+        // Append count samples to the block, written straight into its
+        // columns
+        void acquireBatch(SampleBlock& block, size_t count)
+        {
+            size_t first = block.appendUninitialized(count);
+            std::span<uint16_t> analog = block.analog().subspan(first);
+            std::span<uint16_t> digital = block.digital().subspan(first);
+
+            adc.start();
+            for (uint16_t& sample : analog)
+            {
+                sample = adc.read();
+            }
+            adc.stop();
+            for (uint16_t& sample : digital)
+            {
+                sample = gpio.read();
+            }
+        }
+
+        //----------------------------------------------------------------------
+        // Driver access, for configuration
+        Adc& adcDriver() { return adc; }
+        Gpio& gpioDriver() { return gpio; }
+
+    private:
+        [[no_unique_address]] Adc adc;
+        [[no_unique_address]] Gpio gpio;
+    };
+
+    //--------------------------------------------------------------------------
+    // The simulated hardware, bound at compile time
+    using SimulatedSignalData =
+        BasicSignalData<SimulatedAdcPolicy, SimulatedGpioPolicy>;
+
+} // namespace SignalDataFacade
+
+#endif // INCLUDE_FACADEPATTERN_POLICY_H_
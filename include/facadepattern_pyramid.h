@@ -0,0 +1,229 @@
+// Copyright (c) 2025 Michael Dello
+//
+// This software is provided under the MIT License.
+// See LICENSE file for details.
+
+#ifndef INCLUDE_FACADEPATTERN_PYRAMID_H_
+#define INCLUDE_FACADEPATTERN_PYRAMID_H_
+//------------------------------------------------------------------------------
+//
+// This header provides a multi-resolution min/max/mean index of a channel of
+// the signal data acquired through the Facade Design Pattern example, so a
+// view zoomed out over hours of capture is drawn from a few thousand
+// summaries rather than a scan of every sample.
+//
+// A SamplePyramid is built incrementally as samples are appended. Level 0
+// holds one node (min, max, sum) per FAN_OUT (64) samples, and each level
+// above one node per FAN_OUT nodes of the level below, so a billion samples
+// take four levels and an eighth of the memory of the samples themselves.
+//
+// A range is summarised from the nodes of the coarsest levels that fit in
+// it, like a segment tree: at most 2 * (FAN_OUT - 1) nodes per level, so the
+// cost grows with the logarithm of the capture length rather than the
+// length of the range. Ranges are resolved to whole level 0 nodes, and each
+// summary reports the samples it actually covers.
+//
+// A pyramid is saved next to the capture it indexes, see pyramidPath(), and
+// can be rebuilt from a capture recorded without one. CapturePyramids keeps
+// one per channel up to date as a CaptureWriter commits chunks, so a capture
+// is indexed as it is recorded.
+//
+// Additional design principles, patterns, and modern C++ features used:
+//
+//    1. Incremental Aggregation - Appending costs one pass over the new
+//       samples; upper levels are extended only when a node below completes
+//
+//    2. Runtime CPU Dispatch - As for the statistics kernels, level 0 nodes
+//       are computed by SIMD kernels picked from what the CPU supports
+//
+//------------------------------------------------------------------------------
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <string>
+#include <vector>
+
+#include "facadepattern_capture.h"
+#include "facadepattern_stats.h"
+
+namespace SignalDataFacade
+{
+    //--------------------------------------------------------------------------
+    // Constants
+    //--------------------------------------------------------------------------
+    constexpr char PYRAMID_MAGIC[8] = {'S', 'D', 'P', 'Y', 'R', 'A', 'M', 'D'};
+    constexpr uint32_t PYRAMID_VERSION = 1;
+
+    //--------------------------------------------------------------------------
+    // PODs
+    //--------------------------------------------------------------------------
+
+    // The samples a summary covers, and their min, max and mean, which are 0
+    // when it covers none
+    struct sRangeSummary
+    {
+        uint64_t firstSample{0};
+        uint64_t numSamples{0};
+        uint16_t min{0};
+        uint16_t max{0};
+        double mean{0.0};
+    };
+
+    //--------------------------------------------------------------------------
+    // On-disk Layout
+    //--------------------------------------------------------------------------
+    struct sPyramidNode
+    {
+        uint64_t sum;
+        uint16_t min;
+        uint16_t max;
+        uint32_t reserved{0};
+    };
+
+    // Followed by the samples of the incomplete level 0 node, then the nodes
+    // of every level, lowest first
+    struct sPyramidFileHeader
+    {
+        char magic[sizeof(PYRAMID_MAGIC)];
+        uint32_t version;
+        uint32_t fanOut;
+        uint64_t numSamples;
+        uint32_t numLevels;
+        uint32_t numPending;
+    };
+
+    //--------------------------------------------------------------------------
+    // Functions
+    //--------------------------------------------------------------------------
+
+    //--------------------------------------------------------------------------
+    // Where the pyramid of a capture file channel is saved
+    std::string pyramidPath(const std::string& sCapturePath, size_t channel);
+
+    //--------------------------------------------------------------------------
+    // Classes
+    //--------------------------------------------------------------------------
+    // Class: SamplePyramid
+    //
+    // Description:
+    //    Min/max/mean pyramid of one channel. Not thread-safe: appended to by
+    //    the consumer of the samples, and queried once appending is done or
+    //    from the same thread.
+    //
+    class SamplePyramid
+    {
+    public:
+        static constexpr size_t FAN_OUT = 64;
+
+        //----------------------------------------------------------------------
+        // An empty pyramid. Kernels use the given level, or the best
+        // supported one below it.
+        explicit SamplePyramid(eSimdLevel level = detectedSimdLevel());
+        // Load a saved pyramid, to query or append to. Throws
+        // std::runtime_error when the file cannot be read or is not a
+        // pyramid.
+        explicit SamplePyramid(
+            const std::string& sPath,
+            eSimdLevel level = detectedSimdLevel());
+
+        //----------------------------------------------------------------------
+        void append(std::span<const uint16_t> samples);
+        // Index every sample of a capture file channel, for captures
+        // recorded without a pyramid. Throws std::out_of_range for a channel
+        // the capture does not have.
+        void append(const CaptureReader& reader, size_t channel);
+        void clear();
+
+        //----------------------------------------------------------------------
+        // Write the pyramid to a file, replacing it. The file is written and
+        // flushed aside, then renamed over the old one, so a crash leaves
+        // either pyramid whole. Throws std::runtime_error when it cannot be
+        // written.
+        void save(const std::string& sPath) const;
+
+        //----------------------------------------------------------------------
+        // The samples in [begin, end), widened to whole level 0 nodes and
+        // clipped to the samples appended; an empty range stays empty.
+        // Throws std::invalid_argument when end is before begin.
+        sRangeSummary summarize(uint64_t begin, uint64_t end) const;
+        // [begin, end) split into numBuckets consecutive buckets, at most
+        // one per level 0 node, for drawing at a given resolution. Bucket
+        // edges are rounded down to whole nodes, so buckets never overlap.
+        std::vector<sRangeSummary> summarize(
+            uint64_t begin,
+            uint64_t end,
+            size_t numBuckets) const;
+
+        //----------------------------------------------------------------------
+        uint64_t numSamples() const { return totalSamples; }
+        size_t numLevels() const { return levels.size(); }
+        size_t numNodes(size_t level) const { return levels.at(level).size(); }
+        // Memory held by the nodes
+        size_t indexBytes() const;
+        eSimdLevel simdLevel() const { return kernelLevel; }
+
+    private:
+        // Methods
+        // Add one node to a level, completing the one above when it fills
+        void pushNode(size_t level, const sPyramidNode& node);
+        // Summary of whole level 0 nodes [firstNode, endNode)
+        sPyramidNode sumNodes(uint64_t firstNode, uint64_t endNode) const;
+
+        // Data Members
+        eSimdLevel kernelLevel;
+        std::vector<std::vector<sPyramidNode>> levels;
+        // Samples of the incomplete level 0 node
+        std::vector<uint16_t> pending;
+        uint64_t totalSamples;
+    };
+
+    //--------------------------------------------------------------------------
+    // Class: CapturePyramids
+    //
+    // Description:
+    //    A pyramid of every channel of a capture file, kept up to date by
+    //    the CaptureWriter recording it: each chunk is indexed as it is
+    //    committed, on the thread committing it. The writer must outlive
+    //    the pyramids, which detach from it when destroyed.
+    //
+    class CapturePyramids
+    {
+    public:
+        //----------------------------------------------------------------------
+        // Attach to the writer of the capture file at sCapturePath. When
+        // appending to a capture, the pyramids saved with it are loaded, or
+        // rebuilt from the capture when missing or behind it.
+        CapturePyramids(
+            CaptureWriter& writer,
+            const std::string& sCapturePath,
+            eSimdLevel level = detectedSimdLevel());
+        ~CapturePyramids();
+
+        CapturePyramids(const CapturePyramids&) = delete;
+        CapturePyramids& operator=(const CapturePyramids&) = delete;
+
+        //----------------------------------------------------------------------
+        // Commit the writer, so every sample written is indexed, then save
+        // each pyramid to its pyramidPath(). Throws std::runtime_error when
+        // one cannot be written.
+        void save();
+
+        //----------------------------------------------------------------------
+        size_t numChannels() const { return pyramids.size(); }
+        // Throws std::out_of_range for a channel the capture does not have
+        const SamplePyramid& pyramid(size_t channel) const
+        {
+            return pyramids.at(channel);
+        }
+
+    private:
+        // Data Members
+        CaptureWriter& writer;
+        std::string sCapturePath;
+        std::vector<SamplePyramid> pyramids;
+    };
+
+} // namespace SignalDataFacade
+
+#endif // INCLUDE_FACADEPATTERN_PYRAMID_H_
@@ -0,0 +1,146 @@
+// Copyright (c) 2025 Michael Dello
+//
+// This software is provided under the MIT License.
+// See LICENSE file for details.
+
+#ifndef INCLUDE_FACADEPATTERN_QUERY_H_
+#define INCLUDE_FACADEPATTERN_QUERY_H_
+//------------------------------------------------------------------------------
+//
+// This header provides a parallel query engine for post-test analysis of the
+// capture files recorded from the Facade Design Pattern example: windowed
+// aggregates (samples above a threshold, mean, GPIO duty cycle) over an
+// analog and a GPIO channel, scanned across every core.
+//
+// The capture is memory-mapped by its CaptureReader, so the engine only
+// partitions it: the chunks in the queried range are split into a few
+// contiguous runs per thread, and a pool of worker threads takes runs from a
+// shared counter until none are left. Each run accumulates partial
+// aggregates for the windows it touches in its own storage, so workers take
+// no lock and write no shared data while scanning. The partials are merged
+// once every run is done; only the windows straddling two runs have more
+// than one.
+//
+// Every result reports how many bytes of samples were scanned and how long
+// the scan took, to measure how throughput scales with the number of
+// threads.
+//
+// Additional design principles, patterns, and modern C++ features used:
+//
+//    1. Partition / Merge - Independent partial aggregates per run of
+//       chunks, combined after the parallel scan rather than under a lock
+//
+//    2. Runtime CPU Dispatch - As for the statistics kernels, each run is
+//       scanned by SIMD kernels picked from what the CPU supports
+//
+//------------------------------------------------------------------------------
+
+#include <cstddef>
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+#include "common/thread_pool.h"
+#include "facadepattern_capture.h"
+#include "facadepattern_stats.h"
+
+namespace SignalDataFacade
+{
+    //--------------------------------------------------------------------------
+    // Configuration
+    //--------------------------------------------------------------------------
+    struct sWindowQuery_t
+    {
+        size_t analogChannel{0};
+        // Analog samples above this code are counted
+        uint16_t threshold{32768};
+        size_t gpioChannel{1};
+        // The line whose duty cycle (fraction of samples high) is measured
+        uint8_t gpioLine{0};
+        // Windows are counted in samples from firstSample; the last one may
+        // be shorter
+        uint64_t windowSamples{1000};
+        // Sample index range [firstSample, endSample), clipped to the
+        // capture
+        uint64_t firstSample{0};
+        uint64_t endSample{UINT64_MAX};
+    };
+
+    //--------------------------------------------------------------------------
+    // PODs
+    //--------------------------------------------------------------------------
+    struct sWindowAggregate
+    {
+        uint64_t firstSample{0};
+        uint64_t numSamples{0};
+        uint64_t numAboveThreshold{0};
+        double mean{0.0};
+        double dutyCycle{0.0};
+    };
+
+    struct sWindowQueryResult
+    {
+        std::vector<sWindowAggregate> windows;
+        // The whole queried range
+        sWindowAggregate total;
+        // Bytes of both channels' samples scanned, and the wall-clock time
+        // of the scan and merge
+        uint64_t bytesScanned{0};
+        double seconds{0.0};
+        size_t numThreads{0};
+
+        double gigabytesPerSecond() const
+        {
+            return seconds > 0.0 ? double(bytesScanned) / seconds / 1e9 : 0.0;
+        }
+    };
+
+    //--------------------------------------------------------------------------
+    // Classes
+    //--------------------------------------------------------------------------
+    // Class: WindowQueryEngine
+    //
+    // Description:
+    //    Owns the worker threads, started once and reused by every query.
+    //    Queries run one at a time: run() must not be called from several
+    //    threads at once.
+    //
+    class WindowQueryEngine
+    {
+    public:
+        // Runs of chunks per thread, so uneven runs balance across threads
+        static constexpr size_t RUNS_PER_THREAD = 8;
+
+        //----------------------------------------------------------------------
+        // Kernels use the given level, or the best supported one below it
+        explicit WindowQueryEngine(
+            size_t numThreads = std::thread::hardware_concurrency(),
+            eSimdLevel level = detectedSimdLevel());
+
+        WindowQueryEngine(const WindowQueryEngine&) = delete;
+        WindowQueryEngine& operator=(const WindowQueryEngine&) = delete;
+
+        //----------------------------------------------------------------------
+        // Throws std::out_of_range for a channel the capture does not have,
+        // and std::invalid_argument for a window of 0 or a line above 15.
+        // Compressed chunks are decoded into per-thread buffers.
+        sWindowQueryResult run(
+            const CaptureReader& reader,
+            const sWindowQuery_t& query);
+
+        //----------------------------------------------------------------------
+        size_t numThreads() const { return pool.size(); }
+        eSimdLevel simdLevel() const { return kernelLevel; }
+
+    private:
+        // Data Members
+        Concurrency::ThreadPool pool;
+        eSimdLevel kernelLevel;
+        // Per-thread decode buffers, for the analog and GPIO columns
+        std::vector<std::vector<uint16_t>> analogBuffers;
+        std::vector<std::vector<uint16_t>> gpioBuffers;
+    };
+
+} // namespace SignalDataFacade
+
+#endif // INCLUDE_FACADEPATTERN_QUERY_H_
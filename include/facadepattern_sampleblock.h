@@ -0,0 +1,145 @@
+// Copyright (c) 2025 Michael Dello
+//
+// This software is provided under the MIT License.
+// See LICENSE file for details.
+
+#ifndef INCLUDE_FACADEPATTERN_SAMPLEBLOCK_H_
+#define INCLUDE_FACADEPATTERN_SAMPLEBLOCK_H_
+//------------------------------------------------------------------------------
+//
+// This header provides a struct-of-arrays container for the signal data
+// acquired through the Facade Design Pattern example.
+//
+// A SampleBlock keeps each signal in its own contiguous column (analog[] and
+// digital[]) rather than an array of sAggregateData records, so downstream
+// processing streams through one column at a time and SIMD kernels load
+// full registers without shuffling.
+//
+// Additional design principles, patterns, and modern C++ features used:
+//
+//    1. Aligned Storage - Columns start on cache line boundaries, so vector
+//       loads never split a line at the start of a block
+//
+//    2. Capacity Reuse - clear() keeps the allocation, so a block refilled
+//       every acquisition cycle allocates only while it grows
+//
+//    3. std::span Views - Columns are exposed as spans, so clients and
+//       drivers read and write them in place without copies
+//
+//------------------------------------------------------------------------------
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <span>
+
+#include "facadepattern.h"
+
+namespace SignalDataFacade
+{
+    //--------------------------------------------------------------------------
+    // PODs
+    //--------------------------------------------------------------------------
+
+    // Column views over a struct-of-arrays block of samples
+    struct sSampleBlockView
+    {
+        std::span<const uint16_t> analog;
+        std::span<const uint16_t> digital;
+    };
+
+    //--------------------------------------------------------------------------
+    // Classes
+    //--------------------------------------------------------------------------
+    // Class: SampleBlock
+    //
+    // Description:
+    //    A growable block of samples stored as one aligned column per signal.
+    //    Move-only, since copying a block is rarely intended and never cheap.
+    //
+    class SampleBlock
+    {
+    public:
+        //----------------------------------------------------------------------
+        // Constants
+        //----------------------------------------------------------------------
+        // Column alignment in bytes, one cache line
+        static constexpr size_t ALIGNMENT = 64;
+
+        //----------------------------------------------------------------------
+        SampleBlock();
+        explicit SampleBlock(size_t initialCapacity);
+        SampleBlock(SampleBlock&& other) noexcept;
+        SampleBlock& operator=(SampleBlock&& other) noexcept;
+        SampleBlock(const SampleBlock&) = delete;
+        SampleBlock& operator=(const SampleBlock&) = delete;
+
+        //----------------------------------------------------------------------
+        size_t size() const noexcept { return numSamples; }
+        size_t capacity() const noexcept { return maxSamples; }
+        bool empty() const noexcept { return numSamples == 0; }
+
+        //----------------------------------------------------------------------
+        // Grow the allocation, keeping the samples. Never shrinks.
+        void reserve(size_t newCapacity);
+        // Keep the first count samples, zeroing any new ones
+        void resize(size_t count);
+        // Drop the samples, keeping the allocation for reuse
+        void clear() noexcept { numSamples = 0; }
+
+        //----------------------------------------------------------------------
+        void push_back(const SignalData::sAggregateData& sample);
+        void append(std::span<const SignalData::sAggregateData> samples);
+        // Grow by count samples left uninitialized, for producers to fill in
+        // place through the column views. Returns the first new index.
+        size_t appendUninitialized(size_t count);
+
+        //----------------------------------------------------------------------
+        SignalData::sAggregateData operator[](size_t index) const noexcept
+        {
+            return {upAnalog[index], upDigital[index]};
+        }
+
+        //----------------------------------------------------------------------
+        // Column views, valid until the block grows or is destroyed
+        std::span<uint16_t> analog() noexcept
+        {
+            return {upAnalog.get(), numSamples};
+        }
+        std::span<const uint16_t> analog() const noexcept
+        {
+            return {upAnalog.get(), numSamples};
+        }
+        std::span<uint16_t> digital() noexcept
+        {
+            return {upDigital.get(), numSamples};
+        }
+        std::span<const uint16_t> digital() const noexcept
+        {
+            return {upDigital.get(), numSamples};
+        }
+        sSampleBlockView view() const noexcept
+        {
+            return {analog(), digital()};
+        }
+
+    private:
+        struct sAlignedDeleter
+        {
+            void operator()(uint16_t* pColumn) const noexcept;
+        };
+        using Column = std::unique_ptr<uint16_t[], sAlignedDeleter>;
+
+        // Methods
+        static Column allocateColumn(size_t count);
+
+        // Data Members
+        Column upAnalog;
+        Column upDigital;
+        size_t numSamples;
+        size_t maxSamples;
+    };
+
+} // namespace SignalDataFacade
+
+#endif // INCLUDE_FACADEPATTERN_SAMPLEBLOCK_H_
@@ -0,0 +1,226 @@
+// Copyright (c) 2025 Michael Dello
+//
+// This software is provided under the MIT License.
+// See LICENSE file for details.
+
+#ifndef INCLUDE_FACADEPATTERN_SPECTRUM_H_
+#define INCLUDE_FACADEPATTERN_SPECTRUM_H_
+//------------------------------------------------------------------------------
+//
+// This header provides in-process spectral analysis of the analog signal
+// acquired through the Facade Design Pattern example, for finding noise spurs
+// without exporting the samples to another tool.
+//
+// RealFFT transforms a power-of-two number of real samples. It packs the even
+// and odd samples into the real and imaginary parts of a complex sequence of
+// half the length, transforms that with a Stockham (self-sorting, so no bit
+// reversal pass) radix-4 FFT, finishing with one radix-2 pass for odd powers
+// of two, and splits the result into the spectrum of the real input.
+// Complex values are kept as separate real and imaginary arrays, so a SIMD
+// butterfly handles 8 (AVX2) or 4 (SSE) of them at once.
+//
+// SpectrumAnalyzer estimates the power spectral density of a stream with
+// Welch's method: overlapping segments are detrended (mean removed),
+// windowed (Hann or Blackman to keep a strong tone from leaking over the
+// spurs around it), transformed, and their periodograms averaged, which
+// trades frequency resolution for a less noisy estimate.
+//
+// Additional design principles, patterns, and modern C++ features used:
+//
+//    1. Flyweight - Twiddle factors depend only on the transform size, so
+//       they are computed once per size and shared by every transform of
+//       that size, whichever thread creates it
+//
+//    2. Runtime CPU Dispatch - As for the statistics kernels, SIMD paths are
+//       compiled with per-function target attributes and picked from what
+//       the CPU supports, with a portable scalar fallback
+//
+//------------------------------------------------------------------------------
+
+#include <complex>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <span>
+#include <vector>
+
+#include "facadepattern.h"
+#include "facadepattern_sampleblock.h"
+#include "facadepattern_stats.h"
+
+namespace SignalDataFacade
+{
+    //--------------------------------------------------------------------------
+    // Types
+    //--------------------------------------------------------------------------
+    enum class eWindow: uint8_t
+    {
+        RECTANGULAR,
+        HANN,
+        BLACKMAN
+    };
+
+    const char* toString(eWindow window);
+
+    //--------------------------------------------------------------------------
+    // PODs
+    //--------------------------------------------------------------------------
+    struct sSpectrumConfig_t
+    {
+        // Samples per segment, a power of two, and the resolution is
+        // sampleRateHz / fftSize
+        size_t fftSize{4096};
+        eWindow window{eWindow::HANN};
+        // Fraction of each segment shared with the next, in [0, 1)
+        double overlap{0.5};
+        double sampleRateHz{1'000'000.0};
+    };
+
+    struct sSpectralPeak
+    {
+        size_t bin{0};
+        double frequencyHz{0.0};
+        // Power spectral density at the bin, codes^2 / Hz
+        double density{0.0};
+    };
+
+    //--------------------------------------------------------------------------
+    // Functions
+    //--------------------------------------------------------------------------
+
+    //--------------------------------------------------------------------------
+    // Coefficients of the periodic form of a window, whose period is its
+    // length, as used for spectral analysis
+    std::vector<float> windowCoefficients(eWindow window, size_t length);
+
+    //--------------------------------------------------------------------------
+    // Classes
+    //--------------------------------------------------------------------------
+    // Class: RealFFT
+    //
+    // Description:
+    //    Forward FFT of a fixed power-of-two number of real samples. Holds
+    //    its own work buffers, so each thread needs its own instance;
+    //    instances of the same size share their twiddle factors.
+    //
+    class RealFFT
+    {
+    public:
+        static constexpr size_t MIN_SIZE = 8;
+
+        //----------------------------------------------------------------------
+        // Throws std::invalid_argument unless size is a power of two of at
+        // least MIN_SIZE. Kernels use the given level, or the best supported
+        // one below it.
+        explicit RealFFT(size_t size, eSimdLevel level = detectedSimdLevel());
+
+        //----------------------------------------------------------------------
+        size_t size() const { return fftSize; }
+        // Bins from DC to Nyquist
+        size_t numBins() const { return fftSize / 2 + 1; }
+        eSimdLevel simdLevel() const { return kernelLevel; }
+
+        //----------------------------------------------------------------------
+        // Unnormalized spectrum X[k] = sum x[t] e^(-2 pi i k t / size) of
+        // size() samples, for k in [0, numBins()). Throws std::invalid_argument
+        // for spans of other sizes.
+        void forward(
+            std::span<const float> samples,
+            std::span<std::complex<float>> spectrum);
+        // |X[k]|^2 only, skipping the complex output
+        void power(std::span<const float> samples, std::span<float> power);
+
+    private:
+        // Twiddle factors of one size
+        struct sTwiddles;
+
+        // Methods
+        // Shared by every transform of the size, computed on first use
+        static std::shared_ptr<const sTwiddles> twiddlesFor(size_t size);
+        // Transform into binsRe and binsIm
+        void transform(std::span<const float> samples);
+
+        // Data Members
+        size_t fftSize;
+        eSimdLevel kernelLevel;
+        std::shared_ptr<const sTwiddles> spTwiddles;
+        // Two ping-pong buffers of size / 2 complex values each
+        std::vector<float> work;
+        // The spectrum, numBins() values each
+        std::vector<float> binsRe;
+        std::vector<float> binsIm;
+    };
+
+    //--------------------------------------------------------------------------
+    // Class: SpectrumAnalyzer
+    //
+    // Description:
+    //    Welch power spectral density estimate of an analog sample stream,
+    //    fed with consecutive batches of any size. Not thread-safe: meant to
+    //    run on the consumer of SignalData's streaming mode.
+    //
+    class SpectrumAnalyzer
+    {
+    public:
+        //----------------------------------------------------------------------
+        // Throws std::invalid_argument for an FFT size RealFFT rejects, an
+        // overlap outside [0, 1) or a sample rate that is not positive
+        explicit SpectrumAnalyzer(
+            const sSpectrumConfig_t& config,
+            eSimdLevel level = detectedSimdLevel());
+
+        //----------------------------------------------------------------------
+        // Add the next samples of the stream, transforming every segment
+        // they complete
+        void process(std::span<const uint16_t> samples);
+        void process(std::span<const SignalData::sAggregateData> samples);
+        void process(const sSampleBlockView& block);
+
+        //----------------------------------------------------------------------
+        // One-sided power spectral density in codes^2 / Hz per bin, from DC
+        // to Nyquist, averaged over the segments so far. Zero before the
+        // first segment. Summed over all bins and multiplied by the bin width
+        // it is the variance of the signal.
+        std::vector<double> powerSpectralDensity() const;
+        // The strongest local maxima above DC, strongest first
+        std::vector<sSpectralPeak> findPeaks(size_t maxPeaks) const;
+
+        //----------------------------------------------------------------------
+        // Drop the averaged segments and any partial one
+        void reset();
+
+        //----------------------------------------------------------------------
+        size_t numBins() const { return fft.numBins(); }
+        double binWidthHz() const;
+        double binFrequencyHz(size_t bin) const;
+        uint64_t segmentsAveraged() const { return numSegments; }
+        const sSpectrumConfig_t& config() const { return spectrumConfig; }
+        eSimdLevel simdLevel() const { return fft.simdLevel(); }
+
+    private:
+        // Methods
+        // Transform every segment complete in pending, keeping the rest
+        void processPending();
+        // Transform the segment starting at pending[first] and accumulate it
+        void processSegment(size_t first);
+
+        // Data Members
+        sSpectrumConfig_t spectrumConfig;
+        RealFFT fft;
+        std::vector<float> window;
+        // Scale from |X|^2 to a one-sided density
+        double densityScale;
+        // Samples between segment starts
+        size_t hop;
+        // Samples of the next segment(s) received so far
+        std::vector<uint16_t> pending;
+        // Reused for every segment
+        std::vector<float> segment;
+        std::vector<float> segmentPower;
+        std::vector<double> powerSum;
+        uint64_t numSegments;
+    };
+
+} // namespace SignalDataFacade
+
+#endif // INCLUDE_FACADEPATTERN_SPECTRUM_H_
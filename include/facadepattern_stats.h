@@ -0,0 +1,98 @@
+// Copyright (c) 2025 Michael Dello
+//
+// This software is provided under the MIT License.
+// See LICENSE file for details.
+
+#ifndef INCLUDE_FACADEPATTERN_STATS_H_
+#define INCLUDE_FACADEPATTERN_STATS_H_
+//------------------------------------------------------------------------------
+//
+// This header provides statistics kernels for the signal data acquired
+// through the Facade Design Pattern example.
+//
+// Min, max, mean, RMS and variance are computed in a single pass over a
+// block of uint16_t samples. Blocks are struct-of-arrays (analog[] and
+// digital[] columns, see SampleBlock), so each column is contiguous and loads
+// straight into SIMD registers.
+//
+// Additional design principles, patterns, and modern C++ features used:
+//
+//    1. Runtime CPU Dispatch - AVX2 and SSE4.1 kernels are compiled with
+//       per-function target attributes and picked on first use from what the
+//       CPU supports, so one binary runs everywhere with a portable fallback
+//
+//    2. Exact Integer Accumulation - Sums and sums of squares are kept in
+//       64-bit integers, so every kernel gives bit-identical results for
+//       blocks of up to 2^32 samples
+//
+//------------------------------------------------------------------------------
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+
+#include "facadepattern_sampleblock.h"
+
+namespace SignalDataFacade
+{
+    //--------------------------------------------------------------------------
+    // Types
+    //--------------------------------------------------------------------------
+
+    // Kernel implementations, in order of preference
+    enum class eSimdLevel: uint8_t
+    {
+        SCALAR,
+        SSE4,
+        AVX2
+    };
+
+    const char* toString(eSimdLevel level);
+
+    //--------------------------------------------------------------------------
+    // PODs
+    //--------------------------------------------------------------------------
+
+    // Zeroed for an empty block. Variance is the population variance.
+    struct sSignalStats
+    {
+        size_t count{0};
+        uint16_t min{0};
+        uint16_t max{0};
+        double mean{0.0};
+        double rms{0.0};
+        double variance{0.0};
+    };
+
+    struct sSampleBlockStats
+    {
+        sSignalStats analog;
+        sSignalStats digital;
+    };
+
+    //--------------------------------------------------------------------------
+    // Functions
+    //--------------------------------------------------------------------------
+
+    //--------------------------------------------------------------------------
+    // Best kernel this CPU supports
+    eSimdLevel detectedSimdLevel();
+
+    //--------------------------------------------------------------------------
+    // Statistics of one column, using the best supported kernel
+    sSignalStats computeStats(std::span<const uint16_t> samples);
+
+    //--------------------------------------------------------------------------
+    // Statistics of one column using the given kernel, or the best supported
+    // one below it, for testing and benchmarking
+    sSignalStats computeStats(
+        std::span<const uint16_t> samples,
+        eSimdLevel level);
+
+    //--------------------------------------------------------------------------
+    // Statistics of every column of a block
+    sSampleBlockStats computeStats(const sSampleBlockView& block);
+
+} // namespace SignalDataFacade
+
+#endif // INCLUDE_FACADEPATTERN_STATS_H_
@@ -17,6 +17,7 @@
 
 #include "facadepattern.h"
 #include <cstdint>
+#include <vector>
 
 namespace SignalDataFacade
 {
@@ -39,13 +40,40 @@ namespace SignalDataFacade
     {
     private:
         bool bStarted;
+        std::vector<uint8_t> scanList;
     public:
         static uint16_t testValue;
         static bool bFail;
+        // Number of start() calls, to check conversions per block
+        static uint32_t startCount;
         ADCDrvStub();
         void start() override;
         void stop() override;
         std::optional<uint16_t> read() override;
+        // Scans yield testValue + channel number for each channel
+        bool configureScan(std::span<const uint8_t> channels) override;
+        size_t scan(std::span<uint16_t> frames) override;
+    };
+
+    //--------------------------------------------------------------------------
+    // Class: AdcPolicyStub
+    //
+    // Description:
+    //    Compile-time counterpart of ADCDrvStub for BasicSignalData, sharing
+    //    its test controls.
+    //
+    class AdcPolicyStub
+    {
+    private:
+        bool bStarted{false};
+    public:
+        void start()
+        {
+            ++ADCDrvStub::startCount;
+            bStarted = !ADCDrvStub::bFail;
+        }
+        void stop() { bStarted = false; }
+        uint16_t read() { return bStarted ? ADCDrvStub::testValue : 0; }
     };
 
     //==========================================================================
@@ -67,6 +95,22 @@ namespace SignalDataFacade
         std::optional<uint16_t> read() override;
     };
 
+    //-------------------------------------------------------------------------
+    // Class: GpioPolicyStub
+    //
+    // Description:
+    //    Compile-time counterpart of GPIODrvStub for BasicSignalData, sharing
+    //    its test controls.
+    //
+    class GpioPolicyStub
+    {
+    public:
+        uint16_t read()
+        {
+            return GPIODrvStub::bFail ? 0 : GPIODrvStub::testValue;
+        }
+    };
+
 } // namespace SignalDataFacade
 
 #endif // INCLUDE_FACADEPATTERN_STUBS_H_
\ No newline at end of file
@@ -0,0 +1,221 @@
+// Copyright (c) 2025 Michael Dello
+//
+// This software is provided under the MIT License.
+// See LICENSE file for details.
+
+#ifndef INCLUDE_FACADEPATTERN_TRIGGER_H_
+#define INCLUDE_FACADEPATTERN_TRIGGER_H_
+//------------------------------------------------------------------------------
+//
+// This header provides a trigger engine for the sample stream acquired
+// through the Facade Design Pattern example: it watches every sample for an
+// event and keeps only a window of samples around each one.
+//
+// A trigger is a set of conditions combined with AND or OR:
+//
+//    ANALOG_LEVEL - the analog signal crosses a threshold: rising when a
+//                   sample at or above it follows one below it
+//    ANALOG_SLOPE - the analog signal changes by at least a threshold from
+//                   one sample to the next, upward when rising
+//    GPIO_EDGE    - a GPIO line changes level
+//    GPIO_PATTERN - the GPIO lines under a mask hold a value. This one is a
+//                   state rather than an event, so it can gate the others.
+//
+// The trigger fires on a sample where the combination becomes true. When it
+// fires, the preSamples before that sample are copied out of a history ring,
+// the postSamples from it on are collected as they arrive, and the finished
+// sTriggerCapture is handed to a callback, for example to write it to a
+// capture file. The trigger re-arms once the post-trigger window is full.
+// The first sample of a stream never fires, since it has no predecessor.
+//
+// Conditions are evaluated 64 samples at a time into bit masks, one bit per
+// sample: a vector compare gives the state of a condition for 16 (AVX2) or 8
+// (SSE) samples at once, events are then the state and the state shifted by
+// one sample, and combining conditions is a bitwise AND or OR. Only the
+// samples where the trigger fires are ever looked at individually.
+//
+// Additional design principles, patterns, and modern C++ features used:
+//
+//    1. Runtime CPU Dispatch - As for the statistics kernels, SIMD paths are
+//       compiled with per-function target attributes and picked from what
+//       the CPU supports, with a portable scalar fallback
+//
+//    2. Observer - Finished captures are pushed to a callback, so the engine
+//       does not decide where they go
+//
+//------------------------------------------------------------------------------
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <span>
+#include <vector>
+
+#include "facadepattern.h"
+#include "facadepattern_bitplane.h"
+#include "facadepattern_sampleblock.h"
+#include "facadepattern_stats.h"
+
+namespace SignalDataFacade
+{
+    //--------------------------------------------------------------------------
+    // Types
+    //--------------------------------------------------------------------------
+    enum class eTriggerSource: uint8_t
+    {
+        ANALOG_LEVEL,
+        ANALOG_SLOPE,
+        GPIO_EDGE,
+        GPIO_PATTERN
+    };
+
+    const char* toString(eTriggerSource source);
+
+    enum class eCombine: uint8_t
+    {
+        AND,
+        OR
+    };
+
+    const char* toString(eCombine combine);
+
+    //--------------------------------------------------------------------------
+    // PODs
+    //--------------------------------------------------------------------------
+    struct sTriggerCondition_t
+    {
+        eTriggerSource source{eTriggerSource::ANALOG_LEVEL};
+        // Analog level, or the smallest sample-to-sample change for a slope,
+        // at least 1
+        uint16_t threshold{32768};
+        // Direction of a level crossing, slope or GPIO edge
+        eEdge edge{eEdge::RISING};
+        // GPIO_EDGE line
+        uint8_t line{0};
+        // GPIO_PATTERN: (digital & mask) == value
+        uint16_t mask{0};
+        uint16_t value{0};
+    };
+
+    struct sTriggerConfig_t
+    {
+        std::vector<sTriggerCondition_t> conditions;
+        eCombine combine{eCombine::AND};
+        // Samples kept before the trigger sample, and from it on
+        size_t preSamples{1000};
+        size_t postSamples{1000};
+        // Timestamps within a batch are spaced at this rate
+        double sampleRateHz{1'000'000.0};
+    };
+
+    // The samples around one trigger
+    struct sTriggerCapture
+    {
+        uint64_t triggerSampleIndex{0};
+        uint64_t triggerTimestampNs{0};
+        // First sample of the window, fewer than preSamples before the
+        // trigger when the stream started later than that
+        uint64_t firstSampleIndex{0};
+        uint64_t firstTimestampNs{0};
+        SampleBlock samples;
+    };
+
+    //--------------------------------------------------------------------------
+    // Classes
+    //--------------------------------------------------------------------------
+    // Class: TriggerEngine
+    //
+    // Description:
+    //    Evaluates a trigger over consecutive batches of samples and emits
+    //    the pre/post-trigger window of each firing. Sample indices count
+    //    from the first sample processed. Not thread-safe: meant to run on
+    //    the consumer of SignalData's streaming mode.
+    //
+    class TriggerEngine
+    {
+    public:
+        using CaptureCallback = std::function<void(sTriggerCapture&&)>;
+
+        //----------------------------------------------------------------------
+        // Throws std::invalid_argument for a trigger without conditions, a
+        // GPIO line past 15, a slope threshold of 0, or a sample rate that
+        // is not positive. Kernels use the given level, or the best
+        // supported one below it.
+        TriggerEngine(
+            const sTriggerConfig_t& config,
+            CaptureCallback onCapture,
+            eSimdLevel level = detectedSimdLevel());
+
+        //----------------------------------------------------------------------
+        // Evaluate the next batch of the stream, timestamped from its first
+        // sample, as returned by SignalData::readStream()
+        void process(
+            std::span<const SignalData::sAggregateData> samples,
+            uint64_t firstTimestampNs);
+        void process(const sSampleBlockView& block, uint64_t firstTimestampNs);
+
+        //----------------------------------------------------------------------
+        // Sample indices where the trigger would fire within the next batch,
+        // ignoring re-arming, without capturing or changing any state, for
+        // testing and benchmarking
+        std::vector<uint64_t> evaluate(const sSampleBlockView& block) const;
+
+        //----------------------------------------------------------------------
+        // Emit a partly filled capture, if any
+        void flush();
+        // Drop any capture, history and trigger count, starting over at
+        // sample index 0
+        void reset();
+
+        //----------------------------------------------------------------------
+        uint64_t samplesProcessed() const { return numProcessed; }
+        uint64_t triggerCount() const { return numTriggers; }
+        eSimdLevel simdLevel() const { return kernelLevel; }
+
+    private:
+        // Evaluation state carried from one batch to the next
+        struct sCarry
+        {
+            bool bStarted{false};
+            uint16_t analog{0};
+            uint16_t digital{0};
+            // Whether the combination held on the last sample
+            bool bCombined{true};
+        };
+
+        // Methods
+        // Fire bits of the batch, consecutive 64-sample groups
+        void fireMasks(
+            const sSampleBlockView& block,
+            sCarry& carry,
+            std::vector<uint64_t>& masks) const;
+        // Record samples in the history ring and any open capture
+        void feed(const sSampleBlockView& block, size_t first, size_t count);
+        void startCapture(uint64_t sampleIndex, uint64_t timestampNs);
+
+        // Data Members
+        sTriggerConfig_t triggerConfig;
+        CaptureCallback onCapture;
+        eSimdLevel kernelLevel;
+        double nsPerSample;
+        sCarry carry;
+        uint64_t numProcessed;
+        uint64_t numTriggers;
+        // Index of the first sample that may fire again
+        uint64_t armedFrom;
+        // History of the last samples, a power of two long
+        std::vector<uint16_t> historyAnalog;
+        std::vector<uint16_t> historyDigital;
+        // Capture being filled with post-trigger samples
+        bool bCapturing;
+        sTriggerCapture capture;
+        // Samples the capture holds once complete
+        size_t captureSize;
+        // Reused across batches
+        SampleBlock columns;
+        std::vector<uint64_t> masks;
+    };
+
+} // namespace SignalDataFacade
+
+#endif // INCLUDE_FACADEPATTERN_TRIGGER_H_
@@ -20,6 +20,38 @@
 //
 // For simplicity, the IDUT interface blocks.
 //
+// A single DUTProxyClient may be shared by many threads. Concurrent callers
+// enqueue their requests, and whichever caller finds the connection idle
+// becomes the writer for everything queued so far: it sends the whole batch
+// in one write and routes each response back to the waiting caller.
+//
+// The server services all of its connections from a single poll() loop.
+// Besides running tests, a connection can subscribe to the DUT's running
+// result: the server then pushes a 16-bit eTestResults event whenever the
+// running result changes, coalescing bursts of changes within a configurable
+// window into one event. This replaces destructive STOP_TESTING polling.
+//
+// Large DUT artifacts (logs, waveform dumps) found in the server's artifact
+// directory can be fetched by name. The server streams them in chunks with
+// sendfile() straight from the page cache to the socket, and the client can
+// splice() them on into a file descriptor, so the payload is never copied
+// through user space on either side. TCP flow control paces the sender to
+// the rate at which the client drains its socket.
+//
+//     Request:  FETCH_ARTIFACT, uint16 name length, name bytes
+//     Response: uint64 artifact size (ARTIFACT_NOT_FOUND if unavailable),
+//               followed by that many artifact bytes
+//
+// The server keeps always-on latency accounting per connection and per test:
+// HDR-style histograms of queue time (received to execute start), execute
+// time and write time (execute end to response fully sent). Requests slower
+// end to end than a configurable threshold are logged as they complete, and a
+// text snapshot of every live connection is returned by the DUMP_STATS
+// request:
+//
+//     Request:  DUMP_STATS
+//     Response: uint32 report length, followed by the report text
+//
 // This design pattern decouples the client logic from the complexities of
 // using an object that the proxy implements, in this case, a TCP/IP network
 // connection.
@@ -36,8 +68,19 @@
 //------------------------------------------------------------------------------
 
 #include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <span>
 #include <string>
 #include <thread>
+#include <vector>
+
+#include "common/latency_histogram.h"
+#include "common/mpsc_queue.h"
 
 namespace DUTProxy
 {
@@ -48,6 +91,9 @@ namespace DUTProxy
     // Define a single instance of the constant representing the proxy TCP port
     inline constexpr uint16_t DUT_PROXY_TCP_PORT = 42042;
 
+    // Artifact size reported when the requested artifact cannot be served
+    inline constexpr uint64_t ARTIFACT_NOT_FOUND = UINT64_MAX;
+
     // Testing result conditions, for both individual tests, and overall
     // assessment (individual results AND'd together)
     enum class eTestResults: uint16_t
@@ -83,6 +129,23 @@ namespace DUTProxy
     // its address in read-only static memory)
     const char* toString(eTests test);
 
+    // Proxy control requests, sharing the 16-bit request space with eTests.
+    // These are handled by the proxy server and never reach the DUT.
+    enum class eProxyRequests: uint16_t
+    {
+        // Turn the connection into a running result event stream. The server
+        // answers with the current running result, then pushes each change.
+        SUBSCRIBE_RESULTS = 0xFFFE,
+        // Stream a named file from the server's artifact directory
+        FETCH_ARTIFACT    = 0xFFFD,
+        // Report the per-connection latency statistics as text
+        DUMP_STATS        = 0xFFFC
+    };
+
+    // Convert a proxy request enum value to a string (literal, safe to return
+    // its address in read-only static memory)
+    const char* toString(eProxyRequests request);
+
     //--------------------------------------------------------------------------
     // PODs
     //--------------------------------------------------------------------------
@@ -96,6 +159,19 @@ namespace DUTProxy
         std::string sIPAddr;
     };
 
+    struct sProxyServerConfig_t
+    {
+        // Running result changes within this window are pushed to subscribers
+        // as a single event carrying the latest result
+        std::chrono::milliseconds eventWindow{10};
+        // Directory holding fetchable DUT artifacts, empty disables fetching
+        std::string sArtifactDir;
+        // Requests taking longer than this from receipt to response sent are
+        // logged individually
+        std::chrono::microseconds slowRequestThreshold{
+            std::chrono::milliseconds(100)};
+    };
+
     //--------------------------------------------------------------------------
     // Classes
     //--------------------------------------------------------------------------
@@ -122,7 +198,8 @@ namespace DUTProxy
     class DUT: public IDUT
     {
     public:
-        DUT(sDUTConfig_t sConfig);
+        // Announcing the new DUT can be skipped when creating many at once
+        DUT(sDUTConfig_t sConfig, bool bAnnounce = true);
         // Make this method available for override in a subclass, for unit test
         // stubbing
         //
@@ -133,6 +210,8 @@ namespace DUTProxy
         //
         // A "stop" condition returns and resets the overal test result
         virtual eTestResults execute(eTests test) override;
+        // Non-destructive view of the running result (STOP_TESTING resets it)
+        eTestResults currentResult() const;
     private:
         eTestResults runningResult;
         std::string sName;
@@ -184,6 +263,9 @@ namespace DUTProxy
     //    case, a TCP client that connects to a remote server to execute tests
     //    on a remote DUT object.
     //
+    //    Thread-safe: concurrent calls to execute() are coalesced into a
+    //    single write on the shared connection (see file header).
+    //
     class DUTProxyClient: public IDUT
     {
     public:
@@ -191,13 +273,77 @@ namespace DUTProxy
 
         eTestResults execute(eTests test) override;
 
+        // Fetch a DUT artifact into a caller-provided buffer. Returns the
+        // artifact size, or nothing if it is unavailable or does not fit.
+        std::optional<size_t> fetchArtifact(
+            const std::string& sArtifactName,
+            std::span<std::byte> buffer);
+
+        // Fetch a DUT artifact into a file descriptor (file, pipe or socket)
+        // using splice(), without copying through user space. Returns the
+        // artifact size, or nothing if it is unavailable or cannot be written.
+        std::optional<size_t> fetchArtifact(
+            const std::string& sArtifactName,
+            int destinationFd);
+
+        // Retrieve the server's latency statistics snapshot
+        std::optional<std::string> fetchStats();
+
     private:
+        // A request waiting to be written, owned by the calling thread's stack
+        struct sPendingRequest
+        {
+            eTests test;
+            eTestResults result{eTestResults::INCOMPLETE};
+            std::atomic<bool> bDone{false};
+            sPendingRequest* pNext{nullptr};
+        };
+
         // Data members
         Socket socket;
         std::string sDUTName;
         std::string sDUTIPAddr;
+        // Requests queued by any thread, flushed by the current writer
+        Concurrency::MpscQueue<sPendingRequest> pendingRequests;
+        // Elects a single writer and wakes callers when a batch completes
+        std::mutex writerMutex;
+        std::condition_variable batchDone;
+        bool bWriterActive;
+        // Wire buffers, only touched by the current writer
+        std::vector<uint16_t> txBuffer;
+        std::vector<uint16_t> rxBuffer;
         // Methods
         void connectToServer();
+        void flushPendingRequests();
+        // Wait for the connection to go idle and take it over exclusively
+        void acquireConnection();
+        void releaseConnection();
+        std::optional<uint64_t> requestArtifact(
+            const std::string& sArtifactName);
+        void discardArtifactBytes(uint64_t length);
+    };
+
+    //--------------------------------------------------------------------------
+    // Class: DUTResultSubscriber
+    //
+    // Description:
+    //    A TCP client that subscribes to a remote DUT's running result and
+    //    receives the events the proxy server pushes, without polling.
+    //
+    class DUTResultSubscriber
+    {
+    public:
+        DUTResultSubscriber(sRemoteDUTConfig_t sConfig);
+
+        // Block until the next pushed running result, or return nothing if
+        // none arrives within the timeout or the server closed the connection
+        std::optional<eTestResults> nextEvent(std::chrono::milliseconds timeout);
+
+    private:
+        // Data members
+        Socket socket;
+        std::string sDUTName;
+        std::string sDUTIPAddr;
     };
 
     //--------------------------------------------------------------------------
@@ -205,28 +351,101 @@ namespace DUTProxy
     //
     // Description:
     //    A concrete DUT with the additional functionality of a Proxy, in this
-    //    case, a TCP server that services requests from a connecting client to
-    //    execute tests on a DUT object with which it has an association.
+    //    case, a TCP server that services requests from connecting clients to
+    //    execute tests on a DUT object with which it has an association, and
+    //    pushes running result changes to subscribed clients.
     //
     class DUTProxyServer
     {
     public:
         // Constructor will start server thread
-        DUTProxyServer(DUT &targetDUT);
+        DUTProxyServer(DUT &targetDUT, sProxyServerConfig_t sConfig = {});
         // Destructor will end server thread
         ~DUTProxyServer();
     private:
+        // An artifact being streamed to a client with sendfile()
+        struct sArtifactTransfer
+        {
+            int fileFd;
+            int64_t offset;
+            uint64_t remaining;
+            ~sArtifactTransfer();
+        };
+
+        using Clock = std::chrono::steady_clock;
+
+        // Latency accounting for one test on one connection
+        struct sTestLatency
+        {
+            uint16_t rawTest;
+            Metrics::LatencyHistogram queueTime;
+            Metrics::LatencyHistogram executeTime;
+            Metrics::LatencyHistogram writeTime;
+        };
+
+        // Timestamps of an executed test whose response is not yet sent
+        struct sRequestTiming
+        {
+            uint16_t rawTest;
+            Clock::time_point received;
+            Clock::time_point executeStart;
+            Clock::time_point executeEnd;
+        };
+
+        // Per-client state, only touched by the server thread
+        struct sConnection
+        {
+            Socket socket;
+            uint64_t id{0};
+            // Received bytes not yet forming a whole request
+            std::vector<uint8_t> rxBytes;
+            // Responses and events not yet accepted by the socket
+            std::vector<uint8_t> txBytes;
+            bool bClosed{false};
+            bool bSubscribed{false};
+            eTestResults lastPublished{eTestResults::NONE};
+            // Requests wait while an artifact is streaming, keeping order
+            std::unique_ptr<sArtifactTransfer> upTransfer;
+            // When the first byte of the oldest request in rxBytes arrived
+            Clock::time_point received;
+            std::vector<sRequestTiming> unsentTimings;
+            // Few distinct tests are run, so a flat list beats a map
+            std::vector<sTestLatency> latencies;
+        };
+
         // Methods
         void ServerEntry();
-        void handleClient(Socket&& clientSocket);
+        void acceptClient();
+        void receiveRequests(sConnection& connection);
+        void processRequests(sConnection& connection);
+        void handleRequest(sConnection& connection, uint16_t rawRequest);
+        void handleDumpStats(sConnection& connection);
+        // Returns false until the whole variable length request has arrived
+        bool handleFetchArtifact(sConnection& connection, size_t& offset);
+        void flush(sConnection& connection);
+        // Returns true once all buffered responses have been sent
+        bool sendBufferedBytes(sConnection& connection);
+        // Returns true once the whole artifact has been sent, sending a
+        // bounded number of chunks per call
+        bool streamArtifact(sConnection& connection);
+        // Account for the responses that have now been sent
+        void recordLatencies(sConnection& connection, Clock::time_point sent);
+        std::string statsReport() const;
+        void publishResultEvents();
+        int pollTimeoutMs() const;
 
         // Data Members
         DUT &dut;
+        sProxyServerConfig_t config;
         std::thread serverThread;
         // Use a thread-safe variable to coordinate stopping the server thread
         // from higher level context (destructor call)
         std::atomic<bool> running;
         Socket serverSocket;
+        std::vector<sConnection> connections;
+        uint64_t nextConnectionId{1};
+        // When the pending burst of running result changes is published
+        std::optional<std::chrono::steady_clock::time_point> eventDeadline;
     };
 
 } // namespace DUTProxy
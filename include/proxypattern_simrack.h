@@ -0,0 +1,259 @@
+// Copyright (c) 2025 Michael Dello
+//
+// This software is provided under the MIT License.
+// See LICENSE file for details.
+
+#ifndef INCLUDE_PROXYPATTERN_SIMRACK_H_
+#define INCLUDE_PROXYPATTERN_SIMRACK_H_
+//------------------------------------------------------------------------------
+//
+// This header provides a simulated rack of DUTs for scale testing the Proxy
+// Design Pattern example.
+//
+// A SimRack listens on the proxy TCP port and serves every accepted
+// connection as its own simulated DUT session, speaking the same wire
+// protocol as the DUTProxyServer, so DUTProxyClient objects (or any other
+// load source) can drive thousands of DUTs on one Linux box. Each test can
+// be given a latency model so the rack behaves like slow real hardware.
+//
+// Sessions are C++20 coroutines cooperatively multitasked by a SimScheduler
+// on a single thread. A session that would block on its socket, or that is
+// simulating test latency, suspends and lets the others run, so 10,000+
+// sessions cost a coroutine frame each rather than a thread each.
+//
+// Additional design principles, patterns, and modern C++ features used:
+//
+//    1. C++20 Coroutines - Sessions are written as straight-line code while
+//       the scheduler interleaves them around I/O readiness and timers
+//
+//    2. RAII - Sockets and coroutine frames are released by their owners,
+//       including sessions still suspended when the scheduler is destroyed
+//
+//------------------------------------------------------------------------------
+
+#include <atomic>
+#include <chrono>
+#include <coroutine>
+#include <cstdint>
+#include <deque>
+#include <exception>
+#include <map>
+#include <memory>
+#include <queue>
+#include <random>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+#include "proxypattern.h"
+
+namespace DUTProxy
+{
+    //--------------------------------------------------------------------------
+    // PODs
+    //--------------------------------------------------------------------------
+
+    // Simulated test duration, uniformly distributed in mean +/- jitter
+    struct sSimLatency_t
+    {
+        std::chrono::microseconds mean{0};
+        std::chrono::microseconds jitter{0};
+    };
+
+    struct sSimRackConfig_t
+    {
+        uint16_t port{DUT_PROXY_TCP_PORT};
+        // Session N simulates the DUT named sNamePrefix + N
+        std::string sNamePrefix{"SIM-DUT-"};
+        // Latency model per test, tests not listed complete immediately
+        std::map<eTests, sSimLatency_t> latencies;
+        // Seed for the latency models, for reproducible runs
+        uint64_t seed{1};
+    };
+
+    //--------------------------------------------------------------------------
+    // Classes
+    //--------------------------------------------------------------------------
+    class SimScheduler;
+
+    //--------------------------------------------------------------------------
+    // Class: SimTask
+    //
+    // Description:
+    //    The return type of a coroutine run by the SimScheduler. It starts
+    //    suspended and is handed to SimScheduler::spawn(), which then owns it.
+    //
+    class SimTask
+    {
+    public:
+        struct promise_type
+        {
+            SimTask get_return_object() noexcept
+            {
+                return SimTask{
+                    std::coroutine_handle<promise_type>::from_promise(*this)};
+            }
+            std::suspend_always initial_suspend() noexcept { return {}; }
+            // Stay suspended so the scheduler sees done() and frees the frame
+            std::suspend_always final_suspend() noexcept { return {}; }
+            void return_void() noexcept {}
+            // Propagate out of SimScheduler::run()
+            void unhandled_exception() { throw; }
+        };
+
+        SimTask(SimTask&& owned) noexcept;
+        SimTask& operator=(SimTask&&) = delete;
+        SimTask(const SimTask&) = delete;
+        SimTask& operator=(const SimTask&) = delete;
+        ~SimTask();
+
+    private:
+        friend class SimScheduler;
+        explicit SimTask(std::coroutine_handle<promise_type> handle) noexcept;
+        std::coroutine_handle<promise_type> handle;
+    };
+
+    //--------------------------------------------------------------------------
+    // Class: SimScheduler
+    //
+    // Description:
+    //    A single-threaded cooperative scheduler for SimTask coroutines. Tasks
+    //    suspend on socket readiness (epoll) or timers and are resumed by
+    //    run() when they can make progress.
+    //
+    class SimScheduler
+    {
+    public:
+        SimScheduler();
+        // Destroys the frames of any tasks still suspended
+        ~SimScheduler();
+
+        SimScheduler(const SimScheduler&) = delete;
+        SimScheduler& operator=(const SimScheduler&) = delete;
+
+        //----------------------------------------------------------------------
+        // Take ownership of a task and make it runnable
+        void spawn(SimTask task);
+
+        //----------------------------------------------------------------------
+        // Run tasks on the calling thread until all have finished or stop()
+        void run();
+
+        //----------------------------------------------------------------------
+        // Make run() return. Safe to call from any thread.
+        void stop();
+
+        //----------------------------------------------------------------------
+        size_t liveTasks() const;
+
+        //----------------------------------------------------------------------
+        // Awaitables, only to be co_awaited by tasks of this scheduler
+        struct SleepAwaiter
+        {
+            SimScheduler& scheduler;
+            std::chrono::steady_clock::time_point wakeTime;
+            bool await_ready() const noexcept;
+            void await_suspend(std::coroutine_handle<> handle);
+            void await_resume() const noexcept {}
+        };
+
+        struct FdAwaiter
+        {
+            SimScheduler& scheduler;
+            int fd;
+            bool bWrite;
+            bool await_ready() const noexcept { return false; }
+            void await_suspend(std::coroutine_handle<> handle);
+            void await_resume() const noexcept {}
+        };
+
+        SleepAwaiter sleepFor(std::chrono::nanoseconds duration);
+        // Resume once the descriptor is readable (or closed/errored)
+        FdAwaiter readable(int fd);
+        // Resume once the descriptor is writable (or closed/errored)
+        FdAwaiter writable(int fd);
+
+    private:
+        struct sTimer
+        {
+            std::chrono::steady_clock::time_point wakeTime;
+            uint64_t sequence;
+            std::coroutine_handle<> handle;
+            bool operator>(const sTimer& other) const
+            {
+                return wakeTime != other.wakeTime ?
+                    wakeTime > other.wakeTime : sequence > other.sequence;
+            }
+        };
+
+        struct sFdWaiters
+        {
+            std::coroutine_handle<> reader;
+            std::coroutine_handle<> writer;
+        };
+
+        // Methods
+        void resumeReady();
+        void fireTimers();
+        void waitForEvents();
+        void watch(int fd, const sFdWaiters& waiters);
+
+        // Data Members
+        int epollFd;
+        // Written by stop() to wake epoll_wait() from another thread
+        int wakeFd;
+        std::atomic<bool> bStopping;
+        // Frames of spawned tasks, by coroutine_handle::address()
+        std::unordered_set<void*> tasks;
+        std::deque<std::coroutine_handle<>> ready;
+        std::priority_queue<sTimer, std::vector<sTimer>, std::greater<>> timers;
+        uint64_t timerSequence;
+        std::unordered_map<int, sFdWaiters> fdWaiters;
+    };
+
+    //--------------------------------------------------------------------------
+    // Class: SimRack
+    //
+    // Description:
+    //    A rack of simulated DUTs served over the proxy wire protocol. Every
+    //    accepted connection becomes a session with its own DUT object. The
+    //    rack runs on the given scheduler, and must not be destroyed while
+    //    the scheduler is running. Either may be destroyed first once it has
+    //    stopped: session frames the scheduler destroys only touch state
+    //    they share ownership of.
+    //
+    class SimRack
+    {
+    public:
+        SimRack(SimScheduler& scheduler, sSimRackConfig_t sConfig = {});
+
+        SimRack(const SimRack&) = delete;
+        SimRack& operator=(const SimRack&) = delete;
+
+        //----------------------------------------------------------------------
+        // Sessions currently connected (readable from any thread)
+        size_t activeSessions() const;
+        // Test requests answered across all sessions (readable from any thread)
+        uint64_t requestsServed() const;
+
+    private:
+        // Methods
+        SimTask acceptSessions();
+        SimTask serveSession(Socket clientSocket, uint64_t sessionIndex);
+        std::chrono::nanoseconds simulatedLatency(eTests test);
+
+        // Data Members
+        SimScheduler& scheduler;
+        sSimRackConfig_t config;
+        Socket listenSocket;
+        std::mt19937_64 latencyRng;
+        uint64_t sessionsAccepted;
+        // Shared with the session frames, which may outlive the rack
+        std::shared_ptr<std::atomic<size_t>> spSessionsActive;
+        std::atomic<uint64_t> requestsAnswered;
+    };
+
+} // namespace DUTProxy
+
+#endif // INCLUDE_PROXYPATTERN_SIMRACK_H_
@@ -10,13 +10,131 @@
 //-----------------------------------------------------------------------------
 
 #include "facadepattern.h"
+#include "facadepattern_sampleblock.h"
+#include "common/tsc_clock.h"
+#include <algorithm>
+#include <array>
+#include <cstring>
+#include <future>
+#include <iomanip>
 #include <iostream>
 #include <memory>
 #include <random>
+#include <span>
+#include <sstream>
+#include <stdexcept>
+#include <string>
 #include <utility>
+#include <vector>
+
+#if defined(__linux__)
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+namespace // anonymous
+{
+    //--------------------------------------------------------------------------
+    // Random values simulating real hardware, four samples per generator call
+    void fillSimulatedSamples(
+        Random::Xoshiro256pp& rng,
+        std::span<uint16_t> samples)
+    {
+        size_t i = 0;
+        for (; i + 4 <= samples.size(); i += 4)
+        {
+            uint64_t bits = rng();
+            samples[i] = uint16_t(bits);
+            samples[i + 1] = uint16_t(bits >> 16);
+            samples[i + 2] = uint16_t(bits >> 32);
+            samples[i + 3] = uint16_t(bits >> 48);
+        }
+        for (; i < samples.size(); ++i)
+        {
+            samples[i] = uint16_t(rng() >> 48);
+        }
+    }
+
+    //--------------------------------------------------------------------------
+    // Restrict the calling thread to one CPU
+    void pinCurrentThread(unsigned cpu)
+    {
+#if defined(__linux__)
+        if (cpu >= CPU_SETSIZE)
+        {
+            throw std::invalid_argument("CPU index out of range");
+        }
+        cpu_set_t cpus;
+        CPU_ZERO(&cpus);
+        CPU_SET(cpu, &cpus);
+        int error =
+            pthread_setaffinity_np(pthread_self(), sizeof(cpus), &cpus);
+        if (error != 0)
+        {
+            throw std::runtime_error(
+                std::string("Failed to set CPU affinity: ") +
+                std::strerror(error));
+        }
+#else
+        (void)cpu;
+        throw std::runtime_error("CPU affinity is not supported");
+#endif
+    }
+
+} // namespace anonymous
 
 namespace SignalDataFacade
 {
+    //===========================================================================
+    // Interface Defaults
+    //===========================================================================
+
+    //---------------------------------------------------------------------------
+    size_t IA2DConverter::readBlock(std::span<uint16_t> samples)
+    {
+        size_t numRead = 0;
+        for (uint16_t& sample : samples)
+        {
+            std::optional<uint16_t> value = read();
+            if (!value)
+            {
+                break;
+            }
+            sample = *value;
+            ++numRead;
+        }
+        return numRead;
+    }
+
+    //---------------------------------------------------------------------------
+    bool IA2DConverter::configureScan(std::span<const uint8_t> channels)
+    {
+        return channels.size() == 1 && channels[0] == 0;
+    }
+
+    //---------------------------------------------------------------------------
+    size_t IA2DConverter::scan(std::span<uint16_t> frames)
+    {
+        // One channel, so a frame is a sample
+        return readBlock(frames);
+    }
+
+    //---------------------------------------------------------------------------
+    size_t IGPIO::readBlock(std::span<uint16_t> samples)
+    {
+        size_t numRead = 0;
+        for (uint16_t& sample : samples)
+        {
+            std::optional<uint16_t> value = read();
+            if (!value)
+            {
+                break;
+            }
+            sample = *value;
+            ++numRead;
+        }
+        return numRead;
+    }
     //===========================================================================
     // ADC Implementation
     //===========================================================================
@@ -25,7 +143,7 @@ namespace SignalDataFacade
     // ADC HAL Implementation
     //---------------------------------------------------------------------------
     A2DConverterHAL::A2DConverterHAL(std::unique_ptr<IA2DConverter> adcImpl)
-    : upADC{std::move(adcImpl)}
+    : upADC{std::move(adcImpl)}, numScanChannels{1}
     {
         std::cout << "Creating new ADC HAL object" << std::endl;
     }
@@ -42,10 +160,77 @@ namespace SignalDataFacade
         return currentADCSignalRead;
     }
 
+    //---------------------------------------------------------------------------
+    size_t A2DConverterHAL::readBlock(std::span<uint16_t> samples) const
+    {
+        // Collect the whole block in one conversion run
+        start();
+        size_t numRead = readBlockStarted(samples);
+        stop();
+
+        return numRead;
+    }
+
+    //---------------------------------------------------------------------------
+    void A2DConverterHAL::start() const
+    {
+        upADC->start();
+    }
+
+    //---------------------------------------------------------------------------
+    void A2DConverterHAL::stop() const
+    {
+        upADC->stop();
+    }
+
+    //---------------------------------------------------------------------------
+    size_t A2DConverterHAL::readBlockStarted(std::span<uint16_t> samples) const
+    {
+        size_t numRead = upADC->readBlock(samples);
+
+        // Simulate no signal for anything that could not be read
+        std::fill(samples.begin() + numRead, samples.end(), uint16_t{0});
+        return numRead;
+    }
+
+    //---------------------------------------------------------------------------
+    bool A2DConverterHAL::configureScan(std::span<const uint8_t> channels)
+    {
+        if (!upADC->configureScan(channels))
+        {
+            return false;
+        }
+        numScanChannels = channels.size();
+        return true;
+    }
+
+    //---------------------------------------------------------------------------
+    size_t A2DConverterHAL::scanChannels() const
+    {
+        return numScanChannels;
+    }
+
+    //---------------------------------------------------------------------------
+    size_t A2DConverterHAL::scan(std::span<uint16_t> frames) const
+    {
+        // Collect every frame in one conversion run
+        upADC->start();
+        size_t numFrames = upADC->scan(frames);
+        upADC->stop();
+
+        // Simulate no signal for anything that could not be read
+        std::fill(
+            frames.begin() + numFrames * numScanChannels,
+            frames.end(),
+            uint16_t{0});
+        return numFrames;
+    }
+
     //-------------------------------------------------------------------------
     // ADC Driver Implementation
     //-------------------------------------------------------------------------
-    ADCDrv::ADCDrv(): bStarted{false}
+    ADCDrv::ADCDrv()
+    : bStarted{false}, scanList{0}, rng{std::random_device{}()}
     {
         std::cout << "Creating new ADC Driver object" << std::endl;
     }
@@ -69,15 +254,67 @@ namespace SignalDataFacade
         if (bStarted)
         {
             // Return a random value simulating real hardware
-            static std::random_device rd;
-            static std::mt19937 rng(rd());
-            static std::uniform_int_distribution<uint16_t> dist(0, 65535);
-            return dist(rng);
+            return uint16_t(rng() >> 48);
         }
         // Default is something is wrong, return nothing
         return {};
     }
 
+    //-------------------------------------------------------------------------
+    size_t ADCDrv::readBlock(std::span<uint16_t> samples)
+    {
+        // Read only if started
+        if (!bStarted)
+        {
+            return 0;
+        }
+        fillSimulatedSamples(rng, samples);
+        return samples.size();
+    }
+
+    //-------------------------------------------------------------------------
+    bool ADCDrv::configureScan(std::span<const uint8_t> channels)
+    {
+        if (channels.empty() ||
+            std::any_of(
+                channels.begin(),
+                channels.end(),
+                [](uint8_t channel) { return channel >= NUM_CHANNELS; }))
+        {
+            return false;
+        }
+        scanList.assign(channels.begin(), channels.end());
+        return true;
+    }
+
+    //-------------------------------------------------------------------------
+    size_t ADCDrv::scan(std::span<uint16_t> frames)
+    {
+        // Read only if started
+        if (!bStarted)
+        {
+            return 0;
+        }
+
+        size_t frameSize = scanList.size();
+        size_t numFrames = frames.size() / frameSize;
+        dmaBuffer.resize(DMA_BLOCK_FRAMES * frameSize);
+        for (size_t done = 0; done < numFrames; done += DMA_BLOCK_FRAMES)
+        {
+            // The converter fills the DMA buffer a block of scans at a time,
+            // then the block is copied out in one transfer
+            size_t blockSamples =
+                std::min(DMA_BLOCK_FRAMES, numFrames - done) * frameSize;
+            fillSimulatedSamples(
+                rng, std::span(dmaBuffer).first(blockSamples));
+            std::copy_n(
+                dmaBuffer.begin(),
+                blockSamples,
+                frames.begin() + done * frameSize);
+        }
+        return numFrames;
+    }
+
     //===========================================================================
     // GPIO Implementation
     //===========================================================================
@@ -102,16 +339,36 @@ namespace SignalDataFacade
         return currentGPIOSignalRead;
     }
 
+    //---------------------------------------------------------------------------
+    size_t GPIOHAL::readBlock(std::span<uint16_t> samples) const
+    {
+        size_t numRead = upGPIO->readBlock(samples);
+
+        // Simulate no signal for anything that could not be read
+        std::fill(samples.begin() + numRead, samples.end(), uint16_t{0});
+        return numRead;
+    }
+
     //-------------------------------------------------------------------------
     // GPIO Driver Implementation
+    //-------------------------------------------------------------------------
+    GPIODrv::GPIODrv(): rng{std::random_device{}()}
+    {
+        // No Body
+    }
+
     //-------------------------------------------------------------------------
     std::optional<uint16_t> GPIODrv::read()
     {
         // Return a random value simulating real hardware
-        static std::random_device rd;
-        static std::mt19937 rng(rd());
-        static std::uniform_int_distribution<uint16_t> dist(0, 65535);
-        return dist(rng);
+        return uint16_t(rng() >> 48);
+    }
+
+    //-------------------------------------------------------------------------
+    size_t GPIODrv::readBlock(std::span<uint16_t> samples)
+    {
+        fillSimulatedSamples(rng, samples);
+        return samples.size();
     }
 
     //===========================================================================
@@ -124,40 +381,53 @@ namespace SignalDataFacade
     SignalData::SignalData(
         std::unique_ptr<A2DConverterHAL> adcImpl,
         std::unique_ptr<GPIOHAL> gpioImpl)
-    : adc{std::move(adcImpl)}, gpio{std::move(gpioImpl)}
+    : adc{adcImpl ? std::move(adcImpl) :
+            std::make_unique<A2DConverterHAL>(std::make_unique<ADCDrv>())},
+      gpio{gpioImpl ? std::move(gpioImpl) :
+            std::make_unique<GPIOHAL>(std::make_unique<GPIODrv>())},
+      bStreaming{false},
+      overruns{0},
+      consumedSamples{0},
+      currentMark{0, 0},
+      samplePeriodNs{0.0},
+      lastStreamTimestampNs{0},
+      lastBlockStartNs{0},
+      lastBlockSamples{0},
+      acquiredSamples{0}
     {
         std::cout << "Creating new Signal Data object" << std::endl;
     }
 
+    //---------------------------------------------------------------------------
+    SignalData::~SignalData()
+    {
+        stopStreaming();
+    }
+
     //---------------------------------------------------------------------------
     // Singleton Instance
     SignalData& SignalData::getInstance(
         std::unique_ptr<A2DConverterHAL> adcImpl,
         std::unique_ptr<GPIOHAL> gpioImpl)
     {
-        // Transfer ownership if implementations provided,
-        // otherwise create new unique implementations
-        static SignalData instance(
-            adcImpl ? std::move(adcImpl) :
-                std::make_unique<A2DConverterHAL>(std::make_unique<ADCDrv>()),
-            gpioImpl ? std::move(gpioImpl) :
-                std::make_unique<GPIOHAL>(std::make_unique<GPIODrv>()));
+        // Transfer ownership if implementations provided, the constructor
+        // creates default ones otherwise
+        static SignalData instance(std::move(adcImpl), std::move(gpioImpl));
 
+        // Implementations left over were passed after the first call
+        if (adcImpl || gpioImpl)
+        {
+            std::cerr << "SignalData::getInstance(): instance already exists, "
+                      << "ignoring the HALs passed in" << std::endl;
+        }
         return instance;
     }
 
-    //---------------------------------------------------------------------------
-    SignalData::sAggregateData::sAggregateData(
-        uint16_t analogData,
-        uint16_t digitalData)
-    : analog{analogData}, digital{digitalData}
-    {
-        std::cout << "Creating new Aggregate Data object" << std::endl;
-    }
-
     //---------------------------------------------------------------------------
     SignalData::sAggregateData SignalData::acquire() const
     {
+        uint64_t startNs = Metrics::TscClock::nowNs();
+
         // Collect Analog data component
         // If no value, simulate no signal by returning 0
         uint16_t analogDataValue = adc->read().value_or(0);
@@ -166,7 +436,431 @@ namespace SignalDataFacade
         // If no value, simulate no signal by returning 0
         uint16_t digitalDataValue = gpio->read().value_or(0);
 
-        return sAggregateData(analogDataValue,digitalDataValue);
+        uint64_t endNs = Metrics::TscClock::nowNs();
+        recordBlock(startNs, endNs, 1);
+        sAggregateData sample(analogDataValue,digitalDataValue);
+        publishLatest(sample, endNs, 1);
+        return sample;
+    }
+
+    //---------------------------------------------------------------------------
+    uint64_t SignalData::acquireBatch(std::span<sAggregateData> samples) const
+    {
+        // Block reads fill a staging column per source, interleaved
+        // afterwards. The columns only grow, to the largest batch seen.
+        std::lock_guard<std::mutex> lock(batchMutex);
+        if (batchAnalog.size() < samples.size())
+        {
+            batchAnalog.resize(samples.size());
+            batchDigital.resize(samples.size());
+        }
+        std::span<uint16_t> analogData(batchAnalog.data(), samples.size());
+        std::span<uint16_t> digitalData(batchDigital.data(), samples.size());
+
+        // Failed reads are zeroed by the HALs, simulating no signal
+        uint64_t startNs = Metrics::TscClock::nowNs();
+        adc->readBlock(analogData);
+        gpio->readBlock(digitalData);
+        uint64_t endNs = Metrics::TscClock::nowNs();
+        recordBlock(startNs, endNs, samples.size());
+
+        for (size_t i = 0; i < samples.size(); ++i)
+        {
+            samples[i].analog = analogData[i];
+            samples[i].digital = digitalData[i];
+        }
+        if (!samples.empty())
+        {
+            publishLatest(samples.back(), endNs, samples.size());
+        }
+        return startNs;
+    }
+
+    //---------------------------------------------------------------------------
+    void SignalData::acquire(SampleBlock& block) const
+    {
+        // Publishes the sample too
+        block.push_back(acquire());
+    }
+
+    //---------------------------------------------------------------------------
+    uint64_t SignalData::acquireBatch(SampleBlock& block, size_t count) const
+    {
+        // No staging buffers, each source fills its own column in place
+        size_t first = block.appendUninitialized(count);
+        uint64_t startNs = Metrics::TscClock::nowNs();
+        adc->readBlock(block.analog().subspan(first));
+        gpio->readBlock(block.digital().subspan(first));
+        uint64_t endNs = Metrics::TscClock::nowNs();
+        recordBlock(startNs, endNs, count);
+        if (count > 0)
+        {
+            publishLatest(block[block.size() - 1], endNs, count);
+        }
+        return startNs;
+    }
+
+    //---------------------------------------------------------------------------
+    // Multi-channel Frames Implementation
+    //---------------------------------------------------------------------------
+    bool SignalData::configureScan(std::span<const uint8_t> channels)
+    {
+        return adc->configureScan(channels);
+    }
+
+    //---------------------------------------------------------------------------
+    size_t SignalData::scanChannels() const
+    {
+        return adc->scanChannels();
+    }
+
+    //---------------------------------------------------------------------------
+    size_t SignalData::acquireFrames(
+        std::span<uint16_t> analogFrames,
+        std::span<uint16_t> digital) const
+    {
+        size_t numFrames = std::min(
+            analogFrames.size() / adc->scanChannels(), digital.size());
+
+        // Failed reads are zeroed by the HALs, simulating no signal
+        uint64_t startNs = Metrics::TscClock::nowNs();
+        adc->scan(analogFrames.first(numFrames * adc->scanChannels()));
+        gpio->readBlock(digital.first(numFrames));
+        recordBlock(startNs, Metrics::TscClock::nowNs(), numFrames);
+        return numFrames;
+    }
+
+    //---------------------------------------------------------------------------
+    // Streaming Mode Implementation
+    //---------------------------------------------------------------------------
+    void SignalData::startStreaming(
+        size_t ringCapacity,
+        std::optional<unsigned> cpu)
+    {
+        if (bStreaming)
+        {
+            return;
+        }
+        consumedSamples = 0;
+        currentMark = {0, 0};
+        nextMark.reset();
+        samplePeriodNs = 0.0;
+        lastStreamTimestampNs = 0;
+        overruns = 0;
+        bStreaming = true;
+
+        // The streaming thread pins itself and allocates the rings, so it
+        // runs on its CPU from its first instruction and the rings are
+        // first touched there. Wait for it, the rings are read from here on.
+        std::promise<void> started;
+        std::future<void> startResult = started.get_future();
+        streamThread = std::thread(
+            &SignalData::streamEntry,
+            this,
+            ringCapacity,
+            cpu,
+            std::move(started));
+        try
+        {
+            startResult.get();
+        }
+        catch (...)
+        {
+            stopStreaming();
+            upStreamRing.reset();
+            upMarkRing.reset();
+            throw;
+        }
+    }
+
+    //---------------------------------------------------------------------------
+    void SignalData::stopStreaming()
+    {
+        bStreaming = false;
+        if (streamThread.joinable())
+        {
+            streamThread.join();
+        }
+    }
+
+    //---------------------------------------------------------------------------
+    bool SignalData::isStreaming() const
+    {
+        return bStreaming;
+    }
+
+    //---------------------------------------------------------------------------
+    size_t SignalData::readStream(std::span<sAggregateData> samples)
+    {
+        size_t numRead = upStreamRing ? upStreamRing->pop(samples) : 0;
+        consumedSamples += numRead;
+        return numRead;
+    }
+
+    //---------------------------------------------------------------------------
+    size_t SignalData::readStream(
+        std::span<sAggregateData> samples,
+        std::chrono::milliseconds timeout)
+    {
+        size_t numRead =
+            upStreamRing ? upStreamRing->popWait(samples, timeout) : 0;
+        consumedSamples += numRead;
+        return numRead;
+    }
+
+    //---------------------------------------------------------------------------
+    size_t SignalData::readStream(
+        std::span<sAggregateData> samples,
+        std::chrono::milliseconds timeout,
+        uint64_t& firstTimestampNs)
+    {
+        uint64_t firstIndex = consumedSamples;
+        size_t numRead = readStream(samples, timeout);
+        if (numRead > 0)
+        {
+            firstTimestampNs = streamTimestampOf(firstIndex);
+        }
+        return numRead;
+    }
+
+    //---------------------------------------------------------------------------
+    uint64_t SignalData::streamTimestampOf(uint64_t sampleIndex)
+    {
+        // Marks are pushed before their samples, so the mark of the block
+        // holding sampleIndex is already in the ring
+        while (true)
+        {
+            if (!nextMark)
+            {
+                sStreamMark mark;
+                if (upMarkRing->pop(std::span(&mark, 1)) == 0)
+                {
+                    break;
+                }
+                nextMark = mark;
+            }
+            if (nextMark->firstSampleIndex > sampleIndex)
+            {
+                break;
+            }
+            // Overruns can leave marks with no samples between them
+            if (nextMark->firstSampleIndex > currentMark.firstSampleIndex)
+            {
+                samplePeriodNs =
+                    double(nextMark->timestampNs - currentMark.timestampNs) /
+                    double(nextMark->firstSampleIndex -
+                        currentMark.firstSampleIndex);
+            }
+            currentMark = *nextMark;
+            nextMark.reset();
+        }
+
+        // Interpolate within the block, from the next block when known
+        double periodNs = samplePeriodNs;
+        if (nextMark)
+        {
+            periodNs =
+                double(nextMark->timestampNs - currentMark.timestampNs) /
+                double(nextMark->firstSampleIndex -
+                    currentMark.firstSampleIndex);
+        }
+        uint64_t timestampNs = currentMark.timestampNs + uint64_t(
+            double(sampleIndex - currentMark.firstSampleIndex) * periodNs);
+
+        // Extrapolating past the last mark can overshoot, but a sample is
+        // never later than its read, nor earlier than the one before
+        timestampNs = std::min(timestampNs, Metrics::TscClock::nowNs());
+        timestampNs = std::max(timestampNs, lastStreamTimestampNs);
+        lastStreamTimestampNs = timestampNs;
+        return timestampNs;
+    }
+
+    //---------------------------------------------------------------------------
+    uint64_t SignalData::streamOverruns() const
+    {
+        return overruns;
+    }
+
+    //---------------------------------------------------------------------------
+    void SignalData::streamEntry(
+        size_t ringCapacity,
+        std::optional<unsigned> cpu,
+        std::promise<void> started)
+    {
+        try
+        {
+            if (cpu)
+            {
+                pinCurrentThread(*cpu);
+            }
+            upStreamRing =
+                std::make_unique<Concurrency::SpscRing<sAggregateData>>(
+                    ringCapacity);
+            // At least one mark per block the ring can hold
+            upMarkRing =
+                std::make_unique<Concurrency::SpscRing<sStreamMark>>(
+                    ringCapacity / STREAM_BLOCK_SIZE + 2);
+        }
+        catch (...)
+        {
+            started.set_exception(std::current_exception());
+            return;
+        }
+        started.set_value();
+
+        std::array<uint16_t, STREAM_BLOCK_SIZE> analogData;
+        std::array<uint16_t, STREAM_BLOCK_SIZE> digitalData;
+        std::array<sAggregateData, STREAM_BLOCK_SIZE> block;
+
+        uint64_t numPushed = 0;
+
+        // The ADC stays started for the whole stream
+        adc->start();
+        while (bStreaming.load(std::memory_order_relaxed))
+        {
+            // Failed reads are zeroed by the HALs, simulating no signal
+            uint64_t startNs = Metrics::TscClock::nowNs();
+            adc->readBlockStarted(analogData);
+            gpio->readBlock(digitalData);
+            uint64_t endNs = Metrics::TscClock::nowNs();
+            recordBlock(startNs, endNs, block.size());
+            for (size_t i = 0; i < STREAM_BLOCK_SIZE; ++i)
+            {
+                block[i].analog = analogData[i];
+                block[i].digital = digitalData[i];
+            }
+            // Readers of the latest value see every block, overrun or not
+            publishLatest(block.back(), endNs, block.size());
+
+            // The mark goes first, so the consumer always finds it, and only
+            // when some of the block will be pushed: a block lost whole must
+            // not take a slot, nor give the next block's index this start.
+            // A lost mark only makes the consumer interpolate further.
+            if (upStreamRing->freeSpace() > 0)
+            {
+                sStreamMark mark{numPushed, startNs};
+                upMarkRing->push(std::span(&mark, 1));
+            }
+
+            // The hardware does not wait for a slow consumer, so whatever
+            // does not fit is lost
+            size_t numBlockPushed = upStreamRing->push(block);
+            numPushed += numBlockPushed;
+            if (numBlockPushed < block.size())
+            {
+                overruns.fetch_add(
+                    block.size() - numBlockPushed, std::memory_order_relaxed);
+            }
+        }
+        adc->stop();
+
+        // Wake a blocked consumer, it can still drain what is left
+        upStreamRing->close();
+    }
+
+    //---------------------------------------------------------------------------
+    // Latest Value Implementation
+    //---------------------------------------------------------------------------
+    std::optional<SignalData::sLatestSample> SignalData::latest() const
+    {
+        sLatestSample snapshot = latestSample.load();
+        if (snapshot.numAcquired == 0)
+        {
+            return {};
+        }
+        return snapshot;
+    }
+
+    //---------------------------------------------------------------------------
+    uint64_t SignalData::latestVersion() const
+    {
+        return latestSample.version();
+    }
+
+    //---------------------------------------------------------------------------
+    void SignalData::publishLatest(
+        sAggregateData sample,
+        uint64_t timestampNs,
+        size_t numSamples) const
+    {
+        // Const acquisitions may run on several threads, and the streaming
+        // thread publishes too: two overlapping publishes would leave the
+        // sequence odd and readers spinning
+        std::lock_guard lock(publishMutex);
+        uint64_t numAcquired = acquiredSamples.fetch_add(
+            numSamples, std::memory_order_relaxed) + numSamples;
+        latestSample.publish({sample, timestampNs, numAcquired});
+    }
+
+    //---------------------------------------------------------------------------
+    // Timing Instrumentation Implementation
+    //---------------------------------------------------------------------------
+    void SignalData::recordBlock(
+        uint64_t startNs,
+        uint64_t endNs,
+        size_t numSamples) const
+    {
+        std::lock_guard lock(timingMutex);
+        if (lastBlockSamples > 0 && startNs >= lastBlockStartNs)
+        {
+            uint64_t intervalNs = startNs - lastBlockStartNs;
+            timing.blockInterval.record(intervalNs);
+            timing.sampleInterval.record(intervalNs / lastBlockSamples);
+        }
+        timing.readTime.record(endNs - startNs);
+        ++timing.numBlocks;
+        timing.numSamples += numSamples;
+        lastBlockStartNs = startNs;
+        lastBlockSamples = numSamples;
+    }
+
+    //---------------------------------------------------------------------------
+    SignalData::sAcquisitionTiming SignalData::timingSnapshot() const
+    {
+        std::lock_guard lock(timingMutex);
+        return timing;
+    }
+
+    //---------------------------------------------------------------------------
+    void SignalData::resetTiming()
+    {
+        std::lock_guard lock(timingMutex);
+        timing = {};
+        lastBlockSamples = 0;
+    }
+
+    //---------------------------------------------------------------------------
+    std::string SignalData::timingReport() const
+    {
+        sAcquisitionTiming snapshot = timingSnapshot();
+        std::ostringstream report;
+        report << std::fixed << std::setprecision(1);
+
+        auto printHistogram = [&report](
+            const char* sName,
+            const Metrics::LatencyHistogram& histogram)
+        {
+            report << "    " << std::left << std::setw(16) << sName
+                   << std::right
+                   << " mean " << histogram.mean()
+                   << " p50 " << histogram.percentile(50)
+                   << " p99 " << histogram.percentile(99)
+                   << " p99.9 " << histogram.percentile(99.9)
+                   << " max " << histogram.max()
+                   << " ns\n";
+        };
+
+        report << "SignalData acquisition timing ("
+               << snapshot.numBlocks
+               << " blocks, "
+               << snapshot.numSamples
+               << " samples, "
+               << (Metrics::TscClock::usesTsc() ? "TSC" : "steady_clock")
+               << ")\n";
+        printHistogram("sample interval", snapshot.sampleInterval);
+        printHistogram("block interval", snapshot.blockInterval);
+        printHistogram("driver read", snapshot.readTime);
+        return report.str();
     }
 
-} // SignalDataFacade
\ No newline at end of file
+} // SignalDataFacade
@@ -0,0 +1,701 @@
+// Copyright (c) 2025 Michael Dello
+//
+// This software is provided under the MIT License.
+// See LICENSE file for details.
+
+//-----------------------------------------------------------------------------
+//
+// GPIO Bit-plane Storage Implementation
+//
+//-----------------------------------------------------------------------------
+
+#include "facadepattern_bitplane.h"
+#include <algorithm>
+#include <bit>
+#include <numeric>
+#include <stdexcept>
+
+// SIMD kernels need GCC/Clang target attributes on an x86 CPU
+#if (defined(__GNUC__) || defined(__clang__)) && \
+    (defined(__x86_64__) || defined(__i386__))
+#define FACADEPATTERN_BITPLANE_X86_KERNELS 1
+#include <immintrin.h>
+#else
+#define FACADEPATTERN_BITPLANE_X86_KERNELS 0
+#endif
+
+namespace // anonymous
+{
+    using SignalDataFacade::eEdge;
+    using SignalDataFacade::eSimdLevel;
+
+    //--------------------------------------------------------------------------
+    // Constants
+    //--------------------------------------------------------------------------
+    constexpr size_t WORD_BITS = SignalDataFacade::GpioBitPlanes::BITS_PER_WORD;
+    constexpr size_t MAX_LINES = SignalDataFacade::GpioBitPlanes::MAX_LINES;
+
+    //--------------------------------------------------------------------------
+    // Local Functions
+    //--------------------------------------------------------------------------
+    // Bits [0, count) set, for count in [0, 64]
+    uint64_t lowBits(size_t count)
+    {
+        return count >= WORD_BITS ? ~uint64_t{0} : (uint64_t{1} << count) - 1;
+    }
+
+    //--------------------------------------------------------------------------
+    // Edges into the samples of word k of a plane. Sample 0 has no earlier
+    // sample, so it never holds an edge.
+    uint64_t edgeWord(const uint64_t* pPlane, size_t k, eEdge edge)
+    {
+        uint64_t current = pPlane[k];
+        uint64_t carry = k > 0 ? pPlane[k - 1] >> 63 : current & 1;
+        uint64_t previous = (current << 1) | carry;
+        switch (edge)
+        {
+            case eEdge::RISING:
+                return current & ~previous;
+            case eEdge::FALLING:
+                return ~current & previous;
+            case eEdge::ANY:
+                break;
+        }
+        return current ^ previous;
+    }
+
+    //--------------------------------------------------------------------------
+    // Set bits of samples whose words are given, for the masked lines
+    void transposeScalar(
+        const uint16_t* pWords,
+        size_t count,
+        uint16_t mask,
+        uint64_t* pBits)
+    {
+        for (size_t line = 0; line < MAX_LINES; ++line)
+        {
+            if (!(mask & (1u << line)))
+            {
+                continue;
+            }
+            uint64_t bits = 0;
+            for (size_t i = 0; i < count; ++i)
+            {
+                bits |= uint64_t((pWords[i] >> line) & 1) << i;
+            }
+            pBits[line] = bits;
+        }
+    }
+
+    //--------------------------------------------------------------------------
+    uint64_t popcountScalar(const uint64_t* pWords, size_t count)
+    {
+        uint64_t total = 0;
+        for (size_t i = 0; i < count; ++i)
+        {
+            total += std::popcount(pWords[i]);
+        }
+        return total;
+    }
+
+    //--------------------------------------------------------------------------
+    uint64_t countEdgesScalar(
+        const uint64_t* pPlane,
+        size_t first,
+        size_t count,
+        eEdge edge)
+    {
+        uint64_t total = 0;
+        for (size_t k = first; k < first + count; ++k)
+        {
+            total += std::popcount(edgeWord(pPlane, k, edge));
+        }
+        return total;
+    }
+
+#if FACADEPATTERN_BITPLANE_X86_KERNELS
+    //--------------------------------------------------------------------------
+    // SSE kernels: hardware popcnt, and movemask over 16 words at a time
+    //--------------------------------------------------------------------------
+    __attribute__((target("sse4.1,popcnt")))
+    void transposeSSE4(const uint16_t* pWords, uint16_t mask, uint64_t* pBits)
+    {
+        for (size_t line = 0; line < MAX_LINES; ++line)
+        {
+            if (!(mask & (1u << line)))
+            {
+                continue;
+            }
+            // Move the line's bit to the sign bit of each word, signed
+            // saturation keeps it as the sign bit of each byte
+            __m128i shift = _mm_cvtsi32_si128(int(15 - line));
+            uint64_t bits = 0;
+            for (size_t i = 0; i < WORD_BITS; i += 16)
+            {
+                __m128i low = _mm_sll_epi16(
+                    _mm_loadu_si128(
+                        reinterpret_cast<const __m128i*>(pWords + i)),
+                    shift);
+                __m128i high = _mm_sll_epi16(
+                    _mm_loadu_si128(
+                        reinterpret_cast<const __m128i*>(pWords + i + 8)),
+                    shift);
+                uint64_t packed = uint32_t(
+                    _mm_movemask_epi8(_mm_packs_epi16(low, high)));
+                bits |= packed << i;
+            }
+            pBits[line] = bits;
+        }
+    }
+
+    //--------------------------------------------------------------------------
+    __attribute__((target("sse4.1,popcnt")))
+    uint64_t popcountSSE4(const uint64_t* pWords, size_t count)
+    {
+        uint64_t total = 0;
+        for (size_t i = 0; i < count; ++i)
+        {
+            total += uint64_t(_mm_popcnt_u64(pWords[i]));
+        }
+        return total;
+    }
+
+    //--------------------------------------------------------------------------
+    __attribute__((target("sse4.1,popcnt")))
+    uint64_t countEdgesSSE4(
+        const uint64_t* pPlane,
+        size_t first,
+        size_t count,
+        eEdge edge)
+    {
+        uint64_t total = 0;
+        for (size_t k = first; k < first + count; ++k)
+        {
+            total += uint64_t(_mm_popcnt_u64(edgeWord(pPlane, k, edge)));
+        }
+        return total;
+    }
+
+    //--------------------------------------------------------------------------
+    // AVX2 kernels
+    //--------------------------------------------------------------------------
+    __attribute__((target("avx2")))
+    void transposeAVX2(const uint16_t* pWords, uint16_t mask, uint64_t* pBits)
+    {
+        __m256i words[4];
+        for (size_t i = 0; i < 4; ++i)
+        {
+            words[i] = _mm256_loadu_si256(
+                reinterpret_cast<const __m256i*>(pWords + 16 * i));
+        }
+        for (size_t line = 0; line < MAX_LINES; ++line)
+        {
+            if (!(mask & (1u << line)))
+            {
+                continue;
+            }
+            __m128i shift = _mm_cvtsi32_si128(int(15 - line));
+            uint64_t bits = 0;
+            for (size_t i = 0; i < 4; i += 2)
+            {
+                // packs works within 128-bit lanes, the permute restores
+                // sample order
+                __m256i packed = _mm256_permute4x64_epi64(
+                    _mm256_packs_epi16(
+                        _mm256_sll_epi16(words[i], shift),
+                        _mm256_sll_epi16(words[i + 1], shift)),
+                    0xD8);
+                bits |= uint64_t(uint32_t(_mm256_movemask_epi8(packed)))
+                    << (16 * i);
+            }
+            pBits[line] = bits;
+        }
+    }
+
+    //--------------------------------------------------------------------------
+    // Per-byte popcounts by nibble lookup, summed into 64-bit lanes
+    __attribute__((target("avx2")))
+    __m256i popcountBytesAVX2(__m256i value)
+    {
+        const __m256i lookup = _mm256_setr_epi8(
+            0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4,
+            0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4);
+        const __m256i lowNibbles = _mm256_set1_epi8(0x0F);
+        __m256i low = _mm256_and_si256(value, lowNibbles);
+        __m256i high =
+            _mm256_and_si256(_mm256_srli_epi16(value, 4), lowNibbles);
+        __m256i counts = _mm256_add_epi8(
+            _mm256_shuffle_epi8(lookup, low),
+            _mm256_shuffle_epi8(lookup, high));
+        return _mm256_sad_epu8(counts, _mm256_setzero_si256());
+    }
+
+    //--------------------------------------------------------------------------
+    __attribute__((target("avx2")))
+    uint64_t horizontalSumAVX2(__m256i lanes)
+    {
+        alignas(32) uint64_t sums[4];
+        _mm256_store_si256(reinterpret_cast<__m256i*>(sums), lanes);
+        return sums[0] + sums[1] + sums[2] + sums[3];
+    }
+
+    //--------------------------------------------------------------------------
+    __attribute__((target("avx2")))
+    uint64_t popcountAVX2(const uint64_t* pWords, size_t count)
+    {
+        __m256i total = _mm256_setzero_si256();
+        size_t i = 0;
+        for (; i + 4 <= count; i += 4)
+        {
+            total = _mm256_add_epi64(
+                total,
+                popcountBytesAVX2(_mm256_loadu_si256(
+                    reinterpret_cast<const __m256i*>(pWords + i))));
+        }
+        return horizontalSumAVX2(total) + popcountScalar(pWords + i, count - i);
+    }
+
+    //--------------------------------------------------------------------------
+    __attribute__((target("avx2")))
+    uint64_t countEdgesAVX2(
+        const uint64_t* pPlane,
+        size_t first,
+        size_t count,
+        eEdge edge)
+    {
+        size_t k = first;
+        uint64_t scalarTotal = 0;
+        // Word 0 has no word before it to load
+        if (k == 0 && count > 0)
+        {
+            scalarTotal += countEdgesScalar(pPlane, 0, 1, edge);
+            ++k;
+        }
+
+        __m256i total = _mm256_setzero_si256();
+        size_t end = first + count;
+        for (; k + 4 <= end; k += 4)
+        {
+            __m256i current = _mm256_loadu_si256(
+                reinterpret_cast<const __m256i*>(pPlane + k));
+            __m256i before = _mm256_loadu_si256(
+                reinterpret_cast<const __m256i*>(pPlane + k - 1));
+            __m256i previous = _mm256_or_si256(
+                _mm256_slli_epi64(current, 1),
+                _mm256_srli_epi64(before, 63));
+            __m256i edges;
+            switch (edge)
+            {
+                case eEdge::RISING:
+                    edges = _mm256_andnot_si256(previous, current);
+                    break;
+                case eEdge::FALLING:
+                    edges = _mm256_andnot_si256(current, previous);
+                    break;
+                default:
+                    edges = _mm256_xor_si256(current, previous);
+                    break;
+            }
+            total = _mm256_add_epi64(total, popcountBytesAVX2(edges));
+        }
+        return scalarTotal + horizontalSumAVX2(total) +
+            countEdgesScalar(pPlane, k, end - k, edge);
+    }
+#endif
+
+    //--------------------------------------------------------------------------
+    // Dispatch
+    //--------------------------------------------------------------------------
+    uint64_t popcountWords(
+        const uint64_t* pWords,
+        size_t count,
+        eSimdLevel level)
+    {
+        switch (level)
+        {
+#if FACADEPATTERN_BITPLANE_X86_KERNELS
+            case eSimdLevel::AVX2:
+                return popcountAVX2(pWords, count);
+            case eSimdLevel::SSE4:
+                return popcountSSE4(pWords, count);
+#endif
+            default:
+                return popcountScalar(pWords, count);
+        }
+    }
+
+    //--------------------------------------------------------------------------
+    uint64_t countEdgeWords(
+        const uint64_t* pPlane,
+        size_t first,
+        size_t count,
+        eEdge edge,
+        eSimdLevel level)
+    {
+        switch (level)
+        {
+#if FACADEPATTERN_BITPLANE_X86_KERNELS
+            case eSimdLevel::AVX2:
+                return countEdgesAVX2(pPlane, first, count, edge);
+            case eSimdLevel::SSE4:
+                return countEdgesSSE4(pPlane, first, count, edge);
+#endif
+            default:
+                return countEdgesScalar(pPlane, first, count, edge);
+        }
+    }
+
+    //--------------------------------------------------------------------------
+    // Popcount of bits [begin, end) of a word stream, whole words in bulk
+    template <typename WordAt, typename Bulk>
+    uint64_t countBits(size_t begin, size_t end, WordAt wordAt, Bulk bulk)
+    {
+        if (begin >= end)
+        {
+            return 0;
+        }
+        size_t firstWord = begin / WORD_BITS;
+        size_t lastWord = (end - 1) / WORD_BITS;
+        uint64_t headMask = ~lowBits(begin % WORD_BITS);
+        uint64_t tailMask = lowBits((end - 1) % WORD_BITS + 1);
+        if (firstWord == lastWord)
+        {
+            return std::popcount(wordAt(firstWord) & headMask & tailMask);
+        }
+        return std::popcount(wordAt(firstWord) & headMask) +
+            bulk(firstWord + 1, lastWord - firstWord - 1) +
+            std::popcount(wordAt(lastWord) & tailMask);
+    }
+
+    //--------------------------------------------------------------------------
+    // Set bits [first, first + count) of a plane
+    void setBits(std::vector<uint64_t>& plane, uint64_t first, uint64_t count)
+    {
+        while (count > 0)
+        {
+            size_t offset = first % WORD_BITS;
+            size_t numBits =
+                size_t(std::min<uint64_t>(count, WORD_BITS - offset));
+            plane[first / WORD_BITS] |= lowBits(numBits) << offset;
+            first += numBits;
+            count -= numBits;
+        }
+    }
+
+} // namespace anonymous
+
+namespace SignalDataFacade
+{
+    //--------------------------------------------------------------------------
+    const char* toString(eEdge edge)
+    {
+        switch (edge)
+        {
+            case eEdge::RISING:
+                return "RISING";
+            case eEdge::FALLING:
+                return "FALLING";
+            case eEdge::ANY:
+                return "ANY";
+        }
+        return "UNKNOWN";
+    }
+
+    //--------------------------------------------------------------------------
+    GpioBitPlanes::GpioBitPlanes(uint16_t lineMask, eSimdLevel level)
+    : mask{lineMask},
+      kernelLevel{std::min(level, detectedSimdLevel())},
+      numSamples{0}
+    {
+        // No Body
+    }
+
+    //--------------------------------------------------------------------------
+    void GpioBitPlanes::append(std::span<const uint16_t> words)
+    {
+        size_t total = numSamples + words.size();
+        reserve(total);
+        size_t numWords = (total + WORD_BITS - 1) / WORD_BITS;
+        for (size_t line = 0; line < MAX_LINES; ++line)
+        {
+            if (hasLine(line))
+            {
+                planes[line].resize(numWords, 0);
+            }
+        }
+
+        // Bit by bit up to a word boundary, then a plane word per 64 samples
+        size_t done = 0;
+        std::array<uint64_t, MAX_LINES> bits{};
+        while (done < words.size())
+        {
+            size_t offset = (numSamples + done) % WORD_BITS;
+            size_t count = std::min(WORD_BITS - offset, words.size() - done);
+            const uint16_t* pWords = words.data() + done;
+            if (offset == 0 && count == WORD_BITS)
+            {
+                switch (kernelLevel)
+                {
+#if FACADEPATTERN_BITPLANE_X86_KERNELS
+                    case eSimdLevel::AVX2:
+                        transposeAVX2(pWords, mask, bits.data());
+                        break;
+                    case eSimdLevel::SSE4:
+                        transposeSSE4(pWords, mask, bits.data());
+                        break;
+#endif
+                    default:
+                        transposeScalar(pWords, count, mask, bits.data());
+                        break;
+                }
+            }
+            else
+            {
+                transposeScalar(pWords, count, mask, bits.data());
+            }
+
+            size_t wordIndex = (numSamples + done) / WORD_BITS;
+            for (size_t line = 0; line < MAX_LINES; ++line)
+            {
+                if (hasLine(line))
+                {
+                    planes[line][wordIndex] |= bits[line] << offset;
+                }
+            }
+            done += count;
+        }
+        numSamples = total;
+    }
+
+    //--------------------------------------------------------------------------
+    void GpioBitPlanes::reserve(size_t count)
+    {
+        for (size_t line = 0; line < MAX_LINES; ++line)
+        {
+            if (hasLine(line))
+            {
+                planes[line].reserve((count + WORD_BITS - 1) / WORD_BITS);
+            }
+        }
+    }
+
+    //--------------------------------------------------------------------------
+    void GpioBitPlanes::clear()
+    {
+        for (auto& plane : planes)
+        {
+            plane.clear();
+        }
+        numSamples = 0;
+    }
+
+    //--------------------------------------------------------------------------
+    bool GpioBitPlanes::hasLine(size_t line) const
+    {
+        return line < MAX_LINES && (mask & (1u << line));
+    }
+
+    //--------------------------------------------------------------------------
+    size_t GpioBitPlanes::memoryBytes() const
+    {
+        return std::accumulate(
+            planes.begin(),
+            planes.end(),
+            size_t{0},
+            [](size_t bytes, const std::vector<uint64_t>& plane)
+            {
+                return bytes + plane.capacity() * sizeof(uint64_t);
+            });
+    }
+
+    //--------------------------------------------------------------------------
+    std::span<const uint64_t> GpioBitPlanes::plane(size_t line) const
+    {
+        return planeOf(line);
+    }
+
+    //--------------------------------------------------------------------------
+    bool GpioBitPlanes::bit(size_t line, size_t index) const
+    {
+        const std::vector<uint64_t>& bits = planeOf(line);
+        if (index >= numSamples)
+        {
+            throw std::out_of_range("GPIO sample index out of range");
+        }
+        return (bits[index / WORD_BITS] >> (index % WORD_BITS)) & 1;
+    }
+
+    //--------------------------------------------------------------------------
+    void GpioBitPlanes::unpack(size_t first, std::span<uint16_t> words) const
+    {
+        if (first > numSamples || words.size() > numSamples - first)
+        {
+            throw std::out_of_range("GPIO sample range out of range");
+        }
+        std::fill(words.begin(), words.end(), uint16_t{0});
+        for (size_t line = 0; line < MAX_LINES; ++line)
+        {
+            if (!hasLine(line))
+            {
+                continue;
+            }
+            const uint64_t* pPlane = planes[line].data();
+            for (size_t i = 0; i < words.size(); ++i)
+            {
+                size_t index = first + i;
+                uint16_t value =
+                    uint16_t((pPlane[index / WORD_BITS] >> (index % WORD_BITS))
+                        & 1);
+                words[i] |= uint16_t(value << line);
+            }
+        }
+    }
+
+    //--------------------------------------------------------------------------
+    std::vector<uint64_t> GpioBitPlanes::edges(size_t line, eEdge edge) const
+    {
+        const std::vector<uint64_t>& bits = planeOf(line);
+        std::vector<uint64_t> result(bits.size());
+        for (size_t k = 0; k < bits.size(); ++k)
+        {
+            result[k] = edgeWord(bits.data(), k, edge);
+        }
+        // A falling edge into the zero padding is not a sample
+        if (!result.empty())
+        {
+            result.back() &= lowBits((numSamples - 1) % WORD_BITS + 1);
+        }
+        return result;
+    }
+
+    //--------------------------------------------------------------------------
+    uint64_t GpioBitPlanes::countHigh(
+        size_t line,
+        size_t first,
+        size_t count) const
+    {
+        const uint64_t* pPlane = planeOf(line).data();
+        count = clippedCount(first, count);
+        return countBits(
+            first,
+            first + count,
+            [pPlane](size_t k) { return pPlane[k]; },
+            [pPlane, this](size_t k, size_t n)
+            {
+                return popcountWords(pPlane + k, n, kernelLevel);
+            });
+    }
+
+    //--------------------------------------------------------------------------
+    double GpioBitPlanes::dutyCycle(
+        size_t line,
+        size_t first,
+        size_t count) const
+    {
+        count = clippedCount(first, count);
+        return count == 0 ?
+            0.0 : double(countHigh(line, first, count)) / double(count);
+    }
+
+    //--------------------------------------------------------------------------
+    uint64_t GpioBitPlanes::countEdges(
+        size_t line,
+        eEdge edge,
+        size_t first,
+        size_t count) const
+    {
+        const uint64_t* pPlane = planeOf(line).data();
+        count = clippedCount(first, count);
+        if (count < 2)
+        {
+            return 0;
+        }
+        // Edges into the second through the last sample of the range
+        return countBits(
+            first + 1,
+            first + count,
+            [pPlane, edge](size_t k) { return edgeWord(pPlane, k, edge); },
+            [pPlane, edge, this](size_t k, size_t n)
+            {
+                return countEdgeWords(pPlane, k, n, edge, kernelLevel);
+            });
+    }
+
+    //--------------------------------------------------------------------------
+    uint64_t GpioBitPlanes::countToggles(
+        size_t line,
+        size_t first,
+        size_t count) const
+    {
+        return countEdges(line, eEdge::ANY, first, count);
+    }
+
+    //--------------------------------------------------------------------------
+    sLineRuns GpioBitPlanes::encodeRuns(size_t line) const
+    {
+        const std::vector<uint64_t>& bits = planeOf(line);
+        sLineRuns runs;
+        if (numSamples == 0)
+        {
+            return runs;
+        }
+        runs.bInitialLevel = bits[0] & 1;
+
+        // Jump from edge to edge, a stable word costs one test
+        uint64_t runStart = 0;
+        std::vector<uint64_t> edgeBits = edges(line, eEdge::ANY);
+        for (size_t k = 0; k < edgeBits.size(); ++k)
+        {
+            for (uint64_t word = edgeBits[k]; word != 0; word &= word - 1)
+            {
+                uint64_t index = k * WORD_BITS + std::countr_zero(word);
+                runs.lengths.push_back(index - runStart);
+                runStart = index;
+            }
+        }
+        runs.lengths.push_back(numSamples - runStart);
+        return runs;
+    }
+
+    //--------------------------------------------------------------------------
+    std::vector<uint64_t> GpioBitPlanes::decodeRuns(const sLineRuns& runs)
+    {
+        uint64_t total = std::accumulate(
+            runs.lengths.begin(), runs.lengths.end(), uint64_t{0});
+        std::vector<uint64_t> plane((total + WORD_BITS - 1) / WORD_BITS, 0);
+
+        uint64_t position = 0;
+        bool bLevel = runs.bInitialLevel;
+        for (uint64_t length : runs.lengths)
+        {
+            if (bLevel)
+            {
+                setBits(plane, position, length);
+            }
+            position += length;
+            bLevel = !bLevel;
+        }
+        return plane;
+    }
+
+    //--------------------------------------------------------------------------
+    const std::vector<uint64_t>& GpioBitPlanes::planeOf(size_t line) const
+    {
+        if (!hasLine(line))
+        {
+            throw std::out_of_range("GPIO line not stored");
+        }
+        return planes[line];
+    }
+
+    //--------------------------------------------------------------------------
+    size_t GpioBitPlanes::clippedCount(size_t first, size_t count) const
+    {
+        if (first > numSamples)
+        {
+            throw std::out_of_range("GPIO sample range out of range");
+        }
+        return std::min(count, numSamples - first);
+    }
+
+} // namespace SignalDataFacade
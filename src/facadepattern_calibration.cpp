@@ -0,0 +1,476 @@
+// Copyright (c) 2025 Michael Dello
+//
+// This software is provided under the MIT License.
+// See LICENSE file for details.
+
+//-----------------------------------------------------------------------------
+//
+// Signal Data Calibration Implementation
+//
+//-----------------------------------------------------------------------------
+
+#include "facadepattern_calibration.h"
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+#include <utility>
+
+// SIMD kernels need GCC/Clang target attributes on an x86 CPU
+#if (defined(__GNUC__) || defined(__clang__)) && \
+    (defined(__x86_64__) || defined(__i386__))
+#define FACADEPATTERN_CALIBRATION_X86_KERNELS 1
+#include <immintrin.h>
+#else
+#define FACADEPATTERN_CALIBRATION_X86_KERNELS 0
+#endif
+
+namespace // anonymous
+{
+    using SignalDataFacade::eSimdLevel;
+
+    //--------------------------------------------------------------------------
+    // Constants
+    //--------------------------------------------------------------------------
+    // Samples of one channel converted at a time by convertFrames()
+    constexpr size_t FRAME_COLUMN_SAMPLES = 1024;
+
+    //--------------------------------------------------------------------------
+    // Local Functions
+    //--------------------------------------------------------------------------
+    int32_t toFixed(double value, double scale)
+    {
+        double scaled = std::round(value * scale);
+        scaled = std::clamp(
+            scaled,
+            double(std::numeric_limits<int32_t>::min()),
+            double(std::numeric_limits<int32_t>::max()));
+        return int32_t(scaled);
+    }
+
+    //--------------------------------------------------------------------------
+    // Scalar Kernels
+    //--------------------------------------------------------------------------
+    void linearScalar(
+        const uint16_t* pCodes,
+        size_t count,
+        float gain,
+        float offset,
+        float* pOut)
+    {
+        for (size_t i = 0; i < count; ++i)
+        {
+            pOut[i] = float(pCodes[i]) * gain + offset;
+        }
+    }
+
+    //--------------------------------------------------------------------------
+    template <typename T>
+    void lookupScalar(
+        const uint16_t* pCodes,
+        size_t count,
+        const T* pTable,
+        T* pOut)
+    {
+        for (size_t i = 0; i < count; ++i)
+        {
+            pOut[i] = pTable[pCodes[i]];
+        }
+    }
+
+#if FACADEPATTERN_CALIBRATION_X86_KERNELS
+    //--------------------------------------------------------------------------
+    // SSE Kernels
+    //--------------------------------------------------------------------------
+    __attribute__((target("sse4.1")))
+    size_t linearSSE4(
+        const uint16_t* pCodes,
+        size_t count,
+        float gain,
+        float offset,
+        float* pOut)
+    {
+        __m128 vGain = _mm_set1_ps(gain);
+        __m128 vOffset = _mm_set1_ps(offset);
+        size_t i = 0;
+        for (; i + 8 <= count; i += 8)
+        {
+            __m128i codes =
+                _mm_loadu_si128(reinterpret_cast<const __m128i*>(pCodes + i));
+            __m128 low = _mm_cvtepi32_ps(_mm_cvtepu16_epi32(codes));
+            __m128 high =
+                _mm_cvtepi32_ps(_mm_cvtepu16_epi32(_mm_srli_si128(codes, 8)));
+            _mm_storeu_ps(
+                pOut + i, _mm_add_ps(_mm_mul_ps(low, vGain), vOffset));
+            _mm_storeu_ps(
+                pOut + i + 4, _mm_add_ps(_mm_mul_ps(high, vGain), vOffset));
+        }
+        return i;
+    }
+
+    //--------------------------------------------------------------------------
+    // AVX2 Kernels
+    //--------------------------------------------------------------------------
+    __attribute__((target("avx2")))
+    size_t linearAVX2(
+        const uint16_t* pCodes,
+        size_t count,
+        float gain,
+        float offset,
+        float* pOut)
+    {
+        __m256 vGain = _mm256_set1_ps(gain);
+        __m256 vOffset = _mm256_set1_ps(offset);
+        size_t i = 0;
+        for (; i + 16 <= count; i += 16)
+        {
+            __m256i codes = _mm256_loadu_si256(
+                reinterpret_cast<const __m256i*>(pCodes + i));
+            __m256 low = _mm256_cvtepi32_ps(
+                _mm256_cvtepu16_epi32(_mm256_castsi256_si128(codes)));
+            __m256 high = _mm256_cvtepi32_ps(
+                _mm256_cvtepu16_epi32(_mm256_extracti128_si256(codes, 1)));
+            _mm256_storeu_ps(
+                pOut + i, _mm256_add_ps(_mm256_mul_ps(low, vGain), vOffset));
+            _mm256_storeu_ps(
+                pOut + i + 8,
+                _mm256_add_ps(_mm256_mul_ps(high, vGain), vOffset));
+        }
+        return i;
+    }
+
+    //--------------------------------------------------------------------------
+    // Gather 8 entries per instruction, codes widened to 32-bit indices
+    __attribute__((target("avx2")))
+    size_t lookupAVX2(
+        const uint16_t* pCodes,
+        size_t count,
+        const float* pTable,
+        float* pOut)
+    {
+        size_t i = 0;
+        for (; i + 8 <= count; i += 8)
+        {
+            __m256i indices = _mm256_cvtepu16_epi32(
+                _mm_loadu_si128(reinterpret_cast<const __m128i*>(pCodes + i)));
+            _mm256_storeu_ps(pOut + i, _mm256_i32gather_ps(pTable, indices, 4));
+        }
+        return i;
+    }
+
+    //--------------------------------------------------------------------------
+    __attribute__((target("avx2")))
+    size_t lookupAVX2(
+        const uint16_t* pCodes,
+        size_t count,
+        const int32_t* pTable,
+        int32_t* pOut)
+    {
+        const int* pEntries = reinterpret_cast<const int*>(pTable);
+        size_t i = 0;
+        for (; i + 8 <= count; i += 8)
+        {
+            __m256i indices = _mm256_cvtepu16_epi32(
+                _mm_loadu_si128(reinterpret_cast<const __m128i*>(pCodes + i)));
+            _mm256_storeu_si256(
+                reinterpret_cast<__m256i*>(pOut + i),
+                _mm256_i32gather_epi32(pEntries, indices, 4));
+        }
+        return i;
+    }
+#endif
+
+    //--------------------------------------------------------------------------
+    // Kernel Dispatch
+    //--------------------------------------------------------------------------
+    void linear(
+        std::span<const uint16_t> codes,
+        float gain,
+        float offset,
+        float* pOut,
+        eSimdLevel level)
+    {
+        size_t done = 0;
+        switch (level)
+        {
+#if FACADEPATTERN_CALIBRATION_X86_KERNELS
+            case eSimdLevel::AVX2:
+                done = linearAVX2(
+                    codes.data(), codes.size(), gain, offset, pOut);
+                break;
+            case eSimdLevel::SSE4:
+                done = linearSSE4(
+                    codes.data(), codes.size(), gain, offset, pOut);
+                break;
+#endif
+            default:
+                break;
+        }
+        linearScalar(
+            codes.data() + done,
+            codes.size() - done,
+            gain,
+            offset,
+            pOut + done);
+    }
+
+    //--------------------------------------------------------------------------
+    // SSE has no gather, a table lookup is scalar below AVX2
+    template <typename T>
+    void lookup(
+        std::span<const uint16_t> codes,
+        const T* pTable,
+        T* pOut,
+        eSimdLevel level)
+    {
+        size_t done = 0;
+#if FACADEPATTERN_CALIBRATION_X86_KERNELS
+        if (level == eSimdLevel::AVX2)
+        {
+            done = lookupAVX2(codes.data(), codes.size(), pTable, pOut);
+        }
+#else
+        (void)level;
+#endif
+        lookupScalar(
+            codes.data() + done, codes.size() - done, pTable, pOut + done);
+    }
+
+} // namespace anonymous
+
+namespace SignalDataFacade
+{
+    //--------------------------------------------------------------------------
+    sCalibration_t calibrationOf(const sCaptureChannel_t& channel)
+    {
+        sCalibration_t calibration;
+        calibration.coefficients = {channel.offset, channel.gain};
+        return calibration;
+    }
+
+    //--------------------------------------------------------------------------
+    // Calibration Table Implementation
+    //--------------------------------------------------------------------------
+    CalibrationTable::CalibrationTable(
+        const sCalibration_t& calibration,
+        eSimdLevel level)
+    : kernelLevel{std::min(level, detectedSimdLevel())},
+      bLinear{false},
+      gain{0.0f},
+      offset{0.0f},
+      scale{calibration.fixedScale},
+      values(NUM_CODES),
+      fixedValues(NUM_CODES)
+    {
+        const auto& coefficients = calibration.coefficients;
+        const auto& table = calibration.table;
+        if ((table.empty() && coefficients.empty()) ||
+            (!table.empty() && table.size() != NUM_CODES) ||
+            !(scale > 0.0) || !std::isfinite(scale))
+        {
+            throw std::invalid_argument("Invalid calibration");
+        }
+
+        bLinear = table.empty() && coefficients.size() <= 2;
+        if (bLinear)
+        {
+            offset = float(coefficients[0]);
+            gain = coefficients.size() > 1 ? float(coefficients[1]) : 0.0f;
+        }
+
+        for (size_t code = 0; code < NUM_CODES; ++code)
+        {
+            double value = 0.0;
+            if (!table.empty())
+            {
+                value = table[code];
+            }
+            else
+            {
+                // Horner's rule, highest order first
+                for (auto it = coefficients.rbegin();
+                     it != coefficients.rend();
+                     ++it)
+                {
+                    value = value * double(code) + *it;
+                }
+            }
+            if (!std::isfinite(value) ||
+                std::abs(value) > std::numeric_limits<float>::max())
+            {
+                throw std::invalid_argument("Calibration value out of range");
+            }
+            values[code] = float(value);
+            fixedValues[code] = toFixed(value, scale);
+        }
+    }
+
+    //--------------------------------------------------------------------------
+    void CalibrationTable::convert(
+        std::span<const uint16_t> codes,
+        std::span<float> outputs) const
+    {
+        if (outputs.size() < codes.size())
+        {
+            throw std::invalid_argument("Too few calibration outputs");
+        }
+        if (bLinear)
+        {
+            linear(codes, gain, offset, outputs.data(), kernelLevel);
+        }
+        else
+        {
+            lookup(codes, values.data(), outputs.data(), kernelLevel);
+        }
+    }
+
+    //--------------------------------------------------------------------------
+    void CalibrationTable::convert(
+        std::span<const uint16_t> codes,
+        std::span<int32_t> outputs) const
+    {
+        if (outputs.size() < codes.size())
+        {
+            throw std::invalid_argument("Too few calibration outputs");
+        }
+        // Computed fixed point would round differently than the table
+        lookup(codes, fixedValues.data(), outputs.data(), kernelLevel);
+    }
+
+    //--------------------------------------------------------------------------
+    // Channel Calibration Implementation
+    //--------------------------------------------------------------------------
+    ChannelCalibration::ChannelCalibration(
+        size_t numChannels,
+        eSimdLevel level)
+    : channelCount{numChannels},
+      kernelLevel{std::min(level, detectedSimdLevel())},
+      tables{std::make_unique<
+          std::atomic<std::shared_ptr<const CalibrationTable>>[]>(
+              numChannels)},
+      swaps{0}
+    {
+        // Channels share the identity until loaded
+        auto spIdentity = std::make_shared<const CalibrationTable>(
+            sCalibration_t{}, kernelLevel);
+        for (size_t channel = 0; channel < channelCount; ++channel)
+        {
+            tables[channel].store(spIdentity);
+        }
+    }
+
+    //--------------------------------------------------------------------------
+    void ChannelCalibration::load(
+        size_t channel,
+        const sCalibration_t& calibration)
+    {
+        // Check first, building a table takes a while
+        slot(channel);
+        setTable(
+            channel,
+            std::make_shared<const CalibrationTable>(
+                calibration, kernelLevel));
+    }
+
+    //--------------------------------------------------------------------------
+    void ChannelCalibration::setTable(
+        size_t channel,
+        std::shared_ptr<const CalibrationTable> spTable)
+    {
+        if (!spTable)
+        {
+            throw std::invalid_argument("Missing calibration table");
+        }
+        // The previous table is freed by whoever holds it last
+        slot(channel).store(std::move(spTable));
+        swaps.fetch_add(1);
+    }
+
+    //--------------------------------------------------------------------------
+    std::shared_ptr<const CalibrationTable> ChannelCalibration::table(
+        size_t channel) const
+    {
+        return slot(channel).load();
+    }
+
+    //--------------------------------------------------------------------------
+    void ChannelCalibration::convert(
+        size_t channel,
+        std::span<const uint16_t> codes,
+        std::span<float> outputs) const
+    {
+        table(channel)->convert(codes, outputs);
+    }
+
+    //--------------------------------------------------------------------------
+    void ChannelCalibration::convert(
+        size_t channel,
+        std::span<const uint16_t> codes,
+        std::span<int32_t> outputs) const
+    {
+        table(channel)->convert(codes, outputs);
+    }
+
+    //--------------------------------------------------------------------------
+    void ChannelCalibration::convertFrames(
+        std::span<const uint16_t> frames,
+        std::span<float> outputs) const
+    {
+        if (channelCount == 0 || frames.size() % channelCount != 0 ||
+            outputs.size() < frames.size())
+        {
+            throw std::invalid_argument("Invalid calibration frames");
+        }
+
+        // One snapshot per channel for the whole batch
+        std::vector<std::shared_ptr<const CalibrationTable>> snapshot;
+        snapshot.reserve(channelCount);
+        for (size_t channel = 0; channel < channelCount; ++channel)
+        {
+            snapshot.push_back(table(channel));
+        }
+
+        // Each channel of a run of frames is gathered into a column, small
+        // enough to stay in L1, and converted by the same kernels as
+        // convert(), then scattered back between the other channels
+        size_t numFrames = frames.size() / channelCount;
+        std::array<uint16_t, FRAME_COLUMN_SAMPLES> column;
+        std::array<float, FRAME_COLUMN_SAMPLES> converted;
+        for (size_t first = 0; first < numFrames;
+             first += FRAME_COLUMN_SAMPLES)
+        {
+            size_t count = std::min(FRAME_COLUMN_SAMPLES, numFrames - first);
+            for (size_t channel = 0; channel < channelCount; ++channel)
+            {
+                const uint16_t* pCodes =
+                    frames.data() + first * channelCount + channel;
+                for (size_t i = 0; i < count; ++i)
+                {
+                    column[i] = pCodes[i * channelCount];
+                }
+                snapshot[channel]->convert(
+                    std::span(column).first(count),
+                    converted);
+                float* pOutputs =
+                    outputs.data() + first * channelCount + channel;
+                for (size_t i = 0; i < count; ++i)
+                {
+                    pOutputs[i * channelCount] = converted[i];
+                }
+            }
+        }
+    }
+
+    //--------------------------------------------------------------------------
+    std::atomic<std::shared_ptr<const CalibrationTable>>&
+    ChannelCalibration::slot(size_t channel) const
+    {
+        if (channel >= channelCount)
+        {
+            throw std::out_of_range("No such calibration channel");
+        }
+        return tables[channel];
+    }
+
+} // namespace SignalDataFacade
@@ -0,0 +1,1015 @@
+// Copyright (c) 2025 Michael Dello
+//
+// This software is provided under the MIT License.
+// See LICENSE file for details.
+
+//-----------------------------------------------------------------------------
+//
+// Signal Data Capture File Implementation
+//
+//-----------------------------------------------------------------------------
+
+#include "facadepattern_capture.h"
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <algorithm>
+#include <array>
+#include <cerrno>
+#include <cmath>
+#include <cstddef>
+#include <cstring>
+#include <stdexcept>
+
+namespace // anonymous
+{
+    using namespace SignalDataFacade;
+
+    //--------------------------------------------------------------------------
+    // Local Functions
+    //--------------------------------------------------------------------------
+    size_t alignUp(size_t bytes)
+    {
+        return (bytes + CAPTURE_COLUMN_ALIGNMENT - 1) /
+            CAPTURE_COLUMN_ALIGNMENT * CAPTURE_COLUMN_ALIGNMENT;
+    }
+
+    //--------------------------------------------------------------------------
+    // Version 1 files hold raw columns, later ones codec frames
+    bool framed(const sCaptureFileHeader& header)
+    {
+        return header.version != CAPTURE_VERSION_RAW;
+    }
+
+    //--------------------------------------------------------------------------
+    // Room for the raw samples or their codec frame
+    size_t columnBytes(const sCaptureFileHeader& header)
+    {
+        return framed(header) ?
+            alignUp(CAPTURE_FRAME_OFFSET + maxFrameBytes(header.chunkSamples)) :
+            alignUp(header.chunkSamples * sizeof(uint16_t));
+    }
+
+    //--------------------------------------------------------------------------
+    uint64_t chunkBytes(const sCaptureFileHeader& header)
+    {
+        return sizeof(sCaptureChunkHeader) +
+            header.numChannels * columnBytes(header);
+    }
+
+    //--------------------------------------------------------------------------
+    size_t chunkOffset(const sCaptureFileHeader& header, uint64_t chunkIndex)
+    {
+        return CAPTURE_HEADER_BYTES + chunkIndex * header.chunkBytes;
+    }
+
+    //--------------------------------------------------------------------------
+    size_t columnOffset(const sCaptureFileHeader& header, size_t channelIndex)
+    {
+        return sizeof(sCaptureChunkHeader) +
+            channelIndex * columnBytes(header);
+    }
+
+    //--------------------------------------------------------------------------
+    // Offset of sampleIndex from a chunk start, rounded to the nanosecond
+    uint64_t sampleOffsetNs(double sampleRateHz, uint64_t sampleIndex)
+    {
+        return static_cast<uint64_t>(
+            std::llround(double(sampleIndex) * 1e9 / sampleRateHz));
+    }
+
+    //--------------------------------------------------------------------------
+    [[noreturn]] void throwErrno(const std::string& sWhat)
+    {
+        throw std::runtime_error(sWhat + ": " + std::strerror(errno));
+    }
+
+    //--------------------------------------------------------------------------
+    void writeAll(int fd, const void* pData, size_t bytes, size_t offset)
+    {
+        const std::byte* pBytes = static_cast<const std::byte*>(pData);
+        while (bytes > 0)
+        {
+            ssize_t written = ::pwrite(fd, pBytes, bytes, off_t(offset));
+            if (written < 0)
+            {
+                if (errno == EINTR)
+                {
+                    continue;
+                }
+                throwErrno("Capture file write failed");
+            }
+            pBytes += written;
+            bytes -= size_t(written);
+            offset += size_t(written);
+        }
+    }
+
+    //--------------------------------------------------------------------------
+    void readAll(int fd, void* pData, size_t bytes, size_t offset)
+    {
+        std::byte* pBytes = static_cast<std::byte*>(pData);
+        while (bytes > 0)
+        {
+            ssize_t numRead = ::pread(fd, pBytes, bytes, off_t(offset));
+            if (numRead < 0 && errno == EINTR)
+            {
+                continue;
+            }
+            if (numRead <= 0)
+            {
+                throw std::runtime_error("Capture file is truncated");
+            }
+            pBytes += numRead;
+            bytes -= size_t(numRead);
+            offset += size_t(numRead);
+        }
+    }
+
+    //--------------------------------------------------------------------------
+    void validateHeader(const sCaptureFileHeader& header)
+    {
+        if (std::memcmp(
+                header.magic, CAPTURE_MAGIC, sizeof(CAPTURE_MAGIC)) != 0)
+        {
+            throw std::runtime_error("Not a capture file");
+        }
+        if (header.version != CAPTURE_VERSION &&
+            header.version != CAPTURE_VERSION_RAW)
+        {
+            throw std::runtime_error(
+                "Unsupported capture file version " +
+                std::to_string(header.version));
+        }
+        if (header.numChannels == 0 ||
+            header.numChannels > CAPTURE_MAX_CHANNELS ||
+            header.chunkSamples == 0 ||
+            !(header.sampleRateHz > 0.0) ||
+            header.chunkBytes != chunkBytes(header))
+        {
+            throw std::runtime_error("Corrupt capture file header");
+        }
+        for (size_t i = 0; i < header.numChannels; ++i)
+        {
+            if (header.channels[i].codec > eCodec::RLE)
+            {
+                throw std::runtime_error("Corrupt capture file header");
+            }
+        }
+    }
+
+    //--------------------------------------------------------------------------
+    // A chunk header is trusted for the size of the columns it maps
+    void validateChunk(
+        const sCaptureFileHeader& header,
+        const sCaptureChunkHeader& chunk)
+    {
+        if (chunk.numSamples == 0 || chunk.numSamples > header.chunkSamples)
+        {
+            throw std::runtime_error("Corrupt capture chunk");
+        }
+    }
+
+    //--------------------------------------------------------------------------
+    // The file header from its block, in the version 2 layout
+    sCaptureFileHeader loadHeader(const std::byte* pBlock)
+    {
+        sCaptureFileHeader header{};
+        constexpr size_t CHANNELS = offsetof(sCaptureFileHeader, channels);
+        std::memcpy(&header, pBlock, CHANNELS);
+        if (header.version != CAPTURE_VERSION_RAW)
+        {
+            std::memcpy(
+                header.channels, pBlock + CHANNELS, sizeof(header.channels));
+        }
+        else
+        {
+            for (size_t i = 0; i < CAPTURE_MAX_CHANNELS; ++i)
+            {
+                sCaptureFileChannelV1 channel;
+                std::memcpy(
+                    &channel,
+                    pBlock + CHANNELS + i * sizeof(channel),
+                    sizeof(channel));
+                std::memcpy(
+                    header.channels[i].name,
+                    channel.name,
+                    sizeof(channel.name));
+                header.channels[i].gain = channel.gain;
+                header.channels[i].offset = channel.offset;
+                header.channels[i].codec = eCodec::RAW;
+            }
+        }
+        validateHeader(header);
+        return header;
+    }
+
+    //--------------------------------------------------------------------------
+    // The file header block, in the layout of the header's version
+    std::array<std::byte, CAPTURE_HEADER_BYTES> storeHeader(
+        const sCaptureFileHeader& header)
+    {
+        std::array<std::byte, CAPTURE_HEADER_BYTES> block{};
+        constexpr size_t CHANNELS = offsetof(sCaptureFileHeader, channels);
+        std::memcpy(block.data(), &header, CHANNELS);
+        if (header.version != CAPTURE_VERSION_RAW)
+        {
+            std::memcpy(
+                block.data() + CHANNELS,
+                header.channels,
+                sizeof(header.channels));
+            return block;
+        }
+        for (size_t i = 0; i < header.numChannels; ++i)
+        {
+            sCaptureFileChannelV1 channel{};
+            std::memcpy(
+                channel.name, header.channels[i].name, sizeof(channel.name));
+            channel.gain = header.channels[i].gain;
+            channel.offset = header.channels[i].offset;
+            std::memcpy(
+                block.data() + CHANNELS + i * sizeof(channel),
+                &channel,
+                sizeof(channel));
+        }
+        return block;
+    }
+
+} // namespace anonymous
+
+namespace SignalDataFacade
+{
+    //==========================================================================
+    // Capture Writer Implementation
+    //==========================================================================
+
+    //--------------------------------------------------------------------------
+    CaptureWriter::CaptureWriter(
+        const std::string& sPath,
+        const sCaptureConfig_t& config)
+    : fd{-1},
+      header{},
+      rawBytesCommitted{0},
+      storedBytesCommitted{0},
+      numStaged{0},
+      stagedTimestampNs{config.startTimeNs},
+      nextSampleIndex{0}
+    {
+        if (config.channels.empty() ||
+            config.channels.size() > CAPTURE_MAX_CHANNELS ||
+            config.chunkSamples == 0 ||
+            !(config.sampleRateHz > 0.0) ||
+            std::any_of(
+                config.channels.begin(),
+                config.channels.end(),
+                [](const sCaptureChannel_t& channel)
+                {
+                    return channel.codec > eCodec::RLE;
+                }))
+        {
+            throw std::invalid_argument("Invalid capture configuration");
+        }
+
+        std::memcpy(header.magic, CAPTURE_MAGIC, sizeof(CAPTURE_MAGIC));
+        bool bCompressed = std::any_of(
+            config.channels.begin(),
+            config.channels.end(),
+            [](const sCaptureChannel_t& channel)
+            {
+                return channel.codec != eCodec::RAW;
+            });
+        header.version = bCompressed ? CAPTURE_VERSION : CAPTURE_VERSION_RAW;
+        header.numChannels = static_cast<uint32_t>(config.channels.size());
+        header.chunkSamples = config.chunkSamples;
+        header.flags = config.bSyncChunks ? CAPTURE_FLAG_SYNC_CHUNKS : 0;
+        header.chunkBytes = chunkBytes(header);
+        header.sampleRateHz = config.sampleRateHz;
+        header.startTimeNs = config.startTimeNs;
+        header.committedChunks = 0;
+        for (size_t i = 0; i < config.channels.size(); ++i)
+        {
+            // Names are truncated, always leaving a terminator
+            const sCaptureChannel_t& channel = config.channels[i];
+            std::strncpy(
+                header.channels[i].name,
+                channel.sName.c_str(),
+                CAPTURE_CHANNEL_NAME_BYTES - 1);
+            header.channels[i].gain = channel.gain;
+            header.channels[i].offset = channel.offset;
+            header.channels[i].codec = channel.codec;
+        }
+
+        fd = ::open(
+            sPath.c_str(), O_RDWR | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+        if (fd < 0)
+        {
+            throwErrno("Failed to create capture file " + sPath);
+        }
+
+        std::array<std::byte, CAPTURE_HEADER_BYTES> headerBlock =
+            storeHeader(header);
+        try
+        {
+            writeAll(fd, headerBlock.data(), headerBlock.size(), 0);
+        }
+        catch (...)
+        {
+            ::close(fd);
+            throw;
+        }
+        staged.resize(size_t{header.numChannels} * header.chunkSamples);
+        if (framed(header))
+        {
+            encoded.resize(maxFrameBytes(header.chunkSamples));
+        }
+    }
+
+    //--------------------------------------------------------------------------
+    CaptureWriter::CaptureWriter(const std::string& sPath)
+    : fd{-1},
+      header{},
+      rawBytesCommitted{0},
+      storedBytesCommitted{0},
+      numStaged{0},
+      stagedTimestampNs{0},
+      nextSampleIndex{0}
+    {
+        fd = ::open(sPath.c_str(), O_RDWR | O_CLOEXEC);
+        if (fd < 0)
+        {
+            throwErrno("Failed to open capture file " + sPath);
+        }
+
+        try
+        {
+            std::array<std::byte, CAPTURE_HEADER_BYTES> headerBlock;
+            readAll(fd, headerBlock.data(), headerBlock.size(), 0);
+            header = loadHeader(headerBlock.data());
+
+            // Continue after the last committed chunk, dropping any chunk
+            // torn by an interrupted writer
+            stagedTimestampNs = header.startTimeNs;
+            if (header.committedChunks > 0)
+            {
+                sCaptureChunkHeader lastChunk;
+                readAll(
+                    fd, &lastChunk, sizeof(lastChunk),
+                    chunkOffset(header, header.committedChunks - 1));
+                validateChunk(header, lastChunk);
+                nextSampleIndex =
+                    lastChunk.firstSampleIndex + lastChunk.numSamples;
+                stagedTimestampNs = lastChunk.firstTimestampNs +
+                    sampleOffsetNs(header.sampleRateHz, lastChunk.numSamples);
+            }
+            if (::ftruncate(
+                    fd, off_t(chunkOffset(header, header.committedChunks))) < 0)
+            {
+                throwErrno("Failed to truncate capture file " + sPath);
+            }
+        }
+        catch (...)
+        {
+            ::close(fd);
+            throw;
+        }
+        staged.resize(size_t{header.numChannels} * header.chunkSamples);
+        if (framed(header))
+        {
+            encoded.resize(maxFrameBytes(header.chunkSamples));
+        }
+    }
+
+    //--------------------------------------------------------------------------
+    CaptureWriter::~CaptureWriter()
+    {
+        try
+        {
+            commit();
+        }
+        catch (...)
+        {
+            // Destructors must not throw, the staged samples are lost
+        }
+        ::close(fd);
+    }
+
+    //--------------------------------------------------------------------------
+    void CaptureWriter::append(
+        std::span<const SignalData::sAggregateData> samples,
+        std::optional<uint64_t> firstTimestampNs)
+    {
+        requireChannels(2);
+        beginAppend(firstTimestampNs);
+
+        size_t done = 0;
+        while (done < samples.size())
+        {
+            size_t count = std::min<size_t>(
+                samples.size() - done, header.chunkSamples - numStaged);
+            uint16_t* pAnalog = stagedColumn(0) + numStaged;
+            uint16_t* pDigital = stagedColumn(1) + numStaged;
+            for (size_t i = 0; i < count; ++i)
+            {
+                pAnalog[i] = samples[done + i].analog;
+                pDigital[i] = samples[done + i].digital;
+            }
+            numStaged += static_cast<uint32_t>(count);
+            done += count;
+            if (numStaged == header.chunkSamples)
+            {
+                commit();
+            }
+        }
+    }
+
+    //--------------------------------------------------------------------------
+    void CaptureWriter::append(
+        const sSampleBlockView& block,
+        std::optional<uint64_t> firstTimestampNs)
+    {
+        std::array<std::span<const uint16_t>, 2> columns{
+            block.analog, block.digital};
+        appendColumns(columns, firstTimestampNs);
+    }
+
+    //--------------------------------------------------------------------------
+    void CaptureWriter::appendColumns(
+        std::span<const std::span<const uint16_t>> columns,
+        std::optional<uint64_t> firstTimestampNs)
+    {
+        requireChannels(columns.size());
+        size_t numSamples = columns.front().size();
+        for (const auto& column : columns)
+        {
+            if (column.size() != numSamples)
+            {
+                throw std::invalid_argument(
+                    "Capture columns differ in length");
+            }
+        }
+        beginAppend(firstTimestampNs);
+
+        size_t done = 0;
+        while (done < numSamples)
+        {
+            size_t count = std::min<size_t>(
+                numSamples - done, header.chunkSamples - numStaged);
+            for (size_t channel = 0; channel < columns.size(); ++channel)
+            {
+                std::copy_n(
+                    columns[channel].begin() + done,
+                    count,
+                    stagedColumn(channel) + numStaged);
+            }
+            numStaged += static_cast<uint32_t>(count);
+            done += count;
+            if (numStaged == header.chunkSamples)
+            {
+                commit();
+            }
+        }
+    }
+
+    //--------------------------------------------------------------------------
+    void CaptureWriter::appendFrames(
+        std::span<const uint16_t> frames,
+        std::optional<uint64_t> firstTimestampNs)
+    {
+        size_t frameSize = header.numChannels;
+        if (frames.size() % frameSize != 0)
+        {
+            throw std::invalid_argument("Capture frames are incomplete");
+        }
+        beginAppend(firstTimestampNs);
+
+        size_t numFrames = frames.size() / frameSize;
+        size_t done = 0;
+        while (done < numFrames)
+        {
+            size_t count = std::min<size_t>(
+                numFrames - done, header.chunkSamples - numStaged);
+            // Deinterleave into the staged columns
+            const uint16_t* pFrame = frames.data() + done * frameSize;
+            for (size_t i = 0; i < count; ++i, pFrame += frameSize)
+            {
+                for (size_t channel = 0; channel < frameSize; ++channel)
+                {
+                    stagedColumn(channel)[numStaged + i] = pFrame[channel];
+                }
+            }
+            numStaged += static_cast<uint32_t>(count);
+            done += count;
+            if (numStaged == header.chunkSamples)
+            {
+                commit();
+            }
+        }
+    }
+
+    //--------------------------------------------------------------------------
+    void CaptureWriter::commit()
+    {
+        if (numStaged == 0)
+        {
+            return;
+        }
+
+        // Write the whole chunk first...
+        size_t offset = chunkOffset(header, header.committedChunks);
+        if (::ftruncate(fd, off_t(offset + header.chunkBytes)) < 0)
+        {
+            throwErrno("Failed to extend capture file");
+        }
+        // Only the samples, or their frame, are written, leaving the rest of
+        // each column slot a hole
+        bool bFrames = framed(header);
+        size_t storedBytes = 0;
+        for (size_t channel = 0; channel < header.numChannels; ++channel)
+        {
+            std::span<const uint16_t> column(stagedColumn(channel), numStaged);
+            size_t columnStart = offset + columnOffset(header, channel);
+            if (bFrames)
+            {
+                size_t bytes = encodeFrame(
+                    header.channels[channel].codec,
+                    column,
+                    std::span<std::byte>(encoded));
+                writeAll(
+                    fd, encoded.data(), bytes,
+                    columnStart + CAPTURE_FRAME_OFFSET);
+                storedBytes += bytes;
+            }
+            else
+            {
+                writeAll(
+                    fd, column.data(), column.size_bytes(), columnStart);
+                storedBytes += column.size_bytes();
+            }
+        }
+        sCaptureChunkHeader chunk{};
+        chunk.firstSampleIndex = nextSampleIndex;
+        chunk.firstTimestampNs = stagedTimestampNs;
+        chunk.numSamples = numStaged;
+        chunk.encoding =
+            bFrames ? CAPTURE_ENCODING_FRAMES : CAPTURE_ENCODING_RAW;
+        writeAll(fd, &chunk, sizeof(chunk), offset);
+        if ((header.flags & CAPTURE_FLAG_SYNC_CHUNKS) != 0 &&
+            ::fdatasync(fd) < 0)
+        {
+            throwErrno("Failed to sync capture chunk");
+        }
+
+        // ...then advance the commit point, making it visible to readers
+        ++header.committedChunks;
+        writeAll(
+            fd,
+            &header.committedChunks,
+            sizeof(header.committedChunks),
+            offsetof(sCaptureFileHeader, committedChunks));
+
+        rawBytesCommitted +=
+            size_t{numStaged} * header.numChannels * sizeof(uint16_t);
+        storedBytesCommitted += storedBytes;
+        stagedTimestampNs = timestampAfterStaged();
+        nextSampleIndex += numStaged;
+        uint32_t numCommitted = std::exchange(numStaged, 0);
+
+        // The staged columns are left as they are until the next append
+        if (onCommit)
+        {
+            std::array<std::span<const uint16_t>, CAPTURE_MAX_CHANNELS>
+                columns;
+            for (size_t channel = 0; channel < header.numChannels; ++channel)
+            {
+                columns[channel] = {stagedColumn(channel), numCommitted};
+            }
+            onCommit(std::span(columns).first(header.numChannels));
+        }
+    }
+
+    //--------------------------------------------------------------------------
+    void CaptureWriter::setCommitCallback(CommitCallback callback)
+    {
+        onCommit = std::move(callback);
+    }
+
+    //--------------------------------------------------------------------------
+    double CaptureWriter::compressionRatio() const
+    {
+        return storedBytesCommitted == 0 ?
+            1.0 : double(rawBytesCommitted) / double(storedBytesCommitted);
+    }
+
+    //--------------------------------------------------------------------------
+    void CaptureWriter::sync()
+    {
+        commit();
+        if (::fdatasync(fd) < 0)
+        {
+            throwErrno("Failed to sync capture file");
+        }
+    }
+
+    //--------------------------------------------------------------------------
+    void CaptureWriter::beginAppend(std::optional<uint64_t> firstTimestampNs)
+    {
+        if (!firstTimestampNs)
+        {
+            return;
+        }
+
+        // Within half a sample period still counts as on the sample clock
+        uint64_t expectedNs = timestampAfterStaged();
+        uint64_t deviationNs = *firstTimestampNs > expectedNs ?
+            *firstTimestampNs - expectedNs : expectedNs - *firstTimestampNs;
+        if (double(deviationNs) * header.sampleRateHz <= 0.5e9)
+        {
+            return;
+        }
+
+        commit();
+        stagedTimestampNs = *firstTimestampNs;
+    }
+
+    //--------------------------------------------------------------------------
+    void CaptureWriter::requireChannels(size_t numChannels) const
+    {
+        if (numChannels != header.numChannels)
+        {
+            throw std::invalid_argument(
+                "Capture file has " + std::to_string(header.numChannels) +
+                " channels, not " + std::to_string(numChannels));
+        }
+    }
+
+    //--------------------------------------------------------------------------
+    uint16_t* CaptureWriter::stagedColumn(size_t channelIndex)
+    {
+        return staged.data() + channelIndex * header.chunkSamples;
+    }
+
+    //--------------------------------------------------------------------------
+    uint64_t CaptureWriter::timestampAfterStaged() const
+    {
+        return stagedTimestampNs +
+            sampleOffsetNs(header.sampleRateHz, numStaged);
+    }
+
+    //==========================================================================
+    // Capture Reader Implementation
+    //==========================================================================
+
+    //--------------------------------------------------------------------------
+    CaptureReader::CaptureReader(const std::string& sPath)
+    : sPath{sPath},
+      pMapped{nullptr},
+      mappedBytes{0},
+      header{},
+      numCommitted{0}
+    {
+        map();
+    }
+
+    //--------------------------------------------------------------------------
+    CaptureReader::~CaptureReader()
+    {
+        unmap();
+    }
+
+    //--------------------------------------------------------------------------
+    void CaptureReader::refresh()
+    {
+        unmap();
+        map();
+    }
+
+    //--------------------------------------------------------------------------
+    sCaptureChannel_t CaptureReader::channel(size_t channelIndex) const
+    {
+        if (channelIndex >= numChannels())
+        {
+            throw std::out_of_range("No such capture channel");
+        }
+        const sCaptureFileChannel& fileChannel = header.channels[channelIndex];
+        return {
+            std::string(
+                fileChannel.name,
+                strnlen(fileChannel.name, CAPTURE_CHANNEL_NAME_BYTES)),
+            fileChannel.gain,
+            fileChannel.offset,
+            fileChannel.codec};
+    }
+
+    //--------------------------------------------------------------------------
+    uint64_t CaptureReader::numSamples() const
+    {
+        if (numCommitted == 0)
+        {
+            return 0;
+        }
+        const sCaptureChunkHeader& last = chunkHeader(numCommitted - 1);
+        return last.firstSampleIndex + last.numSamples;
+    }
+
+    //--------------------------------------------------------------------------
+    const sCaptureChunkHeader& CaptureReader::chunkHeader(
+        size_t chunkIndex) const
+    {
+        const sCaptureChunkHeader& chunk =
+            *reinterpret_cast<const sCaptureChunkHeader*>(
+                pMapped + chunkOffset(header, chunkIndex));
+        validateChunk(header, chunk);
+        return chunk;
+    }
+
+    //--------------------------------------------------------------------------
+    std::span<const uint16_t> CaptureReader::column(
+        size_t chunkIndex,
+        size_t channelIndex) const
+    {
+        if (auto mapped = mappedColumn(chunkIndex, channelIndex))
+        {
+            return *mapped;
+        }
+        return *decoded(chunkIndex, channelIndex);
+    }
+
+    //--------------------------------------------------------------------------
+    void CaptureReader::decodeColumn(
+        size_t chunkIndex,
+        size_t channelIndex,
+        std::vector<uint16_t>& samples) const
+    {
+        if (auto mapped = mappedColumn(chunkIndex, channelIndex))
+        {
+            samples.assign(mapped->begin(), mapped->end());
+            return;
+        }
+        samples.clear();
+        decodeFrame(
+            columnSlot(chunkIndex, channelIndex).subspan(CAPTURE_FRAME_OFFSET),
+            samples);
+    }
+
+    //--------------------------------------------------------------------------
+    sSampleBlockView CaptureReader::chunkView(size_t chunkIndex) const
+    {
+        return {
+            column(chunkIndex, 0),
+            numChannels() > 1 ?
+                column(chunkIndex, 1) : std::span<const uint16_t>{}};
+    }
+
+    //--------------------------------------------------------------------------
+    uint64_t CaptureReader::timestampOf(
+        size_t chunkIndex,
+        size_t sampleInChunk) const
+    {
+        return chunkHeader(chunkIndex).firstTimestampNs +
+            sampleOffsetNs(header.sampleRateHz, sampleInChunk);
+    }
+
+    //--------------------------------------------------------------------------
+    size_t CaptureReader::findChunk(uint64_t timestampNs) const
+    {
+        // Binary search the strided chunk headers for the first chunk that
+        // starts after timestampNs
+        size_t low = 0;
+        size_t high = numCommitted;
+        while (low < high)
+        {
+            size_t middle = low + (high - low) / 2;
+            if (chunkHeader(middle).firstTimestampNs <= timestampNs)
+            {
+                low = middle + 1;
+            }
+            else
+            {
+                high = middle;
+            }
+        }
+        return low > 0 ? low - 1 : 0;
+    }
+
+    //--------------------------------------------------------------------------
+    std::vector<CaptureReader::sCaptureSpan> CaptureReader::range(
+        uint64_t beginNs,
+        uint64_t endNs) const
+    {
+        std::vector<sCaptureSpan> spans;
+        for (size_t chunk = findChunk(beginNs);
+             beginNs < endNs && chunk < numCommitted &&
+                chunkHeader(chunk).firstTimestampNs < endNs;
+             ++chunk)
+        {
+            size_t first = sampleAtOrAfter(chunk, beginNs);
+            size_t last = sampleAtOrAfter(chunk, endNs);
+            if (first < last)
+            {
+                sCaptureSpan& span = spans.emplace_back();
+                span.chunkIndex = chunk;
+                span.firstSampleIndex =
+                    chunkHeader(chunk).firstSampleIndex + first;
+                span.firstTimestampNs = timestampOf(chunk, first);
+                span.samples.analog = holdColumn(chunk, 0, span.spDecoded[0])
+                    .subspan(first, last - first);
+                if (numChannels() > 1)
+                {
+                    span.samples.digital =
+                        holdColumn(chunk, 1, span.spDecoded[1])
+                            .subspan(first, last - first);
+                }
+            }
+        }
+        return spans;
+    }
+
+    //--------------------------------------------------------------------------
+    void CaptureReader::map()
+    {
+        int fd = ::open(sPath.c_str(), O_RDONLY | O_CLOEXEC);
+        if (fd < 0)
+        {
+            throwErrno("Failed to open capture file " + sPath);
+        }
+        struct stat fileStat{};
+        if (::fstat(fd, &fileStat) < 0)
+        {
+            ::close(fd);
+            throwErrno("Failed to stat capture file " + sPath);
+        }
+        if (size_t(fileStat.st_size) < CAPTURE_HEADER_BYTES)
+        {
+            ::close(fd);
+            throw std::runtime_error("Not a capture file: " + sPath);
+        }
+
+        mappedBytes = size_t(fileStat.st_size);
+        void* pMapping =
+            ::mmap(nullptr, mappedBytes, PROT_READ, MAP_SHARED, fd, 0);
+        // The mapping keeps the file referenced
+        ::close(fd);
+        if (pMapping == MAP_FAILED)
+        {
+            mappedBytes = 0;
+            throwErrno("Failed to map capture file " + sPath);
+        }
+        pMapped = static_cast<const std::byte*>(pMapping);
+
+        try
+        {
+            header = loadHeader(pMapped);
+        }
+        catch (...)
+        {
+            unmap();
+            throw;
+        }
+        // Only chunks both committed and within the mapping are visible
+        numCommitted = std::min<size_t>(
+            header.committedChunks,
+            (mappedBytes - CAPTURE_HEADER_BYTES) / header.chunkBytes);
+    }
+
+    //--------------------------------------------------------------------------
+    void CaptureReader::unmap()
+    {
+        if (pMapped != nullptr)
+        {
+            ::munmap(const_cast<std::byte*>(pMapped), mappedBytes);
+        }
+        pMapped = nullptr;
+        header = {};
+        mappedBytes = 0;
+        numCommitted = 0;
+        std::lock_guard<std::mutex> lock(decodedMutex);
+        decodedColumns.clear();
+    }
+
+    //--------------------------------------------------------------------------
+    size_t CaptureReader::sampleAtOrAfter(
+        size_t chunkIndex,
+        uint64_t timestampNs) const
+    {
+        const sCaptureChunkHeader& chunk = chunkHeader(chunkIndex);
+        if (timestampNs <= chunk.firstTimestampNs)
+        {
+            return 0;
+        }
+
+        // Estimate from the sample rate, then settle the rounding
+        size_t numSamples = chunk.numSamples;
+        size_t index = std::min<size_t>(
+            numSamples,
+            static_cast<size_t>(
+                double(timestampNs - chunk.firstTimestampNs) *
+                header.sampleRateHz / 1e9));
+        while (index < numSamples &&
+               timestampOf(chunkIndex, index) < timestampNs)
+        {
+            ++index;
+        }
+        while (index > 0 &&
+               timestampOf(chunkIndex, index - 1) >= timestampNs)
+        {
+            --index;
+        }
+        return index;
+    }
+
+    //--------------------------------------------------------------------------
+    std::span<const std::byte> CaptureReader::columnSlot(
+        size_t chunkIndex,
+        size_t channelIndex) const
+    {
+        if (channelIndex >= numChannels())
+        {
+            throw std::out_of_range("No such capture channel");
+        }
+        return {
+            pMapped + chunkOffset(header, chunkIndex) +
+                columnOffset(header, channelIndex),
+            columnBytes(header)};
+    }
+
+    //--------------------------------------------------------------------------
+    std::optional<std::span<const uint16_t>> CaptureReader::mappedColumn(
+        size_t chunkIndex,
+        size_t channelIndex) const
+    {
+        const sCaptureChunkHeader& chunk = chunkHeader(chunkIndex);
+        std::span<const std::byte> slot = columnSlot(chunkIndex, channelIndex);
+        switch (chunk.encoding)
+        {
+            case CAPTURE_ENCODING_RAW:
+                break;
+            case CAPTURE_ENCODING_FRAMES:
+            {
+                slot = slot.subspan(CAPTURE_FRAME_OFFSET);
+                sCodecFrameHeader frame = peekFrame(slot);
+                if (frame.numSamples != chunk.numSamples)
+                {
+                    throw std::runtime_error("Corrupt capture chunk");
+                }
+                if (frame.codec != eCodec::RAW)
+                {
+                    return std::nullopt;
+                }
+                slot = slot.subspan(sizeof(frame));
+                break;
+            }
+            default:
+                throw std::runtime_error(
+                    "Unsupported capture chunk encoding " +
+                    std::to_string(chunk.encoding));
+        }
+        return std::span<const uint16_t>(
+            reinterpret_cast<const uint16_t*>(slot.data()), chunk.numSamples);
+    }
+
+    //--------------------------------------------------------------------------
+    std::shared_ptr<const std::vector<uint16_t>> CaptureReader::decoded(
+        size_t chunkIndex,
+        size_t channelIndex) const
+    {
+        size_t key = chunkIndex * numChannels() + channelIndex;
+        std::lock_guard<std::mutex> lock(decodedMutex);
+        auto found = std::find_if(
+            decodedColumns.begin(),
+            decodedColumns.end(),
+            [key](const auto& entry) { return entry.first == key; });
+        if (found != decodedColumns.end())
+        {
+            std::rotate(decodedColumns.begin(), found, found + 1);
+            return decodedColumns.front().second;
+        }
+
+        // Evicted columns live on in the views still holding them
+        auto spColumn = std::make_shared<std::vector<uint16_t>>();
+        decodeFrame(
+            columnSlot(chunkIndex, channelIndex).subspan(CAPTURE_FRAME_OFFSET),
+            *spColumn);
+        if (decodedColumns.size() == DECODED_COLUMNS_KEPT)
+        {
+            decodedColumns.pop_back();
+        }
+        decodedColumns.emplace(decodedColumns.begin(), key, spColumn);
+        return spColumn;
+    }
+
+    //--------------------------------------------------------------------------
+    std::span<const uint16_t> CaptureReader::holdColumn(
+        size_t chunkIndex,
+        size_t channelIndex,
+        std::shared_ptr<const std::vector<uint16_t>>& spDecoded) const
+    {
+        if (auto mapped = mappedColumn(chunkIndex, channelIndex))
+        {
+            return *mapped;
+        }
+        spDecoded = decoded(chunkIndex, channelIndex);
+        return *spDecoded;
+    }
+
+} // namespace SignalDataFacade
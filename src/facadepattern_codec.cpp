@@ -0,0 +1,905 @@
+// Copyright (c) 2025 Michael Dello
+//
+// This software is provided under the MIT License.
+// See LICENSE file for details.
+
+//-----------------------------------------------------------------------------
+//
+// Signal Data Codec Implementation
+//
+//-----------------------------------------------------------------------------
+
+#include "facadepattern_codec.h"
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+
+#include "common/tsc_clock.h"
+
+// SIMD kernels need GCC/Clang target attributes on an x86 CPU
+#if (defined(__GNUC__) || defined(__clang__)) && \
+    (defined(__x86_64__) || defined(__i386__))
+#define FACADEPATTERN_CODEC_X86_KERNELS 1
+#include <immintrin.h>
+#else
+#define FACADEPATTERN_CODEC_X86_KERNELS 0
+#endif
+
+namespace // anonymous
+{
+    using SignalDataFacade::eCodec;
+    using SignalDataFacade::eSimdLevel;
+    using SignalDataFacade::sCodecFrameHeader;
+
+    //--------------------------------------------------------------------------
+    // Constants
+    //--------------------------------------------------------------------------
+    constexpr size_t BLOCK_LANES = 8;
+    constexpr size_t BLOCK_ROWS = 16;
+    constexpr size_t BLOCK_SAMPLES = BLOCK_LANES * BLOCK_ROWS;
+    // Width byte, then up to 16 words per lane
+    constexpr size_t MAX_BLOCK_BYTES = 1 + BLOCK_SAMPLES * sizeof(uint16_t);
+    constexpr size_t MAX_VARINT_BYTES = 10;
+    // Word and its run length
+    constexpr size_t MAX_RUN_BYTES = sizeof(uint16_t) + MAX_VARINT_BYTES;
+
+    //--------------------------------------------------------------------------
+    // Local Functions
+    //--------------------------------------------------------------------------
+    [[noreturn]] void throwCorrupt(const char* pWhat)
+    {
+        throw std::runtime_error(std::string("Corrupt codec frame: ") + pWhat);
+    }
+
+    //--------------------------------------------------------------------------
+    // Small differences either way map to small numbers: 0, -1, 1, -2, ...
+    uint16_t zigzag(uint16_t delta)
+    {
+        return uint16_t((delta << 1) ^ uint16_t(int16_t(delta) >> 15));
+    }
+
+    //--------------------------------------------------------------------------
+    uint16_t unzigzag(uint16_t value)
+    {
+        return uint16_t((value >> 1) ^ uint16_t(-(value & 1)));
+    }
+
+    //--------------------------------------------------------------------------
+    // Delta Bit-packing Kernels
+    //--------------------------------------------------------------------------
+    // Encode one block of samples after previous, returning its size
+    size_t encodeBlockScalar(
+        const uint16_t* pSamples,
+        uint16_t& previous,
+        std::byte* pOut)
+    {
+        std::array<uint16_t, BLOCK_SAMPLES> values;
+        uint16_t bitsUsed = 0;
+        for (size_t i = 0; i < BLOCK_SAMPLES; ++i)
+        {
+            values[i] = zigzag(uint16_t(pSamples[i] - previous));
+            previous = pSamples[i];
+            bitsUsed |= values[i];
+        }
+        unsigned width = unsigned(std::bit_width(bitsUsed));
+        pOut[0] = std::byte(width);
+
+        // Each lane's rows are concatenated, low bits first, into width words
+        std::array<uint16_t, BLOCK_SAMPLES> words;
+        for (size_t lane = 0; lane < BLOCK_LANES; ++lane)
+        {
+            uint32_t pending = 0;
+            unsigned numPending = 0;
+            size_t word = 0;
+            for (size_t row = 0; row < BLOCK_ROWS; ++row)
+            {
+                pending |= uint32_t(values[row * BLOCK_LANES + lane])
+                    << numPending;
+                numPending += width;
+                if (numPending >= 16)
+                {
+                    words[word++ * BLOCK_LANES + lane] = uint16_t(pending);
+                    pending >>= 16;
+                    numPending -= 16;
+                }
+            }
+        }
+        std::memcpy(pOut + 1, words.data(), width * BLOCK_LANES * 2);
+        return 1 + width * BLOCK_LANES * 2;
+    }
+
+    //--------------------------------------------------------------------------
+    size_t blockBytes(const std::byte* pIn, size_t available)
+    {
+        if (available == 0)
+        {
+            throwCorrupt("truncated block");
+        }
+        unsigned width = unsigned(pIn[0]);
+        if (width > 16)
+        {
+            throwCorrupt("bad bit width");
+        }
+        size_t bytes = 1 + width * BLOCK_LANES * 2;
+        if (bytes > available)
+        {
+            throwCorrupt("truncated block");
+        }
+        return bytes;
+    }
+
+    //--------------------------------------------------------------------------
+    // Decode one block following previous, returning its size
+    size_t decodeBlockScalar(
+        const std::byte* pIn,
+        size_t available,
+        uint16_t& previous,
+        uint16_t* pSamples)
+    {
+        size_t bytes = blockBytes(pIn, available);
+        unsigned width = unsigned(pIn[0]);
+        std::array<uint16_t, BLOCK_SAMPLES> words;
+        std::memcpy(words.data(), pIn + 1, bytes - 1);
+
+        uint32_t mask = (uint32_t{1} << width) - 1;
+        std::array<uint16_t, BLOCK_SAMPLES> values;
+        for (size_t lane = 0; lane < BLOCK_LANES; ++lane)
+        {
+            uint32_t pending = 0;
+            unsigned numPending = 0;
+            size_t word = 0;
+            for (size_t row = 0; row < BLOCK_ROWS; ++row)
+            {
+                if (numPending < width)
+                {
+                    pending |= uint32_t(words[word++ * BLOCK_LANES + lane])
+                        << numPending;
+                    numPending += 16;
+                }
+                values[row * BLOCK_LANES + lane] = uint16_t(pending & mask);
+                pending >>= width;
+                numPending -= width;
+            }
+        }
+
+        for (size_t i = 0; i < BLOCK_SAMPLES; ++i)
+        {
+            previous = uint16_t(previous + unzigzag(values[i]));
+            pSamples[i] = previous;
+        }
+        return bytes;
+    }
+
+#if FACADEPATTERN_CODEC_X86_KERNELS
+    //--------------------------------------------------------------------------
+    // A block row is one register, so rows pack with whole-register shifts.
+    // AVX2 would need 16 lanes per row, the SSE kernels serve both levels.
+    __attribute__((target("sse4.1")))
+    size_t encodeBlockSSE4(
+        const uint16_t* pSamples,
+        uint16_t& previous,
+        std::byte* pOut)
+    {
+        __m128i rows[BLOCK_ROWS];
+        __m128i last = _mm_set1_epi16(short(previous));
+        __m128i bitsUsed = _mm_setzero_si128();
+        for (size_t row = 0; row < BLOCK_ROWS; ++row)
+        {
+            __m128i current = _mm_loadu_si128(
+                reinterpret_cast<const __m128i*>(
+                    pSamples + row * BLOCK_LANES));
+            // Each sample's predecessor: the last of the previous row, then
+            // this row shifted up one
+            __m128i delta = _mm_sub_epi16(
+                current, _mm_alignr_epi8(current, last, 14));
+            rows[row] = _mm_xor_si128(
+                _mm_slli_epi16(delta, 1), _mm_srai_epi16(delta, 15));
+            bitsUsed = _mm_or_si128(bitsUsed, rows[row]);
+            last = current;
+        }
+        previous = pSamples[BLOCK_SAMPLES - 1];
+
+        bitsUsed = _mm_or_si128(bitsUsed, _mm_srli_si128(bitsUsed, 8));
+        bitsUsed = _mm_or_si128(bitsUsed, _mm_srli_si128(bitsUsed, 4));
+        bitsUsed = _mm_or_si128(bitsUsed, _mm_srli_si128(bitsUsed, 2));
+        unsigned width = unsigned(
+            std::bit_width(uint16_t(_mm_cvtsi128_si32(bitsUsed))));
+        pOut[0] = std::byte(width);
+
+        std::byte* pWords = pOut + 1;
+        __m128i pending = _mm_setzero_si128();
+        unsigned numPending = 0;
+        for (size_t row = 0; width > 0 && row < BLOCK_ROWS; ++row)
+        {
+            pending = _mm_or_si128(
+                pending,
+                _mm_sll_epi16(rows[row], _mm_cvtsi32_si128(int(numPending))));
+            numPending += width;
+            if (numPending >= 16)
+            {
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(pWords), pending);
+                pWords += sizeof(__m128i);
+                numPending -= 16;
+                // Bits of the row that did not fit
+                pending = _mm_srl_epi16(
+                    rows[row], _mm_cvtsi32_si128(int(width - numPending)));
+            }
+        }
+        return 1 + width * BLOCK_LANES * 2;
+    }
+
+    //--------------------------------------------------------------------------
+    __attribute__((target("sse4.1")))
+    size_t decodeBlockSSE4(
+        const std::byte* pIn,
+        size_t available,
+        uint16_t& previous,
+        uint16_t* pSamples)
+    {
+        size_t bytes = blockBytes(pIn, available);
+        unsigned width = unsigned(pIn[0]);
+        const __m128i* pWords = reinterpret_cast<const __m128i*>(pIn + 1);
+        const __m128i mask = _mm_set1_epi16(short((1u << width) - 1));
+        const __m128i one = _mm_set1_epi16(1);
+        const __m128i lastLane = _mm_set1_epi16(0x0F0E);
+
+        __m128i current = width > 0 ?
+            _mm_loadu_si128(pWords++) : _mm_setzero_si128();
+        unsigned numLoaded = width > 0 ? 1 : 0;
+        unsigned consumed = 0;
+        __m128i carry = _mm_set1_epi16(short(previous));
+        for (size_t row = 0; row < BLOCK_ROWS; ++row)
+        {
+            __m128i value = _mm_srl_epi16(
+                current, _mm_cvtsi32_si128(int(consumed)));
+            consumed += width;
+            if (consumed >= 16)
+            {
+                consumed -= 16;
+                if (numLoaded < width)
+                {
+                    current = _mm_loadu_si128(pWords++);
+                    ++numLoaded;
+                }
+                if (consumed > 0)
+                {
+                    value = _mm_or_si128(
+                        value,
+                        _mm_sll_epi16(
+                            current,
+                            _mm_cvtsi32_si128(int(width - consumed))));
+                }
+            }
+            value = _mm_and_si128(value, mask);
+
+            __m128i delta = _mm_xor_si128(
+                _mm_srli_epi16(value, 1),
+                _mm_sub_epi16(_mm_setzero_si128(), _mm_and_si128(value, one)));
+            // Prefix sum across the row, then add the running value
+            delta = _mm_add_epi16(delta, _mm_slli_si128(delta, 2));
+            delta = _mm_add_epi16(delta, _mm_slli_si128(delta, 4));
+            delta = _mm_add_epi16(delta, _mm_slli_si128(delta, 8));
+            __m128i samples = _mm_add_epi16(delta, carry);
+            _mm_storeu_si128(
+                reinterpret_cast<__m128i*>(pSamples + row * BLOCK_LANES),
+                samples);
+            carry = _mm_shuffle_epi8(samples, lastLane);
+        }
+        previous = pSamples[BLOCK_SAMPLES - 1];
+        return bytes;
+    }
+
+    //--------------------------------------------------------------------------
+    // Run Kernels
+    //--------------------------------------------------------------------------
+    __attribute__((target("sse4.1")))
+    size_t runLengthSSE4(const uint16_t* pSamples, size_t count)
+    {
+        const __m128i value = _mm_set1_epi16(short(pSamples[0]));
+        size_t i = 1;
+        for (; i + 8 <= count; i += 8)
+        {
+            unsigned equal = unsigned(_mm_movemask_epi8(_mm_cmpeq_epi16(
+                _mm_loadu_si128(
+                    reinterpret_cast<const __m128i*>(pSamples + i)),
+                value)));
+            if (equal != 0xFFFF)
+            {
+                return i + std::countr_zero(~equal) / 2;
+            }
+        }
+        while (i < count && pSamples[i] == pSamples[0])
+        {
+            ++i;
+        }
+        return i;
+    }
+
+    //--------------------------------------------------------------------------
+    __attribute__((target("sse4.1")))
+    void fillSSE4(uint16_t* pSamples, size_t count, uint16_t value)
+    {
+        const __m128i values = _mm_set1_epi16(short(value));
+        size_t i = 0;
+        for (; i + 8 <= count; i += 8)
+        {
+            _mm_storeu_si128(
+                reinterpret_cast<__m128i*>(pSamples + i), values);
+        }
+        std::fill_n(pSamples + i, count - i, value);
+    }
+
+    //--------------------------------------------------------------------------
+    __attribute__((target("avx2")))
+    size_t runLengthAVX2(const uint16_t* pSamples, size_t count)
+    {
+        const __m256i value = _mm256_set1_epi16(short(pSamples[0]));
+        size_t i = 1;
+        for (; i + 16 <= count; i += 16)
+        {
+            unsigned equal = unsigned(_mm256_movemask_epi8(_mm256_cmpeq_epi16(
+                _mm256_loadu_si256(
+                    reinterpret_cast<const __m256i*>(pSamples + i)),
+                value)));
+            if (equal != 0xFFFFFFFFu)
+            {
+                return i + std::countr_zero(~equal) / 2;
+            }
+        }
+        while (i < count && pSamples[i] == pSamples[0])
+        {
+            ++i;
+        }
+        return i;
+    }
+
+    //--------------------------------------------------------------------------
+    __attribute__((target("avx2")))
+    void fillAVX2(uint16_t* pSamples, size_t count, uint16_t value)
+    {
+        const __m256i values = _mm256_set1_epi16(short(value));
+        size_t i = 0;
+        for (; i + 16 <= count; i += 16)
+        {
+            _mm256_storeu_si256(
+                reinterpret_cast<__m256i*>(pSamples + i), values);
+        }
+        std::fill_n(pSamples + i, count - i, value);
+    }
+#endif
+
+    //--------------------------------------------------------------------------
+    size_t runLengthScalar(const uint16_t* pSamples, size_t count)
+    {
+        size_t i = 1;
+        while (i < count && pSamples[i] == pSamples[0])
+        {
+            ++i;
+        }
+        return i;
+    }
+
+    //--------------------------------------------------------------------------
+    // Dispatch
+    //--------------------------------------------------------------------------
+    size_t encodeBlock(
+        const uint16_t* pSamples,
+        uint16_t& previous,
+        std::byte* pOut,
+        eSimdLevel level)
+    {
+#if FACADEPATTERN_CODEC_X86_KERNELS
+        if (level >= eSimdLevel::SSE4)
+        {
+            return encodeBlockSSE4(pSamples, previous, pOut);
+        }
+#endif
+        (void)level;
+        return encodeBlockScalar(pSamples, previous, pOut);
+    }
+
+    //--------------------------------------------------------------------------
+    size_t decodeBlock(
+        const std::byte* pIn,
+        size_t available,
+        uint16_t& previous,
+        uint16_t* pSamples,
+        eSimdLevel level)
+    {
+#if FACADEPATTERN_CODEC_X86_KERNELS
+        if (level >= eSimdLevel::SSE4)
+        {
+            return decodeBlockSSE4(pIn, available, previous, pSamples);
+        }
+#endif
+        (void)level;
+        return decodeBlockScalar(pIn, available, previous, pSamples);
+    }
+
+    //--------------------------------------------------------------------------
+    size_t runLength(const uint16_t* pSamples, size_t count, eSimdLevel level)
+    {
+        switch (level)
+        {
+#if FACADEPATTERN_CODEC_X86_KERNELS
+            case eSimdLevel::AVX2:
+                return runLengthAVX2(pSamples, count);
+            case eSimdLevel::SSE4:
+                return runLengthSSE4(pSamples, count);
+#endif
+            default:
+                return runLengthScalar(pSamples, count);
+        }
+    }
+
+    //--------------------------------------------------------------------------
+    void fill(
+        uint16_t* pSamples,
+        size_t count,
+        uint16_t value,
+        eSimdLevel level)
+    {
+        switch (level)
+        {
+#if FACADEPATTERN_CODEC_X86_KERNELS
+            case eSimdLevel::AVX2:
+                fillAVX2(pSamples, count, value);
+                return;
+            case eSimdLevel::SSE4:
+                fillSSE4(pSamples, count, value);
+                return;
+#endif
+            default:
+                std::fill_n(pSamples, count, value);
+                return;
+        }
+    }
+
+    //--------------------------------------------------------------------------
+    // Payloads
+    //--------------------------------------------------------------------------
+    // Encode into out, returning the payload size, or SIZE_MAX when it does
+    // not fit
+    size_t encodeDeltaBitpack(
+        std::span<const uint16_t> samples,
+        std::span<std::byte> out,
+        eSimdLevel level)
+    {
+        std::byte* pNext = out.data();
+        std::byte* pEnd = pNext + out.size();
+        uint16_t previous = 0;
+        // Blocks are encoded in place while the worst case fits, then aside
+        std::array<std::byte, MAX_BLOCK_BYTES> aside;
+        auto encodeOne = [&](const uint16_t* pBlock)
+        {
+            if (size_t(pEnd - pNext) >= MAX_BLOCK_BYTES)
+            {
+                pNext += encodeBlock(pBlock, previous, pNext, level);
+                return true;
+            }
+            size_t bytes = encodeBlock(pBlock, previous, aside.data(), level);
+            if (bytes > size_t(pEnd - pNext))
+            {
+                return false;
+            }
+            std::memcpy(pNext, aside.data(), bytes);
+            pNext += bytes;
+            return true;
+        };
+
+        size_t done = 0;
+        for (; done + BLOCK_SAMPLES <= samples.size(); done += BLOCK_SAMPLES)
+        {
+            if (!encodeOne(samples.data() + done))
+            {
+                return SIZE_MAX;
+            }
+        }
+        if (done < samples.size())
+        {
+            // Repeat the last sample, padding the block with zero deltas
+            std::array<uint16_t, BLOCK_SAMPLES> block;
+            block.fill(samples.back());
+            std::copy(samples.begin() + done, samples.end(), block.begin());
+            if (!encodeOne(block.data()))
+            {
+                return SIZE_MAX;
+            }
+        }
+        return size_t(pNext - out.data());
+    }
+
+    //--------------------------------------------------------------------------
+    void decodeDeltaBitpack(
+        std::span<const std::byte> payload,
+        std::span<uint16_t> samples,
+        eSimdLevel level)
+    {
+        const std::byte* pNext = payload.data();
+        const std::byte* pEnd = pNext + payload.size();
+        uint16_t previous = 0;
+        size_t done = 0;
+        for (; done + BLOCK_SAMPLES <= samples.size(); done += BLOCK_SAMPLES)
+        {
+            pNext += decodeBlock(
+                pNext, size_t(pEnd - pNext), previous,
+                samples.data() + done, level);
+        }
+        if (done < samples.size())
+        {
+            std::array<uint16_t, BLOCK_SAMPLES> block;
+            pNext += decodeBlock(
+                pNext, size_t(pEnd - pNext), previous, block.data(), level);
+            std::copy_n(block.begin(), samples.size() - done,
+                samples.begin() + done);
+        }
+        if (pNext != pEnd)
+        {
+            throwCorrupt("payload size mismatch");
+        }
+    }
+
+    //--------------------------------------------------------------------------
+    // Encode into out, returning the payload size, or SIZE_MAX when it does
+    // not fit
+    size_t encodeRle(
+        std::span<const uint16_t> samples,
+        std::span<std::byte> out,
+        eSimdLevel level)
+    {
+        std::byte* pNext = out.data();
+        std::byte* pEnd = pNext + out.size();
+        for (size_t done = 0; done < samples.size();)
+        {
+            uint16_t value = samples[done];
+            uint64_t length = runLength(
+                samples.data() + done, samples.size() - done, level);
+
+            std::array<std::byte, MAX_RUN_BYTES> run;
+            std::byte* pRun = run.data();
+            std::memcpy(pRun, &value, sizeof(value));
+            pRun += sizeof(value);
+            // LEB128: 7 bits per byte, high bit set on all but the last
+            for (uint64_t rest = length; ; rest >>= 7)
+            {
+                if (rest < 0x80)
+                {
+                    *pRun++ = std::byte(rest);
+                    break;
+                }
+                *pRun++ = std::byte((rest & 0x7F) | 0x80);
+            }
+            size_t runBytes = size_t(pRun - run.data());
+            if (runBytes > size_t(pEnd - pNext))
+            {
+                return SIZE_MAX;
+            }
+            std::memcpy(pNext, run.data(), runBytes);
+            pNext += runBytes;
+            done += length;
+        }
+        return size_t(pNext - out.data());
+    }
+
+    //--------------------------------------------------------------------------
+    void decodeRle(
+        std::span<const std::byte> payload,
+        std::span<uint16_t> samples,
+        eSimdLevel level)
+    {
+        const std::byte* pNext = payload.data();
+        const std::byte* pEnd = pNext + payload.size();
+        size_t done = 0;
+        while (pNext != pEnd)
+        {
+            uint16_t value;
+            if (size_t(pEnd - pNext) < sizeof(value))
+            {
+                throwCorrupt("truncated run");
+            }
+            std::memcpy(&value, pNext, sizeof(value));
+            pNext += sizeof(value);
+
+            uint64_t length = 0;
+            for (size_t i = 0; ; ++i)
+            {
+                if (pNext == pEnd || i == MAX_VARINT_BYTES)
+                {
+                    throwCorrupt("bad run length");
+                }
+                uint64_t byte = uint64_t(*pNext++);
+                length |= (byte & 0x7F) << (7 * i);
+                if (!(byte & 0x80))
+                {
+                    break;
+                }
+            }
+            if (length == 0 || length > samples.size() - done)
+            {
+                throwCorrupt("bad run length");
+            }
+            fill(samples.data() + done, size_t(length), value, level);
+            done += size_t(length);
+        }
+        if (done != samples.size())
+        {
+            throwCorrupt("sample count mismatch");
+        }
+    }
+
+} // namespace anonymous
+
+namespace SignalDataFacade
+{
+    //--------------------------------------------------------------------------
+    const char* toString(eCodec codec)
+    {
+        switch (codec)
+        {
+            case eCodec::RAW:
+                return "RAW";
+            case eCodec::DELTA_BITPACK:
+                return "DELTA_BITPACK";
+            case eCodec::RLE:
+                return "RLE";
+        }
+        return "UNKNOWN";
+    }
+
+    //--------------------------------------------------------------------------
+    size_t encodeFrame(
+        eCodec codec,
+        std::span<const uint16_t> samples,
+        std::span<std::byte> out,
+        eSimdLevel level)
+    {
+        if (samples.size() > UINT32_MAX / sizeof(uint16_t))
+        {
+            throw std::invalid_argument("Too many samples for a codec frame");
+        }
+        if (out.size() < maxFrameBytes(samples.size()))
+        {
+            throw std::out_of_range("Codec frame needs more room");
+        }
+        level = std::min(level, detectedSimdLevel());
+
+        // RAW, or any codec that would not shrink the samples, copies them,
+        // so no codec may write more than the raw samples
+        size_t rawBytes = samples.size() * sizeof(uint16_t);
+        auto payload = out.subspan(sizeof(sCodecFrameHeader), rawBytes);
+        size_t payloadBytes = SIZE_MAX;
+        switch (codec)
+        {
+            case eCodec::DELTA_BITPACK:
+                payloadBytes = encodeDeltaBitpack(samples, payload, level);
+                break;
+            case eCodec::RLE:
+                payloadBytes = encodeRle(samples, payload, level);
+                break;
+            case eCodec::RAW:
+                break;
+            default:
+                throw std::invalid_argument("Unknown codec");
+        }
+        if (payloadBytes > rawBytes)
+        {
+            codec = eCodec::RAW;
+            payloadBytes = rawBytes;
+            std::memcpy(payload.data(), samples.data(), rawBytes);
+        }
+
+        sCodecFrameHeader header{
+            codec,
+            uint32_t(samples.size()),
+            uint32_t(payloadBytes),
+            0};
+        std::memcpy(out.data(), &header, sizeof(header));
+        return sizeof(header) + payloadBytes;
+    }
+
+    //--------------------------------------------------------------------------
+    size_t encodeFrame(
+        eCodec codec,
+        std::span<const uint16_t> samples,
+        std::vector<std::byte>& out,
+        eSimdLevel level)
+    {
+        if (samples.size() > UINT32_MAX / sizeof(uint16_t))
+        {
+            throw std::invalid_argument("Too many samples for a codec frame");
+        }
+
+        // Room for the largest frame, trimmed afterwards
+        size_t start = out.size();
+        out.resize(start + maxFrameBytes(samples.size()));
+        size_t bytes = 0;
+        try
+        {
+            bytes = encodeFrame(
+                codec, samples, std::span(out).subspan(start), level);
+        }
+        catch (...)
+        {
+            out.resize(start);
+            throw;
+        }
+        out.resize(start + bytes);
+        return bytes;
+    }
+
+    //--------------------------------------------------------------------------
+    sCodecFrameHeader peekFrame(std::span<const std::byte> bytes)
+    {
+        sCodecFrameHeader header;
+        if (bytes.size() < sizeof(header))
+        {
+            throwCorrupt("truncated header");
+        }
+        std::memcpy(&header, bytes.data(), sizeof(header));
+        if (header.codec > eCodec::RLE)
+        {
+            throwCorrupt("unknown codec");
+        }
+        if (header.payloadBytes > bytes.size() - sizeof(header))
+        {
+            throwCorrupt("truncated payload");
+        }
+        if (header.codec == eCodec::RAW &&
+            header.payloadBytes != header.numSamples * sizeof(uint16_t))
+        {
+            throwCorrupt("payload size mismatch");
+        }
+        return header;
+    }
+
+    //--------------------------------------------------------------------------
+    size_t decodeFrame(
+        std::span<const std::byte> bytes,
+        std::span<uint16_t> samples,
+        eSimdLevel level)
+    {
+        sCodecFrameHeader header = peekFrame(bytes);
+        if (samples.size() < header.numSamples)
+        {
+            throw std::out_of_range("Codec frame has more samples than room");
+        }
+        level = std::min(level, detectedSimdLevel());
+
+        samples = samples.first(header.numSamples);
+        auto payload = bytes.subspan(sizeof(header), header.payloadBytes);
+        switch (header.codec)
+        {
+            case eCodec::RAW:
+                std::memcpy(samples.data(), payload.data(), payload.size());
+                break;
+            case eCodec::DELTA_BITPACK:
+                decodeDeltaBitpack(payload, samples, level);
+                break;
+            case eCodec::RLE:
+                decodeRle(payload, samples, level);
+                break;
+        }
+        return sizeof(header) + header.payloadBytes;
+    }
+
+    //--------------------------------------------------------------------------
+    size_t decodeFrame(
+        std::span<const std::byte> bytes,
+        std::vector<uint16_t>& samples,
+        eSimdLevel level)
+    {
+        sCodecFrameHeader header = peekFrame(bytes);
+        size_t start = samples.size();
+        samples.resize(start + header.numSamples);
+        try
+        {
+            return decodeFrame(
+                bytes, std::span<uint16_t>(samples).subspan(start), level);
+        }
+        catch (...)
+        {
+            samples.resize(start);
+            throw;
+        }
+    }
+
+    //==========================================================================
+    // Sample Stream Codec Implementation
+    //==========================================================================
+
+    //--------------------------------------------------------------------------
+    SampleStreamCodec::SampleStreamCodec(eSimdLevel level)
+    : kernelLevel{std::min(level, detectedSimdLevel())},
+      rawBytesEncoded{0},
+      encodedBytes{0},
+      encodeNs{0},
+      rawBytesDecoded{0},
+      decodeNs{0}
+    {
+        // No Body
+    }
+
+    //--------------------------------------------------------------------------
+    size_t SampleStreamCodec::encode(
+        std::span<const SignalData::sAggregateData> samples,
+        std::vector<std::byte>& out)
+    {
+        uint64_t startNs = Metrics::TscClock::nowNs();
+        analog.resize(samples.size());
+        digital.resize(samples.size());
+        for (size_t i = 0; i < samples.size(); ++i)
+        {
+            analog[i] = samples[i].analog;
+            digital[i] = samples[i].digital;
+        }
+        size_t bytes =
+            encodeFrame(eCodec::DELTA_BITPACK, analog, out, kernelLevel) +
+            encodeFrame(eCodec::RLE, digital, out, kernelLevel);
+
+        encodeNs += Metrics::TscClock::nowNs() - startNs;
+        rawBytesEncoded += samples.size_bytes();
+        encodedBytes += bytes;
+        return bytes;
+    }
+
+    //--------------------------------------------------------------------------
+    size_t SampleStreamCodec::decode(
+        std::span<const std::byte> bytes,
+        std::vector<SignalData::sAggregateData>& samples)
+    {
+        uint64_t startNs = Metrics::TscClock::nowNs();
+        analog.clear();
+        digital.clear();
+        size_t analogBytes = decodeFrame(bytes, analog, kernelLevel);
+        size_t digitalBytes =
+            decodeFrame(bytes.subspan(analogBytes), digital, kernelLevel);
+        if (analog.size() != digital.size())
+        {
+            throwCorrupt("column lengths differ");
+        }
+
+        size_t start = samples.size();
+        samples.resize(start + analog.size());
+        for (size_t i = 0; i < analog.size(); ++i)
+        {
+            samples[start + i] = {analog[i], digital[i]};
+        }
+
+        decodeNs += Metrics::TscClock::nowNs() - startNs;
+        rawBytesDecoded += analog.size() * sizeof(SignalData::sAggregateData);
+        return analogBytes + digitalBytes;
+    }
+
+    //--------------------------------------------------------------------------
+    double SampleStreamCodec::compressionRatio() const
+    {
+        return encodedBytes == 0 ?
+            1.0 : double(rawBytesEncoded) / double(encodedBytes);
+    }
+
+    //--------------------------------------------------------------------------
+    double SampleStreamCodec::encodeGBps() const
+    {
+        return encodeNs == 0 ? 0.0 : double(rawBytesEncoded) / double(encodeNs);
+    }
+
+    //--------------------------------------------------------------------------
+    double SampleStreamCodec::decodeGBps() const
+    {
+        return decodeNs == 0 ? 0.0 : double(rawBytesDecoded) / double(decodeNs);
+    }
+
+    //--------------------------------------------------------------------------
+    void SampleStreamCodec::resetTotals()
+    {
+        rawBytesEncoded = 0;
+        encodedBytes = 0;
+        encodeNs = 0;
+        rawBytesDecoded = 0;
+        decodeNs = 0;
+    }
+
+} // namespace SignalDataFacade
@@ -0,0 +1,848 @@
+// Copyright (c) 2025 Michael Dello
+//
+// This software is provided under the MIT License.
+// See LICENSE file for details.
+
+//-----------------------------------------------------------------------------
+//
+// Derived Channels Implementation
+//
+//-----------------------------------------------------------------------------
+
+#include "facadepattern_derived.h"
+#include <algorithm>
+#include <bit>
+#include <cstring>
+#include <numeric>
+#include <stdexcept>
+
+// SIMD kernels need GCC/Clang target attributes on an x86 CPU
+#if (defined(__GNUC__) || defined(__clang__)) && \
+    (defined(__x86_64__) || defined(__i386__))
+#define FACADEPATTERN_DERIVED_X86_KERNELS 1
+#include <immintrin.h>
+#else
+#define FACADEPATTERN_DERIVED_X86_KERNELS 0
+#endif
+
+namespace // anonymous
+{
+    using SignalDataFacade::eSimdLevel;
+
+    //--------------------------------------------------------------------------
+    // Scalar Kernels, over one tile. Each returns how many samples it did,
+    // the vector kernels leaving the tail to the scalar ones.
+    //--------------------------------------------------------------------------
+    size_t loadScalar(
+        const uint16_t* pSource,
+        size_t count,
+        float gain,
+        float offset,
+        float* pOut)
+    {
+        for (size_t i = 0; i < count; ++i)
+        {
+            pOut[i] = float(pSource[i]) * gain + offset;
+        }
+        return count;
+    }
+
+    //--------------------------------------------------------------------------
+    size_t scaleScalar(float* pValues, size_t count, float gain, float offset)
+    {
+        for (size_t i = 0; i < count; ++i)
+        {
+            pValues[i] = pValues[i] * gain + offset;
+        }
+        return count;
+    }
+
+    //--------------------------------------------------------------------------
+    size_t maskScalar(
+        float* pValues,
+        const uint16_t* pGpio,
+        size_t count,
+        uint16_t bit,
+        bool bWhenHigh)
+    {
+        // Branch free, GPIO lines toggle too unpredictably for a branch
+        uint16_t wanted = bWhenHigh ? bit : 0;
+        for (size_t i = 0; i < count; ++i)
+        {
+            uint32_t valueBits;
+            std::memcpy(&valueBits, &pValues[i], sizeof(valueBits));
+            valueBits &= -uint32_t((pGpio[i] & bit) == wanted);
+            std::memcpy(&pValues[i], &valueBits, sizeof(valueBits));
+        }
+        return count;
+    }
+
+    //--------------------------------------------------------------------------
+    size_t subtractScalar(float* pValues, const float* pOther, size_t count)
+    {
+        for (size_t i = 0; i < count; ++i)
+        {
+            pValues[i] -= pOther[i];
+        }
+        return count;
+    }
+
+#if FACADEPATTERN_DERIVED_X86_KERNELS
+    //--------------------------------------------------------------------------
+    // SSE Kernels
+    //--------------------------------------------------------------------------
+    __attribute__((target("sse4.1")))
+    size_t loadSSE4(
+        const uint16_t* pSource,
+        size_t count,
+        float gain,
+        float offset,
+        float* pOut)
+    {
+        __m128 vGain = _mm_set1_ps(gain);
+        __m128 vOffset = _mm_set1_ps(offset);
+        size_t i = 0;
+        for (; i + 4 <= count; i += 4)
+        {
+            __m128i codes = _mm_loadl_epi64(
+                reinterpret_cast<const __m128i*>(pSource + i));
+            __m128 values = _mm_cvtepi32_ps(_mm_cvtepu16_epi32(codes));
+            _mm_storeu_ps(
+                pOut + i, _mm_add_ps(_mm_mul_ps(values, vGain), vOffset));
+        }
+        return i;
+    }
+
+    //--------------------------------------------------------------------------
+    __attribute__((target("sse4.1")))
+    size_t scaleSSE4(float* pValues, size_t count, float gain, float offset)
+    {
+        __m128 vGain = _mm_set1_ps(gain);
+        __m128 vOffset = _mm_set1_ps(offset);
+        size_t i = 0;
+        for (; i + 4 <= count; i += 4)
+        {
+            __m128 values = _mm_loadu_ps(pValues + i);
+            _mm_storeu_ps(
+                pValues + i, _mm_add_ps(_mm_mul_ps(values, vGain), vOffset));
+        }
+        return i;
+    }
+
+    //--------------------------------------------------------------------------
+    __attribute__((target("sse4.1")))
+    size_t maskSSE4(
+        float* pValues,
+        const uint16_t* pGpio,
+        size_t count,
+        uint16_t bit,
+        bool bWhenHigh)
+    {
+        __m128i vBit = _mm_set1_epi32(bit);
+        __m128i vWanted = _mm_set1_epi32(bWhenHigh ? bit : 0);
+        size_t i = 0;
+        for (; i + 4 <= count; i += 4)
+        {
+            __m128i gpio = _mm_cvtepu16_epi32(_mm_loadl_epi64(
+                reinterpret_cast<const __m128i*>(pGpio + i)));
+            __m128i keep =
+                _mm_cmpeq_epi32(_mm_and_si128(gpio, vBit), vWanted);
+            _mm_storeu_ps(
+                pValues + i,
+                _mm_and_ps(_mm_loadu_ps(pValues + i), _mm_castsi128_ps(keep)));
+        }
+        return i;
+    }
+
+    //--------------------------------------------------------------------------
+    __attribute__((target("sse4.1")))
+    size_t subtractSSE4(float* pValues, const float* pOther, size_t count)
+    {
+        size_t i = 0;
+        for (; i + 4 <= count; i += 4)
+        {
+            _mm_storeu_ps(
+                pValues + i,
+                _mm_sub_ps(
+                    _mm_loadu_ps(pValues + i), _mm_loadu_ps(pOther + i)));
+        }
+        return i;
+    }
+
+    //--------------------------------------------------------------------------
+    // AVX2 Kernels
+    //--------------------------------------------------------------------------
+    __attribute__((target("avx2")))
+    size_t loadAVX2(
+        const uint16_t* pSource,
+        size_t count,
+        float gain,
+        float offset,
+        float* pOut)
+    {
+        __m256 vGain = _mm256_set1_ps(gain);
+        __m256 vOffset = _mm256_set1_ps(offset);
+        size_t i = 0;
+        for (; i + 8 <= count; i += 8)
+        {
+            __m128i codes = _mm_loadu_si128(
+                reinterpret_cast<const __m128i*>(pSource + i));
+            __m256 values = _mm256_cvtepi32_ps(_mm256_cvtepu16_epi32(codes));
+            _mm256_storeu_ps(
+                pOut + i,
+                _mm256_add_ps(_mm256_mul_ps(values, vGain), vOffset));
+        }
+        return i;
+    }
+
+    //--------------------------------------------------------------------------
+    __attribute__((target("avx2")))
+    size_t scaleAVX2(float* pValues, size_t count, float gain, float offset)
+    {
+        __m256 vGain = _mm256_set1_ps(gain);
+        __m256 vOffset = _mm256_set1_ps(offset);
+        size_t i = 0;
+        for (; i + 8 <= count; i += 8)
+        {
+            __m256 values = _mm256_loadu_ps(pValues + i);
+            _mm256_storeu_ps(
+                pValues + i,
+                _mm256_add_ps(_mm256_mul_ps(values, vGain), vOffset));
+        }
+        return i;
+    }
+
+    //--------------------------------------------------------------------------
+    __attribute__((target("avx2")))
+    size_t maskAVX2(
+        float* pValues,
+        const uint16_t* pGpio,
+        size_t count,
+        uint16_t bit,
+        bool bWhenHigh)
+    {
+        __m256i vBit = _mm256_set1_epi32(bit);
+        __m256i vWanted = _mm256_set1_epi32(bWhenHigh ? bit : 0);
+        size_t i = 0;
+        for (; i + 8 <= count; i += 8)
+        {
+            __m256i gpio = _mm256_cvtepu16_epi32(_mm_loadu_si128(
+                reinterpret_cast<const __m128i*>(pGpio + i)));
+            __m256i keep =
+                _mm256_cmpeq_epi32(_mm256_and_si256(gpio, vBit), vWanted);
+            _mm256_storeu_ps(
+                pValues + i,
+                _mm256_and_ps(
+                    _mm256_loadu_ps(pValues + i), _mm256_castsi256_ps(keep)));
+        }
+        return i;
+    }
+
+    //--------------------------------------------------------------------------
+    __attribute__((target("avx2")))
+    size_t subtractAVX2(float* pValues, const float* pOther, size_t count)
+    {
+        size_t i = 0;
+        for (; i + 8 <= count; i += 8)
+        {
+            _mm256_storeu_ps(
+                pValues + i,
+                _mm256_sub_ps(
+                    _mm256_loadu_ps(pValues + i),
+                    _mm256_loadu_ps(pOther + i)));
+        }
+        return i;
+    }
+#endif
+
+    //--------------------------------------------------------------------------
+    // Kernel Dispatch
+    //--------------------------------------------------------------------------
+    void load(
+        const uint16_t* pSource,
+        size_t count,
+        float gain,
+        float offset,
+        float* pOut,
+        eSimdLevel level)
+    {
+        size_t done = 0;
+        switch (level)
+        {
+#if FACADEPATTERN_DERIVED_X86_KERNELS
+            case eSimdLevel::AVX2:
+                done = loadAVX2(pSource, count, gain, offset, pOut);
+                break;
+            case eSimdLevel::SSE4:
+                done = loadSSE4(pSource, count, gain, offset, pOut);
+                break;
+#endif
+            default:
+                break;
+        }
+        loadScalar(pSource + done, count - done, gain, offset, pOut + done);
+    }
+
+    //--------------------------------------------------------------------------
+    void scale(
+        float* pValues,
+        size_t count,
+        float gain,
+        float offset,
+        eSimdLevel level)
+    {
+        size_t done = 0;
+        switch (level)
+        {
+#if FACADEPATTERN_DERIVED_X86_KERNELS
+            case eSimdLevel::AVX2:
+                done = scaleAVX2(pValues, count, gain, offset);
+                break;
+            case eSimdLevel::SSE4:
+                done = scaleSSE4(pValues, count, gain, offset);
+                break;
+#endif
+            default:
+                break;
+        }
+        scaleScalar(pValues + done, count - done, gain, offset);
+    }
+
+    //--------------------------------------------------------------------------
+    void mask(
+        float* pValues,
+        const uint16_t* pGpio,
+        size_t count,
+        uint16_t bit,
+        bool bWhenHigh,
+        eSimdLevel level)
+    {
+        size_t done = 0;
+        switch (level)
+        {
+#if FACADEPATTERN_DERIVED_X86_KERNELS
+            case eSimdLevel::AVX2:
+                done = maskAVX2(pValues, pGpio, count, bit, bWhenHigh);
+                break;
+            case eSimdLevel::SSE4:
+                done = maskSSE4(pValues, pGpio, count, bit, bWhenHigh);
+                break;
+#endif
+            default:
+                break;
+        }
+        maskScalar(pValues + done, pGpio + done, count - done, bit, bWhenHigh);
+    }
+
+    //--------------------------------------------------------------------------
+    void subtract(
+        float* pValues,
+        const float* pOther,
+        size_t count,
+        eSimdLevel level)
+    {
+        size_t done = 0;
+        switch (level)
+        {
+#if FACADEPATTERN_DERIVED_X86_KERNELS
+            case eSimdLevel::AVX2:
+                done = subtractAVX2(pValues, pOther, count);
+                break;
+            case eSimdLevel::SSE4:
+                done = subtractSSE4(pValues, pOther, count);
+                break;
+#endif
+            default:
+                break;
+        }
+        subtractScalar(pValues + done, pOther + done, count - done);
+    }
+
+} // namespace anonymous
+
+namespace SignalDataFacade
+{
+    //--------------------------------------------------------------------------
+    const char* toString(eDerivedOp op)
+    {
+        switch (op)
+        {
+            case eDerivedOp::SOURCE:
+                return "SOURCE";
+            case eDerivedOp::SCALED:
+                return "SCALED";
+            case eDerivedOp::MASKED:
+                return "MASKED";
+            case eDerivedOp::MOVING_AVERAGE:
+                return "MOVING_AVERAGE";
+            case eDerivedOp::DIFFERENCE:
+                return "DIFFERENCE";
+        }
+        return "UNKNOWN";
+    }
+
+    //--------------------------------------------------------------------------
+    DerivedChannels::DerivedChannels(size_t numSources, eSimdLevel level)
+    : kernelLevel{std::min(level, detectedSimdLevel())},
+      sources(numSources),
+      sourceGenerations(numSources, 0),
+      numEvaluations{0}
+    {
+        if (numSources == 0 || numSources > MAX_SOURCES)
+        {
+            throw std::invalid_argument("Invalid number of derived sources");
+        }
+    }
+
+    //--------------------------------------------------------------------------
+    // Declaring Channels
+    //--------------------------------------------------------------------------
+    DerivedChannel DerivedChannels::source(size_t sourceIndex)
+    {
+        if (sourceIndex >= sources.size())
+        {
+            throw std::out_of_range("No such derived channel source");
+        }
+        sNode node{};
+        node.op = eDerivedOp::SOURCE;
+        node.sourceIndex = sourceIndex;
+        node.sourceMask = uint64_t{1} << sourceIndex;
+        return declare(node);
+    }
+
+    //--------------------------------------------------------------------------
+    DerivedChannel DerivedChannels::scaled(
+        DerivedChannel x,
+        float gain,
+        float offset)
+    {
+        sNode node{};
+        node.op = eDerivedOp::SCALED;
+        node.x = x;
+        node.gain = gain;
+        node.offset = offset;
+        node.sourceMask = nodeAt(x).sourceMask;
+        return declare(node);
+    }
+
+    //--------------------------------------------------------------------------
+    DerivedChannel DerivedChannels::masked(
+        DerivedChannel x,
+        size_t gpioSource,
+        uint8_t line,
+        bool bWhenHigh)
+    {
+        if (gpioSource >= sources.size())
+        {
+            throw std::out_of_range("No such derived channel source");
+        }
+        if (line >= 16)
+        {
+            throw std::invalid_argument("Invalid derived channel GPIO line");
+        }
+        sNode node{};
+        node.op = eDerivedOp::MASKED;
+        node.x = x;
+        node.sourceIndex = gpioSource;
+        node.line = line;
+        node.bWhenHigh = bWhenHigh;
+        node.sourceMask = nodeAt(x).sourceMask | (uint64_t{1} << gpioSource);
+        return declare(node);
+    }
+
+    //--------------------------------------------------------------------------
+    DerivedChannel DerivedChannels::movingAverage(
+        DerivedChannel x,
+        size_t window)
+    {
+        if (window == 0)
+        {
+            throw std::invalid_argument("Invalid moving average window");
+        }
+        sNode node{};
+        node.op = eDerivedOp::MOVING_AVERAGE;
+        node.x = x;
+        node.window = window;
+        node.sourceMask = nodeAt(x).sourceMask;
+        return declare(node);
+    }
+
+    //--------------------------------------------------------------------------
+    DerivedChannel DerivedChannels::difference(
+        DerivedChannel x,
+        DerivedChannel y)
+    {
+        sNode node{};
+        node.op = eDerivedOp::DIFFERENCE;
+        node.x = x;
+        node.y = y;
+        node.sourceMask = nodeAt(x).sourceMask | nodeAt(y).sourceMask;
+        return declare(node);
+    }
+
+    //--------------------------------------------------------------------------
+    DerivedChannel DerivedChannels::declare(const sNode& node)
+    {
+        // Graphs are small, a linear search finds an equal expression
+        for (size_t i = 0; i < nodes.size(); ++i)
+        {
+            const sNode& existing = nodes[i];
+            if (existing.op == node.op &&
+                existing.x == node.x &&
+                existing.y == node.y &&
+                existing.sourceIndex == node.sourceIndex &&
+                existing.gain == node.gain &&
+                existing.offset == node.offset &&
+                existing.line == node.line &&
+                existing.bWhenHigh == node.bWhenHigh &&
+                existing.window == node.window)
+            {
+                return DerivedChannel(i);
+            }
+        }
+        nodes.push_back(node);
+        if (node.op == eDerivedOp::MOVING_AVERAGE)
+        {
+            nodes.back().history.assign(node.window, 0.0f);
+        }
+        if (node.op != eDerivedOp::SOURCE)
+        {
+            ++nodes[node.x].numConsumers;
+        }
+        if (node.op == eDerivedOp::DIFFERENCE)
+        {
+            ++nodes[node.y].numConsumers;
+        }
+        return DerivedChannel(nodes.size() - 1);
+    }
+
+    //--------------------------------------------------------------------------
+    eDerivedOp DerivedChannels::op(DerivedChannel channel) const
+    {
+        return nodeAt(channel).op;
+    }
+
+    //--------------------------------------------------------------------------
+    const DerivedChannels::sNode& DerivedChannels::nodeAt(
+        DerivedChannel channel) const
+    {
+        if (channel >= nodes.size())
+        {
+            throw std::out_of_range("No such derived channel");
+        }
+        return nodes[channel];
+    }
+
+    //--------------------------------------------------------------------------
+    // Feeding Blocks
+    //--------------------------------------------------------------------------
+    void DerivedChannels::setSources(
+        std::span<const std::span<const uint16_t>> columns)
+    {
+        if (columns.size() != sources.size())
+        {
+            throw std::invalid_argument("Wrong number of derived sources");
+        }
+        catchUp();
+        for (size_t i = 0; i < columns.size(); ++i)
+        {
+            sources[i] = columns[i];
+            ++sourceGenerations[i];
+        }
+    }
+
+    //--------------------------------------------------------------------------
+    void DerivedChannels::setBlock(const sSampleBlockView& block)
+    {
+        const std::span<const uint16_t> columns[] = {
+            block.analog, block.digital};
+        setSources(columns);
+    }
+
+    //--------------------------------------------------------------------------
+    void DerivedChannels::setSource(
+        size_t sourceIndex,
+        std::span<const uint16_t> column)
+    {
+        if (sourceIndex >= sources.size())
+        {
+            throw std::out_of_range("No such derived channel source");
+        }
+        sources[sourceIndex] = column;
+        ++sourceGenerations[sourceIndex];
+    }
+
+    //--------------------------------------------------------------------------
+    void DerivedChannels::catchUp()
+    {
+        for (size_t i = 0; i < nodes.size(); ++i)
+        {
+            const sNode& node = nodes[i];
+            if (node.op != eDerivedOp::MOVING_AVERAGE || isCached(node))
+            {
+                continue;
+            }
+            // Nothing to catch up before the first block
+            bool bFed = true;
+            for (size_t source = 0; source < sources.size(); ++source)
+            {
+                bFed = bFed && (!(node.sourceMask >> source & 1) ||
+                    sourceGenerations[source] > 0);
+            }
+            if (bFed)
+            {
+                evaluate(DerivedChannel(i));
+            }
+        }
+    }
+
+    //--------------------------------------------------------------------------
+    void DerivedChannels::reset()
+    {
+        for (auto& node : nodes)
+        {
+            if (node.op == eDerivedOp::MOVING_AVERAGE)
+            {
+                std::fill(node.history.begin(), node.history.end(), 0.0f);
+                node.numSeen = 0;
+                // Left out of the new stream, rather than caught up
+                node.cachedKey = keyOf(node);
+                node.bCached = true;
+            }
+        }
+    }
+
+    //--------------------------------------------------------------------------
+    // Evaluation
+    //--------------------------------------------------------------------------
+    std::span<const float> DerivedChannels::read(DerivedChannel channel)
+    {
+        nodeAt(channel);
+        if (!isCached(nodes[channel]))
+        {
+            evaluate(channel);
+        }
+        return nodes[channel].values;
+    }
+
+    //--------------------------------------------------------------------------
+    uint64_t DerivedChannels::keyOf(const sNode& node) const
+    {
+        uint64_t key = 0;
+        for (uint64_t mask = node.sourceMask; mask != 0; mask &= mask - 1)
+        {
+            key += sourceGenerations[std::countr_zero(mask)];
+        }
+        return key;
+    }
+
+    //--------------------------------------------------------------------------
+    bool DerivedChannels::isCached(const sNode& node) const
+    {
+        return node.bCached && node.cachedKey == keyOf(node);
+    }
+
+    //--------------------------------------------------------------------------
+    size_t DerivedChannels::lengthOf(const sNode& node) const
+    {
+        size_t length = sources[std::countr_zero(node.sourceMask)].size();
+        for (uint64_t mask = node.sourceMask; mask != 0; mask &= mask - 1)
+        {
+            if (sources[std::countr_zero(mask)].size() != length)
+            {
+                throw std::invalid_argument(
+                    "Derived channel sources differ in length");
+            }
+        }
+        return length;
+    }
+
+    //--------------------------------------------------------------------------
+    void DerivedChannels::evaluate(DerivedChannel channel)
+    {
+        size_t length = lengthOf(nodes[channel]);
+        if (nodes[channel].op == eDerivedOp::MOVING_AVERAGE)
+        {
+            evaluateMovingAverage(nodes[channel], length);
+        }
+        else
+        {
+            std::vector<sInstruction> program;
+            size_t depth = compile(channel, true, program);
+            nodes[channel].values.resize(length);
+            run(program, depth, nodes[channel].values);
+        }
+        sNode& node = nodes[channel];
+        node.cachedKey = keyOf(node);
+        node.bCached = true;
+        ++numEvaluations;
+    }
+
+    //--------------------------------------------------------------------------
+    void DerivedChannels::evaluateMovingAverage(sNode& node, size_t length)
+    {
+        // Compiling can evaluate other moving averages, which reuse windowed
+        std::vector<sInstruction> program;
+        size_t depth = compile(node.x, false, program);
+
+        // The window history, then the block's input values
+        size_t window = node.window;
+        windowed.resize(window + length);
+        std::copy(node.history.begin(), node.history.end(), windowed.begin());
+        run(program, depth, std::span(windowed).subspan(window));
+
+        // Summed afresh each block, so rounding cannot build up
+        double sum = std::accumulate(
+            windowed.begin(), windowed.begin() + window, 0.0);
+        node.values.resize(length);
+        for (size_t i = 0; i < length; ++i)
+        {
+            sum += double(windowed[window + i]) - double(windowed[i]);
+            // Averaging only the samples seen at the start of a stream
+            uint64_t numAveraged = std::min<uint64_t>(node.numSeen + i + 1,
+                window);
+            node.values[i] = float(sum / double(numAveraged));
+        }
+        node.numSeen += length;
+        std::copy(
+            windowed.end() - window, windowed.end(), node.history.begin());
+    }
+
+    //--------------------------------------------------------------------------
+    size_t DerivedChannels::compile(
+        DerivedChannel channel,
+        bool bRoot,
+        std::vector<sInstruction>& program)
+    {
+        // Moving averages, channels feeding several others and channels
+        // already computed are loaded whole. A shared channel is computed
+        // once for all its consumers rather than again in each program.
+        const sNode& node = nodes[channel];
+        bool bShared = !bRoot && node.op != eDerivedOp::SOURCE &&
+            node.numConsumers > 1;
+        if ((node.op == eDerivedOp::MOVING_AVERAGE || bShared) &&
+            !isCached(node))
+        {
+            evaluate(channel);
+        }
+        if (!bRoot && isCached(nodes[channel]))
+        {
+            program.push_back({.code = sInstruction::eCode::LOAD_CHANNEL,
+                               .index = channel});
+            return 1;
+        }
+
+        size_t depth = 1;
+        switch (node.op)
+        {
+            case eDerivedOp::SOURCE:
+                program.push_back({.code = sInstruction::eCode::LOAD_SOURCE,
+                                   .index = node.sourceIndex,
+                                   .gain = 1.0f,
+                                   .offset = 0.0f});
+                break;
+            case eDerivedOp::SCALED:
+                depth = compile(node.x, false, program);
+                // Scaling a source is fused into its load
+                if (program.back().code ==
+                    sInstruction::eCode::LOAD_SOURCE)
+                {
+                    sInstruction& loaded = program.back();
+                    loaded.gain *= node.gain;
+                    loaded.offset = loaded.offset * node.gain + node.offset;
+                }
+                else
+                {
+                    program.push_back({.code = sInstruction::eCode::SCALE,
+                                       .gain = node.gain,
+                                       .offset = node.offset});
+                }
+                break;
+            case eDerivedOp::MASKED:
+                depth = compile(node.x, false, program);
+                program.push_back({.code = sInstruction::eCode::MASK,
+                                   .index = node.sourceIndex,
+                                   .bit = uint16_t(1u << node.line),
+                                   .bWhenHigh = node.bWhenHigh});
+                break;
+            case eDerivedOp::DIFFERENCE:
+            {
+                // x is pushed first, y above it while x is held
+                size_t xDepth = compile(node.x, false, program);
+                size_t yDepth = compile(node.y, false, program);
+                depth = std::max(xDepth, yDepth + 1);
+                program.push_back({.code = sInstruction::eCode::SUBTRACT});
+                break;
+            }
+            case eDerivedOp::MOVING_AVERAGE:
+                // Root only, evaluated by evaluateMovingAverage()
+                break;
+        }
+        return depth;
+    }
+
+    //--------------------------------------------------------------------------
+    void DerivedChannels::run(
+        const std::vector<sInstruction>& program,
+        size_t depth,
+        std::span<float> out)
+    {
+        // Slot 0 is the output itself, the others are tiles in L1
+        stack.resize(depth * TILE_SAMPLES);
+        for (size_t first = 0; first < out.size(); first += TILE_SAMPLES)
+        {
+            size_t count = std::min(TILE_SAMPLES, out.size() - first);
+            auto slot = [&](size_t index)
+            {
+                return index == 0 ? out.data() + first :
+                    stack.data() + index * TILE_SAMPLES;
+            };
+
+            size_t top = 0;
+            for (const auto& instruction : program)
+            {
+                switch (instruction.code)
+                {
+                    case sInstruction::eCode::LOAD_SOURCE:
+                        load(
+                            sources[instruction.index].data() + first,
+                            count,
+                            instruction.gain,
+                            instruction.offset,
+                            slot(top++),
+                            kernelLevel);
+                        break;
+                    case sInstruction::eCode::LOAD_CHANNEL:
+                        std::memcpy(
+                            slot(top++),
+                            nodes[instruction.index].values.data() + first,
+                            count * sizeof(float));
+                        break;
+                    case sInstruction::eCode::SCALE:
+                        scale(
+                            slot(top - 1),
+                            count,
+                            instruction.gain,
+                            instruction.offset,
+                            kernelLevel);
+                        break;
+                    case sInstruction::eCode::MASK:
+                        mask(
+                            slot(top - 1),
+                            sources[instruction.index].data() + first,
+                            count,
+                            instruction.bit,
+                            instruction.bWhenHigh,
+                            kernelLevel);
+                        break;
+                    case sInstruction::eCode::SUBTRACT:
+                        --top;
+                        subtract(
+                            slot(top - 1), slot(top), count, kernelLevel);
+                        break;
+                }
+            }
+        }
+    }
+
+} // namespace SignalDataFacade
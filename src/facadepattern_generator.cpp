@@ -0,0 +1,537 @@
+// Copyright (c) 2025 Michael Dello
+//
+// This software is provided under the MIT License.
+// See LICENSE file for details.
+
+//-----------------------------------------------------------------------------
+//
+// Synthetic Signal Generator Implementation
+//
+//-----------------------------------------------------------------------------
+
+#include "facadepattern_generator.h"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <numbers>
+#include <stdexcept>
+
+namespace // anonymous
+{
+    //--------------------------------------------------------------------------
+    // Constants
+    //--------------------------------------------------------------------------
+    // 4096 entries, a quantization well below that of a 16-bit converter's
+    // noise floor for test signals
+    constexpr unsigned SINE_TABLE_BITS = 12;
+    constexpr double PHASE_CYCLE = 18446744073709551616.0; // 2^64
+    // Samples scratch-generated at a time when scanning
+    constexpr size_t SCAN_BLOCK_FRAMES = 256;
+
+    //--------------------------------------------------------------------------
+    // Local Functions
+    //--------------------------------------------------------------------------
+    uint16_t clampToCode(int64_t value)
+    {
+        return uint16_t(std::clamp<int64_t>(value, 0, 65535));
+    }
+
+    //--------------------------------------------------------------------------
+    // Phase advance per sample, for a frequency below Nyquist
+    uint64_t phaseIncrementOf(double frequencyHz, double sampleRateHz)
+    {
+        double fraction = frequencyHz / sampleRateHz;
+        if (!(fraction >= 0.0 && fraction < 0.5))
+        {
+            throw std::invalid_argument(
+                "Generator frequency must be in [0, Nyquist)");
+        }
+        return uint64_t(fraction * PHASE_CYCLE);
+    }
+
+    //--------------------------------------------------------------------------
+    uint64_t dutyPhaseOf(double dutyCycle)
+    {
+        if (!(dutyCycle >= 0.0 && dutyCycle <= 1.0))
+        {
+            throw std::invalid_argument("Duty cycle must be in [0, 1]");
+        }
+        return dutyCycle >= 1.0 ?
+            std::numeric_limits<uint64_t>::max() :
+            uint64_t(dutyCycle * PHASE_CYCLE);
+    }
+
+    //--------------------------------------------------------------------------
+    // Samples until the next event of the given per-sample probability, a
+    // geometric draw, so rare events cost nothing per sample
+    uint64_t samplesUntilEvent(Random::Xoshiro256pp& rng, double probability)
+    {
+        constexpr uint64_t NEVER = std::numeric_limits<uint64_t>::max() / 2;
+        if (probability <= 0.0)
+        {
+            return NEVER;
+        }
+        if (probability >= 1.0)
+        {
+            return 0;
+        }
+        // In (0, 1], so the logarithm is finite
+        double uniform = 1.0 - rng.nextDouble();
+        double gap = std::floor(std::log(uniform) / std::log1p(-probability));
+        return gap < double(NEVER) ? uint64_t(gap) : NEVER;
+    }
+
+    //--------------------------------------------------------------------------
+    // Index in [0, count), from the top bits of a draw
+    uint32_t uniformIndex(Random::Xoshiro256pp& rng, uint32_t count)
+    {
+        return uint32_t(((rng() >> 32) * count) >> 32);
+    }
+
+    //--------------------------------------------------------------------------
+    void requireProbability(double probability)
+    {
+        if (!(probability >= 0.0 && probability <= 1.0))
+        {
+            throw std::invalid_argument(
+                "Glitch probability must be in [0, 1]");
+        }
+    }
+
+} // namespace anonymous
+
+namespace SignalDataFacade
+{
+    //--------------------------------------------------------------------------
+    const char* toString(eWaveform waveform)
+    {
+        switch (waveform)
+        {
+            case eWaveform::SINE:
+                return "SINE";
+            case eWaveform::SQUARE:
+                return "SQUARE";
+            case eWaveform::CHIRP:
+                return "CHIRP";
+            case eWaveform::NOISE:
+                return "NOISE";
+            case eWaveform::STEPS:
+                return "STEPS";
+        }
+        return "UNKNOWN";
+    }
+
+    //==========================================================================
+    // Signal Generator
+    //==========================================================================
+
+    //--------------------------------------------------------------------------
+    SignalGenerator::SignalGenerator(const sWaveformConfig_t& config)
+    : waveformConfig{config},
+      phaseIncrement{0},
+      startIncrement{0},
+      chirpStep{0},
+      sweepSamples{1},
+      dutyPhase{0},
+      samplesPerStep{1},
+      stepLevel{config.center}
+    {
+        if (!(config.sampleRateHz > 0.0))
+        {
+            throw std::invalid_argument("Sample rate must be positive");
+        }
+        requireProbability(config.glitchProbability);
+
+        int64_t low = int64_t(config.center) - config.amplitude;
+        int64_t high = int64_t(config.center) + config.amplitude;
+        switch (config.waveform)
+        {
+            case eWaveform::SINE:
+            case eWaveform::CHIRP:
+            {
+                sineTable.resize(size_t{1} << SINE_TABLE_BITS);
+                for (size_t i = 0; i < sineTable.size(); ++i)
+                {
+                    double angle =
+                        2.0 * std::numbers::pi * double(i) / sineTable.size();
+                    sineTable[i] = clampToCode(std::llround(
+                        config.center + config.amplitude * std::sin(angle)));
+                }
+                startIncrement =
+                    phaseIncrementOf(config.frequencyHz, config.sampleRateHz);
+                if (config.waveform == eWaveform::CHIRP)
+                {
+                    uint64_t endIncrement = phaseIncrementOf(
+                        config.chirpEndHz, config.sampleRateHz);
+                    double sweep = config.sweepSeconds * config.sampleRateHz;
+                    if (!(sweep >= 1.0))
+                    {
+                        throw std::invalid_argument(
+                            "Chirp sweep must last at least one sample");
+                    }
+                    sweepSamples = uint64_t(sweep);
+                    // Both increments are below 2^63, so the difference fits
+                    chirpStep = uint64_t(
+                        (int64_t(endIncrement) - int64_t(startIncrement)) /
+                        int64_t(sweepSamples));
+                }
+                break;
+            }
+            case eWaveform::SQUARE:
+                levels = {clampToCode(low), clampToCode(high)};
+                startIncrement =
+                    phaseIncrementOf(config.frequencyHz, config.sampleRateHz);
+                dutyPhase = dutyPhaseOf(config.dutyCycle);
+                break;
+            case eWaveform::NOISE:
+                break;
+            case eWaveform::STEPS:
+            {
+                if (config.numLevels == 0 || !(config.frequencyHz > 0.0))
+                {
+                    throw std::invalid_argument(
+                        "Steps need levels and a positive rate");
+                }
+                levels.resize(config.numLevels);
+                for (size_t i = 0; i < levels.size(); ++i)
+                {
+                    levels[i] = config.numLevels == 1 ?
+                        config.center :
+                        clampToCode(low + (high - low) * int64_t(i) /
+                            int64_t(config.numLevels - 1));
+                }
+                samplesPerStep = std::max<uint64_t>(
+                    1,
+                    uint64_t(std::llround(
+                        config.sampleRateHz / config.frequencyHz)));
+                break;
+            }
+            default:
+                throw std::invalid_argument("Unknown waveform");
+        }
+
+        reset();
+    }
+
+    //--------------------------------------------------------------------------
+    void SignalGenerator::reset()
+    {
+        rng = Random::Xoshiro256pp{waveformConfig.seed};
+        noiseKey = rng();
+        glitchRng = rng;
+        glitchRng.jump();
+        sampleIndex = 0;
+        phase = 0;
+        phaseIncrement = startIncrement;
+        sweepPosition = 0;
+        stepRemaining = 0;
+        glitchCountdown = samplesUntilGlitch();
+    }
+
+    //--------------------------------------------------------------------------
+    void SignalGenerator::generate(std::span<uint16_t> samples)
+    {
+        switch (waveformConfig.waveform)
+        {
+            case eWaveform::SINE:
+            {
+                const uint16_t* pTable = sineTable.data();
+                uint64_t start = phase;
+                uint64_t increment = phaseIncrement;
+                for (size_t i = 0; i < samples.size(); ++i)
+                {
+                    uint64_t samplePhase = start + i * increment;
+                    samples[i] = pTable[samplePhase >> (64 - SINE_TABLE_BITS)];
+                }
+                phase = start + samples.size() * increment;
+                break;
+            }
+            case eWaveform::SQUARE:
+            {
+                uint64_t start = phase;
+                uint64_t increment = phaseIncrement;
+                uint64_t threshold = dutyPhase;
+                uint16_t low = levels[0];
+                uint16_t high = levels[1];
+                for (size_t i = 0; i < samples.size(); ++i)
+                {
+                    uint64_t samplePhase = start + i * increment;
+                    samples[i] = samplePhase < threshold ? high : low;
+                }
+                phase = start + samples.size() * increment;
+                break;
+            }
+            case eWaveform::CHIRP:
+                generateChirp(samples);
+                break;
+            case eWaveform::NOISE:
+                fillNoise(
+                    samples,
+                    int32_t(waveformConfig.center) - waveformConfig.amplitude,
+                    2 * uint32_t(waveformConfig.amplitude) + 1,
+                    false);
+                break;
+            case eWaveform::STEPS:
+                generateSteps(samples);
+                break;
+        }
+
+        if (waveformConfig.noiseAmplitude != 0)
+        {
+            fillNoise(
+                samples,
+                -int32_t(waveformConfig.noiseAmplitude),
+                2 * uint32_t(waveformConfig.noiseAmplitude) + 1,
+                true);
+        }
+        addGlitches(samples);
+        sampleIndex += samples.size();
+    }
+
+    //--------------------------------------------------------------------------
+    uint16_t SignalGenerator::next()
+    {
+        uint16_t sample;
+        generate(std::span(&sample, 1));
+        return sample;
+    }
+
+    //--------------------------------------------------------------------------
+    void SignalGenerator::generateChirp(std::span<uint16_t> samples)
+    {
+        const uint16_t* pTable = sineTable.data();
+        size_t done = 0;
+        while (done < samples.size())
+        {
+            // A segment never crosses the end of a sweep
+            size_t count = size_t(std::min<uint64_t>(
+                samples.size() - done, sweepSamples - sweepPosition));
+
+            // phase(i) = phase + i * increment + i * (i - 1) / 2 * step,
+            // exact in modulo 2^64 arithmetic
+            uint64_t start = phase;
+            uint64_t increment = phaseIncrement;
+            uint64_t step = chirpStep;
+            uint16_t* pOut = samples.data() + done;
+            for (size_t i = 0; i < count; ++i)
+            {
+                uint64_t triangle = uint64_t(i) * (i - 1) / 2;
+                uint64_t samplePhase = start + i * increment + triangle * step;
+                pOut[i] = pTable[samplePhase >> (64 - SINE_TABLE_BITS)];
+            }
+
+            uint64_t triangle = uint64_t(count) * (count - 1) / 2;
+            phase = start + count * increment + triangle * step;
+            phaseIncrement = increment + count * step;
+            sweepPosition += count;
+            if (sweepPosition == sweepSamples)
+            {
+                sweepPosition = 0;
+                phaseIncrement = startIncrement;
+            }
+            done += count;
+        }
+    }
+
+    //--------------------------------------------------------------------------
+    void SignalGenerator::generateSteps(std::span<uint16_t> samples)
+    {
+        size_t done = 0;
+        while (done < samples.size())
+        {
+            if (stepRemaining == 0)
+            {
+                stepLevel =
+                    levels[uniformIndex(rng, uint32_t(levels.size()))];
+                stepRemaining = samplesPerStep;
+            }
+            size_t count = size_t(
+                std::min<uint64_t>(samples.size() - done, stepRemaining));
+            std::fill_n(samples.begin() + done, count, stepLevel);
+            stepRemaining -= count;
+            done += count;
+        }
+    }
+
+    //--------------------------------------------------------------------------
+    void SignalGenerator::fillNoise(
+        std::span<uint16_t> samples,
+        int32_t low,
+        uint32_t range,
+        bool bAdd) const
+    {
+        // Sample n takes 16 bits of the hash of n / 4, so it depends only on
+        // the seed and its index
+        for (size_t i = 0; i < samples.size(); ++i)
+        {
+            uint64_t index = sampleIndex + i;
+            uint64_t counter = noiseKey + (index >> 2) * 0x9e3779b97f4a7c15;
+            uint64_t bits = Random::splitmix64(counter);
+            uint32_t uniform = uint16_t(bits >> (16 * (index & 3)));
+            int64_t offset = low + int64_t((uniform * uint64_t(range)) >> 16);
+            samples[i] = clampToCode((bAdd ? samples[i] : 0) + offset);
+        }
+    }
+
+    //--------------------------------------------------------------------------
+    void SignalGenerator::addGlitches(std::span<uint16_t> samples)
+    {
+        size_t position = 0;
+        while (glitchCountdown < samples.size() - position)
+        {
+            position += glitchCountdown;
+            samples[position++] = uint16_t(glitchRng() >> 48);
+            glitchCountdown = samplesUntilGlitch();
+        }
+        glitchCountdown -= samples.size() - position;
+    }
+
+    //--------------------------------------------------------------------------
+    uint64_t SignalGenerator::samplesUntilGlitch()
+    {
+        return samplesUntilEvent(glitchRng, waveformConfig.glitchProbability);
+    }
+
+    //==========================================================================
+    // Synthetic ADC Driver
+    //==========================================================================
+
+    //--------------------------------------------------------------------------
+    SyntheticADCDrv::SyntheticADCDrv(const sWaveformConfig_t& config)
+    : bStarted{false}, numScanChannels{1}, generator{config}
+    {
+        // No Body
+    }
+
+    //--------------------------------------------------------------------------
+    void SyntheticADCDrv::start()
+    {
+        bStarted = true;
+    }
+
+    //--------------------------------------------------------------------------
+    void SyntheticADCDrv::stop()
+    {
+        bStarted = false;
+    }
+
+    //--------------------------------------------------------------------------
+    std::optional<uint16_t> SyntheticADCDrv::read()
+    {
+        if (!bStarted)
+        {
+            return {};
+        }
+        return generator.next();
+    }
+
+    //--------------------------------------------------------------------------
+    size_t SyntheticADCDrv::readBlock(std::span<uint16_t> samples)
+    {
+        if (!bStarted)
+        {
+            return 0;
+        }
+        generator.generate(samples);
+        return samples.size();
+    }
+
+    //--------------------------------------------------------------------------
+    bool SyntheticADCDrv::configureScan(std::span<const uint8_t> channels)
+    {
+        if (channels.empty() || channels.size() > ADCDrv::NUM_CHANNELS)
+        {
+            return false;
+        }
+        numScanChannels = channels.size();
+        return true;
+    }
+
+    //--------------------------------------------------------------------------
+    size_t SyntheticADCDrv::scan(std::span<uint16_t> frames)
+    {
+        if (!bStarted)
+        {
+            return 0;
+        }
+
+        size_t numFrames = frames.size() / numScanChannels;
+        std::array<uint16_t, SCAN_BLOCK_FRAMES> block;
+        for (size_t done = 0; done < numFrames; done += SCAN_BLOCK_FRAMES)
+        {
+            size_t count = std::min(SCAN_BLOCK_FRAMES, numFrames - done);
+            generator.generate(std::span(block).first(count));
+            uint16_t* pFrame = frames.data() + done * numScanChannels;
+            for (size_t i = 0; i < count; ++i)
+            {
+                std::fill_n(pFrame, numScanChannels, block[i]);
+                pFrame += numScanChannels;
+            }
+        }
+        return numFrames;
+    }
+
+    //==========================================================================
+    // Synthetic GPIO Driver
+    //==========================================================================
+
+    //--------------------------------------------------------------------------
+    SyntheticGPIODrv::SyntheticGPIODrv(const sGpioGeneratorConfig_t& config)
+    : gpioConfig{config}, rng{config.seed}, phases{}, increments{}, dutyPhases{}
+    {
+        if (!(config.sampleRateHz > 0.0) || config.lines.size() > MAX_LINES)
+        {
+            throw std::invalid_argument("Invalid GPIO generator configuration");
+        }
+        requireProbability(config.glitchProbability);
+        for (size_t line = 0; line < config.lines.size(); ++line)
+        {
+            increments[line] = phaseIncrementOf(
+                config.lines[line].frequencyHz, config.sampleRateHz);
+            dutyPhases[line] = dutyPhaseOf(config.lines[line].dutyCycle);
+        }
+        glitchCountdown = samplesUntilEvent(rng, config.glitchProbability);
+    }
+
+    //--------------------------------------------------------------------------
+    std::optional<uint16_t> SyntheticGPIODrv::read()
+    {
+        uint16_t sample;
+        readBlock(std::span(&sample, 1));
+        return sample;
+    }
+
+    //--------------------------------------------------------------------------
+    size_t SyntheticGPIODrv::readBlock(std::span<uint16_t> samples)
+    {
+        std::fill(samples.begin(), samples.end(), uint16_t{0});
+        for (size_t line = 0; line < gpioConfig.lines.size(); ++line)
+        {
+            uint64_t start = phases[line];
+            uint64_t increment = increments[line];
+            uint64_t threshold = dutyPhases[line];
+            uint16_t bit = uint16_t(1u << line);
+            for (size_t i = 0; i < samples.size(); ++i)
+            {
+                uint64_t samplePhase = start + i * increment;
+                samples[i] |= samplePhase < threshold ? bit : uint16_t{0};
+            }
+            phases[line] = start + samples.size() * increment;
+        }
+
+        size_t numLines = gpioConfig.lines.size();
+        size_t position = 0;
+        while (numLines != 0 && glitchCountdown < samples.size() - position)
+        {
+            position += glitchCountdown;
+            samples[position++] ^=
+                uint16_t(1u << uniformIndex(rng, uint32_t(numLines)));
+            glitchCountdown =
+                samplesUntilEvent(rng, gpioConfig.glitchProbability);
+        }
+        glitchCountdown -= std::min<uint64_t>(
+            glitchCountdown, samples.size() - position);
+        return samples.size();
+    }
+
+} // namespace SignalDataFacade
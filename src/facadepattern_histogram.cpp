@@ -0,0 +1,510 @@
+// Copyright (c) 2025 Michael Dello
+//
+// This software is provided under the MIT License.
+// See LICENSE file for details.
+
+//-----------------------------------------------------------------------------
+//
+// Streaming Histogram and Quantile Sketch Implementation
+//
+//-----------------------------------------------------------------------------
+
+#include "facadepattern_histogram.h"
+#include <algorithm>
+#include <bit>
+#include <cmath>
+#include <limits>
+#include <numeric>
+#include <stdexcept>
+
+namespace // anonymous
+{
+    //--------------------------------------------------------------------------
+    // Constants
+    //--------------------------------------------------------------------------
+    // Level capacities shrink by this factor per level below the top
+    constexpr double CAPACITY_DECAY = 2.0 / 3.0;
+    // Smallest level capacity, so every compaction promotes a sample
+    constexpr size_t MIN_CAPACITY = 2;
+
+    //--------------------------------------------------------------------------
+    // Local Functions
+    //--------------------------------------------------------------------------
+    void requireQuantile(double q)
+    {
+        // Also rejects NaN
+        if (!(q >= 0.0 && q <= 1.0))
+        {
+            throw std::invalid_argument("Quantile must be within [0, 1]");
+        }
+    }
+
+    //--------------------------------------------------------------------------
+    // 1-based rank of quantile q among count samples
+    uint64_t targetRank(double q, uint64_t count)
+    {
+        auto rank = static_cast<uint64_t>(std::ceil(q * double(count)));
+        return std::clamp<uint64_t>(rank, 1, count);
+    }
+
+} // namespace anonymous
+
+namespace SignalDataFacade
+{
+    //--------------------------------------------------------------------------
+    // SampleHistogram Public Methods
+    //--------------------------------------------------------------------------
+
+    //--------------------------------------------------------------------------
+    SampleHistogram::SampleHistogram()
+    : bins(NUM_BINS, 0),
+      totalCount{0}
+    {
+        // No Body
+    }
+
+    //--------------------------------------------------------------------------
+    void SampleHistogram::add(std::span<const uint16_t> samples)
+    {
+        // Four independent increments per iteration keep several bin updates
+        // in flight. Neighbouring samples of a slow signal often share a bin,
+        // which serialises those increments whatever the unrolling, but never
+        // makes the result wrong.
+        uint64_t* pBins = bins.data();
+        const uint16_t* pSamples = samples.data();
+        size_t n = samples.size();
+        size_t i = 0;
+        for (; i + 4 <= n; i += 4)
+        {
+            ++pBins[pSamples[i]];
+            ++pBins[pSamples[i + 1]];
+            ++pBins[pSamples[i + 2]];
+            ++pBins[pSamples[i + 3]];
+        }
+        for (; i < n; ++i)
+        {
+            ++pBins[pSamples[i]];
+        }
+        totalCount += n;
+    }
+
+    //--------------------------------------------------------------------------
+    void SampleHistogram::merge(const SampleHistogram& other)
+    {
+        for (size_t i = 0; i < NUM_BINS; ++i)
+        {
+            bins[i] += other.bins[i];
+        }
+        totalCount += other.totalCount;
+    }
+
+    //--------------------------------------------------------------------------
+    void SampleHistogram::reset()
+    {
+        std::fill(bins.begin(), bins.end(), 0);
+        totalCount = 0;
+    }
+
+    //--------------------------------------------------------------------------
+    uint64_t SampleHistogram::rank(uint16_t sample) const
+    {
+        return std::accumulate(
+            bins.begin(),
+            bins.begin() + sample + 1,
+            uint64_t{0});
+    }
+
+    //--------------------------------------------------------------------------
+    uint16_t SampleHistogram::min() const
+    {
+        auto it = std::find_if(
+            bins.begin(),
+            bins.end(),
+            [](uint64_t binCount) { return binCount != 0; });
+        return it == bins.end() ? 0 : uint16_t(it - bins.begin());
+    }
+
+    //--------------------------------------------------------------------------
+    uint16_t SampleHistogram::max() const
+    {
+        auto it = std::find_if(
+            bins.rbegin(),
+            bins.rend(),
+            [](uint64_t binCount) { return binCount != 0; });
+        return it == bins.rend() ? 0 : uint16_t(bins.rend() - it - 1);
+    }
+
+    //--------------------------------------------------------------------------
+    double SampleHistogram::mean() const
+    {
+        if (totalCount == 0)
+        {
+            return 0.0;
+        }
+
+        // Exact: at most 2^48 samples of up to 2^16 fit the 64-bit sum
+        uint64_t sum = 0;
+        for (size_t i = 0; i < NUM_BINS; ++i)
+        {
+            sum += bins[i] * i;
+        }
+        return double(sum) / double(totalCount);
+    }
+
+    //--------------------------------------------------------------------------
+    uint16_t SampleHistogram::quantile(double q) const
+    {
+        return quantiles(std::span<const double>(&q, 1)).front();
+    }
+
+    //--------------------------------------------------------------------------
+    std::vector<uint16_t> SampleHistogram::quantiles(
+        std::span<const double> qs) const
+    {
+        for (double q : qs)
+        {
+            requireQuantile(q);
+        }
+
+        std::vector<uint16_t> results(qs.size(), 0);
+        if (totalCount == 0)
+        {
+            return results;
+        }
+
+        // Visit the quantiles in increasing order, so one pass finds them all
+        std::vector<size_t> order(qs.size());
+        std::iota(order.begin(), order.end(), size_t{0});
+        std::sort(
+            order.begin(),
+            order.end(),
+            [&](size_t a, size_t b) { return qs[a] < qs[b]; });
+
+        uint64_t seen = 0;
+        size_t bin = 0;
+        for (size_t index : order)
+        {
+            uint64_t rank = targetRank(qs[index], totalCount);
+            while (seen + bins[bin] < rank)
+            {
+                seen += bins[bin];
+                ++bin;
+            }
+            results[index] = uint16_t(bin);
+        }
+        return results;
+    }
+
+    //--------------------------------------------------------------------------
+    // QuantileSketch Public Methods
+    //--------------------------------------------------------------------------
+
+    //--------------------------------------------------------------------------
+    QuantileSketch::QuantileSketch(uint32_t k, uint64_t seed)
+    : kParameter{k},
+      coinSeed{seed},
+      coin{seed},
+      retained{0},
+      maxRetained{0},
+      totalCount{0},
+      minValue{std::numeric_limits<double>::infinity()},
+      maxValue{-std::numeric_limits<double>::infinity()}
+    {
+        if (k < MIN_K)
+        {
+            throw std::invalid_argument("Sketch k is too small");
+        }
+        addLevel();
+    }
+
+    //--------------------------------------------------------------------------
+    void QuantileSketch::add(double value)
+    {
+        add(std::span<const double>(&value, 1));
+    }
+
+    //--------------------------------------------------------------------------
+    void QuantileSketch::add(std::span<const uint16_t> samples)
+    {
+        // Level 0 takes whatever room is left in the sketch at once, then the
+        // sketch is compressed, so most samples cost an append
+        while (!samples.empty())
+        {
+            size_t room = std::min(samples.size(), maxRetained - retained);
+            std::vector<double>& level0 = levels.front();
+            uint16_t low = std::numeric_limits<uint16_t>::max();
+            uint16_t high = 0;
+            for (uint16_t sample : samples.first(room))
+            {
+                level0.push_back(sample);
+                low = std::min(low, sample);
+                high = std::max(high, sample);
+            }
+            minValue = std::min(minValue, double(low));
+            maxValue = std::max(maxValue, double(high));
+            retained += room;
+            totalCount += room;
+            samples = samples.subspan(room);
+            compress();
+        }
+    }
+
+    //--------------------------------------------------------------------------
+    void QuantileSketch::add(std::span<const double> values)
+    {
+        while (!values.empty())
+        {
+            size_t room = std::min(values.size(), maxRetained - retained);
+            std::vector<double>& level0 = levels.front();
+            for (double value : values.first(room))
+            {
+                level0.push_back(value);
+                minValue = std::min(minValue, value);
+                maxValue = std::max(maxValue, value);
+            }
+            retained += room;
+            totalCount += room;
+            values = values.subspan(room);
+            compress();
+        }
+    }
+
+    //--------------------------------------------------------------------------
+    void QuantileSketch::add(const SampleHistogram& histogram)
+    {
+        // A code seen c times goes in once at every level h where bit h of c
+        // is set, which weighs exactly c, so only the compactions that follow
+        // lose anything
+        for (size_t code = 0; code < SampleHistogram::NUM_BINS; ++code)
+        {
+            uint64_t binCount = histogram.countOf(uint16_t(code));
+            if (binCount == 0)
+            {
+                continue;
+            }
+
+            while (levels.size() < size_t(std::bit_width(binCount)))
+            {
+                addLevel();
+            }
+            for (size_t h = 0; binCount != 0; ++h, binCount >>= 1)
+            {
+                if (binCount & 1)
+                {
+                    levels[h].push_back(double(code));
+                    ++retained;
+                }
+            }
+            minValue = std::min(minValue, double(code));
+            maxValue = std::max(maxValue, double(code));
+        }
+        totalCount += histogram.count();
+        compress();
+    }
+
+    //--------------------------------------------------------------------------
+    void QuantileSketch::merge(const QuantileSketch& other)
+    {
+        if (other.kParameter != kParameter)
+        {
+            throw std::invalid_argument("Sketches have different k");
+        }
+        if (&other == this)
+        {
+            QuantileSketch copy = other;
+            merge(copy);
+            return;
+        }
+
+        while (levels.size() < other.levels.size())
+        {
+            addLevel();
+        }
+        for (size_t h = 0; h < other.levels.size(); ++h)
+        {
+            levels[h].insert(
+                levels[h].end(),
+                other.levels[h].begin(),
+                other.levels[h].end());
+        }
+        retained += other.retained;
+        totalCount += other.totalCount;
+        minValue = std::min(minValue, other.minValue);
+        maxValue = std::max(maxValue, other.maxValue);
+        compress();
+    }
+
+    //--------------------------------------------------------------------------
+    void QuantileSketch::reset()
+    {
+        *this = QuantileSketch(kParameter, coinSeed);
+    }
+
+    //--------------------------------------------------------------------------
+    double QuantileSketch::min() const
+    {
+        return totalCount ? minValue : 0.0;
+    }
+
+    //--------------------------------------------------------------------------
+    double QuantileSketch::max() const
+    {
+        return totalCount ? maxValue : 0.0;
+    }
+
+    //--------------------------------------------------------------------------
+    double QuantileSketch::rank(double value) const
+    {
+        if (totalCount == 0)
+        {
+            return 0.0;
+        }
+
+        uint64_t weight = 0;
+        for (size_t h = 0; h < levels.size(); ++h)
+        {
+            for (double retainedValue : levels[h])
+            {
+                if (retainedValue <= value)
+                {
+                    weight += uint64_t{1} << h;
+                }
+            }
+        }
+        return double(weight) / double(totalCount);
+    }
+
+    //--------------------------------------------------------------------------
+    double QuantileSketch::quantile(double q) const
+    {
+        return quantiles(std::span<const double>(&q, 1)).front();
+    }
+
+    //--------------------------------------------------------------------------
+    std::vector<double> QuantileSketch::quantiles(
+        std::span<const double> qs) const
+    {
+        for (double q : qs)
+        {
+            requireQuantile(q);
+        }
+
+        std::vector<double> results(qs.size(), 0.0);
+        if (totalCount == 0)
+        {
+            return results;
+        }
+
+        std::vector<sWeightedValue> sorted = sortedValues();
+        // Cumulative weights, which end at totalCount since compactions
+        // conserve weight
+        std::vector<uint64_t> cumulative(sorted.size());
+        uint64_t seen = 0;
+        for (size_t i = 0; i < sorted.size(); ++i)
+        {
+            seen += sorted[i].weight;
+            cumulative[i] = seen;
+        }
+
+        for (size_t i = 0; i < qs.size(); ++i)
+        {
+            if (qs[i] == 0.0)
+            {
+                results[i] = minValue;
+            }
+            else if (qs[i] == 1.0)
+            {
+                results[i] = maxValue;
+            }
+            else
+            {
+                uint64_t rank = targetRank(qs[i], totalCount);
+                auto it = std::lower_bound(
+                    cumulative.begin(),
+                    cumulative.end(),
+                    rank);
+                results[i] = sorted[size_t(it - cumulative.begin())].value;
+            }
+        }
+        return results;
+    }
+
+    //--------------------------------------------------------------------------
+    // QuantileSketch Private Methods
+    //--------------------------------------------------------------------------
+
+    //--------------------------------------------------------------------------
+    void QuantileSketch::addLevel()
+    {
+        levels.emplace_back();
+
+        // Capacities are relative to the top level, so all of them change
+        capacities.resize(levels.size());
+        maxRetained = 0;
+        for (size_t h = 0; h < levels.size(); ++h)
+        {
+            size_t depth = levels.size() - 1 - h;
+            auto levelCapacity = static_cast<size_t>(std::ceil(
+                double(kParameter) * std::pow(CAPACITY_DECAY, double(depth))));
+            capacities[h] = std::max(levelCapacity, MIN_CAPACITY);
+            maxRetained += capacities[h];
+        }
+    }
+
+    //--------------------------------------------------------------------------
+    void QuantileSketch::compress()
+    {
+        // While the sketch is full, some level is at or over its capacity
+        while (retained >= maxRetained)
+        {
+            size_t h = 0;
+            while (levels[h].size() < capacities[h])
+            {
+                ++h;
+            }
+            if (h + 1 == levels.size())
+            {
+                addLevel();
+            }
+
+            // An odd sample out stays behind, so the promoted pairs conserve
+            // the total weight exactly
+            std::vector<double>& level = levels[h];
+            size_t keep = level.size() % 2;
+            std::sort(level.begin() + keep, level.end());
+            std::vector<double>& above = levels[h + 1];
+            size_t before = above.size();
+            for (size_t i = keep + (coin() & 1); i < level.size(); i += 2)
+            {
+                above.push_back(level[i]);
+            }
+            size_t promoted = above.size() - before;
+            retained -= level.size() - keep - promoted;
+            level.resize(keep);
+        }
+    }
+
+    //--------------------------------------------------------------------------
+    std::vector<QuantileSketch::sWeightedValue>
+    QuantileSketch::sortedValues() const
+    {
+        std::vector<sWeightedValue> sorted;
+        sorted.reserve(retained);
+        for (size_t h = 0; h < levels.size(); ++h)
+        {
+            for (double value : levels[h])
+            {
+                sorted.push_back({value, uint64_t{1} << h});
+            }
+        }
+        std::sort(
+            sorted.begin(),
+            sorted.end(),
+            [](const sWeightedValue& a, const sWeightedValue& b)
+            {
+                return a.value < b.value;
+            });
+        return sorted;
+    }
+
+} // namespace SignalDataFacade
@@ -0,0 +1,685 @@
+// Copyright (c) 2025 Michael Dello
+//
+// This software is provided under the MIT License.
+// See LICENSE file for details.
+
+//-----------------------------------------------------------------------------
+//
+// Signal Data Pyramid Index Implementation
+//
+//-----------------------------------------------------------------------------
+
+#include "facadepattern_pyramid.h"
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <optional>
+#include <stdexcept>
+#include <utility>
+
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+// SIMD kernels need GCC/Clang target attributes on an x86 CPU
+#if (defined(__GNUC__) || defined(__clang__)) && \
+    (defined(__x86_64__) || defined(__i386__))
+#define FACADEPATTERN_PYRAMID_X86_KERNELS 1
+#include <immintrin.h>
+#else
+#define FACADEPATTERN_PYRAMID_X86_KERNELS 0
+#endif
+
+namespace // anonymous
+{
+    using SignalDataFacade::eSimdLevel;
+    using SignalDataFacade::sPyramidNode;
+
+    //--------------------------------------------------------------------------
+    // Constants
+    //--------------------------------------------------------------------------
+    constexpr size_t FAN_OUT = SignalDataFacade::SamplePyramid::FAN_OUT;
+    constexpr sPyramidNode EMPTY_NODE{0, UINT16_MAX, 0};
+
+    static_assert(sizeof(sPyramidNode) == 16, "Pyramid nodes are 16 bytes");
+
+    //--------------------------------------------------------------------------
+    // Local Functions
+    //--------------------------------------------------------------------------
+    void combine(sPyramidNode& into, const sPyramidNode& node)
+    {
+        into.sum += node.sum;
+        into.min = std::min(into.min, node.min);
+        into.max = std::max(into.max, node.max);
+    }
+
+    //--------------------------------------------------------------------------
+    void combine(sPyramidNode& into, const sPyramidNode* pNodes, size_t count)
+    {
+        for (size_t i = 0; i < count; ++i)
+        {
+            combine(into, pNodes[i]);
+        }
+    }
+
+    //--------------------------------------------------------------------------
+    [[noreturn]] void throwErrno(const std::string& sWhat)
+    {
+        throw std::runtime_error(sWhat + ": " + std::strerror(errno));
+    }
+
+    //--------------------------------------------------------------------------
+    void writeAll(int fd, const void* pData, size_t bytes)
+    {
+        const std::byte* pBytes = static_cast<const std::byte*>(pData);
+        while (bytes > 0)
+        {
+            ssize_t written = ::write(fd, pBytes, bytes);
+            if (written < 0)
+            {
+                if (errno == EINTR)
+                {
+                    continue;
+                }
+                throwErrno("Pyramid file write failed");
+            }
+            pBytes += written;
+            bytes -= size_t(written);
+        }
+    }
+
+    //--------------------------------------------------------------------------
+    void readAll(int fd, void* pData, size_t bytes)
+    {
+        std::byte* pBytes = static_cast<std::byte*>(pData);
+        while (bytes > 0)
+        {
+            ssize_t numRead = ::read(fd, pBytes, bytes);
+            if (numRead < 0 && errno == EINTR)
+            {
+                continue;
+            }
+            if (numRead < 0)
+            {
+                throwErrno("Pyramid file read failed");
+            }
+            if (numRead == 0)
+            {
+                throw std::runtime_error("Pyramid file is truncated");
+            }
+            pBytes += numRead;
+            bytes -= size_t(numRead);
+        }
+    }
+
+    //--------------------------------------------------------------------------
+    // Closes a file descriptor on scope exit
+    struct sFileCloser
+    {
+        int fd;
+        ~sFileCloser() { ::close(fd); }
+    };
+
+    //--------------------------------------------------------------------------
+    // Nodes of each level for a number of samples; the top level is the
+    // first with fewer than FAN_OUT nodes
+    std::vector<size_t> levelSizes(uint64_t numSamples)
+    {
+        std::vector<size_t> sizes{size_t(numSamples / FAN_OUT)};
+        while (sizes.back() >= FAN_OUT)
+        {
+            sizes.push_back(sizes.back() / FAN_OUT);
+        }
+        return sizes;
+    }
+
+    //--------------------------------------------------------------------------
+    // Scalar Kernels
+    //--------------------------------------------------------------------------
+    // One level 0 node per FAN_OUT samples
+    void baseNodesScalar(
+        const uint16_t* pSamples,
+        size_t numNodes,
+        sPyramidNode* pOut)
+    {
+        for (size_t n = 0; n < numNodes; ++n)
+        {
+            const uint16_t* pRun = pSamples + n * FAN_OUT;
+            uint64_t sum = 0;
+            uint16_t min = UINT16_MAX;
+            uint16_t max = 0;
+            for (size_t i = 0; i < FAN_OUT; ++i)
+            {
+                sum += pRun[i];
+                min = std::min(min, pRun[i]);
+                max = std::max(max, pRun[i]);
+            }
+            pOut[n] = {sum, min, max};
+        }
+    }
+
+#if FACADEPATTERN_PYRAMID_X86_KERNELS
+    //--------------------------------------------------------------------------
+    // SSE Kernels
+    //--------------------------------------------------------------------------
+    // Samples are summed as signed 16-bit (x - 32768) pairs by madd, and the
+    // bias added back once per node. Horizontal min is minpos, and max the
+    // complement of the minpos of the complement.
+    __attribute__((target("sse4.1")))
+    sPyramidNode reduceSSE4(__m128i vMin, __m128i vMax, __m128i vSum)
+    {
+        vSum = _mm_add_epi32(vSum, _mm_shuffle_epi32(vSum, 0x4E));
+        vSum = _mm_add_epi32(vSum, _mm_shuffle_epi32(vSum, 0xB1));
+        int64_t biased = _mm_cvtsi128_si32(vSum);
+        __m128i allBits = _mm_set1_epi32(-1);
+        uint16_t min = uint16_t(_mm_cvtsi128_si32(_mm_minpos_epu16(vMin)));
+        uint16_t max = uint16_t(~_mm_cvtsi128_si32(
+            _mm_minpos_epu16(_mm_xor_si128(vMax, allBits))));
+        return {uint64_t(biased + int64_t(FAN_OUT) * 32768), min, max};
+    }
+
+    //--------------------------------------------------------------------------
+    __attribute__((target("sse4.1")))
+    size_t baseNodesSSE4(
+        const uint16_t* pSamples,
+        size_t numNodes,
+        sPyramidNode* pOut)
+    {
+        const __m128i bias = _mm_set1_epi16(int16_t(0x8000));
+        const __m128i ones = _mm_set1_epi16(1);
+        for (size_t n = 0; n < numNodes; ++n)
+        {
+            const __m128i* pRun =
+                reinterpret_cast<const __m128i*>(pSamples + n * FAN_OUT);
+            __m128i vMin = _mm_set1_epi16(-1);
+            __m128i vMax = _mm_setzero_si128();
+            __m128i vSum = _mm_setzero_si128();
+            for (size_t i = 0; i < FAN_OUT / 8; ++i)
+            {
+                __m128i x = _mm_loadu_si128(pRun + i);
+                vMin = _mm_min_epu16(vMin, x);
+                vMax = _mm_max_epu16(vMax, x);
+                vSum = _mm_add_epi32(
+                    vSum, _mm_madd_epi16(_mm_xor_si128(x, bias), ones));
+            }
+            pOut[n] = reduceSSE4(vMin, vMax, vSum);
+        }
+        return numNodes;
+    }
+
+    //--------------------------------------------------------------------------
+    // AVX2 Kernels
+    //--------------------------------------------------------------------------
+    __attribute__((target("avx2")))
+    size_t baseNodesAVX2(
+        const uint16_t* pSamples,
+        size_t numNodes,
+        sPyramidNode* pOut)
+    {
+        const __m256i bias = _mm256_set1_epi16(int16_t(0x8000));
+        const __m256i ones = _mm256_set1_epi16(1);
+        for (size_t n = 0; n < numNodes; ++n)
+        {
+            const __m256i* pRun =
+                reinterpret_cast<const __m256i*>(pSamples + n * FAN_OUT);
+            __m256i x0 = _mm256_loadu_si256(pRun);
+            __m256i x1 = _mm256_loadu_si256(pRun + 1);
+            __m256i x2 = _mm256_loadu_si256(pRun + 2);
+            __m256i x3 = _mm256_loadu_si256(pRun + 3);
+            __m256i vMin = _mm256_min_epu16(
+                _mm256_min_epu16(x0, x1), _mm256_min_epu16(x2, x3));
+            __m256i vMax = _mm256_max_epu16(
+                _mm256_max_epu16(x0, x1), _mm256_max_epu16(x2, x3));
+            __m256i vSum = _mm256_add_epi32(
+                _mm256_add_epi32(
+                    _mm256_madd_epi16(_mm256_xor_si256(x0, bias), ones),
+                    _mm256_madd_epi16(_mm256_xor_si256(x1, bias), ones)),
+                _mm256_add_epi32(
+                    _mm256_madd_epi16(_mm256_xor_si256(x2, bias), ones),
+                    _mm256_madd_epi16(_mm256_xor_si256(x3, bias), ones)));
+            pOut[n] = reduceSSE4(
+                _mm_min_epu16(
+                    _mm256_castsi256_si128(vMin),
+                    _mm256_extracti128_si256(vMin, 1)),
+                _mm_max_epu16(
+                    _mm256_castsi256_si128(vMax),
+                    _mm256_extracti128_si256(vMax, 1)),
+                _mm_add_epi32(
+                    _mm256_castsi256_si128(vSum),
+                    _mm256_extracti128_si256(vSum, 1)));
+        }
+        return numNodes;
+    }
+#endif
+
+    //--------------------------------------------------------------------------
+    // Kernel Dispatch
+    //--------------------------------------------------------------------------
+    void baseNodes(
+        const uint16_t* pSamples,
+        size_t numNodes,
+        sPyramidNode* pOut,
+        eSimdLevel level)
+    {
+        size_t done = 0;
+        switch (level)
+        {
+#if FACADEPATTERN_PYRAMID_X86_KERNELS
+            case eSimdLevel::AVX2:
+                done = baseNodesAVX2(pSamples, numNodes, pOut);
+                break;
+            case eSimdLevel::SSE4:
+                done = baseNodesSSE4(pSamples, numNodes, pOut);
+                break;
+#endif
+            default:
+                break;
+        }
+        baseNodesScalar(
+            pSamples + done * FAN_OUT, numNodes - done, pOut + done);
+    }
+
+} // namespace anonymous
+
+namespace SignalDataFacade
+{
+    //--------------------------------------------------------------------------
+    std::string pyramidPath(const std::string& sCapturePath, size_t channel)
+    {
+        return sCapturePath + ".ch" + std::to_string(channel) + ".pyr";
+    }
+
+    //--------------------------------------------------------------------------
+    // Sample Pyramid Implementation
+    //--------------------------------------------------------------------------
+    SamplePyramid::SamplePyramid(eSimdLevel level)
+    : kernelLevel{std::min(level, detectedSimdLevel())},
+      levels(1),
+      totalSamples{0}
+    {
+        pending.reserve(FAN_OUT);
+    }
+
+    //--------------------------------------------------------------------------
+    SamplePyramid::SamplePyramid(const std::string& sPath, eSimdLevel level)
+    : SamplePyramid(level)
+    {
+        int fd = ::open(sPath.c_str(), O_RDONLY | O_CLOEXEC);
+        if (fd < 0)
+        {
+            throwErrno("Failed to open pyramid file " + sPath);
+        }
+        sFileCloser closer{fd};
+        struct stat fileStat{};
+        if (::fstat(fd, &fileStat) < 0)
+        {
+            throwErrno("Failed to stat pyramid file " + sPath);
+        }
+
+        sPyramidFileHeader header{};
+        if (size_t(fileStat.st_size) < sizeof(header))
+        {
+            throw std::runtime_error("Not a pyramid file: " + sPath);
+        }
+        readAll(fd, &header, sizeof(header));
+        std::vector<size_t> sizes = levelSizes(header.numSamples);
+        if (std::memcmp(
+                header.magic, PYRAMID_MAGIC, sizeof(PYRAMID_MAGIC)) != 0 ||
+            header.version != PYRAMID_VERSION ||
+            header.fanOut != FAN_OUT ||
+            header.numLevels != sizes.size() ||
+            header.numPending != header.numSamples % FAN_OUT)
+        {
+            throw std::runtime_error("Not a pyramid file: " + sPath);
+        }
+        size_t numNodes = 0;
+        for (size_t size : sizes)
+        {
+            numNodes += size;
+        }
+        if (size_t(fileStat.st_size) !=
+            sizeof(header) + header.numPending * sizeof(uint16_t) +
+                numNodes * sizeof(sPyramidNode))
+        {
+            throw std::runtime_error("Pyramid file size mismatch: " + sPath);
+        }
+
+        pending.resize(header.numPending);
+        readAll(fd, pending.data(), pending.size() * sizeof(uint16_t));
+        levels.resize(sizes.size());
+        for (size_t i = 0; i < sizes.size(); ++i)
+        {
+            levels[i].resize(sizes[i]);
+            readAll(
+                fd, levels[i].data(), levels[i].size() * sizeof(sPyramidNode));
+        }
+        totalSamples = header.numSamples;
+    }
+
+    //--------------------------------------------------------------------------
+    void SamplePyramid::append(std::span<const uint16_t> samples)
+    {
+        size_t done = 0;
+        // Complete the node left incomplete by the last append
+        if (!pending.empty())
+        {
+            done = std::min(samples.size(), FAN_OUT - pending.size());
+            pending.insert(
+                pending.end(), samples.begin(), samples.begin() + done);
+            if (pending.size() == FAN_OUT)
+            {
+                sPyramidNode node;
+                baseNodes(pending.data(), 1, &node, kernelLevel);
+                pushNode(0, node);
+                pending.clear();
+            }
+        }
+
+        // Whole nodes straight from the samples, then the levels above
+        size_t numNodes = (samples.size() - done) / FAN_OUT;
+        if (numNodes > 0)
+        {
+            // Not a reference: pushing a parent can add a level
+            size_t first = levels[0].size();
+            levels[0].resize(first + numNodes);
+            baseNodes(
+                samples.data() + done,
+                numNodes,
+                levels[0].data() + first,
+                kernelLevel);
+            for (size_t parent = first / FAN_OUT;
+                 parent < levels[0].size() / FAN_OUT;
+                 ++parent)
+            {
+                sPyramidNode node{EMPTY_NODE};
+                combine(node, levels[0].data() + parent * FAN_OUT, FAN_OUT);
+                pushNode(1, node);
+            }
+            done += numNodes * FAN_OUT;
+        }
+
+        pending.insert(pending.end(), samples.begin() + done, samples.end());
+        totalSamples += samples.size();
+    }
+
+    //--------------------------------------------------------------------------
+    void SamplePyramid::append(const CaptureReader& reader, size_t channel)
+    {
+        if (channel >= reader.numChannels())
+        {
+            throw std::out_of_range("Capture channel out of range");
+        }
+        std::vector<uint16_t> samples;
+        for (size_t chunk = 0; chunk < reader.numChunks(); ++chunk)
+        {
+            reader.decodeColumn(chunk, channel, samples);
+            append(samples);
+        }
+    }
+
+    //--------------------------------------------------------------------------
+    void SamplePyramid::clear()
+    {
+        levels.assign(1, {});
+        pending.clear();
+        totalSamples = 0;
+    }
+
+    //--------------------------------------------------------------------------
+    void SamplePyramid::save(const std::string& sPath) const
+    {
+        sPyramidFileHeader header{};
+        std::memcpy(header.magic, PYRAMID_MAGIC, sizeof(PYRAMID_MAGIC));
+        header.version = PYRAMID_VERSION;
+        header.fanOut = FAN_OUT;
+        header.numSamples = totalSamples;
+        header.numLevels = static_cast<uint32_t>(levels.size());
+        header.numPending = static_cast<uint32_t>(pending.size());
+
+        // Written and flushed aside before replacing the file, so the old
+        // pyramid stays whole until the new one is
+        std::string sTempPath = sPath + ".tmp";
+        int fd = ::open(
+            sTempPath.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+        if (fd < 0)
+        {
+            throwErrno("Failed to create pyramid file " + sTempPath);
+        }
+        try
+        {
+            sFileCloser closer{fd};
+            writeAll(fd, &header, sizeof(header));
+            writeAll(fd, pending.data(), pending.size() * sizeof(uint16_t));
+            for (const auto& level : levels)
+            {
+                writeAll(
+                    fd, level.data(), level.size() * sizeof(sPyramidNode));
+            }
+            if (::fdatasync(fd) < 0)
+            {
+                throwErrno("Failed to sync pyramid file " + sTempPath);
+            }
+        }
+        catch (...)
+        {
+            ::unlink(sTempPath.c_str());
+            throw;
+        }
+        if (::rename(sTempPath.c_str(), sPath.c_str()) < 0)
+        {
+            int error = errno;
+            ::unlink(sTempPath.c_str());
+            errno = error;
+            throwErrno("Failed to replace pyramid file " + sPath);
+        }
+    }
+
+    //--------------------------------------------------------------------------
+    sRangeSummary SamplePyramid::summarize(uint64_t begin, uint64_t end) const
+    {
+        if (end < begin)
+        {
+            throw std::invalid_argument("Pyramid range ends before it begins");
+        }
+        // Widen to whole nodes, the incomplete one counting as a node
+        uint64_t firstNode = std::min(begin, totalSamples) / FAN_OUT;
+        // An empty range stays empty rather than widening to a node
+        uint64_t endSample = std::min(end, totalSamples);
+        uint64_t endNode = endSample > begin ?
+            (endSample + FAN_OUT - 1) / FAN_OUT :
+            firstNode;
+
+        sRangeSummary summary;
+        summary.firstSample = firstNode * FAN_OUT;
+        if (endNode <= firstNode)
+        {
+            return summary;
+        }
+
+        uint64_t numComplete = levels[0].size();
+        sPyramidNode node = sumNodes(firstNode, std::min(endNode, numComplete));
+        uint64_t lastSample = std::min(endNode, numComplete) * FAN_OUT;
+        if (endNode > numComplete)
+        {
+            for (uint16_t sample : pending)
+            {
+                node.sum += sample;
+                node.min = std::min(node.min, sample);
+                node.max = std::max(node.max, sample);
+            }
+            lastSample = totalSamples;
+        }
+
+        summary.numSamples = lastSample - summary.firstSample;
+        summary.min = node.min;
+        summary.max = node.max;
+        summary.mean = double(node.sum) / double(summary.numSamples);
+        return summary;
+    }
+
+    //--------------------------------------------------------------------------
+    std::vector<sRangeSummary> SamplePyramid::summarize(
+        uint64_t begin,
+        uint64_t end,
+        size_t numBuckets) const
+    {
+        if (end < begin)
+        {
+            throw std::invalid_argument("Pyramid range ends before it begins");
+        }
+        if (numBuckets == 0)
+        {
+            throw std::invalid_argument("Pyramid query needs a bucket");
+        }
+        uint64_t firstNode = std::min(begin, totalSamples) / FAN_OUT;
+        // An empty range stays empty rather than widening to a node
+        uint64_t endSample = std::min(end, totalSamples);
+        uint64_t endNode = endSample > begin ?
+            (endSample + FAN_OUT - 1) / FAN_OUT :
+            firstNode;
+        uint64_t numUnits = endNode > firstNode ? endNode - firstNode : 0;
+        numBuckets = size_t(std::min<uint64_t>(numBuckets, numUnits));
+
+        std::vector<sRangeSummary> summaries;
+        summaries.reserve(numBuckets);
+        for (size_t bucket = 0; bucket < numBuckets; ++bucket)
+        {
+            // 128-bit products would only matter past 2^58 samples
+            uint64_t from = firstNode + numUnits * bucket / numBuckets;
+            uint64_t to = firstNode + numUnits * (bucket + 1) / numBuckets;
+            summaries.push_back(summarize(from * FAN_OUT, to * FAN_OUT));
+        }
+        return summaries;
+    }
+
+    //--------------------------------------------------------------------------
+    size_t SamplePyramid::indexBytes() const
+    {
+        size_t bytes = pending.capacity() * sizeof(uint16_t);
+        for (const auto& level : levels)
+        {
+            bytes += level.capacity() * sizeof(sPyramidNode);
+        }
+        return bytes;
+    }
+
+    //--------------------------------------------------------------------------
+    void SamplePyramid::pushNode(size_t level, const sPyramidNode& node)
+    {
+        if (level == levels.size())
+        {
+            levels.emplace_back();
+        }
+        auto& nodes = levels[level];
+        nodes.push_back(node);
+        if (nodes.size() % FAN_OUT == 0)
+        {
+            sPyramidNode parent{EMPTY_NODE};
+            combine(parent, nodes.data() + nodes.size() - FAN_OUT, FAN_OUT);
+            pushNode(level + 1, parent);
+        }
+    }
+
+    //--------------------------------------------------------------------------
+    // Like a segment tree: the nodes short of a FAN_OUT boundary at either
+    // end are combined at this level, and the whole groups between the
+    // boundaries by their parents one level up
+    sPyramidNode SamplePyramid::sumNodes(
+        uint64_t firstNode,
+        uint64_t endNode) const
+    {
+        sPyramidNode node{EMPTY_NODE};
+        size_t level = 0;
+        while (firstNode < endNode)
+        {
+            const sPyramidNode* pNodes = levels[level].data();
+            uint64_t firstParent = (firstNode + FAN_OUT - 1) / FAN_OUT;
+            uint64_t endParent = endNode / FAN_OUT;
+            if (level + 1 == levels.size() || firstParent >= endParent)
+            {
+                combine(node, pNodes + firstNode, endNode - firstNode);
+                break;
+            }
+            combine(
+                node, pNodes + firstNode, firstParent * FAN_OUT - firstNode);
+            combine(
+                node,
+                pNodes + endParent * FAN_OUT,
+                endNode - endParent * FAN_OUT);
+            firstNode = firstParent;
+            endNode = endParent;
+            ++level;
+        }
+        return node;
+    }
+
+    //--------------------------------------------------------------------------
+    // Capture Pyramids Implementation
+    //--------------------------------------------------------------------------
+    CapturePyramids::CapturePyramids(
+        CaptureWriter& writer,
+        const std::string& sCapturePath,
+        eSimdLevel level)
+    : writer{writer},
+      sCapturePath{sCapturePath}
+    {
+        pyramids.reserve(writer.numChannels());
+        for (size_t channel = 0; channel < writer.numChannels(); ++channel)
+        {
+            pyramids.emplace_back(level);
+        }
+
+        // Appending: a saved pyramid is only used if it indexes every
+        // sample committed, a crash after a commit leaves it behind
+        uint64_t numWritten = writer.samplesWritten();
+        std::optional<CaptureReader> reader;
+        for (size_t channel = 0; numWritten > 0 && channel < pyramids.size();
+             ++channel)
+        {
+            try
+            {
+                SamplePyramid saved{pyramidPath(sCapturePath, channel), level};
+                if (saved.numSamples() == numWritten)
+                {
+                    pyramids[channel] = std::move(saved);
+                    continue;
+                }
+            }
+            catch (const std::runtime_error&)
+            {
+                // Missing or not a pyramid, rebuilt below
+            }
+            if (!reader)
+            {
+                reader.emplace(sCapturePath);
+            }
+            pyramids[channel].append(*reader, channel);
+        }
+
+        writer.setCommitCallback(
+            [this](std::span<const std::span<const uint16_t>> columns)
+            {
+                for (size_t channel = 0; channel < pyramids.size(); ++channel)
+                {
+                    pyramids[channel].append(columns[channel]);
+                }
+            });
+    }
+
+    //--------------------------------------------------------------------------
+    CapturePyramids::~CapturePyramids()
+    {
+        writer.setCommitCallback({});
+    }
+
+    //--------------------------------------------------------------------------
+    void CapturePyramids::save()
+    {
+        writer.commit();
+        for (size_t channel = 0; channel < pyramids.size(); ++channel)
+        {
+            pyramids[channel].save(pyramidPath(sCapturePath, channel));
+        }
+    }
+
+} // namespace SignalDataFacade
@@ -0,0 +1,432 @@
+// Copyright (c) 2025 Michael Dello
+//
+// This software is provided under the MIT License.
+// See LICENSE file for details.
+
+//-----------------------------------------------------------------------------
+//
+// Signal Data Window Query Implementation
+//
+//-----------------------------------------------------------------------------
+
+#include "facadepattern_query.h"
+#include <algorithm>
+#include <chrono>
+#include <stdexcept>
+
+// SIMD kernels need GCC/Clang target attributes on an x86 CPU
+#if (defined(__GNUC__) || defined(__clang__)) && \
+    (defined(__x86_64__) || defined(__i386__))
+#define FACADEPATTERN_QUERY_X86_KERNELS 1
+#include <immintrin.h>
+#else
+#define FACADEPATTERN_QUERY_X86_KERNELS 0
+#endif
+
+namespace // anonymous
+{
+    using SignalDataFacade::CaptureReader;
+    using SignalDataFacade::eSimdLevel;
+
+    //--------------------------------------------------------------------------
+    // Constants
+    //--------------------------------------------------------------------------
+    // Vector iterations between widening the lane counters, so neither the
+    // 16-bit counts nor the 32-bit sums summed across lanes can overflow
+    constexpr size_t LANE_BLOCK = 2048;
+
+    //--------------------------------------------------------------------------
+    // Types
+    //--------------------------------------------------------------------------
+    // Aggregates of some of the samples of one window
+    struct sPartial
+    {
+        uint64_t sum;
+        uint64_t numSamples;
+        uint64_t numAbove;
+        uint64_t numHigh;
+    };
+
+    //--------------------------------------------------------------------------
+    // Local Functions
+    //--------------------------------------------------------------------------
+    // The first chunk ending after sampleIndex, or numChunks() when none does
+    size_t chunkEndingAfter(const CaptureReader& reader, uint64_t sampleIndex)
+    {
+        size_t low = 0;
+        size_t high = reader.numChunks();
+        while (low < high)
+        {
+            size_t middle = low + (high - low) / 2;
+            const auto& header = reader.chunkHeader(middle);
+            if (header.firstSampleIndex + header.numSamples <= sampleIndex)
+            {
+                low = middle + 1;
+            }
+            else
+            {
+                high = middle;
+            }
+        }
+        return low;
+    }
+
+    //--------------------------------------------------------------------------
+    // Scalar Kernels
+    //--------------------------------------------------------------------------
+    void accumulateScalar(
+        const uint16_t* pAnalog,
+        const uint16_t* pGpio,
+        size_t count,
+        uint16_t threshold,
+        uint16_t lineMask,
+        sPartial& partial)
+    {
+        uint64_t sum = 0;
+        uint64_t numAbove = 0;
+        uint64_t numHigh = 0;
+        for (size_t i = 0; i < count; ++i)
+        {
+            sum += pAnalog[i];
+            numAbove += pAnalog[i] > threshold;
+            numHigh += (pGpio[i] & lineMask) != 0;
+        }
+        partial.sum += sum;
+        partial.numAbove += numAbove;
+        partial.numHigh += numHigh;
+    }
+
+#if FACADEPATTERN_QUERY_X86_KERNELS
+    //--------------------------------------------------------------------------
+    // SSE Kernels
+    //--------------------------------------------------------------------------
+    // Analog samples are summed as signed 16-bit (x - 32768) pairs by madd,
+    // with the bias added back per block. Counts are the compare masks (-1)
+    // subtracted in 16-bit lanes, widened every LANE_BLOCK iterations. A
+    // sample is above the threshold unless min(x, threshold) == x.
+    __attribute__((target("sse4.1")))
+    uint64_t sumLanesSSE4(__m128i lanes)
+    {
+        lanes = _mm_add_epi32(lanes, _mm_shuffle_epi32(lanes, 0x4E));
+        lanes = _mm_add_epi32(lanes, _mm_shuffle_epi32(lanes, 0xB1));
+        return uint64_t(int64_t(_mm_cvtsi128_si32(lanes)));
+    }
+
+    //--------------------------------------------------------------------------
+    __attribute__((target("sse4.1")))
+    size_t accumulateSSE4(
+        const uint16_t* pAnalog,
+        const uint16_t* pGpio,
+        size_t count,
+        uint16_t threshold,
+        uint16_t lineMask,
+        sPartial& partial)
+    {
+        const __m128i bias = _mm_set1_epi16(int16_t(0x8000));
+        const __m128i ones = _mm_set1_epi16(1);
+        const __m128i vThreshold = _mm_set1_epi16(int16_t(threshold));
+        const __m128i vLine = _mm_set1_epi16(int16_t(lineMask));
+        size_t i = 0;
+        while (i + 8 <= count)
+        {
+            size_t blockEnd = std::min(count & ~size_t(7), i + 8 * LANE_BLOCK);
+            size_t numBlock = blockEnd - i;
+            __m128i vSum = _mm_setzero_si128();
+            __m128i vAtMost = _mm_setzero_si128();
+            __m128i vHigh = _mm_setzero_si128();
+            for (; i < blockEnd; i += 8)
+            {
+                __m128i x = _mm_loadu_si128(
+                    reinterpret_cast<const __m128i*>(pAnalog + i));
+                __m128i g = _mm_loadu_si128(
+                    reinterpret_cast<const __m128i*>(pGpio + i));
+                vSum = _mm_add_epi32(
+                    vSum, _mm_madd_epi16(_mm_xor_si128(x, bias), ones));
+                vAtMost = _mm_sub_epi16(
+                    vAtMost,
+                    _mm_cmpeq_epi16(_mm_min_epu16(x, vThreshold), x));
+                vHigh = _mm_sub_epi16(
+                    vHigh, _mm_cmpeq_epi16(_mm_and_si128(g, vLine), vLine));
+            }
+            partial.sum += sumLanesSSE4(vSum) + uint64_t(numBlock) * 32768;
+            partial.numAbove +=
+                numBlock - sumLanesSSE4(_mm_madd_epi16(vAtMost, ones));
+            partial.numHigh += sumLanesSSE4(_mm_madd_epi16(vHigh, ones));
+        }
+        return i;
+    }
+
+    //--------------------------------------------------------------------------
+    // AVX2 Kernels
+    //--------------------------------------------------------------------------
+    __attribute__((target("avx2")))
+    uint64_t sumLanesAVX2(__m256i lanes)
+    {
+        return sumLanesSSE4(_mm_add_epi32(
+            _mm256_castsi256_si128(lanes),
+            _mm256_extracti128_si256(lanes, 1)));
+    }
+
+    //--------------------------------------------------------------------------
+    __attribute__((target("avx2")))
+    size_t accumulateAVX2(
+        const uint16_t* pAnalog,
+        const uint16_t* pGpio,
+        size_t count,
+        uint16_t threshold,
+        uint16_t lineMask,
+        sPartial& partial)
+    {
+        const __m256i bias = _mm256_set1_epi16(int16_t(0x8000));
+        const __m256i ones = _mm256_set1_epi16(1);
+        const __m256i vThreshold = _mm256_set1_epi16(int16_t(threshold));
+        const __m256i vLine = _mm256_set1_epi16(int16_t(lineMask));
+        size_t i = 0;
+        while (i + 16 <= count)
+        {
+            size_t blockEnd =
+                std::min(count & ~size_t(15), i + 16 * LANE_BLOCK);
+            size_t numBlock = blockEnd - i;
+            __m256i vSum = _mm256_setzero_si256();
+            __m256i vAtMost = _mm256_setzero_si256();
+            __m256i vHigh = _mm256_setzero_si256();
+            for (; i < blockEnd; i += 16)
+            {
+                __m256i x = _mm256_loadu_si256(
+                    reinterpret_cast<const __m256i*>(pAnalog + i));
+                __m256i g = _mm256_loadu_si256(
+                    reinterpret_cast<const __m256i*>(pGpio + i));
+                vSum = _mm256_add_epi32(
+                    vSum,
+                    _mm256_madd_epi16(_mm256_xor_si256(x, bias), ones));
+                vAtMost = _mm256_sub_epi16(
+                    vAtMost,
+                    _mm256_cmpeq_epi16(_mm256_min_epu16(x, vThreshold), x));
+                vHigh = _mm256_sub_epi16(
+                    vHigh,
+                    _mm256_cmpeq_epi16(_mm256_and_si256(g, vLine), vLine));
+            }
+            partial.sum += sumLanesAVX2(vSum) + uint64_t(numBlock) * 32768;
+            partial.numAbove +=
+                numBlock - sumLanesAVX2(_mm256_madd_epi16(vAtMost, ones));
+            partial.numHigh += sumLanesAVX2(_mm256_madd_epi16(vHigh, ones));
+        }
+        return i;
+    }
+#endif
+
+    //--------------------------------------------------------------------------
+    // Kernel Dispatch
+    //--------------------------------------------------------------------------
+    void accumulate(
+        const uint16_t* pAnalog,
+        const uint16_t* pGpio,
+        size_t count,
+        uint16_t threshold,
+        uint16_t lineMask,
+        sPartial& partial,
+        eSimdLevel level)
+    {
+        size_t done = 0;
+        switch (level)
+        {
+#if FACADEPATTERN_QUERY_X86_KERNELS
+            case eSimdLevel::AVX2:
+                done = accumulateAVX2(
+                    pAnalog, pGpio, count, threshold, lineMask, partial);
+                break;
+            case eSimdLevel::SSE4:
+                done = accumulateSSE4(
+                    pAnalog, pGpio, count, threshold, lineMask, partial);
+                break;
+#endif
+            default:
+                break;
+        }
+        accumulateScalar(
+            pAnalog + done,
+            pGpio + done,
+            count - done,
+            threshold,
+            lineMask,
+            partial);
+        partial.numSamples += count;
+    }
+
+    //--------------------------------------------------------------------------
+    void merge(sPartial& into, const sPartial& partial)
+    {
+        into.sum += partial.sum;
+        into.numSamples += partial.numSamples;
+        into.numAbove += partial.numAbove;
+        into.numHigh += partial.numHigh;
+    }
+
+    //--------------------------------------------------------------------------
+    SignalDataFacade::sWindowAggregate aggregateOf(
+        uint64_t firstSample,
+        const sPartial& partial)
+    {
+        SignalDataFacade::sWindowAggregate aggregate;
+        aggregate.firstSample = firstSample;
+        aggregate.numSamples = partial.numSamples;
+        aggregate.numAboveThreshold = partial.numAbove;
+        if (partial.numSamples > 0)
+        {
+            aggregate.mean =
+                double(partial.sum) / double(partial.numSamples);
+            aggregate.dutyCycle =
+                double(partial.numHigh) / double(partial.numSamples);
+        }
+        return aggregate;
+    }
+
+} // namespace anonymous
+
+namespace SignalDataFacade
+{
+    //--------------------------------------------------------------------------
+    // Window Query Engine Implementation
+    //--------------------------------------------------------------------------
+    WindowQueryEngine::WindowQueryEngine(size_t numThreads, eSimdLevel level)
+    : pool{numThreads},
+      kernelLevel{std::min(level, detectedSimdLevel())},
+      analogBuffers(pool.size()),
+      gpioBuffers(pool.size())
+    {
+        // No Body
+    }
+
+    //--------------------------------------------------------------------------
+    sWindowQueryResult WindowQueryEngine::run(
+        const CaptureReader& reader,
+        const sWindowQuery_t& query)
+    {
+        if (query.analogChannel >= reader.numChannels() ||
+            query.gpioChannel >= reader.numChannels())
+        {
+            throw std::out_of_range("Query channel out of range");
+        }
+        if (query.windowSamples == 0 || query.gpioLine > 15)
+        {
+            throw std::invalid_argument("Invalid window query");
+        }
+
+        auto start = std::chrono::steady_clock::now();
+        sWindowQueryResult result;
+        result.numThreads = pool.size();
+        const uint64_t first = query.firstSample;
+        const uint64_t end = std::min(query.endSample, reader.numSamples());
+        result.total.firstSample = first;
+        if (end <= first)
+        {
+            return result;
+        }
+        const uint64_t window = query.windowSamples;
+        const uint16_t lineMask = uint16_t(1u << query.gpioLine);
+
+        // Split the chunks holding [first, end) into contiguous runs
+        size_t firstChunk = chunkEndingAfter(reader, first);
+        size_t endChunk = chunkEndingAfter(reader, end - 1) + 1;
+        size_t numChunks = endChunk - firstChunk;
+        size_t numRuns = std::min(numChunks, pool.size() * RUNS_PER_THREAD);
+
+        // Each run's partials, for the windows from its first one on
+        std::vector<uint64_t> runFirstWindows(numRuns);
+        std::vector<std::vector<sPartial>> runPartials(numRuns);
+        auto scanRun = [&](size_t run, size_t worker)
+        {
+            size_t runFirstChunk = firstChunk + numChunks * run / numRuns;
+            size_t runEndChunk = firstChunk + numChunks * (run + 1) / numRuns;
+            const auto& lastHeader = reader.chunkHeader(runEndChunk - 1);
+            uint64_t runFirst = std::max(
+                reader.chunkHeader(runFirstChunk).firstSampleIndex, first);
+            uint64_t runEnd = std::min(
+                lastHeader.firstSampleIndex + lastHeader.numSamples, end);
+            if (runEnd <= runFirst)
+            {
+                return;
+            }
+            uint64_t firstWindow = (runFirst - first) / window;
+            auto& partials = runPartials[run];
+            runFirstWindows[run] = firstWindow;
+            partials.assign(
+                (runEnd - 1 - first) / window - firstWindow + 1, {});
+
+            for (size_t chunk = runFirstChunk; chunk < runEndChunk; ++chunk)
+            {
+                const auto& header = reader.chunkHeader(chunk);
+                uint64_t chunkFirst = header.firstSampleIndex;
+                uint64_t sample = std::max(chunkFirst, first);
+                uint64_t chunkEnd =
+                    std::min(chunkFirst + header.numSamples, end);
+                if (chunkEnd <= sample)
+                {
+                    continue;
+                }
+
+                // Mapped in place, unless compressed
+                const uint16_t* pAnalog = nullptr;
+                const uint16_t* pGpio = nullptr;
+                if (header.encoding == CAPTURE_ENCODING_RAW)
+                {
+                    pAnalog = reader.column(chunk, query.analogChannel).data();
+                    pGpio = reader.column(chunk, query.gpioChannel).data();
+                }
+                else
+                {
+                    reader.decodeColumn(
+                        chunk, query.analogChannel, analogBuffers[worker]);
+                    reader.decodeColumn(
+                        chunk, query.gpioChannel, gpioBuffers[worker]);
+                    pAnalog = analogBuffers[worker].data();
+                    pGpio = gpioBuffers[worker].data();
+                }
+
+                while (sample < chunkEnd)
+                {
+                    uint64_t windowIndex = (sample - first) / window;
+                    uint64_t windowEnd = std::min(
+                        first + (windowIndex + 1) * window, chunkEnd);
+                    accumulate(
+                        pAnalog + (sample - chunkFirst),
+                        pGpio + (sample - chunkFirst),
+                        size_t(windowEnd - sample),
+                        query.threshold,
+                        lineMask,
+                        partials[windowIndex - firstWindow],
+                        kernelLevel);
+                    sample = windowEnd;
+                }
+            }
+        };
+        pool.run(numRuns, scanRun);
+
+        // Merge the runs' partials; windows straddling runs have several
+        size_t numWindows = size_t((end - first + window - 1) / window);
+        std::vector<sPartial> merged(numWindows, sPartial{});
+        for (size_t run = 0; run < numRuns; ++run)
+        {
+            const auto& partials = runPartials[run];
+            for (size_t i = 0; i < partials.size(); ++i)
+            {
+                merge(merged[runFirstWindows[run] + i], partials[i]);
+            }
+        }
+
+        sPartial total{};
+        result.windows.reserve(numWindows);
+        for (size_t i = 0; i < numWindows; ++i)
+        {
+            merge(total, merged[i]);
+            result.windows.push_back(
+                aggregateOf(first + i * window, merged[i]));
+        }
+        result.total = aggregateOf(first, total);
+        result.bytesScanned = total.numSamples * 2 * sizeof(uint16_t);
+        result.seconds = std::chrono::duration<double>(
+            std::chrono::steady_clock::now() - start).count();
+        return result;
+    }
+
+} // namespace SignalDataFacade
@@ -0,0 +1,134 @@
+// Copyright (c) 2025 Michael Dello
+//
+// This software is provided under the MIT License.
+// See LICENSE file for details.
+
+//-----------------------------------------------------------------------------
+//
+// Signal Data Sample Block Implementation
+//
+//-----------------------------------------------------------------------------
+
+#include "facadepattern_sampleblock.h"
+#include <algorithm>
+#include <new>
+#include <utility>
+
+namespace SignalDataFacade
+{
+    //--------------------------------------------------------------------------
+    SampleBlock::SampleBlock(): numSamples{0}, maxSamples{0}
+    {
+        // No Body
+    }
+
+    //--------------------------------------------------------------------------
+    SampleBlock::SampleBlock(size_t initialCapacity): SampleBlock()
+    {
+        reserve(initialCapacity);
+    }
+
+    //--------------------------------------------------------------------------
+    SampleBlock::SampleBlock(SampleBlock&& other) noexcept
+    : upAnalog{std::move(other.upAnalog)},
+      upDigital{std::move(other.upDigital)},
+      numSamples{std::exchange(other.numSamples, 0)},
+      maxSamples{std::exchange(other.maxSamples, 0)}
+    {
+        // No Body
+    }
+
+    //--------------------------------------------------------------------------
+    SampleBlock& SampleBlock::operator=(SampleBlock&& other) noexcept
+    {
+        upAnalog = std::move(other.upAnalog);
+        upDigital = std::move(other.upDigital);
+        numSamples = std::exchange(other.numSamples, 0);
+        maxSamples = std::exchange(other.maxSamples, 0);
+        return *this;
+    }
+
+    //--------------------------------------------------------------------------
+    void SampleBlock::reserve(size_t newCapacity)
+    {
+        if (newCapacity <= maxSamples)
+        {
+            return;
+        }
+
+        // Round up to whole cache lines, the tail is usable capacity anyway
+        constexpr size_t SAMPLES_PER_LINE = ALIGNMENT / sizeof(uint16_t);
+        newCapacity = (newCapacity + SAMPLES_PER_LINE - 1) /
+            SAMPLES_PER_LINE * SAMPLES_PER_LINE;
+
+        Column upNewAnalog = allocateColumn(newCapacity);
+        Column upNewDigital = allocateColumn(newCapacity);
+        std::copy_n(upAnalog.get(), numSamples, upNewAnalog.get());
+        std::copy_n(upDigital.get(), numSamples, upNewDigital.get());
+        upAnalog = std::move(upNewAnalog);
+        upDigital = std::move(upNewDigital);
+        maxSamples = newCapacity;
+    }
+
+    //--------------------------------------------------------------------------
+    void SampleBlock::resize(size_t count)
+    {
+        if (count <= numSamples)
+        {
+            numSamples = count;
+            return;
+        }
+        size_t first = appendUninitialized(count - numSamples);
+        std::fill(upAnalog.get() + first, upAnalog.get() + count, uint16_t{0});
+        std::fill(
+            upDigital.get() + first, upDigital.get() + count, uint16_t{0});
+    }
+
+    //--------------------------------------------------------------------------
+    void SampleBlock::push_back(const SignalData::sAggregateData& sample)
+    {
+        size_t index = appendUninitialized(1);
+        upAnalog[index] = sample.analog;
+        upDigital[index] = sample.digital;
+    }
+
+    //--------------------------------------------------------------------------
+    void SampleBlock::append(
+        std::span<const SignalData::sAggregateData> samples)
+    {
+        size_t first = appendUninitialized(samples.size());
+        for (size_t i = 0; i < samples.size(); ++i)
+        {
+            upAnalog[first + i] = samples[i].analog;
+            upDigital[first + i] = samples[i].digital;
+        }
+    }
+
+    //--------------------------------------------------------------------------
+    size_t SampleBlock::appendUninitialized(size_t count)
+    {
+        size_t first = numSamples;
+        if (first + count > maxSamples)
+        {
+            // Geometric growth keeps repeated appends amortized O(1)
+            reserve(std::max(first + count, 2 * maxSamples));
+        }
+        numSamples = first + count;
+        return first;
+    }
+
+    //--------------------------------------------------------------------------
+    SampleBlock::Column SampleBlock::allocateColumn(size_t count)
+    {
+        return Column{static_cast<uint16_t*>(::operator new(
+            count * sizeof(uint16_t), std::align_val_t{ALIGNMENT}))};
+    }
+
+    //--------------------------------------------------------------------------
+    void SampleBlock::sAlignedDeleter::operator()(
+        uint16_t* pColumn) const noexcept
+    {
+        ::operator delete(pColumn, std::align_val_t{ALIGNMENT});
+    }
+
+} // namespace SignalDataFacade
@@ -0,0 +1,1110 @@
+// Copyright (c) 2025 Michael Dello
+//
+// This software is provided under the MIT License.
+// See LICENSE file for details.
+
+//-----------------------------------------------------------------------------
+//
+// Spectral Analysis Implementation
+//
+//-----------------------------------------------------------------------------
+
+#include "facadepattern_spectrum.h"
+#include <algorithm>
+#include <bit>
+#include <cmath>
+#include <iterator>
+#include <map>
+#include <mutex>
+#include <numbers>
+#include <stdexcept>
+
+// SIMD kernels need GCC/Clang target attributes on an x86 CPU
+#if (defined(__GNUC__) || defined(__clang__)) && \
+    (defined(__x86_64__) || defined(__i386__))
+#define FACADEPATTERN_SPECTRUM_X86_KERNELS 1
+#include <immintrin.h>
+#else
+#define FACADEPATTERN_SPECTRUM_X86_KERNELS 0
+#endif
+
+namespace // anonymous
+{
+    using SignalDataFacade::eSimdLevel;
+
+    //--------------------------------------------------------------------------
+    // Types
+    //--------------------------------------------------------------------------
+    // Twiddles of an FFT of size real samples, M = size / 2 complex values
+    struct sTwiddles
+    {
+        // e^(-2 pi i k / M) for k < M. A radix-4 pass with stride s over
+        // groups of 4m uses entries p s, 2 p s and 3 p s for p < m.
+        std::vector<float> re;
+        std::vector<float> im;
+        // Entries 2p and 3p for p < M / 4, contiguous for the first pass
+        std::vector<float> re2;
+        std::vector<float> im2;
+        std::vector<float> re3;
+        std::vector<float> im3;
+        // e^(-2 pi i k / size) for k <= M, for splitting the spectrum
+        std::vector<float> splitRe;
+        std::vector<float> splitIm;
+    };
+
+    // Split complex arrays, the input and output of one pass
+    struct sPass
+    {
+        const float* pXr;
+        const float* pXi;
+        float* pYr;
+        float* pYi;
+    };
+
+    //--------------------------------------------------------------------------
+    // Scalar Kernels
+    //--------------------------------------------------------------------------
+    // One radix-4 Stockham pass: m groups of 4 butterfly inputs, each s
+    // apart, s the product of the radices of the passes before
+    void radix4Scalar(
+        const sPass& pass,
+        size_t m,
+        size_t s,
+        const sTwiddles& tw)
+    {
+        size_t quarter = s * m;
+        for (size_t p = 0; p < m; ++p)
+        {
+            float w1r = tw.re[p * s];
+            float w1i = tw.im[p * s];
+            float w2r = tw.re[2 * p * s];
+            float w2i = tw.im[2 * p * s];
+            float w3r = tw.re[3 * p * s];
+            float w3i = tw.im[3 * p * s];
+            for (size_t q = 0; q < s; ++q)
+            {
+                size_t in = q + s * p;
+                float ar = pass.pXr[in];
+                float ai = pass.pXi[in];
+                float br = pass.pXr[in + quarter];
+                float bi = pass.pXi[in + quarter];
+                float cr = pass.pXr[in + 2 * quarter];
+                float ci = pass.pXi[in + 2 * quarter];
+                float dr = pass.pXr[in + 3 * quarter];
+                float di = pass.pXi[in + 3 * quarter];
+
+                float apcR = ar + cr;
+                float apcI = ai + ci;
+                float amcR = ar - cr;
+                float amcI = ai - ci;
+                float bpdR = br + dr;
+                float bpdI = bi + di;
+                float bmdR = br - dr;
+                float bmdI = bi - di;
+
+                // (a - c) -/+ i (b - d), and (a + c) - (b + d)
+                float t1r = amcR + bmdI;
+                float t1i = amcI - bmdR;
+                float t2r = apcR - bpdR;
+                float t2i = apcI - bpdI;
+                float t3r = amcR - bmdI;
+                float t3i = amcI + bmdR;
+
+                size_t out = q + s * 4 * p;
+                pass.pYr[out] = apcR + bpdR;
+                pass.pYi[out] = apcI + bpdI;
+                pass.pYr[out + s] = t1r * w1r - t1i * w1i;
+                pass.pYi[out + s] = t1r * w1i + t1i * w1r;
+                pass.pYr[out + 2 * s] = t2r * w2r - t2i * w2i;
+                pass.pYi[out + 2 * s] = t2r * w2i + t2i * w2r;
+                pass.pYr[out + 3 * s] = t3r * w3r - t3i * w3i;
+                pass.pYi[out + 3 * s] = t3r * w3i + t3i * w3r;
+            }
+        }
+    }
+
+    //--------------------------------------------------------------------------
+    // The final radix-2 pass of an odd power of two, no twiddles
+    void radix2Scalar(const sPass& pass, size_t s)
+    {
+        for (size_t q = 0; q < s; ++q)
+        {
+            float ar = pass.pXr[q];
+            float ai = pass.pXi[q];
+            float br = pass.pXr[q + s];
+            float bi = pass.pXi[q + s];
+            pass.pYr[q] = ar + br;
+            pass.pYi[q] = ai + bi;
+            pass.pYr[q + s] = ar - br;
+            pass.pYi[q + s] = ai - bi;
+        }
+    }
+
+#if FACADEPATTERN_SPECTRUM_X86_KERNELS
+    //--------------------------------------------------------------------------
+    // SSE Kernels
+    //--------------------------------------------------------------------------
+    struct sComplex4
+    {
+        __m128 re;
+        __m128 im;
+    };
+
+    //--------------------------------------------------------------------------
+    __attribute__((target("sse4.1")))
+    inline sComplex4 multiplySSE(__m128 xr, __m128 xi, __m128 wr, __m128 wi)
+    {
+        return {
+            _mm_sub_ps(_mm_mul_ps(xr, wr), _mm_mul_ps(xi, wi)),
+            _mm_add_ps(_mm_mul_ps(xr, wi), _mm_mul_ps(xi, wr))};
+    }
+
+    //--------------------------------------------------------------------------
+    // The four outputs of radix-4 butterflies on 4 lanes
+    struct sButterfly4
+    {
+        sComplex4 y0;
+        sComplex4 y1;
+        sComplex4 y2;
+        sComplex4 y3;
+    };
+
+    __attribute__((target("sse4.1")))
+    inline sButterfly4 butterflySSE(
+        sComplex4 a, sComplex4 b, sComplex4 c, sComplex4 d,
+        sComplex4 w1, sComplex4 w2, sComplex4 w3)
+    {
+        __m128 apcR = _mm_add_ps(a.re, c.re);
+        __m128 apcI = _mm_add_ps(a.im, c.im);
+        __m128 amcR = _mm_sub_ps(a.re, c.re);
+        __m128 amcI = _mm_sub_ps(a.im, c.im);
+        __m128 bpdR = _mm_add_ps(b.re, d.re);
+        __m128 bpdI = _mm_add_ps(b.im, d.im);
+        __m128 bmdR = _mm_sub_ps(b.re, d.re);
+        __m128 bmdI = _mm_sub_ps(b.im, d.im);
+        return {
+            {_mm_add_ps(apcR, bpdR), _mm_add_ps(apcI, bpdI)},
+            multiplySSE(
+                _mm_add_ps(amcR, bmdI), _mm_sub_ps(amcI, bmdR),
+                w1.re, w1.im),
+            multiplySSE(
+                _mm_sub_ps(apcR, bpdR), _mm_sub_ps(apcI, bpdI),
+                w2.re, w2.im),
+            multiplySSE(
+                _mm_sub_ps(amcR, bmdI), _mm_add_ps(amcI, bmdR),
+                w3.re, w3.im)};
+    }
+
+    //--------------------------------------------------------------------------
+    __attribute__((target("sse4.1")))
+    inline sComplex4 loadSSE(const float* pRe, const float* pIm, size_t i)
+    {
+        return {_mm_loadu_ps(pRe + i), _mm_loadu_ps(pIm + i)};
+    }
+
+    __attribute__((target("sse4.1")))
+    inline void storeSSE(float* pRe, float* pIm, size_t i, sComplex4 value)
+    {
+        _mm_storeu_ps(pRe + i, value.re);
+        _mm_storeu_ps(pIm + i, value.im);
+    }
+
+    //--------------------------------------------------------------------------
+    // A pass with s a multiple of 4: 4 values of q per butterfly, sharing
+    // their twiddles
+    __attribute__((target("sse4.1")))
+    void radix4StridedSSE(
+        const sPass& pass,
+        size_t m,
+        size_t s,
+        const sTwiddles& tw)
+    {
+        size_t quarter = s * m;
+        for (size_t p = 0; p < m; ++p)
+        {
+            sComplex4 w1{_mm_set1_ps(tw.re[p * s]), _mm_set1_ps(tw.im[p * s])};
+            sComplex4 w2{
+                _mm_set1_ps(tw.re[2 * p * s]), _mm_set1_ps(tw.im[2 * p * s])};
+            sComplex4 w3{
+                _mm_set1_ps(tw.re[3 * p * s]), _mm_set1_ps(tw.im[3 * p * s])};
+            for (size_t q = 0; q < s; q += 4)
+            {
+                size_t in = q + s * p;
+                sButterfly4 y = butterflySSE(
+                    loadSSE(pass.pXr, pass.pXi, in),
+                    loadSSE(pass.pXr, pass.pXi, in + quarter),
+                    loadSSE(pass.pXr, pass.pXi, in + 2 * quarter),
+                    loadSSE(pass.pXr, pass.pXi, in + 3 * quarter),
+                    w1, w2, w3);
+                size_t out = q + s * 4 * p;
+                storeSSE(pass.pYr, pass.pYi, out, y.y0);
+                storeSSE(pass.pYr, pass.pYi, out + s, y.y1);
+                storeSSE(pass.pYr, pass.pYi, out + 2 * s, y.y2);
+                storeSSE(pass.pYr, pass.pYi, out + 3 * s, y.y3);
+            }
+        }
+    }
+
+    //--------------------------------------------------------------------------
+    // The first pass (s = 1) with m a multiple of 4: 4 values of p per
+    // butterfly. Their outputs interleave, so they are transposed to store.
+    __attribute__((target("sse4.1")))
+    void radix4FirstSSE(const sPass& pass, size_t m, const sTwiddles& tw)
+    {
+        for (size_t p = 0; p < m; p += 4)
+        {
+            sButterfly4 y = butterflySSE(
+                loadSSE(pass.pXr, pass.pXi, p),
+                loadSSE(pass.pXr, pass.pXi, p + m),
+                loadSSE(pass.pXr, pass.pXi, p + 2 * m),
+                loadSSE(pass.pXr, pass.pXi, p + 3 * m),
+                loadSSE(tw.re.data(), tw.im.data(), p),
+                loadSSE(tw.re2.data(), tw.im2.data(), p),
+                loadSSE(tw.re3.data(), tw.im3.data(), p));
+            _MM_TRANSPOSE4_PS(y.y0.re, y.y1.re, y.y2.re, y.y3.re);
+            _MM_TRANSPOSE4_PS(y.y0.im, y.y1.im, y.y2.im, y.y3.im);
+            size_t out = 4 * p;
+            storeSSE(pass.pYr, pass.pYi, out, y.y0);
+            storeSSE(pass.pYr, pass.pYi, out + 4, y.y1);
+            storeSSE(pass.pYr, pass.pYi, out + 8, y.y2);
+            storeSSE(pass.pYr, pass.pYi, out + 12, y.y3);
+        }
+    }
+
+    //--------------------------------------------------------------------------
+    __attribute__((target("sse4.1")))
+    void radix2SSE(const sPass& pass, size_t s)
+    {
+        for (size_t q = 0; q < s; q += 4)
+        {
+            sComplex4 a = loadSSE(pass.pXr, pass.pXi, q);
+            sComplex4 b = loadSSE(pass.pXr, pass.pXi, q + s);
+            storeSSE(pass.pYr, pass.pYi, q,
+                {_mm_add_ps(a.re, b.re), _mm_add_ps(a.im, b.im)});
+            storeSSE(pass.pYr, pass.pYi, q + s,
+                {_mm_sub_ps(a.re, b.re), _mm_sub_ps(a.im, b.im)});
+        }
+    }
+
+    //--------------------------------------------------------------------------
+    // AVX2 Kernels
+    //--------------------------------------------------------------------------
+    struct sComplex8
+    {
+        __m256 re;
+        __m256 im;
+    };
+
+    //--------------------------------------------------------------------------
+    __attribute__((target("avx2")))
+    inline sComplex8 multiplyAVX2(__m256 xr, __m256 xi, __m256 wr, __m256 wi)
+    {
+        return {
+            _mm256_sub_ps(_mm256_mul_ps(xr, wr), _mm256_mul_ps(xi, wi)),
+            _mm256_add_ps(_mm256_mul_ps(xr, wi), _mm256_mul_ps(xi, wr))};
+    }
+
+    //--------------------------------------------------------------------------
+    struct sButterfly8
+    {
+        sComplex8 y0;
+        sComplex8 y1;
+        sComplex8 y2;
+        sComplex8 y3;
+    };
+
+    __attribute__((target("avx2")))
+    inline sButterfly8 butterflyAVX2(
+        sComplex8 a, sComplex8 b, sComplex8 c, sComplex8 d,
+        sComplex8 w1, sComplex8 w2, sComplex8 w3)
+    {
+        __m256 apcR = _mm256_add_ps(a.re, c.re);
+        __m256 apcI = _mm256_add_ps(a.im, c.im);
+        __m256 amcR = _mm256_sub_ps(a.re, c.re);
+        __m256 amcI = _mm256_sub_ps(a.im, c.im);
+        __m256 bpdR = _mm256_add_ps(b.re, d.re);
+        __m256 bpdI = _mm256_add_ps(b.im, d.im);
+        __m256 bmdR = _mm256_sub_ps(b.re, d.re);
+        __m256 bmdI = _mm256_sub_ps(b.im, d.im);
+        return {
+            {_mm256_add_ps(apcR, bpdR), _mm256_add_ps(apcI, bpdI)},
+            multiplyAVX2(
+                _mm256_add_ps(amcR, bmdI), _mm256_sub_ps(amcI, bmdR),
+                w1.re, w1.im),
+            multiplyAVX2(
+                _mm256_sub_ps(apcR, bpdR), _mm256_sub_ps(apcI, bpdI),
+                w2.re, w2.im),
+            multiplyAVX2(
+                _mm256_sub_ps(amcR, bmdI), _mm256_add_ps(amcI, bmdR),
+                w3.re, w3.im)};
+    }
+
+    //--------------------------------------------------------------------------
+    __attribute__((target("avx2")))
+    inline sComplex8 loadAVX2(const float* pRe, const float* pIm, size_t i)
+    {
+        return {_mm256_loadu_ps(pRe + i), _mm256_loadu_ps(pIm + i)};
+    }
+
+    __attribute__((target("avx2")))
+    inline void storeAVX2(float* pRe, float* pIm, size_t i, sComplex8 value)
+    {
+        _mm256_storeu_ps(pRe + i, value.re);
+        _mm256_storeu_ps(pIm + i, value.im);
+    }
+
+    //--------------------------------------------------------------------------
+    // Rows r0..r3 of 8 lanes each, as 8 consecutive columns of 4, in place
+    __attribute__((target("avx2")))
+    inline void transpose4x8AVX2(__m256& r0, __m256& r1, __m256& r2, __m256& r3)
+    {
+        __m256 t0 = _mm256_unpacklo_ps(r0, r1);
+        __m256 t1 = _mm256_unpackhi_ps(r0, r1);
+        __m256 t2 = _mm256_unpacklo_ps(r2, r3);
+        __m256 t3 = _mm256_unpackhi_ps(r2, r3);
+        // Columns 0 and 4, 1 and 5, 2 and 6, 3 and 7
+        __m256 c04 = _mm256_shuffle_ps(t0, t2, 0x44);
+        __m256 c15 = _mm256_shuffle_ps(t0, t2, 0xEE);
+        __m256 c26 = _mm256_shuffle_ps(t1, t3, 0x44);
+        __m256 c37 = _mm256_shuffle_ps(t1, t3, 0xEE);
+        r0 = _mm256_permute2f128_ps(c04, c15, 0x20);
+        r1 = _mm256_permute2f128_ps(c26, c37, 0x20);
+        r2 = _mm256_permute2f128_ps(c04, c15, 0x31);
+        r3 = _mm256_permute2f128_ps(c26, c37, 0x31);
+    }
+
+    //--------------------------------------------------------------------------
+    __attribute__((target("avx2")))
+    void radix4StridedAVX2(
+        const sPass& pass,
+        size_t m,
+        size_t s,
+        const sTwiddles& tw)
+    {
+        size_t quarter = s * m;
+        for (size_t p = 0; p < m; ++p)
+        {
+            sComplex8 w1{
+                _mm256_set1_ps(tw.re[p * s]), _mm256_set1_ps(tw.im[p * s])};
+            sComplex8 w2{
+                _mm256_set1_ps(tw.re[2 * p * s]),
+                _mm256_set1_ps(tw.im[2 * p * s])};
+            sComplex8 w3{
+                _mm256_set1_ps(tw.re[3 * p * s]),
+                _mm256_set1_ps(tw.im[3 * p * s])};
+            for (size_t q = 0; q < s; q += 8)
+            {
+                size_t in = q + s * p;
+                sButterfly8 y = butterflyAVX2(
+                    loadAVX2(pass.pXr, pass.pXi, in),
+                    loadAVX2(pass.pXr, pass.pXi, in + quarter),
+                    loadAVX2(pass.pXr, pass.pXi, in + 2 * quarter),
+                    loadAVX2(pass.pXr, pass.pXi, in + 3 * quarter),
+                    w1, w2, w3);
+                size_t out = q + s * 4 * p;
+                storeAVX2(pass.pYr, pass.pYi, out, y.y0);
+                storeAVX2(pass.pYr, pass.pYi, out + s, y.y1);
+                storeAVX2(pass.pYr, pass.pYi, out + 2 * s, y.y2);
+                storeAVX2(pass.pYr, pass.pYi, out + 3 * s, y.y3);
+            }
+        }
+    }
+
+    //--------------------------------------------------------------------------
+    __attribute__((target("avx2")))
+    void radix4FirstAVX2(const sPass& pass, size_t m, const sTwiddles& tw)
+    {
+        for (size_t p = 0; p < m; p += 8)
+        {
+            sButterfly8 y = butterflyAVX2(
+                loadAVX2(pass.pXr, pass.pXi, p),
+                loadAVX2(pass.pXr, pass.pXi, p + m),
+                loadAVX2(pass.pXr, pass.pXi, p + 2 * m),
+                loadAVX2(pass.pXr, pass.pXi, p + 3 * m),
+                loadAVX2(tw.re.data(), tw.im.data(), p),
+                loadAVX2(tw.re2.data(), tw.im2.data(), p),
+                loadAVX2(tw.re3.data(), tw.im3.data(), p));
+            transpose4x8AVX2(y.y0.re, y.y1.re, y.y2.re, y.y3.re);
+            transpose4x8AVX2(y.y0.im, y.y1.im, y.y2.im, y.y3.im);
+            size_t out = 4 * p;
+            storeAVX2(pass.pYr, pass.pYi, out, y.y0);
+            storeAVX2(pass.pYr, pass.pYi, out + 8, y.y1);
+            storeAVX2(pass.pYr, pass.pYi, out + 16, y.y2);
+            storeAVX2(pass.pYr, pass.pYi, out + 24, y.y3);
+        }
+    }
+
+    //--------------------------------------------------------------------------
+    __attribute__((target("avx2")))
+    void radix2AVX2(const sPass& pass, size_t s)
+    {
+        for (size_t q = 0; q < s; q += 8)
+        {
+            sComplex8 a = loadAVX2(pass.pXr, pass.pXi, q);
+            sComplex8 b = loadAVX2(pass.pXr, pass.pXi, q + s);
+            storeAVX2(pass.pYr, pass.pYi, q,
+                {_mm256_add_ps(a.re, b.re), _mm256_add_ps(a.im, b.im)});
+            storeAVX2(pass.pYr, pass.pYi, q + s,
+                {_mm256_sub_ps(a.re, b.re), _mm256_sub_ps(a.im, b.im)});
+        }
+    }
+#endif
+
+    //--------------------------------------------------------------------------
+    // Dispatch
+    //--------------------------------------------------------------------------
+    // Lanes of the widest kernel at a level
+    size_t vectorLanes(eSimdLevel level)
+    {
+        switch (level)
+        {
+            case eSimdLevel::AVX2:
+                return 8;
+            case eSimdLevel::SSE4:
+                return 4;
+            default:
+                break;
+        }
+        return 1;
+    }
+
+    //--------------------------------------------------------------------------
+    void radix4Pass(
+        const sPass& pass,
+        size_t m,
+        size_t s,
+        const sTwiddles& tw,
+        eSimdLevel level)
+    {
+        // The widest kernel the pass geometry allows, vectorized over p in
+        // the first pass and over q in the others
+        size_t lanes = vectorLanes(level);
+        while (lanes > 1 && (s == 1 ? m : s) % lanes != 0)
+        {
+            lanes /= 2;
+        }
+        if (lanes == 2)
+        {
+            lanes = 1;
+        }
+
+        switch (lanes)
+        {
+#if FACADEPATTERN_SPECTRUM_X86_KERNELS
+            case 8:
+                s == 1 ? radix4FirstAVX2(pass, m, tw)
+                       : radix4StridedAVX2(pass, m, s, tw);
+                return;
+            case 4:
+                s == 1 ? radix4FirstSSE(pass, m, tw)
+                       : radix4StridedSSE(pass, m, s, tw);
+                return;
+#endif
+            default:
+                radix4Scalar(pass, m, s, tw);
+                return;
+        }
+    }
+
+    //--------------------------------------------------------------------------
+    void radix2Pass(const sPass& pass, size_t s, eSimdLevel level)
+    {
+        size_t lanes = vectorLanes(level);
+        while (lanes > 1 && s % lanes != 0)
+        {
+            lanes /= 2;
+        }
+
+        switch (lanes)
+        {
+#if FACADEPATTERN_SPECTRUM_X86_KERNELS
+            case 8:
+                radix2AVX2(pass, s);
+                return;
+            case 4:
+                radix2SSE(pass, s);
+                return;
+#endif
+            default:
+                radix2Scalar(pass, s);
+                return;
+        }
+    }
+
+    //--------------------------------------------------------------------------
+    // Packing and Splitting Kernels
+    //--------------------------------------------------------------------------
+    // The real input as half as many complex values: even samples as real
+    // parts, odd ones as imaginary parts
+    void packScalar(const float* pSamples, float* pZr, float* pZi, size_t half)
+    {
+        for (size_t k = 0; k < half; ++k)
+        {
+            pZr[k] = pSamples[2 * k];
+            pZi[k] = pSamples[2 * k + 1];
+        }
+    }
+
+    //--------------------------------------------------------------------------
+    // Bins [first, last) of the real input's spectrum, 0 < first and
+    // last < M, from the half-length spectrum Z: the even samples' spectrum
+    // E[k] = (Z[k] + conj(Z[M - k])) / 2 and the odd samples' spectrum
+    // O[k] = -i (Z[k] - conj(Z[M - k])) / 2, recombined as
+    // X[k] = E[k] + e^(-2 pi i k / size) O[k]
+    void splitScalar(
+        const float* pZr,
+        const float* pZi,
+        float* pXr,
+        float* pXi,
+        size_t first,
+        size_t last,
+        size_t half,
+        const sTwiddles& tw)
+    {
+        for (size_t k = first; k < last; ++k)
+        {
+            float zr = pZr[k];
+            float zi = pZi[k];
+            float cr = pZr[half - k];
+            float ci = -pZi[half - k];
+            float er = 0.5f * (zr + cr);
+            float ei = 0.5f * (zi + ci);
+            float or_ = 0.5f * (zi - ci);
+            float oi = 0.5f * (cr - zr);
+            float wr = tw.splitRe[k];
+            float wi = tw.splitIm[k];
+            pXr[k] = er + or_ * wr - oi * wi;
+            pXi[k] = ei + or_ * wi + oi * wr;
+        }
+    }
+
+#if FACADEPATTERN_SPECTRUM_X86_KERNELS
+    //--------------------------------------------------------------------------
+    __attribute__((target("sse4.1")))
+    void packSSE(const float* pSamples, float* pZr, float* pZi, size_t half)
+    {
+        for (size_t k = 0; k < half; k += 4)
+        {
+            __m128 low = _mm_loadu_ps(pSamples + 2 * k);
+            __m128 high = _mm_loadu_ps(pSamples + 2 * k + 4);
+            _mm_storeu_ps(
+                pZr + k, _mm_shuffle_ps(low, high, _MM_SHUFFLE(2, 0, 2, 0)));
+            _mm_storeu_ps(
+                pZi + k, _mm_shuffle_ps(low, high, _MM_SHUFFLE(3, 1, 3, 1)));
+        }
+    }
+
+    //--------------------------------------------------------------------------
+    // 4 bins at a time, the mirrored bins loaded from M - k - 3 and reversed
+    __attribute__((target("sse4.1")))
+    size_t splitSSE(
+        const float* pZr,
+        const float* pZi,
+        float* pXr,
+        float* pXi,
+        size_t half,
+        const sTwiddles& tw)
+    {
+        const __m128 HALF = _mm_set1_ps(0.5f);
+        size_t k = 1;
+        for (; k + 4 <= half; k += 4)
+        {
+            __m128 zr = _mm_loadu_ps(pZr + k);
+            __m128 zi = _mm_loadu_ps(pZi + k);
+            __m128 cr = _mm_loadu_ps(pZr + half - k - 3);
+            __m128 ci = _mm_loadu_ps(pZi + half - k - 3);
+            cr = _mm_shuffle_ps(cr, cr, _MM_SHUFFLE(0, 1, 2, 3));
+            ci = _mm_shuffle_ps(ci, ci, _MM_SHUFFLE(0, 1, 2, 3));
+            // c is Z[M - k], unconjugated: E = (zr + cr, zi - ci) / 2 and
+            // O = (zi + ci, cr - zr) / 2
+            __m128 er = _mm_mul_ps(HALF, _mm_add_ps(zr, cr));
+            __m128 ei = _mm_mul_ps(HALF, _mm_sub_ps(zi, ci));
+            __m128 orr = _mm_mul_ps(HALF, _mm_add_ps(zi, ci));
+            __m128 oi = _mm_mul_ps(HALF, _mm_sub_ps(cr, zr));
+            __m128 wr = _mm_loadu_ps(tw.splitRe.data() + k);
+            __m128 wi = _mm_loadu_ps(tw.splitIm.data() + k);
+            sComplex4 wo = multiplySSE(orr, oi, wr, wi);
+            _mm_storeu_ps(pXr + k, _mm_add_ps(er, wo.re));
+            _mm_storeu_ps(pXi + k, _mm_add_ps(ei, wo.im));
+        }
+        return k;
+    }
+
+    //--------------------------------------------------------------------------
+    __attribute__((target("avx2")))
+    void packAVX2(const float* pSamples, float* pZr, float* pZi, size_t half)
+    {
+        for (size_t k = 0; k < half; k += 8)
+        {
+            __m256 low = _mm256_loadu_ps(pSamples + 2 * k);
+            __m256 high = _mm256_loadu_ps(pSamples + 2 * k + 8);
+            // Within 128-bit lanes, then the 64-bit pairs back in order
+            __m256 even = _mm256_shuffle_ps(low, high, _MM_SHUFFLE(2, 0, 2, 0));
+            __m256 odd = _mm256_shuffle_ps(low, high, _MM_SHUFFLE(3, 1, 3, 1));
+            _mm256_storeu_ps(pZr + k, _mm256_castpd_ps(_mm256_permute4x64_pd(
+                _mm256_castps_pd(even), 0xD8)));
+            _mm256_storeu_ps(pZi + k, _mm256_castpd_ps(_mm256_permute4x64_pd(
+                _mm256_castps_pd(odd), 0xD8)));
+        }
+    }
+
+    //--------------------------------------------------------------------------
+    __attribute__((target("avx2")))
+    size_t splitAVX2(
+        const float* pZr,
+        const float* pZi,
+        float* pXr,
+        float* pXi,
+        size_t half,
+        const sTwiddles& tw)
+    {
+        const __m256 HALF = _mm256_set1_ps(0.5f);
+        const __m256i REVERSE = _mm256_setr_epi32(7, 6, 5, 4, 3, 2, 1, 0);
+        size_t k = 1;
+        for (; k + 8 <= half; k += 8)
+        {
+            __m256 zr = _mm256_loadu_ps(pZr + k);
+            __m256 zi = _mm256_loadu_ps(pZi + k);
+            __m256 cr = _mm256_permutevar8x32_ps(
+                _mm256_loadu_ps(pZr + half - k - 7), REVERSE);
+            __m256 ci = _mm256_permutevar8x32_ps(
+                _mm256_loadu_ps(pZi + half - k - 7), REVERSE);
+            __m256 er = _mm256_mul_ps(HALF, _mm256_add_ps(zr, cr));
+            __m256 ei = _mm256_mul_ps(HALF, _mm256_sub_ps(zi, ci));
+            __m256 orr = _mm256_mul_ps(HALF, _mm256_add_ps(zi, ci));
+            __m256 oi = _mm256_mul_ps(HALF, _mm256_sub_ps(cr, zr));
+            __m256 wr = _mm256_loadu_ps(tw.splitRe.data() + k);
+            __m256 wi = _mm256_loadu_ps(tw.splitIm.data() + k);
+            sComplex8 wo = multiplyAVX2(orr, oi, wr, wi);
+            _mm256_storeu_ps(pXr + k, _mm256_add_ps(er, wo.re));
+            _mm256_storeu_ps(pXi + k, _mm256_add_ps(ei, wo.im));
+        }
+        return k;
+    }
+#endif
+
+    //--------------------------------------------------------------------------
+    void pack(
+        const float* pSamples,
+        float* pZr,
+        float* pZi,
+        size_t half,
+        eSimdLevel level)
+    {
+        switch (level)
+        {
+#if FACADEPATTERN_SPECTRUM_X86_KERNELS
+            case eSimdLevel::AVX2:
+                if (half % 8 == 0)
+                {
+                    packAVX2(pSamples, pZr, pZi, half);
+                    return;
+                }
+                [[fallthrough]];
+            case eSimdLevel::SSE4:
+                packSSE(pSamples, pZr, pZi, half);
+                return;
+#endif
+            default:
+                packScalar(pSamples, pZr, pZi, half);
+                return;
+        }
+    }
+
+    //--------------------------------------------------------------------------
+    // Every bin from DC to Nyquist
+    void split(
+        const float* pZr,
+        const float* pZi,
+        float* pXr,
+        float* pXi,
+        size_t half,
+        const sTwiddles& tw,
+        eSimdLevel level)
+    {
+        // DC and Nyquist are real: the sum and difference of the even and
+        // odd samples' DC
+        pXr[0] = pZr[0] + pZi[0];
+        pXi[0] = 0.0f;
+        pXr[half] = pZr[0] - pZi[0];
+        pXi[half] = 0.0f;
+
+        size_t k = 1;
+        switch (level)
+        {
+#if FACADEPATTERN_SPECTRUM_X86_KERNELS
+            case eSimdLevel::AVX2:
+                k = splitAVX2(pZr, pZi, pXr, pXi, half, tw);
+                break;
+            case eSimdLevel::SSE4:
+                k = splitSSE(pZr, pZi, pXr, pXi, half, tw);
+                break;
+#endif
+            default:
+                break;
+        }
+        splitScalar(pZr, pZi, pXr, pXi, k, half, half, tw);
+    }
+
+} // namespace anonymous
+
+namespace SignalDataFacade
+{
+    //--------------------------------------------------------------------------
+    // The kernels' twiddle table, under the name RealFFT declares
+    struct RealFFT::sTwiddles : ::sTwiddles
+    {
+        // No Body
+    };
+
+    //--------------------------------------------------------------------------
+    const char* toString(eWindow window)
+    {
+        switch (window)
+        {
+            case eWindow::RECTANGULAR:
+                return "RECTANGULAR";
+            case eWindow::HANN:
+                return "HANN";
+            case eWindow::BLACKMAN:
+                return "BLACKMAN";
+        }
+        return "UNKNOWN";
+    }
+
+    //--------------------------------------------------------------------------
+    std::vector<float> windowCoefficients(eWindow window, size_t length)
+    {
+        std::vector<float> coefficients(length, 1.0f);
+        for (size_t i = 0; i < length; ++i)
+        {
+            double phase = 2.0 * std::numbers::pi * double(i) / double(length);
+            switch (window)
+            {
+                case eWindow::RECTANGULAR:
+                    break;
+                case eWindow::HANN:
+                    coefficients[i] = float(0.5 - 0.5 * std::cos(phase));
+                    break;
+                case eWindow::BLACKMAN:
+                    coefficients[i] = float(
+                        0.42 - 0.5 * std::cos(phase) +
+                        0.08 * std::cos(2.0 * phase));
+                    break;
+            }
+        }
+        return coefficients;
+    }
+
+    //--------------------------------------------------------------------------
+    // RealFFT Public Methods
+    //--------------------------------------------------------------------------
+
+    //--------------------------------------------------------------------------
+    RealFFT::RealFFT(size_t size, eSimdLevel level)
+    : fftSize{size},
+      kernelLevel{std::min(level, detectedSimdLevel())},
+      spTwiddles{},
+      work{},
+      binsRe{},
+      binsIm{}
+    {
+        if (size < MIN_SIZE || !std::has_single_bit(size))
+        {
+            throw std::invalid_argument(
+                "FFT size must be a power of two of at least 8");
+        }
+        spTwiddles = twiddlesFor(size);
+        work.resize(2 * size);
+        binsRe.resize(numBins());
+        binsIm.resize(numBins());
+    }
+
+    //--------------------------------------------------------------------------
+    void RealFFT::forward(
+        std::span<const float> samples,
+        std::span<std::complex<float>> spectrum)
+    {
+        if (spectrum.size() != numBins())
+        {
+            throw std::invalid_argument("Spectrum must hold size / 2 + 1 bins");
+        }
+
+        transform(samples);
+        for (size_t k = 0; k < spectrum.size(); ++k)
+        {
+            spectrum[k] = {binsRe[k], binsIm[k]};
+        }
+    }
+
+    //--------------------------------------------------------------------------
+    void RealFFT::power(std::span<const float> samples, std::span<float> power)
+    {
+        if (power.size() != numBins())
+        {
+            throw std::invalid_argument("Power must hold size / 2 + 1 bins");
+        }
+
+        transform(samples);
+        for (size_t k = 0; k < power.size(); ++k)
+        {
+            power[k] = binsRe[k] * binsRe[k] + binsIm[k] * binsIm[k];
+        }
+    }
+
+    //--------------------------------------------------------------------------
+    // RealFFT Private Methods
+    //--------------------------------------------------------------------------
+
+    //--------------------------------------------------------------------------
+    std::shared_ptr<const RealFFT::sTwiddles> RealFFT::twiddlesFor(size_t size)
+    {
+        static std::mutex cacheMutex;
+        static std::map<size_t, std::shared_ptr<const sTwiddles>> cache;
+
+        std::lock_guard<std::mutex> lock(cacheMutex);
+        auto& spCached = cache[size];
+        if (!spCached)
+        {
+            // Computed in double, so every entry is the nearest float
+            auto spNew = std::make_shared<sTwiddles>();
+            size_t half = size / 2;
+            auto angle = [](size_t k, size_t n)
+            {
+                return -2.0 * std::numbers::pi * double(k) / double(n);
+            };
+            for (size_t k = 0; k < half; ++k)
+            {
+                spNew->re.push_back(float(std::cos(angle(k, half))));
+                spNew->im.push_back(float(std::sin(angle(k, half))));
+            }
+            for (size_t p = 0; p < half / 4; ++p)
+            {
+                spNew->re2.push_back(spNew->re[2 * p]);
+                spNew->im2.push_back(spNew->im[2 * p]);
+                spNew->re3.push_back(spNew->re[3 * p]);
+                spNew->im3.push_back(spNew->im[3 * p]);
+            }
+            for (size_t k = 0; k <= half; ++k)
+            {
+                spNew->splitRe.push_back(float(std::cos(angle(k, size))));
+                spNew->splitIm.push_back(float(std::sin(angle(k, size))));
+            }
+            spCached = std::move(spNew);
+        }
+        return spCached;
+    }
+
+    //--------------------------------------------------------------------------
+    void RealFFT::transform(std::span<const float> samples)
+    {
+        if (samples.size() != fftSize)
+        {
+            throw std::invalid_argument("Samples must hold the FFT size");
+        }
+
+        size_t half = fftSize / 2;
+        float* pXr = work.data();
+        float* pXi = pXr + half;
+        float* pYr = pXi + half;
+        float* pYi = pYr + half;
+        pack(samples.data(), pXr, pXi, half, kernelLevel);
+
+        // Each pass reads one buffer and writes the other
+        size_t s = 1;
+        size_t length = half;
+        for (; length >= 4; length /= 4, s *= 4)
+        {
+            radix4Pass(
+                {pXr, pXi, pYr, pYi}, length / 4, s, *spTwiddles, kernelLevel);
+            std::swap(pXr, pYr);
+            std::swap(pXi, pYi);
+        }
+        if (length == 2)
+        {
+            radix2Pass({pXr, pXi, pYr, pYi}, s, kernelLevel);
+            std::swap(pXr, pYr);
+            std::swap(pXi, pYi);
+        }
+
+        split(
+            pXr, pXi, binsRe.data(), binsIm.data(), half, *spTwiddles,
+            kernelLevel);
+    }
+
+    //--------------------------------------------------------------------------
+    // SpectrumAnalyzer Public Methods
+    //--------------------------------------------------------------------------
+
+    //--------------------------------------------------------------------------
+    SpectrumAnalyzer::SpectrumAnalyzer(
+        const sSpectrumConfig_t& config,
+        eSimdLevel level)
+    : spectrumConfig{config},
+      fft{config.fftSize, level},
+      window{windowCoefficients(config.window, config.fftSize)},
+      densityScale{0.0},
+      hop{0},
+      pending{},
+      segment(config.fftSize),
+      segmentPower(fft.numBins()),
+      powerSum(fft.numBins(), 0.0),
+      numSegments{0}
+    {
+        if (!(config.overlap >= 0.0 && config.overlap < 1.0))
+        {
+            throw std::invalid_argument("Overlap must be within [0, 1)");
+        }
+        if (!(config.sampleRateHz > 0.0))
+        {
+            throw std::invalid_argument("Sample rate must be positive");
+        }
+
+        double sumSquares = 0.0;
+        for (float coefficient : window)
+        {
+            sumSquares += double(coefficient) * coefficient;
+        }
+        densityScale = 1.0 / (config.sampleRateHz * sumSquares);
+        hop = std::max<size_t>(1, size_t(std::lround(
+            double(config.fftSize) * (1.0 - config.overlap))));
+    }
+
+    //--------------------------------------------------------------------------
+    void SpectrumAnalyzer::process(std::span<const uint16_t> samples)
+    {
+        pending.insert(pending.end(), samples.begin(), samples.end());
+        processPending();
+    }
+
+    //--------------------------------------------------------------------------
+    void SpectrumAnalyzer::process(
+        std::span<const SignalData::sAggregateData> samples)
+    {
+        // Straight into the pending samples, which keep their capacity, so
+        // no buffer is allocated per call
+        std::transform(
+            samples.begin(),
+            samples.end(),
+            std::back_inserter(pending),
+            [](const SignalData::sAggregateData& sample)
+            {
+                return sample.analog;
+            });
+        processPending();
+    }
+
+    //--------------------------------------------------------------------------
+    void SpectrumAnalyzer::process(const sSampleBlockView& block)
+    {
+        process(block.analog);
+    }
+
+    //--------------------------------------------------------------------------
+    std::vector<double> SpectrumAnalyzer::powerSpectralDensity() const
+    {
+        std::vector<double> density(numBins(), 0.0);
+        if (numSegments == 0)
+        {
+            return density;
+        }
+
+        double scale = densityScale / double(numSegments);
+        for (size_t k = 0; k < density.size(); ++k)
+        {
+            // One-sided: every bin but DC and Nyquist also holds the power
+            // of its negative frequency
+            bool bEdge = k == 0 || k + 1 == density.size();
+            density[k] = powerSum[k] * scale * (bEdge ? 1.0 : 2.0);
+        }
+        return density;
+    }
+
+    //--------------------------------------------------------------------------
+    std::vector<sSpectralPeak> SpectrumAnalyzer::findPeaks(
+        size_t maxPeaks) const
+    {
+        std::vector<double> density = powerSpectralDensity();
+        std::vector<sSpectralPeak> peaks;
+        for (size_t k = 1; k < density.size(); ++k)
+        {
+            bool bAboveNext = k + 1 == density.size() ||
+                density[k] >= density[k + 1];
+            if (density[k] > density[k - 1] && bAboveNext)
+            {
+                peaks.push_back({k, binFrequencyHz(k), density[k]});
+            }
+        }
+
+        std::sort(
+            peaks.begin(),
+            peaks.end(),
+            [](const sSpectralPeak& a, const sSpectralPeak& b)
+            {
+                return a.density > b.density;
+            });
+        peaks.resize(std::min(peaks.size(), maxPeaks));
+        return peaks;
+    }
+
+    //--------------------------------------------------------------------------
+    void SpectrumAnalyzer::reset()
+    {
+        pending.clear();
+        std::fill(powerSum.begin(), powerSum.end(), 0.0);
+        numSegments = 0;
+    }
+
+    //--------------------------------------------------------------------------
+    double SpectrumAnalyzer::binWidthHz() const
+    {
+        return spectrumConfig.sampleRateHz / double(spectrumConfig.fftSize);
+    }
+
+    //--------------------------------------------------------------------------
+    double SpectrumAnalyzer::binFrequencyHz(size_t bin) const
+    {
+        return double(bin) * binWidthHz();
+    }
+
+    //--------------------------------------------------------------------------
+    // SpectrumAnalyzer Private Methods
+    //--------------------------------------------------------------------------
+
+    //--------------------------------------------------------------------------
+    void SpectrumAnalyzer::processPending()
+    {
+        size_t first = 0;
+        while (pending.size() - first >= spectrumConfig.fftSize)
+        {
+            processSegment(first);
+            first += hop;
+        }
+        pending.erase(pending.begin(), pending.begin() + first);
+    }
+
+    //--------------------------------------------------------------------------
+    void SpectrumAnalyzer::processSegment(size_t first)
+    {
+        const uint16_t* pSamples = pending.data() + first;
+        size_t n = spectrumConfig.fftSize;
+        uint64_t sum = 0;
+        for (size_t i = 0; i < n; ++i)
+        {
+            sum += pSamples[i];
+        }
+        float mean = float(double(sum) / double(n));
+        for (size_t i = 0; i < n; ++i)
+        {
+            segment[i] = (float(pSamples[i]) - mean) * window[i];
+        }
+
+        fft.power(segment, segmentPower);
+        for (size_t k = 0; k < powerSum.size(); ++k)
+        {
+            powerSum[k] += segmentPower[k];
+        }
+        ++numSegments;
+    }
+
+} // namespace SignalDataFacade
@@ -0,0 +1,323 @@
+// Copyright (c) 2025 Michael Dello
+//
+// This software is provided under the MIT License.
+// See LICENSE file for details.
+
+//-----------------------------------------------------------------------------
+//
+// Signal Data Statistics Implementation
+//
+//-----------------------------------------------------------------------------
+
+#include "facadepattern_stats.h"
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <limits>
+
+// SIMD kernels need GCC/Clang target attributes on an x86 CPU
+#if (defined(__GNUC__) || defined(__clang__)) && \
+    (defined(__x86_64__) || defined(__i386__))
+#define FACADEPATTERN_STATS_X86_KERNELS 1
+#include <immintrin.h>
+#else
+#define FACADEPATTERN_STATS_X86_KERNELS 0
+#endif
+
+namespace // anonymous
+{
+    //--------------------------------------------------------------------------
+    // Types
+    //--------------------------------------------------------------------------
+
+    // Integer moments every kernel reduces a column to
+    struct sMoments
+    {
+        uint16_t min{std::numeric_limits<uint16_t>::max()};
+        uint16_t max{0};
+        uint64_t sum{0};
+        uint64_t sumSq{0};
+    };
+
+    //--------------------------------------------------------------------------
+    // Constants
+    //--------------------------------------------------------------------------
+    // Vector iterations between widening the 32-bit lane sums to 64 bits.
+    // A lane gains at most 2 * 65535 per iteration, so this stays far below
+    // 2^32.
+    constexpr size_t MAX_NARROW_ITERATIONS = 16384;
+
+    //--------------------------------------------------------------------------
+    // Local Functions
+    //--------------------------------------------------------------------------
+    void accumulateScalar(
+        sMoments& moments,
+        const uint16_t* pSamples,
+        size_t count)
+    {
+        for (size_t i = 0; i < count; ++i)
+        {
+            uint16_t sample = pSamples[i];
+            moments.min = std::min(moments.min, sample);
+            moments.max = std::max(moments.max, sample);
+            moments.sum += sample;
+            moments.sumSq += uint64_t{sample} * sample;
+        }
+    }
+
+    //--------------------------------------------------------------------------
+    sMoments momentsScalar(std::span<const uint16_t> samples)
+    {
+        sMoments moments;
+        accumulateScalar(moments, samples.data(), samples.size());
+        return moments;
+    }
+
+#if FACADEPATTERN_STATS_X86_KERNELS
+    //--------------------------------------------------------------------------
+    // Fold vector partials into the scalar moments
+    template <size_t NUM_LANES16, size_t NUM_LANES64>
+    void reduceVectors(
+        sMoments& moments,
+        const std::array<uint16_t, NUM_LANES16>& mins,
+        const std::array<uint16_t, NUM_LANES16>& maxs,
+        const std::array<uint64_t, NUM_LANES64>& sums,
+        const std::array<uint64_t, NUM_LANES64>& sumSqs)
+    {
+        for (size_t lane = 0; lane < NUM_LANES16; ++lane)
+        {
+            moments.min = std::min(moments.min, mins[lane]);
+            moments.max = std::max(moments.max, maxs[lane]);
+        }
+        for (size_t lane = 0; lane < NUM_LANES64; ++lane)
+        {
+            moments.sum += sums[lane];
+            moments.sumSq += sumSqs[lane];
+        }
+    }
+
+    //--------------------------------------------------------------------------
+    // 8 samples per iteration
+    __attribute__((target("sse4.1")))
+    sMoments momentsSSE4(std::span<const uint16_t> samples)
+    {
+        constexpr size_t LANES = 8;
+        const uint16_t* pSamples = samples.data();
+        size_t numVectors = samples.size() / LANES;
+
+        __m128i vMin = _mm_set1_epi16(-1);
+        __m128i vMax = _mm_setzero_si128();
+        __m128i vSum = _mm_setzero_si128();
+        __m128i vSumSq = _mm_setzero_si128();
+
+        for (size_t i = 0; i < numVectors;)
+        {
+            size_t runEnd = std::min(numVectors, i + MAX_NARROW_ITERATIONS);
+            __m128i vSum32 = _mm_setzero_si128();
+            for (; i < runEnd; ++i)
+            {
+                __m128i v = _mm_loadu_si128(
+                    reinterpret_cast<const __m128i*>(pSamples + i * LANES));
+                vMin = _mm_min_epu16(vMin, v);
+                vMax = _mm_max_epu16(vMax, v);
+
+                __m128i lo = _mm_cvtepu16_epi32(v);
+                __m128i hi = _mm_cvtepu16_epi32(_mm_srli_si128(v, 8));
+                vSum32 = _mm_add_epi32(vSum32, _mm_add_epi32(lo, hi));
+
+                // Squares of the even then odd 32-bit lanes, as 64-bit values
+                __m128i loOdd = _mm_srli_epi64(lo, 32);
+                __m128i hiOdd = _mm_srli_epi64(hi, 32);
+                vSumSq = _mm_add_epi64(vSumSq, _mm_add_epi64(
+                    _mm_mul_epu32(lo, lo), _mm_mul_epu32(loOdd, loOdd)));
+                vSumSq = _mm_add_epi64(vSumSq, _mm_add_epi64(
+                    _mm_mul_epu32(hi, hi), _mm_mul_epu32(hiOdd, hiOdd)));
+            }
+            vSum = _mm_add_epi64(vSum, _mm_add_epi64(
+                _mm_cvtepu32_epi64(vSum32),
+                _mm_cvtepu32_epi64(_mm_srli_si128(vSum32, 8))));
+        }
+
+        std::array<uint16_t, LANES> mins;
+        std::array<uint16_t, LANES> maxs;
+        std::array<uint64_t, 2> sums;
+        std::array<uint64_t, 2> sumSqs;
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(mins.data()), vMin);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(maxs.data()), vMax);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(sums.data()), vSum);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(sumSqs.data()), vSumSq);
+
+        sMoments moments;
+        if (numVectors > 0)
+        {
+            reduceVectors(moments, mins, maxs, sums, sumSqs);
+        }
+        accumulateScalar(
+            moments,
+            pSamples + numVectors * LANES,
+            samples.size() - numVectors * LANES);
+        return moments;
+    }
+
+    //--------------------------------------------------------------------------
+    // 16 samples per iteration
+    __attribute__((target("avx2")))
+    sMoments momentsAVX2(std::span<const uint16_t> samples)
+    {
+        constexpr size_t LANES = 16;
+        const uint16_t* pSamples = samples.data();
+        size_t numVectors = samples.size() / LANES;
+
+        __m256i vMin = _mm256_set1_epi16(-1);
+        __m256i vMax = _mm256_setzero_si256();
+        __m256i vSum = _mm256_setzero_si256();
+        __m256i vSumSq = _mm256_setzero_si256();
+
+        for (size_t i = 0; i < numVectors;)
+        {
+            size_t runEnd = std::min(numVectors, i + MAX_NARROW_ITERATIONS);
+            __m256i vSum32 = _mm256_setzero_si256();
+            for (; i < runEnd; ++i)
+            {
+                __m256i v = _mm256_loadu_si256(
+                    reinterpret_cast<const __m256i*>(pSamples + i * LANES));
+                vMin = _mm256_min_epu16(vMin, v);
+                vMax = _mm256_max_epu16(vMax, v);
+
+                __m256i lo = _mm256_cvtepu16_epi32(_mm256_castsi256_si128(v));
+                __m256i hi = _mm256_cvtepu16_epi32(
+                    _mm256_extracti128_si256(v, 1));
+                vSum32 = _mm256_add_epi32(vSum32, _mm256_add_epi32(lo, hi));
+
+                // Squares of the even then odd 32-bit lanes, as 64-bit values
+                __m256i loOdd = _mm256_srli_epi64(lo, 32);
+                __m256i hiOdd = _mm256_srli_epi64(hi, 32);
+                vSumSq = _mm256_add_epi64(vSumSq, _mm256_add_epi64(
+                    _mm256_mul_epu32(lo, lo), _mm256_mul_epu32(loOdd, loOdd)));
+                vSumSq = _mm256_add_epi64(vSumSq, _mm256_add_epi64(
+                    _mm256_mul_epu32(hi, hi), _mm256_mul_epu32(hiOdd, hiOdd)));
+            }
+            vSum = _mm256_add_epi64(vSum, _mm256_add_epi64(
+                _mm256_cvtepu32_epi64(_mm256_castsi256_si128(vSum32)),
+                _mm256_cvtepu32_epi64(_mm256_extracti128_si256(vSum32, 1))));
+        }
+
+        std::array<uint16_t, LANES> mins;
+        std::array<uint16_t, LANES> maxs;
+        std::array<uint64_t, 4> sums;
+        std::array<uint64_t, 4> sumSqs;
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(mins.data()), vMin);
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(maxs.data()), vMax);
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(sums.data()), vSum);
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(sumSqs.data()), vSumSq);
+
+        sMoments moments;
+        if (numVectors > 0)
+        {
+            reduceVectors(moments, mins, maxs, sums, sumSqs);
+        }
+        accumulateScalar(
+            moments,
+            pSamples + numVectors * LANES,
+            samples.size() - numVectors * LANES);
+        return moments;
+    }
+#endif // FACADEPATTERN_STATS_X86_KERNELS
+
+    //--------------------------------------------------------------------------
+    SignalDataFacade::sSignalStats finalize(
+        const sMoments& moments,
+        size_t count)
+    {
+        SignalDataFacade::sSignalStats stats;
+        if (count == 0)
+        {
+            return stats;
+        }
+
+        long double n = static_cast<long double>(count);
+        long double sum = static_cast<long double>(moments.sum);
+        long double sumSq = static_cast<long double>(moments.sumSq);
+        stats.count = count;
+        stats.min = moments.min;
+        stats.max = moments.max;
+        stats.mean = static_cast<double>(sum / n);
+        stats.rms = static_cast<double>(std::sqrt(sumSq / n));
+        // Clamped, rounding must not make a constant block's variance negative
+        stats.variance = static_cast<double>(
+            std::max(0.0L, (sumSq - sum * sum / n) / n));
+        return stats;
+    }
+
+} // namespace anonymous
+
+namespace SignalDataFacade
+{
+    //--------------------------------------------------------------------------
+    const char* toString(eSimdLevel level)
+    {
+        switch (level)
+        {
+            case eSimdLevel::SCALAR:
+                return "SCALAR";
+            case eSimdLevel::SSE4:
+                return "SSE4";
+            case eSimdLevel::AVX2:
+                return "AVX2";
+        }
+        return "UNKNOWN";
+    }
+
+    //--------------------------------------------------------------------------
+    eSimdLevel detectedSimdLevel()
+    {
+#if FACADEPATTERN_STATS_X86_KERNELS
+        static const eSimdLevel level =
+            __builtin_cpu_supports("avx2") ? eSimdLevel::AVX2 :
+            __builtin_cpu_supports("sse4.1") ? eSimdLevel::SSE4 :
+            eSimdLevel::SCALAR;
+        return level;
+#else
+        return eSimdLevel::SCALAR;
+#endif
+    }
+
+    //--------------------------------------------------------------------------
+    sSignalStats computeStats(std::span<const uint16_t> samples)
+    {
+        return computeStats(samples, detectedSimdLevel());
+    }
+
+    //--------------------------------------------------------------------------
+    sSignalStats computeStats(
+        std::span<const uint16_t> samples,
+        eSimdLevel level)
+    {
+        // Never run a kernel the CPU cannot execute
+        level = std::min(level, detectedSimdLevel());
+
+        sMoments moments;
+        switch (level)
+        {
+#if FACADEPATTERN_STATS_X86_KERNELS
+            case eSimdLevel::AVX2:
+                moments = momentsAVX2(samples);
+                break;
+            case eSimdLevel::SSE4:
+                moments = momentsSSE4(samples);
+                break;
+#endif
+            default:
+                moments = momentsScalar(samples);
+                break;
+        }
+        return finalize(moments, samples.size());
+    }
+
+    //--------------------------------------------------------------------------
+    sSampleBlockStats computeStats(const sSampleBlockView& block)
+    {
+        return {computeStats(block.analog), computeStats(block.digital)};
+    }
+
+} // namespace SignalDataFacade
@@ -0,0 +1,689 @@
+// Copyright (c) 2025 Michael Dello
+//
+// This software is provided under the MIT License.
+// See LICENSE file for details.
+
+//-----------------------------------------------------------------------------
+//
+// Trigger Engine Implementation
+//
+//-----------------------------------------------------------------------------
+
+#include "facadepattern_trigger.h"
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cmath>
+#include <stdexcept>
+#include <utility>
+
+// SIMD kernels need GCC/Clang target attributes on an x86 CPU
+#if (defined(__GNUC__) || defined(__clang__)) && \
+    (defined(__x86_64__) || defined(__i386__))
+#define FACADEPATTERN_TRIGGER_X86_KERNELS 1
+#include <immintrin.h>
+#else
+#define FACADEPATTERN_TRIGGER_X86_KERNELS 0
+#endif
+
+namespace // anonymous
+{
+    using SignalDataFacade::eEdge;
+    using SignalDataFacade::eSimdLevel;
+    using SignalDataFacade::eTriggerSource;
+    using SignalDataFacade::sTriggerCondition_t;
+
+    //--------------------------------------------------------------------------
+    // Constants
+    //--------------------------------------------------------------------------
+    constexpr size_t GROUP_SAMPLES = 64;
+    // Room before a scratch group for the previous sample, keeping the
+    // group itself 32-byte aligned
+    constexpr size_t GROUP_PAD = 16;
+
+    //--------------------------------------------------------------------------
+    // Local Functions
+    //--------------------------------------------------------------------------
+    uint64_t lowBits(size_t count)
+    {
+        return count >= 64 ? ~uint64_t{0} : (uint64_t{1} << count) - 1;
+    }
+
+    //--------------------------------------------------------------------------
+    // Events from the state of a condition on each sample and the one before
+    uint64_t edgeBits(uint64_t state, bool bPreviousState, eEdge edge)
+    {
+        uint64_t previous = (state << 1) | uint64_t(bPreviousState);
+        switch (edge)
+        {
+            case eEdge::RISING:
+                return state & ~previous;
+            case eEdge::FALLING:
+                return ~state & previous;
+            case eEdge::ANY:
+                break;
+        }
+        return state ^ previous;
+    }
+
+    //--------------------------------------------------------------------------
+    // Scalar Kernels, over one group of 64 samples
+    //--------------------------------------------------------------------------
+    // Samples at or above threshold
+    uint64_t atLeastScalar(const uint16_t* pSamples, uint16_t threshold)
+    {
+        uint64_t bits = 0;
+        for (size_t i = 0; i < GROUP_SAMPLES; ++i)
+        {
+            bits |= uint64_t(pSamples[i] >= threshold) << i;
+        }
+        return bits;
+    }
+
+    //--------------------------------------------------------------------------
+    uint64_t maskedEqualScalar(
+        const uint16_t* pSamples,
+        uint16_t mask,
+        uint16_t value)
+    {
+        uint64_t bits = 0;
+        for (size_t i = 0; i < GROUP_SAMPLES; ++i)
+        {
+            bits |= uint64_t((pSamples[i] & mask) == value) << i;
+        }
+        return bits;
+    }
+
+    //--------------------------------------------------------------------------
+    // Samples that exceed their counterpart in pBase by at least threshold
+    uint64_t stepAtLeastScalar(
+        const uint16_t* pSamples,
+        const uint16_t* pBase,
+        uint16_t threshold)
+    {
+        uint64_t bits = 0;
+        for (size_t i = 0; i < GROUP_SAMPLES; ++i)
+        {
+            int step = int(pSamples[i]) - int(pBase[i]);
+            bits |= uint64_t(step >= int(threshold)) << i;
+        }
+        return bits;
+    }
+
+#if FACADEPATTERN_TRIGGER_X86_KERNELS
+    //--------------------------------------------------------------------------
+    // SSE Kernels
+    //--------------------------------------------------------------------------
+    // Compare results of 8 samples each, to one bit per sample
+    __attribute__((target("sse4.1")))
+    uint64_t packMasksSSE4(const __m128i* pCompares)
+    {
+        uint64_t bits = 0;
+        for (size_t i = 0; i < 4; ++i)
+        {
+            uint64_t packed = uint32_t(_mm_movemask_epi8(
+                _mm_packs_epi16(pCompares[2 * i], pCompares[2 * i + 1])));
+            bits |= packed << (16 * i);
+        }
+        return bits;
+    }
+
+    //--------------------------------------------------------------------------
+    __attribute__((target("sse4.1")))
+    __m128i loadSSE4(const uint16_t* pSamples, size_t i)
+    {
+        return _mm_loadu_si128(
+            reinterpret_cast<const __m128i*>(pSamples + 8 * i));
+    }
+
+    //--------------------------------------------------------------------------
+    __attribute__((target("sse4.1")))
+    uint64_t atLeastSSE4(const uint16_t* pSamples, uint16_t threshold)
+    {
+        // Unsigned x >= t exactly when max(x, t) == x
+        const __m128i thresholds = _mm_set1_epi16(short(threshold));
+        __m128i compares[8];
+        for (size_t i = 0; i < 8; ++i)
+        {
+            __m128i samples = loadSSE4(pSamples, i);
+            compares[i] = _mm_cmpeq_epi16(
+                _mm_max_epu16(samples, thresholds), samples);
+        }
+        return packMasksSSE4(compares);
+    }
+
+    //--------------------------------------------------------------------------
+    __attribute__((target("sse4.1")))
+    uint64_t maskedEqualSSE4(
+        const uint16_t* pSamples,
+        uint16_t mask,
+        uint16_t value)
+    {
+        const __m128i masks = _mm_set1_epi16(short(mask));
+        const __m128i values = _mm_set1_epi16(short(value));
+        __m128i compares[8];
+        for (size_t i = 0; i < 8; ++i)
+        {
+            compares[i] = _mm_cmpeq_epi16(
+                _mm_and_si128(loadSSE4(pSamples, i), masks), values);
+        }
+        return packMasksSSE4(compares);
+    }
+
+    //--------------------------------------------------------------------------
+    __attribute__((target("sse4.1")))
+    uint64_t stepAtLeastSSE4(
+        const uint16_t* pSamples,
+        const uint16_t* pBase,
+        uint16_t threshold)
+    {
+        // Saturating subtraction is 0 for a step down
+        const __m128i thresholds = _mm_set1_epi16(short(threshold));
+        __m128i compares[8];
+        for (size_t i = 0; i < 8; ++i)
+        {
+            __m128i steps = _mm_subs_epu16(
+                loadSSE4(pSamples, i), loadSSE4(pBase, i));
+            compares[i] = _mm_cmpeq_epi16(
+                _mm_max_epu16(steps, thresholds), steps);
+        }
+        return packMasksSSE4(compares);
+    }
+
+    //--------------------------------------------------------------------------
+    // AVX2 Kernels
+    //--------------------------------------------------------------------------
+    // Compare results of 16 samples each, to one bit per sample
+    __attribute__((target("avx2")))
+    uint64_t packMasksAVX2(const __m256i* pCompares)
+    {
+        uint64_t bits = 0;
+        for (size_t i = 0; i < 2; ++i)
+        {
+            // packs works within 128-bit lanes, the permute restores order
+            __m256i packed = _mm256_permute4x64_epi64(
+                _mm256_packs_epi16(pCompares[2 * i], pCompares[2 * i + 1]),
+                0xD8);
+            bits |= uint64_t(uint32_t(_mm256_movemask_epi8(packed)))
+                << (32 * i);
+        }
+        return bits;
+    }
+
+    //--------------------------------------------------------------------------
+    __attribute__((target("avx2")))
+    __m256i loadAVX2(const uint16_t* pSamples, size_t i)
+    {
+        return _mm256_loadu_si256(
+            reinterpret_cast<const __m256i*>(pSamples + 16 * i));
+    }
+
+    //--------------------------------------------------------------------------
+    __attribute__((target("avx2")))
+    uint64_t atLeastAVX2(const uint16_t* pSamples, uint16_t threshold)
+    {
+        const __m256i thresholds = _mm256_set1_epi16(short(threshold));
+        __m256i compares[4];
+        for (size_t i = 0; i < 4; ++i)
+        {
+            __m256i samples = loadAVX2(pSamples, i);
+            compares[i] = _mm256_cmpeq_epi16(
+                _mm256_max_epu16(samples, thresholds), samples);
+        }
+        return packMasksAVX2(compares);
+    }
+
+    //--------------------------------------------------------------------------
+    __attribute__((target("avx2")))
+    uint64_t maskedEqualAVX2(
+        const uint16_t* pSamples,
+        uint16_t mask,
+        uint16_t value)
+    {
+        const __m256i masks = _mm256_set1_epi16(short(mask));
+        const __m256i values = _mm256_set1_epi16(short(value));
+        __m256i compares[4];
+        for (size_t i = 0; i < 4; ++i)
+        {
+            compares[i] = _mm256_cmpeq_epi16(
+                _mm256_and_si256(loadAVX2(pSamples, i), masks), values);
+        }
+        return packMasksAVX2(compares);
+    }
+
+    //--------------------------------------------------------------------------
+    __attribute__((target("avx2")))
+    uint64_t stepAtLeastAVX2(
+        const uint16_t* pSamples,
+        const uint16_t* pBase,
+        uint16_t threshold)
+    {
+        const __m256i thresholds = _mm256_set1_epi16(short(threshold));
+        __m256i compares[4];
+        for (size_t i = 0; i < 4; ++i)
+        {
+            __m256i steps = _mm256_subs_epu16(
+                loadAVX2(pSamples, i), loadAVX2(pBase, i));
+            compares[i] = _mm256_cmpeq_epi16(
+                _mm256_max_epu16(steps, thresholds), steps);
+        }
+        return packMasksAVX2(compares);
+    }
+#endif
+
+    //--------------------------------------------------------------------------
+    // Dispatch
+    //--------------------------------------------------------------------------
+    uint64_t atLeast(
+        const uint16_t* pSamples,
+        uint16_t threshold,
+        eSimdLevel level)
+    {
+        switch (level)
+        {
+#if FACADEPATTERN_TRIGGER_X86_KERNELS
+            case eSimdLevel::AVX2:
+                return atLeastAVX2(pSamples, threshold);
+            case eSimdLevel::SSE4:
+                return atLeastSSE4(pSamples, threshold);
+#endif
+            default:
+                return atLeastScalar(pSamples, threshold);
+        }
+    }
+
+    //--------------------------------------------------------------------------
+    uint64_t maskedEqual(
+        const uint16_t* pSamples,
+        uint16_t mask,
+        uint16_t value,
+        eSimdLevel level)
+    {
+        switch (level)
+        {
+#if FACADEPATTERN_TRIGGER_X86_KERNELS
+            case eSimdLevel::AVX2:
+                return maskedEqualAVX2(pSamples, mask, value);
+            case eSimdLevel::SSE4:
+                return maskedEqualSSE4(pSamples, mask, value);
+#endif
+            default:
+                return maskedEqualScalar(pSamples, mask, value);
+        }
+    }
+
+    //--------------------------------------------------------------------------
+    uint64_t stepAtLeast(
+        const uint16_t* pSamples,
+        const uint16_t* pBase,
+        uint16_t threshold,
+        eSimdLevel level)
+    {
+        switch (level)
+        {
+#if FACADEPATTERN_TRIGGER_X86_KERNELS
+            case eSimdLevel::AVX2:
+                return stepAtLeastAVX2(pSamples, pBase, threshold);
+            case eSimdLevel::SSE4:
+                return stepAtLeastSSE4(pSamples, pBase, threshold);
+#endif
+            default:
+                return stepAtLeastScalar(pSamples, pBase, threshold);
+        }
+    }
+
+    //--------------------------------------------------------------------------
+    // Bits of a group where a condition holds. The sample before each
+    // group is readable at index -1.
+    uint64_t conditionBits(
+        const sTriggerCondition_t& condition,
+        const uint16_t* pAnalog,
+        const uint16_t* pDigital,
+        eSimdLevel level)
+    {
+        switch (condition.source)
+        {
+            case eTriggerSource::ANALOG_LEVEL:
+                return edgeBits(
+                    atLeast(pAnalog, condition.threshold, level),
+                    pAnalog[-1] >= condition.threshold,
+                    condition.edge);
+            case eTriggerSource::ANALOG_SLOPE:
+            {
+                // Step up from the previous sample, or down to it
+                uint64_t up = condition.edge == eEdge::FALLING ? 0 :
+                    stepAtLeast(pAnalog, pAnalog - 1, condition.threshold,
+                        level);
+                uint64_t down = condition.edge == eEdge::RISING ? 0 :
+                    stepAtLeast(pAnalog - 1, pAnalog, condition.threshold,
+                        level);
+                return up | down;
+            }
+            case eTriggerSource::GPIO_EDGE:
+            {
+                uint16_t bit = uint16_t(1u << condition.line);
+                return edgeBits(
+                    maskedEqual(pDigital, bit, bit, level),
+                    (pDigital[-1] & bit) != 0,
+                    condition.edge);
+            }
+            case eTriggerSource::GPIO_PATTERN:
+                return maskedEqual(
+                    pDigital, condition.mask, condition.value, level);
+        }
+        return 0;
+    }
+
+} // namespace anonymous
+
+namespace SignalDataFacade
+{
+    //--------------------------------------------------------------------------
+    const char* toString(eTriggerSource source)
+    {
+        switch (source)
+        {
+            case eTriggerSource::ANALOG_LEVEL:
+                return "ANALOG_LEVEL";
+            case eTriggerSource::ANALOG_SLOPE:
+                return "ANALOG_SLOPE";
+            case eTriggerSource::GPIO_EDGE:
+                return "GPIO_EDGE";
+            case eTriggerSource::GPIO_PATTERN:
+                return "GPIO_PATTERN";
+        }
+        return "UNKNOWN";
+    }
+
+    //--------------------------------------------------------------------------
+    const char* toString(eCombine combine)
+    {
+        switch (combine)
+        {
+            case eCombine::AND:
+                return "AND";
+            case eCombine::OR:
+                return "OR";
+        }
+        return "UNKNOWN";
+    }
+
+    //--------------------------------------------------------------------------
+    TriggerEngine::TriggerEngine(
+        const sTriggerConfig_t& config,
+        CaptureCallback onCapture,
+        eSimdLevel level)
+    : triggerConfig{config},
+      onCapture{std::move(onCapture)},
+      kernelLevel{std::min(level, detectedSimdLevel())},
+      nsPerSample{0.0},
+      numProcessed{0},
+      numTriggers{0},
+      armedFrom{0},
+      historyAnalog(std::bit_ceil(std::max<size_t>(config.preSamples, 1))),
+      historyDigital(historyAnalog.size()),
+      bCapturing{false},
+      captureSize{0}
+    {
+        if (config.conditions.empty() || !(config.sampleRateHz > 0.0))
+        {
+            throw std::invalid_argument("Invalid trigger configuration");
+        }
+        for (const auto& condition : config.conditions)
+        {
+            if (condition.line >= GpioBitPlanes::MAX_LINES)
+            {
+                throw std::invalid_argument("Invalid trigger GPIO line");
+            }
+            // The kernels saturate a step the wrong way to 0, which a
+            // threshold of 0 would count
+            if (condition.source == eTriggerSource::ANALOG_SLOPE &&
+                condition.threshold == 0)
+            {
+                throw std::invalid_argument("Invalid trigger slope threshold");
+            }
+        }
+        nsPerSample = 1e9 / config.sampleRateHz;
+    }
+
+    //--------------------------------------------------------------------------
+    void TriggerEngine::process(
+        std::span<const SignalData::sAggregateData> samples,
+        uint64_t firstTimestampNs)
+    {
+        columns.clear();
+        columns.append(samples);
+        process(columns.view(), firstTimestampNs);
+    }
+
+    //--------------------------------------------------------------------------
+    void TriggerEngine::process(
+        const sSampleBlockView& block,
+        uint64_t firstTimestampNs)
+    {
+        if (block.digital.size() != block.analog.size())
+        {
+            throw std::invalid_argument("Trigger columns differ in length");
+        }
+
+        fireMasks(block, carry, masks);
+
+        // Split the batch at each accepted firing
+        size_t done = 0;
+        for (size_t group = 0; group < masks.size(); ++group)
+        {
+            for (uint64_t bits = masks[group]; bits != 0; bits &= bits - 1)
+            {
+                size_t sample =
+                    group * GROUP_SAMPLES + size_t(std::countr_zero(bits));
+                if (numProcessed + sample < armedFrom)
+                {
+                    continue;
+                }
+                feed(block, done, sample - done);
+                done = sample;
+                startCapture(
+                    numProcessed + sample,
+                    firstTimestampNs +
+                        uint64_t(std::llround(double(sample) * nsPerSample)));
+            }
+        }
+        feed(block, done, block.analog.size() - done);
+        numProcessed += block.analog.size();
+    }
+
+    //--------------------------------------------------------------------------
+    std::vector<uint64_t> TriggerEngine::evaluate(
+        const sSampleBlockView& block) const
+    {
+        if (block.digital.size() != block.analog.size())
+        {
+            throw std::invalid_argument("Trigger columns differ in length");
+        }
+
+        sCarry state = carry;
+        std::vector<uint64_t> fired;
+        fireMasks(block, state, fired);
+
+        std::vector<uint64_t> indices;
+        for (size_t group = 0; group < fired.size(); ++group)
+        {
+            for (uint64_t bits = fired[group]; bits != 0; bits &= bits - 1)
+            {
+                indices.push_back(
+                    numProcessed + group * GROUP_SAMPLES +
+                    uint64_t(std::countr_zero(bits)));
+            }
+        }
+        return indices;
+    }
+
+    //--------------------------------------------------------------------------
+    void TriggerEngine::flush()
+    {
+        if (!bCapturing)
+        {
+            return;
+        }
+        bCapturing = false;
+        sTriggerCapture finished = std::move(capture);
+        capture = sTriggerCapture{};
+        onCapture(std::move(finished));
+    }
+
+    //--------------------------------------------------------------------------
+    void TriggerEngine::reset()
+    {
+        carry = sCarry{};
+        numProcessed = 0;
+        numTriggers = 0;
+        armedFrom = 0;
+        bCapturing = false;
+        capture = sTriggerCapture{};
+    }
+
+    //--------------------------------------------------------------------------
+    void TriggerEngine::fireMasks(
+        const sSampleBlockView& block,
+        sCarry& state,
+        std::vector<uint64_t>& fired) const
+    {
+        size_t numSamples = block.analog.size();
+        fired.assign((numSamples + GROUP_SAMPLES - 1) / GROUP_SAMPLES, 0);
+        if (numSamples == 0)
+        {
+            return;
+        }
+        if (!state.bStarted)
+        {
+            // The first sample is its own predecessor, so it has no events
+            state.bStarted = true;
+            state.analog = block.analog[0];
+            state.digital = block.digital[0];
+        }
+
+        alignas(32) std::array<uint16_t, GROUP_PAD + GROUP_SAMPLES> analog;
+        alignas(32) std::array<uint16_t, GROUP_PAD + GROUP_SAMPLES> digital;
+        for (size_t group = 0; group < fired.size(); ++group)
+        {
+            size_t first = group * GROUP_SAMPLES;
+            size_t count = std::min(GROUP_SAMPLES, numSamples - first);
+            const uint16_t* pAnalog = block.analog.data() + first;
+            const uint16_t* pDigital = block.digital.data() + first;
+            if (first == 0 || count < GROUP_SAMPLES)
+            {
+                // Stage the group after its previous sample, padded with
+                // the last sample
+                analog[GROUP_PAD - 1] =
+                    first > 0 ? block.analog[first - 1] : state.analog;
+                digital[GROUP_PAD - 1] =
+                    first > 0 ? block.digital[first - 1] : state.digital;
+                auto analogEnd = std::copy_n(
+                    pAnalog, count, analog.begin() + GROUP_PAD);
+                auto digitalEnd = std::copy_n(
+                    pDigital, count, digital.begin() + GROUP_PAD);
+                std::fill(analogEnd, analog.end(), pAnalog[count - 1]);
+                std::fill(digitalEnd, digital.end(), pDigital[count - 1]);
+                pAnalog = analog.data() + GROUP_PAD;
+                pDigital = digital.data() + GROUP_PAD;
+            }
+
+            bool bAnd = triggerConfig.combine == eCombine::AND;
+            uint64_t combined = bAnd ? ~uint64_t{0} : 0;
+            for (const auto& condition : triggerConfig.conditions)
+            {
+                uint64_t bits =
+                    conditionBits(condition, pAnalog, pDigital, kernelLevel);
+                combined = bAnd ? combined & bits : combined | bits;
+            }
+            combined &= lowBits(count);
+
+            // Fire where the combination becomes true
+            fired[group] =
+                combined & ~((combined << 1) | uint64_t(state.bCombined));
+            state.bCombined = (combined >> (count - 1)) & 1;
+        }
+        state.analog = block.analog.back();
+        state.digital = block.digital.back();
+    }
+
+    //--------------------------------------------------------------------------
+    void TriggerEngine::feed(
+        const sSampleBlockView& block,
+        size_t first,
+        size_t count)
+    {
+        if (bCapturing)
+        {
+            size_t take = std::min(count, captureSize - capture.samples.size());
+            size_t start = capture.samples.appendUninitialized(take);
+            std::copy_n(
+                block.analog.begin() + first, take,
+                capture.samples.analog().begin() + start);
+            std::copy_n(
+                block.digital.begin() + first, take,
+                capture.samples.digital().begin() + start);
+            if (capture.samples.size() == captureSize)
+            {
+                flush();
+            }
+        }
+
+        // Only the newest samples that fit matter to the history, copied in
+        // at most two runs around the end of the ring
+        size_t capacity = historyAnalog.size();
+        size_t skip = count > capacity ? count - capacity : 0;
+        first += skip;
+        count -= skip;
+        while (count > 0)
+        {
+            size_t slot = size_t(numProcessed + first) & (capacity - 1);
+            size_t run = std::min(count, capacity - slot);
+            std::copy_n(
+                block.analog.begin() + first, run,
+                historyAnalog.begin() + slot);
+            std::copy_n(
+                block.digital.begin() + first, run,
+                historyDigital.begin() + slot);
+            first += run;
+            count -= run;
+        }
+    }
+
+    //--------------------------------------------------------------------------
+    void TriggerEngine::startCapture(uint64_t sampleIndex, uint64_t timestampNs)
+    {
+        ++numTriggers;
+        armedFrom =
+            sampleIndex + std::max<size_t>(triggerConfig.postSamples, 1);
+
+        // Pre-trigger samples, as far back as the stream goes
+        size_t numPre = size_t(
+            std::min<uint64_t>(triggerConfig.preSamples, sampleIndex));
+        capture.triggerSampleIndex = sampleIndex;
+        capture.triggerTimestampNs = timestampNs;
+        capture.firstSampleIndex = sampleIndex - numPre;
+        uint64_t preNs = uint64_t(std::llround(double(numPre) * nsPerSample));
+        capture.firstTimestampNs =
+            timestampNs > preNs ? timestampNs - preNs : 0;
+        captureSize = numPre + triggerConfig.postSamples;
+        capture.samples.clear();
+        capture.samples.reserve(captureSize);
+        capture.samples.resize(numPre);
+
+        size_t mask = historyAnalog.size() - 1;
+        for (size_t i = 0; i < numPre; ++i)
+        {
+            size_t slot = size_t(capture.firstSampleIndex + i) & mask;
+            capture.samples.analog()[i] = historyAnalog[slot];
+            capture.samples.digital()[i] = historyDigital[slot];
+        }
+
+        bCapturing = true;
+        if (capture.samples.size() == captureSize)
+        {
+            flush();
+        }
+    }
+
+} // namespace SignalDataFacade
@@ -14,10 +14,12 @@
 //------------------------------------------------------------------------------
 
 #include "mainhelp.h"
+#include <chrono>
 #include <iostream>
 #include <memory>
 #include <ranges>
 #include <utility>
+#include <vector>
 #include "adapterpattern.h"
 #include "facadepattern.h"
 #include "proxypattern.h"
@@ -130,7 +132,7 @@ namespace mainhelp
         auto upGpioHAL =
             std::make_unique<SignalDataFacade::GPIOHAL>(std::move(upGpioDrv));
         std::cout << "Data Acquisition Subsystem Facade:" <<std::endl;
-        const auto& facade =
+        auto& facade =
             SignalDataFacade::SignalData::getInstance(
                 std::move(upA2dConverterHAL),
                 std::move(upGpioHAL));
@@ -147,6 +149,18 @@ namespace mainhelp
                       << acquiredData.digital
                       << std::endl;
         }
+        std::cout << "Exercise Facade Streaming:" <<std::endl;
+        facade.resetTiming();
+        facade.startStreaming();
+        std::vector<SignalDataFacade::SignalData::sAggregateData> samples(4096);
+        auto stopAt =
+            std::chrono::steady_clock::now() + std::chrono::milliseconds(200);
+        while (std::chrono::steady_clock::now() < stopAt)
+        {
+            facade.readStream(samples, std::chrono::milliseconds(100));
+        }
+        facade.stopStreaming();
+        std::cout << facade.timingReport();
         std::cout << "-------------------------------------------" << std::endl;
     }
 
@@ -14,18 +14,131 @@
 // Socket libraries
 #include <sys/types.h>
 #include <sys/socket.h>
+#include <sys/sendfile.h>
+#include <sys/stat.h>
 #include <netinet/in.h>
 #include <arpa/inet.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <pthread.h>
 #include <unistd.h>
+#include <csignal>
 #include <cstring>
 
+#include <algorithm>
+#include <array>
 #include <chrono>
+#include <iomanip>
 #include <iostream>
+#include <sstream>
 #include <stdexcept>
 #include <thread>
 
 #include "common/st_enum_ops.h"
 
+namespace // anonymous
+{
+    //--------------------------------------------------------------------------
+    // Local Functions
+    //--------------------------------------------------------------------------
+    // Send the whole buffer, retrying partial writes. Returns false on error.
+    bool sendAll(int fd, const void* pData, size_t length)
+    {
+        const auto* pBytes = static_cast<const uint8_t*>(pData);
+        while (length > 0)
+        {
+            ssize_t sent = ::send(fd, pBytes, length, MSG_NOSIGNAL);
+            if (sent <= 0)
+            {
+                return false;
+            }
+            pBytes += sent;
+            length -= static_cast<size_t>(sent);
+        }
+        return true;
+    }
+
+    //--------------------------------------------------------------------------
+    // Receive exactly length bytes. Returns the last recv() result on failure
+    // (0 for closed, negative for error), or 1 on success.
+    ssize_t receiveAll(int fd, void* pData, size_t length)
+    {
+        auto* pBytes = static_cast<uint8_t*>(pData);
+        while (length > 0)
+        {
+            ssize_t received = ::recv(fd, pBytes, length, 0);
+            if (received <= 0)
+            {
+                return received;
+            }
+            pBytes += received;
+            length -= static_cast<size_t>(received);
+        }
+        return 1;
+    }
+
+    //--------------------------------------------------------------------------
+    // Connect a TCP socket to the proxy server at the given IPv4 address
+    void connectToProxy(const DUTProxy::Socket& socket, const std::string& ip)
+    {
+        // Define the server connect address
+        sockaddr_in serverAddr
+        {
+            .sin_family = AF_INET,
+            .sin_port = htons(DUTProxy::DUT_PROXY_TCP_PORT),
+            .sin_addr = {.s_addr = inet_addr(ip.c_str())}
+        };
+
+        // Connect to the server using the globally available connect()
+        // function
+        if (::connect(
+                socket.get(),
+                reinterpret_cast<sockaddr*>(&serverAddr),
+                sizeof(serverAddr)) < 0)
+        {
+            throw std::runtime_error(
+                "Connection failed on: " +
+                std::string(std::strerror(errno)));
+        }
+
+        std::cout << "Connected to server at "
+                    << ip
+                    << ":"
+                    << DUTProxy::DUT_PROXY_TCP_PORT
+                    << std::endl;
+    }
+
+    //--------------------------------------------------------------------------
+    // Queue a 16-bit wire word for sending
+    void appendWord(std::vector<uint8_t>& bytes, uint16_t word)
+    {
+        const auto* pWord = reinterpret_cast<const uint8_t*>(&word);
+        bytes.insert(bytes.end(), pWord, pWord + sizeof(word));
+    }
+
+    //--------------------------------------------------------------------------
+    // Upper bound on how long the server sleeps in poll() so it notices a
+    // shutdown request promptly
+    constexpr int MAX_POLL_INTERVAL_MS = 100;
+
+    // Largest artifact chunk handed to the kernel per sendfile()/splice(), and
+    // how many the server sends to one connection per wakeup, so one large
+    // transfer to a fast client does not monopolize the server loop
+    constexpr size_t ARTIFACT_CHUNK_BYTES = 1 << 20;
+    constexpr size_t ARTIFACT_CHUNKS_PER_WAKEUP = 4;
+
+    //--------------------------------------------------------------------------
+    // Only plain file names are served, never paths out of the artifact dir
+    bool isValidArtifactName(const std::string& sName)
+    {
+        return !sName.empty() &&
+            sName != "." &&
+            sName != ".." &&
+            sName.find('/') == std::string::npos;
+    }
+
+} // namespace anonymous
+
 namespace DUTProxy
 {
     using namespace StronglyTypedEnumOps;
@@ -57,15 +170,30 @@ namespace DUTProxy
         }
     }
 
+    //--------------------------------------------------------------------------
+    const char* toString(eProxyRequests request)
+    {
+        switch (request)
+        {
+            case eProxyRequests::SUBSCRIBE_RESULTS: return "SUBSCRIBE_RESULTS";
+            case eProxyRequests::FETCH_ARTIFACT:    return "FETCH_ARTIFACT";
+            case eProxyRequests::DUMP_STATS:        return "DUMP_STATS";
+            default:                                return "UNKNOWN REQUEST";
+        }
+    }
+
     //--------------------------------------------------------------------------
     // DUT Implementation
     //--------------------------------------------------------------------------
-    DUT::DUT(sDUTConfig_t sConfig)
+    DUT::DUT(sDUTConfig_t sConfig, bool bAnnounce)
     : runningResult{eTestResults::NONE}, sName{sConfig.sName}
     {
-        std::cout << "Creating new DUT object with name: "
-                  << sName
-                  << std::endl;
+        if (bAnnounce)
+        {
+            std::cout << "Creating new DUT object with name: "
+                      << sName
+                      << std::endl;
+        }
     }
 
     //--------------------------------------------------------------------------
@@ -114,6 +242,12 @@ namespace DUTProxy
         return result;
     }
 
+    //--------------------------------------------------------------------------
+    eTestResults DUT::currentResult() const
+    {
+        return runningResult;
+    }
+
     //--------------------------------------------------------------------------
     // Socket Class Implementation
     //--------------------------------------------------------------------------
@@ -197,7 +331,8 @@ namespace DUTProxy
     // Avoid extra copies, move instead
     : sDUTName(std::move(sConfig.sName)),
       sDUTIPAddr(std::move(sConfig.sIPAddr)),
-      socket(AF_INET, SOCK_STREAM, 0)
+      socket(AF_INET, SOCK_STREAM, 0),
+      bWriterActive(false)
     {
         std::cout << "Creating new DUTProxyClient for DUT: ("
                   << sDUTName
@@ -212,54 +347,71 @@ namespace DUTProxy
     //---------------------------------------------------------------------------
     void DUTProxyClient::connectToServer()
     {
-        // Define the server connect address
-        sockaddr_in serverAddr
-        {
-            .sin_family = AF_INET,
-            .sin_port = htons(DUT_PROXY_TCP_PORT),
-            .sin_addr = {.s_addr = inet_addr(sDUTIPAddr.c_str())}
-        };
+        connectToProxy(socket, sDUTIPAddr);
+        socket.setReceiveTimeout(5);
+    }
 
-        // Connect to the server using the globally available connect()
-        // function
-        if (::connect(
-                socket.get(),
-                reinterpret_cast<sockaddr*>(&serverAddr),
-                sizeof(serverAddr)) < 0)
+    //---------------------------------------------------------------------------
+    eTestResults DUTProxyClient::execute(eTests test)
+    {
+        // The request lives on this thread's stack until the writer marks it
+        // done, so enqueueing never allocates
+        sPendingRequest request{test};
+        pendingRequests.push(&request);
+
+        std::unique_lock<std::mutex> lock(writerMutex);
+        while (!request.bDone.load(std::memory_order_acquire))
         {
-            throw std::runtime_error(
-                "Connection failed on: " +
-                std::string(std::strerror(errno)));
-        }
+            if (bWriterActive)
+            {
+                // Another caller owns the connection, it will either carry
+                // this request in its batch or hand over when it is done
+                batchDone.wait(lock);
+                continue;
+            }
 
-        socket.setReceiveTimeout(5);
+            // Become the writer for everything queued so far
+            bWriterActive = true;
+            lock.unlock();
+            flushPendingRequests();
+            lock.lock();
+            bWriterActive = false;
+            batchDone.notify_all();
+        }
 
-        std::cout << "Connected to server at "
-                    << sDUTIPAddr
-                    << ":"
-                    << DUT_PROXY_TCP_PORT
-                    << std::endl;
+        return request.result;
     }
 
     //---------------------------------------------------------------------------
-    eTestResults DUTProxyClient::execute(eTests test)
+    void DUTProxyClient::flushPendingRequests()
     {
-        eTestResults result{eTestResults::INCOMPLETE};
+        sPendingRequest* pBatch = pendingRequests.drain();
 
-        uint16_t request = static_cast<uint16_t>(test);
-
-        // Send request to server, return result
-        ssize_t sent = send(socket.get(), &request, sizeof(request), 0);
+        txBuffer.clear();
+        for (sPendingRequest* pRequest = pBatch;
+             pRequest != nullptr;
+             pRequest = pRequest->pNext)
+        {
+            txBuffer.push_back(static_cast<uint16_t>(pRequest->test));
+        }
+        rxBuffer.resize(txBuffer.size());
 
-        if (sent != sizeof(request))
+        // Send all requests in one write, the server answers in order
+        bool bReceived = false;
+        if (!sendAll(
+                socket.get(),
+                txBuffer.data(),
+                txBuffer.size() * sizeof(uint16_t)))
         {
             std::cerr << "Unexpected: Failed to send Request" << std::endl;
         }
         else
         {
-            // Receive the result
-            uint16_t rawRsp;
-            ssize_t received = recv(socket.get(), &rawRsp, sizeof(rawRsp), 0);
+            // Receive the results
+            ssize_t received = receiveAll(
+                socket.get(),
+                rxBuffer.data(),
+                rxBuffer.size() * sizeof(uint16_t));
             // Evaluate the result
             if (received == 0)
             {
@@ -271,18 +423,296 @@ namespace DUTProxy
             }
             else
             {
-                result = static_cast<eTestResults>(rawRsp);
+                bReceived = true;
             }
         }
 
-        return result;
+        // Route each result back to its caller
+        size_t index = 0;
+        sPendingRequest* pRequest = pBatch;
+        while (pRequest != nullptr)
+        {
+            // Read the link first, the caller may return as soon as it is done
+            sPendingRequest* pNext = pRequest->pNext;
+            if (bReceived)
+            {
+                pRequest->result = static_cast<eTestResults>(rxBuffer[index]);
+            }
+            pRequest->bDone.store(true, std::memory_order_release);
+            pRequest = pNext;
+            ++index;
+        }
+    }
+
+    //---------------------------------------------------------------------------
+    std::optional<size_t> DUTProxyClient::fetchArtifact(
+        const std::string& sArtifactName,
+        std::span<std::byte> buffer)
+    {
+        std::optional<size_t> fetched;
+
+        acquireConnection();
+        std::optional<uint64_t> size = requestArtifact(sArtifactName);
+        if (size && *size > buffer.size())
+        {
+            std::cerr << "Artifact does not fit in buffer: "
+                      << sArtifactName
+                      << std::endl;
+            discardArtifactBytes(*size);
+        }
+        else if (size)
+        {
+            // Receive directly into the caller's buffer
+            if (receiveAll(socket.get(), buffer.data(), *size) > 0)
+            {
+                fetched = *size;
+            }
+            else
+            {
+                std::cerr << "Artifact receive error: "
+                          << strerror(errno)
+                          << std::endl;
+            }
+        }
+        releaseConnection();
+
+        return fetched;
+    }
+
+    //---------------------------------------------------------------------------
+    std::optional<size_t> DUTProxyClient::fetchArtifact(
+        const std::string& sArtifactName,
+        int destinationFd)
+    {
+        std::optional<size_t> fetched;
+
+        acquireConnection();
+        std::optional<uint64_t> size = requestArtifact(sArtifactName);
+        // splice() needs a pipe between the socket and the destination
+        int pipeFds[2]{-1, -1};
+        if (size && ::pipe2(pipeFds, O_CLOEXEC) < 0)
+        {
+            std::cerr << "Failed to create pipe: "
+                      << strerror(errno)
+                      << std::endl;
+            discardArtifactBytes(*size);
+            size.reset();
+        }
+
+        if (size)
+        {
+            uint64_t remaining = *size;
+            bool bWriteFailed = false;
+            while (remaining > 0)
+            {
+                // Socket to pipe: at most one chunk, so the pipe never blocks
+                ssize_t inPipe =
+                    ::splice(
+                        socket.get(), nullptr, pipeFds[1], nullptr,
+                        std::min<uint64_t>(remaining, ARTIFACT_CHUNK_BYTES),
+                        SPLICE_F_MOVE | SPLICE_F_MORE);
+                if (inPipe <= 0)
+                {
+                    std::cerr << "Artifact receive error: "
+                              << strerror(errno)
+                              << std::endl;
+                    break;
+                }
+                remaining -= static_cast<uint64_t>(inPipe);
+
+                // Pipe to destination, or drop the bytes once writing failed
+                // so the connection stays in step with the server
+                while (inPipe > 0)
+                {
+                    ssize_t moved = bWriteFailed ? -1 :
+                        ::splice(
+                            pipeFds[0], nullptr, destinationFd, nullptr,
+                            static_cast<size_t>(inPipe), SPLICE_F_MOVE);
+                    if (moved <= 0)
+                    {
+                        if (!bWriteFailed)
+                        {
+                            std::cerr << "Artifact write error: "
+                                      << strerror(errno)
+                                      << std::endl;
+                            bWriteFailed = true;
+                        }
+                        std::array<std::byte, 4096> scratch;
+                        moved = ::read(
+                            pipeFds[0], scratch.data(),
+                            std::min<size_t>(inPipe, scratch.size()));
+                        if (moved <= 0) break;
+                    }
+                    inPipe -= moved;
+                }
+            }
+
+            if (remaining == 0 && !bWriteFailed)
+            {
+                fetched = *size;
+            }
+        }
+
+        for (int pipeFd : pipeFds)
+        {
+            if (pipeFd >= 0) ::close(pipeFd);
+        }
+        releaseConnection();
+
+        return fetched;
+    }
+
+    //---------------------------------------------------------------------------
+    std::optional<std::string> DUTProxyClient::fetchStats()
+    {
+        std::optional<std::string> sReport;
+
+        acquireConnection();
+        uint16_t request = static_cast<uint16_t>(eProxyRequests::DUMP_STATS);
+        uint32_t length{0};
+        if (!sendAll(socket.get(), &request, sizeof(request)))
+        {
+            std::cerr << "Unexpected: Failed to send Request" << std::endl;
+        }
+        else if (receiveAll(socket.get(), &length, sizeof(length)) > 0)
+        {
+            std::string sReceived(length, '\0');
+            if (receiveAll(socket.get(), sReceived.data(), length) > 0)
+            {
+                sReport = std::move(sReceived);
+            }
+        }
+        if (!sReport)
+        {
+            std::cerr << "Receive error: " << strerror(errno) << std::endl;
+        }
+        releaseConnection();
+
+        return sReport;
+    }
+
+    //---------------------------------------------------------------------------
+    void DUTProxyClient::acquireConnection()
+    {
+        // Queued test requests wait for the transfer, like any other batch
+        std::unique_lock<std::mutex> lock(writerMutex);
+        batchDone.wait(lock, [this]() { return !bWriterActive; });
+        bWriterActive = true;
+    }
+
+    //---------------------------------------------------------------------------
+    void DUTProxyClient::releaseConnection()
+    {
+        std::lock_guard<std::mutex> lock(writerMutex);
+        bWriterActive = false;
+        batchDone.notify_all();
+    }
+
+    //---------------------------------------------------------------------------
+    std::optional<uint64_t> DUTProxyClient::requestArtifact(
+        const std::string& sArtifactName)
+    {
+        if (sArtifactName.size() > UINT16_MAX)
+        {
+            std::cerr << "Artifact name too long" << std::endl;
+            return std::nullopt;
+        }
+
+        std::vector<uint8_t> request;
+        appendWord(
+            request, static_cast<uint16_t>(eProxyRequests::FETCH_ARTIFACT));
+        appendWord(request, static_cast<uint16_t>(sArtifactName.size()));
+        request.insert(
+            request.end(), sArtifactName.begin(), sArtifactName.end());
+
+        uint64_t size{ARTIFACT_NOT_FOUND};
+        if (!sendAll(socket.get(), request.data(), request.size()))
+        {
+            std::cerr << "Unexpected: Failed to send Request" << std::endl;
+        }
+        else if (receiveAll(socket.get(), &size, sizeof(size)) <= 0)
+        {
+            std::cerr << "Receive error: " << strerror(errno) << std::endl;
+            size = ARTIFACT_NOT_FOUND;
+        }
+
+        if (ARTIFACT_NOT_FOUND == size)
+        {
+            std::cerr << "Artifact unavailable: " << sArtifactName << std::endl;
+            return std::nullopt;
+        }
+        return size;
+    }
+
+    //---------------------------------------------------------------------------
+    void DUTProxyClient::discardArtifactBytes(uint64_t length)
+    {
+        std::array<std::byte, 4096> scratch;
+        while (length > 0)
+        {
+            ssize_t received =
+                ::recv(
+                    socket.get(), scratch.data(),
+                    std::min<uint64_t>(length, scratch.size()), 0);
+            if (received <= 0) break;
+            length -= static_cast<uint64_t>(received);
+        }
+    }
+
+    //---------------------------------------------------------------------------
+    // DUTResultSubscriber Implementation
+    //---------------------------------------------------------------------------
+    DUTResultSubscriber::DUTResultSubscriber(sRemoteDUTConfig_t sConfig)
+    : socket(AF_INET, SOCK_STREAM, 0),
+      sDUTName(std::move(sConfig.sName)),
+      sDUTIPAddr(std::move(sConfig.sIPAddr))
+    {
+        std::cout << "Creating new DUTResultSubscriber for DUT: ("
+                  << sDUTName
+                  << ", "
+                  << sDUTIPAddr
+                  << ")"
+                  << std::endl;
+
+        connectToProxy(socket, sDUTIPAddr);
+        socket.setReceiveTimeout(5);
+
+        uint16_t request =
+            static_cast<uint16_t>(eProxyRequests::SUBSCRIBE_RESULTS);
+        if (!sendAll(socket.get(), &request, sizeof(request)))
+        {
+            throw std::runtime_error(
+                "Subscribe failed: " + std::string(std::strerror(errno)));
+        }
+    }
+
+    //---------------------------------------------------------------------------
+    std::optional<eTestResults> DUTResultSubscriber::nextEvent(
+        std::chrono::milliseconds timeout)
+    {
+        pollfd pollFd{socket.get(), POLLIN, 0};
+        if (::poll(&pollFd, 1, static_cast<int>(timeout.count())) <= 0)
+        {
+            return std::nullopt;
+        }
+
+        uint16_t rawEvent{0};
+        if (receiveAll(socket.get(), &rawEvent, sizeof(rawEvent)) <= 0)
+        {
+            return std::nullopt;
+        }
+
+        return static_cast<eTestResults>(rawEvent);
     }
 
     //---------------------------------------------------------------------------
     // DUTProxyServer Implementation
     //---------------------------------------------------------------------------
-    DUTProxyServer::DUTProxyServer(DUT &targetDUT)
-    : dut(targetDUT), running(false), serverSocket(AF_INET, SOCK_STREAM, 0)
+    DUTProxyServer::DUTProxyServer(DUT &targetDUT, sProxyServerConfig_t sConfig)
+    : dut(targetDUT),
+      config(sConfig),
+      running(false),
+      serverSocket(AF_INET, SOCK_STREAM, 0)
     {
         // Set and bind socket to this host
         sockaddr_in addr
@@ -325,8 +755,8 @@ namespace DUTProxy
         // Discontinue server thread's loop
         running = false;
 
-        // Force-close the socket to unblock accept() using the globally
-        // available function
+        // Force-close the socket to wake poll() using the globally available
+        // function
         ::shutdown(serverSocket.get(), SHUT_RDWR);
 
         // Wait for server thread to exit
@@ -341,61 +771,567 @@ namespace DUTProxy
     //---------------------------------------------------------------------------
     void DUTProxyServer::ServerEntry()
     {
+        // sendfile() has no MSG_NOSIGNAL, so keep a client that disconnects
+        // mid-transfer from raising SIGPIPE on this thread
+        sigset_t pipeSignal;
+        sigemptyset(&pipeSignal);
+        sigaddset(&pipeSignal, SIGPIPE);
+        pthread_sigmask(SIG_BLOCK, &pipeSignal, nullptr);
+
+        std::vector<pollfd> pollFds;
+
         while (running)
         {
-            sockaddr_in clientAddr{};
-            socklen_t clientLen = sizeof(clientAddr);
+            // The listening socket first, then one entry per connection
+            pollFds.clear();
+            pollFds.push_back({serverSocket.get(), POLLIN, 0});
+            for (const auto& connection : connections)
+            {
+                short events = POLLIN;
+                if (!connection.txBytes.empty() || connection.upTransfer)
+                {
+                    events |= POLLOUT;
+                }
+                pollFds.push_back({connection.socket.get(), events, 0});
+            }
 
-            // Accept incoming connection using globally available function
-            int clientSocket =
-                ::accept(
-                    serverSocket.get(),
-                    reinterpret_cast<sockaddr*>(&clientAddr),
-                    &clientLen);
-            if (clientSocket < 0)
+            if (::poll(pollFds.data(), pollFds.size(), pollTimeoutMs()) < 0 &&
+                errno != EINTR)
             {
-                // Stop if shutting down
-                if (!running) break;
-                std::cerr << "Accept failed" << std::endl;
-                continue;
+                std::cerr << "Poll failed: "
+                          << std::strerror(errno)
+                          << std::endl;
+                break;
             }
+            // Stop if shutting down
+            if (!running) break;
 
-            // Handle client inline, client will close the connection when it
-            // is done
-            handleClient(Socket(clientSocket));
+            // Service the connections that were polled, new ones are only
+            // appended afterwards so indices stay aligned
+            for (size_t i = 0; i < connections.size(); ++i)
+            {
+                if (pollFds[i + 1].revents != 0)
+                {
+                    receiveRequests(connections[i]);
+                    flush(connections[i]);
+                }
+            }
+
+            if (pollFds[0].revents & POLLIN)
+            {
+                acceptClient();
+            }
+
+            publishResultEvents();
 
-            close(clientSocket);
+            std::erase_if(
+                connections,
+                [](const sConnection& connection)
+                {
+                    return connection.bClosed;
+                });
         }
     }
 
     //---------------------------------------------------------------------------
-    void DUTProxyServer::handleClient(Socket&& clientSocket)
+    void DUTProxyServer::acceptClient()
     {
-        while (running)
+        // Accept incoming connection using globally available function,
+        // non-blocking so one slow client cannot stall the others
+        int clientSocket =
+            ::accept4(serverSocket.get(), nullptr, nullptr, SOCK_NONBLOCK);
+        if (clientSocket < 0)
         {
-            std::cout << "Processing client requests" << std::endl;
-            uint16_t rawRequest{0};
-            // Receive request using globally available recv()
+            std::cerr << "Accept failed" << std::endl;
+            return;
+        }
+
+        std::cout << "Processing client requests" << std::endl;
+        // The Socket adopts the descriptor and closes it
+        connections.push_back(sConnection{Socket(clientSocket)});
+        connections.back().id = nextConnectionId++;
+    }
+
+    //---------------------------------------------------------------------------
+    void DUTProxyServer::receiveRequests(sConnection& connection)
+    {
+        // A client may send several requests in one write, so drain the socket
+        // and answer the whole batch at once
+        std::array<uint8_t, 512> rxChunk{};
+        while (true)
+        {
+            // Receive requests using globally available recv()
             ssize_t bytes =
-                ::recv(clientSocket.get(), &rawRequest, sizeof(rawRequest), 0);
-            if (bytes <= 0)
+                ::recv(connection.socket.get(), rxChunk.data(), rxChunk.size(),
+                       0);
+            if (bytes > 0)
+            {
+                // Queue time starts when the first byte of a request
+                // arrives, not its last
+                if (connection.rxBytes.empty())
+                {
+                    connection.received = Clock::now();
+                }
+                connection.rxBytes.insert(
+                    connection.rxBytes.end(),
+                    rxChunk.begin(),
+                    rxChunk.begin() + bytes);
+                continue;
+            }
+            if (bytes < 0 && errno == EINTR)
+            {
+                continue;
+            }
+            if (bytes == 0 || (errno != EAGAIN && errno != EWOULDBLOCK))
             {
                 std::cout << "Socket Receive: no data" << std::endl;
                 // Assume this condition means the socket has been shut down by
-                // the client and stop processing
-                break;
+                // the client and stop processing after this batch
+                connection.bClosed = true;
+            }
+            break;
+        }
+
+        processRequests(connection);
+    }
+
+    //---------------------------------------------------------------------------
+    void DUTProxyServer::processRequests(sConnection& connection)
+    {
+        size_t offset = 0;
+        // Requests queue behind a streaming artifact to keep responses in order
+        while (!connection.upTransfer &&
+               offset + sizeof(uint16_t) <= connection.rxBytes.size())
+        {
+            uint16_t rawRequest{0};
+            std::memcpy(
+                &rawRequest,
+                connection.rxBytes.data() + offset,
+                sizeof(rawRequest));
+
+            if (eProxyRequests::FETCH_ARTIFACT ==
+                    static_cast<eProxyRequests>(rawRequest))
+            {
+                if (!handleFetchArtifact(connection, offset))
+                {
+                    break;
+                }
+                continue;
             }
 
-            eTests testToRun = static_cast<eTests>(rawRequest);
-            std::cout << "Running test: " << toString(testToRun) << std::endl;
+            handleRequest(connection, rawRequest);
+            offset += sizeof(uint16_t);
+        }
+
+        // Keep a trailing partial request for the next receive
+        connection.rxBytes.erase(
+            connection.rxBytes.begin(),
+            connection.rxBytes.begin() + offset);
+    }
+
+    //---------------------------------------------------------------------------
+    void DUTProxyServer::handleRequest(
+        sConnection& connection,
+        uint16_t rawRequest)
+    {
+        if (eProxyRequests::SUBSCRIBE_RESULTS ==
+                static_cast<eProxyRequests>(rawRequest))
+        {
+            std::cout << "Request: "
+                      << toString(eProxyRequests::SUBSCRIBE_RESULTS)
+                      << std::endl;
+            // Acknowledge with the current state, changes follow as events
+            connection.bSubscribed = true;
+            connection.lastPublished = dut.currentResult();
+            appendWord(
+                connection.txBytes,
+                static_cast<uint16_t>(connection.lastPublished));
+            return;
+        }
+
+        if (connection.bSubscribed)
+        {
+            // An event stream carries no responses, ignore further requests
+            return;
+        }
+
+        if (eProxyRequests::DUMP_STATS ==
+                static_cast<eProxyRequests>(rawRequest))
+        {
+            handleDumpStats(connection);
+            return;
+        }
+
+        eTests testToRun = static_cast<eTests>(rawRequest);
+        std::cout << "Running test: " << toString(testToRun) << std::endl;
+
+        const auto executeStart = Clock::now();
+        eTestResults result = dut.execute(testToRun);
+        const auto executeEnd = Clock::now();
+        std::cout << "Result: " << toString(result) << std::endl;
+
+        appendWord(connection.txBytes, static_cast<uint16_t>(result));
+        connection.unsentTimings.push_back(
+            {rawRequest, connection.received, executeStart, executeEnd});
+    }
 
-            eTestResults result = dut.execute(testToRun);
-            std::cout << "Result: " << toString(result) << std::endl;
+    //---------------------------------------------------------------------------
+    void DUTProxyServer::handleDumpStats(sConnection& connection)
+    {
+        std::cout << "Request: "
+                  << toString(eProxyRequests::DUMP_STATS)
+                  << std::endl;
+
+        // Snapshot before this connection's own response is queued
+        std::string sReport = statsReport();
+        std::cout << sReport;
+
+        uint32_t length = static_cast<uint32_t>(sReport.size());
+        const auto* pLength = reinterpret_cast<const uint8_t*>(&length);
+        connection.txBytes.insert(
+            connection.txBytes.end(), pLength, pLength + sizeof(length));
+        connection.txBytes.insert(
+            connection.txBytes.end(), sReport.begin(), sReport.end());
+    }
 
-            uint16_t rawResult = static_cast<uint16_t>(result);
+    //---------------------------------------------------------------------------
+    bool DUTProxyServer::handleFetchArtifact(
+        sConnection& connection,
+        size_t& offset)
+    {
+        // Opcode and name length, then the name itself
+        constexpr size_t HEADER_BYTES = 2 * sizeof(uint16_t);
+        if (offset + HEADER_BYTES > connection.rxBytes.size())
+        {
+            return false;
+        }
+        uint16_t nameLength{0};
+        std::memcpy(
+            &nameLength,
+            connection.rxBytes.data() + offset + sizeof(uint16_t),
+            sizeof(nameLength));
+        if (offset + HEADER_BYTES + nameLength > connection.rxBytes.size())
+        {
+            return false;
+        }
+
+        const auto nameBegin =
+            connection.rxBytes.begin() + offset + HEADER_BYTES;
+        std::string sArtifactName(nameBegin, nameBegin + nameLength);
+        offset += HEADER_BYTES + nameLength;
+
+        if (connection.bSubscribed)
+        {
+            // An event stream carries no responses, ignore further requests
+            return true;
+        }
+
+        std::cout << "Request: "
+                  << toString(eProxyRequests::FETCH_ARTIFACT)
+                  << " "
+                  << sArtifactName
+                  << std::endl;
+
+        uint64_t size{ARTIFACT_NOT_FOUND};
+        int fileFd = -1;
+        if (!config.sArtifactDir.empty() && isValidArtifactName(sArtifactName))
+        {
+            std::string sPath = config.sArtifactDir + "/" + sArtifactName;
+            fileFd = ::open(sPath.c_str(), O_RDONLY | O_CLOEXEC);
+        }
+
+        struct stat fileStat{};
+        if (fileFd >= 0 &&
+            ::fstat(fileFd, &fileStat) == 0 &&
+            S_ISREG(fileStat.st_mode))
+        {
+            size = static_cast<uint64_t>(fileStat.st_size);
+            connection.upTransfer =
+                std::make_unique<sArtifactTransfer>(fileFd, 0, size);
+        }
+        else if (fileFd >= 0)
+        {
+            ::close(fileFd);
+        }
+
+        const auto* pSize = reinterpret_cast<const uint8_t*>(&size);
+        connection.txBytes.insert(
+            connection.txBytes.end(), pSize, pSize + sizeof(size));
+
+        return true;
+    }
+
+    //---------------------------------------------------------------------------
+    void DUTProxyServer::flush(sConnection& connection)
+    {
+        // Responses go out first, then any artifact, then the requests that
+        // queued behind the artifact
+        while (sendBufferedBytes(connection) && connection.upTransfer)
+        {
+            if (!streamArtifact(connection))
+            {
+                return;
+            }
+            processRequests(connection);
+        }
+    }
+
+    //---------------------------------------------------------------------------
+    bool DUTProxyServer::sendBufferedBytes(sConnection& connection)
+    {
+        size_t sentBytes = 0;
+        while (!connection.bClosed && sentBytes < connection.txBytes.size())
+        {
             // Send using globally available send()
-            ::send(clientSocket.get(), &rawResult, sizeof(rawResult), 0);
+            ssize_t sent =
+                ::send(
+                    connection.socket.get(),
+                    connection.txBytes.data() + sentBytes,
+                    connection.txBytes.size() - sentBytes,
+                    MSG_NOSIGNAL);
+            if (sent > 0)
+            {
+                sentBytes += static_cast<size_t>(sent);
+            }
+            else if (sent < 0 && errno == EINTR)
+            {
+                continue;
+            }
+            else if (sent < 0 && (errno == EAGAIN || errno == EWOULDBLOCK))
+            {
+                // Socket buffer full, finish when poll() reports POLLOUT
+                break;
+            }
+            else
+            {
+                std::cerr << "Failed to send results" << std::endl;
+                connection.bClosed = true;
+            }
+        }
+
+        connection.txBytes.erase(
+            connection.txBytes.begin(),
+            connection.txBytes.begin() + sentBytes);
+
+        if (connection.txBytes.empty() && !connection.unsentTimings.empty())
+        {
+            recordLatencies(connection, Clock::now());
         }
+
+        return !connection.bClosed && connection.txBytes.empty();
+    }
+
+    //---------------------------------------------------------------------------
+    void DUTProxyServer::recordLatencies(
+        sConnection& connection,
+        Clock::time_point sent)
+    {
+        auto toNs = [](Clock::duration duration)
+        {
+            return static_cast<uint64_t>(
+                std::chrono::duration_cast<std::chrono::nanoseconds>(
+                    duration).count());
+        };
+
+        for (const sRequestTiming& timing : connection.unsentTimings)
+        {
+            auto it = std::find_if(
+                connection.latencies.begin(),
+                connection.latencies.end(),
+                [&timing](const sTestLatency& latency)
+                {
+                    return latency.rawTest == timing.rawTest;
+                });
+            if (it == connection.latencies.end())
+            {
+                connection.latencies.push_back({timing.rawTest, {}, {}, {}});
+                it = std::prev(connection.latencies.end());
+            }
+
+            it->queueTime.record(toNs(timing.executeStart - timing.received));
+            it->executeTime.record(
+                toNs(timing.executeEnd - timing.executeStart));
+            it->writeTime.record(toNs(sent - timing.executeEnd));
+
+            if (sent - timing.received > config.slowRequestThreshold)
+            {
+                std::cerr << "Slow request on connection "
+                          << connection.id
+                          << ": "
+                          << toString(static_cast<eTests>(timing.rawTest))
+                          << " took "
+                          << toNs(sent - timing.received) / 1000
+                          << " us (queue "
+                          << toNs(timing.executeStart - timing.received) / 1000
+                          << " us, execute "
+                          << toNs(timing.executeEnd - timing.executeStart) /
+                                1000
+                          << " us, write "
+                          << toNs(sent - timing.executeEnd) / 1000
+                          << " us)"
+                          << std::endl;
+            }
+        }
+        connection.unsentTimings.clear();
+    }
+
+    //---------------------------------------------------------------------------
+    std::string DUTProxyServer::statsReport() const
+    {
+        std::ostringstream report;
+        report << std::fixed << std::setprecision(1);
+
+        auto printHistogram = [&report](
+            const char* sPhase,
+            const Metrics::LatencyHistogram& histogram)
+        {
+            // Microseconds read more naturally than nanoseconds here
+            report << "    " << std::left << std::setw(8) << sPhase
+                   << std::right
+                   << " mean " << histogram.mean() / 1000.0
+                   << " p50 " << histogram.percentile(50) / 1000.0
+                   << " p90 " << histogram.percentile(90) / 1000.0
+                   << " p99 " << histogram.percentile(99) / 1000.0
+                   << " max " << histogram.max() / 1000.0
+                   << " us\n";
+        };
+
+        report << "DUTProxyServer latency statistics ("
+               << connections.size()
+               << " connections)\n";
+        for (const auto& connection : connections)
+        {
+            report << "Connection " << connection.id << "\n";
+            for (const auto& latency : connection.latencies)
+            {
+                report << "  "
+                       << toString(static_cast<eTests>(latency.rawTest))
+                       << ": "
+                       << latency.executeTime.count()
+                       << " requests\n";
+                printHistogram("queue", latency.queueTime);
+                printHistogram("execute", latency.executeTime);
+                printHistogram("write", latency.writeTime);
+            }
+        }
+
+        return report.str();
+    }
+
+    //---------------------------------------------------------------------------
+    bool DUTProxyServer::streamArtifact(sConnection& connection)
+    {
+        sArtifactTransfer& transfer = *connection.upTransfer;
+        size_t numChunks = 0;
+        while (transfer.remaining > 0)
+        {
+            if (numChunks++ == ARTIFACT_CHUNKS_PER_WAKEUP)
+            {
+                // Let the other connections run, resume on POLLOUT
+                return false;
+            }
+
+            // Page cache to socket, no user space copy
+            off_t offset = static_cast<off_t>(transfer.offset);
+            ssize_t sent =
+                ::sendfile(
+                    connection.socket.get(),
+                    transfer.fileFd,
+                    &offset,
+                    std::min<uint64_t>(
+                        transfer.remaining, ARTIFACT_CHUNK_BYTES));
+            if (sent > 0)
+            {
+                transfer.offset = offset;
+                transfer.remaining -= static_cast<uint64_t>(sent);
+                continue;
+            }
+            if (sent < 0 && errno == EINTR)
+            {
+                continue;
+            }
+            if (sent < 0 && (errno == EAGAIN || errno == EWOULDBLOCK))
+            {
+                // Client is slower than the file, resume on POLLOUT
+                return false;
+            }
+
+            // A failed or truncated file cannot be recovered mid-stream
+            std::cerr << "Artifact send failed" << std::endl;
+            connection.bClosed = true;
+            connection.upTransfer.reset();
+            return false;
+        }
+
+        connection.upTransfer.reset();
+        return true;
+    }
+
+    //---------------------------------------------------------------------------
+    DUTProxyServer::sArtifactTransfer::~sArtifactTransfer()
+    {
+        ::close(fileFd);
+    }
+
+    //---------------------------------------------------------------------------
+    void DUTProxyServer::publishResultEvents()
+    {
+        const auto now = std::chrono::steady_clock::now();
+        const eTestResults current = dut.currentResult();
+
+        if (!eventDeadline)
+        {
+            // Open a coalescing window on the first change any subscriber
+            // has not seen yet
+            bool bChanged = std::any_of(
+                connections.begin(),
+                connections.end(),
+                [current](const sConnection& connection)
+                {
+                    return connection.bSubscribed &&
+                        connection.lastPublished != current;
+                });
+            if (!bChanged)
+            {
+                return;
+            }
+            eventDeadline = now + config.eventWindow;
+        }
+
+        if (now < *eventDeadline)
+        {
+            return;
+        }
+        eventDeadline.reset();
+
+        // Push only the latest result, intermediate changes are coalesced
+        for (auto& connection : connections)
+        {
+            if (connection.bSubscribed &&
+                !connection.bClosed &&
+                connection.lastPublished != current)
+            {
+                connection.lastPublished = current;
+                appendWord(connection.txBytes, static_cast<uint16_t>(current));
+                flush(connection);
+            }
+        }
+    }
+
+    //---------------------------------------------------------------------------
+    int DUTProxyServer::pollTimeoutMs() const
+    {
+        if (!eventDeadline)
+        {
+            return MAX_POLL_INTERVAL_MS;
+        }
+
+        // Round up so the window has elapsed when poll() returns
+        auto remaining =
+            std::chrono::ceil<std::chrono::milliseconds>(
+                *eventDeadline - std::chrono::steady_clock::now());
+        return static_cast<int>(
+            std::clamp<int64_t>(remaining.count(), 0, MAX_POLL_INTERVAL_MS));
     }
 
 } // DUTProxy
\ No newline at end of file
@@ -0,0 +1,476 @@
+// Copyright (c) 2025 Michael Dello
+//
+// This software is provided under the MIT License.
+// See LICENSE file for details.
+
+//------------------------------------------------------------------------------
+//
+// Simulated DUT Rack Implementation
+//
+//------------------------------------------------------------------------------
+
+#include "proxypattern_simrack.h"
+
+// Socket libraries
+#include <sys/types.h>
+#include <sys/socket.h>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <netinet/in.h>
+#include <unistd.h>
+#include <cstring>
+
+#include <algorithm>
+#include <array>
+#include <iostream>
+#include <stdexcept>
+#include <utility>
+
+namespace DUTProxy
+{
+    //--------------------------------------------------------------------------
+    // SimTask Implementation
+    //--------------------------------------------------------------------------
+    SimTask::SimTask(std::coroutine_handle<promise_type> handle) noexcept
+    : handle(handle)
+    {
+        // No Body
+    }
+
+    //--------------------------------------------------------------------------
+    SimTask::SimTask(SimTask&& owned) noexcept
+    : handle(std::exchange(owned.handle, nullptr))
+    {
+        // No Body
+    }
+
+    //--------------------------------------------------------------------------
+    SimTask::~SimTask()
+    {
+        // Only a task never handed to a scheduler still owns its frame
+        if (handle)
+        {
+            handle.destroy();
+        }
+    }
+
+    //--------------------------------------------------------------------------
+    // SimScheduler Implementation
+    //--------------------------------------------------------------------------
+    SimScheduler::SimScheduler()
+    : epollFd(::epoll_create1(EPOLL_CLOEXEC)),
+      wakeFd(::eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC)),
+      bStopping(false),
+      timerSequence(0)
+    {
+        if (epollFd < 0 || wakeFd < 0)
+        {
+            throw std::runtime_error(
+                "Failed to create scheduler" +
+                std::string(std::strerror(errno)));
+        }
+
+        // The wake descriptor is always watched
+        epoll_event event{};
+        event.events = EPOLLIN;
+        event.data.fd = wakeFd;
+        ::epoll_ctl(epollFd, EPOLL_CTL_ADD, wakeFd, &event);
+    }
+
+    //--------------------------------------------------------------------------
+    SimScheduler::~SimScheduler()
+    {
+        // Suspended frames still own resources such as sockets
+        for (void* pFrame : tasks)
+        {
+            std::coroutine_handle<>::from_address(pFrame).destroy();
+        }
+        ::close(wakeFd);
+        ::close(epollFd);
+    }
+
+    //--------------------------------------------------------------------------
+    void SimScheduler::spawn(SimTask task)
+    {
+        std::coroutine_handle<> handle = std::exchange(task.handle, nullptr);
+        tasks.insert(handle.address());
+        ready.push_back(handle);
+    }
+
+    //--------------------------------------------------------------------------
+    void SimScheduler::run()
+    {
+        while (!bStopping && !tasks.empty())
+        {
+            resumeReady();
+            fireTimers();
+            if (ready.empty() && !bStopping && !tasks.empty())
+            {
+                waitForEvents();
+            }
+        }
+        // Allow running again after a stop
+        bStopping = false;
+    }
+
+    //--------------------------------------------------------------------------
+    void SimScheduler::stop()
+    {
+        bStopping = true;
+        uint64_t increment = 1;
+        // Wake epoll_wait(), failure only means it is already signalled
+        [[maybe_unused]] ssize_t written =
+            ::write(wakeFd, &increment, sizeof(increment));
+    }
+
+    //--------------------------------------------------------------------------
+    size_t SimScheduler::liveTasks() const
+    {
+        return tasks.size();
+    }
+
+    //--------------------------------------------------------------------------
+    SimScheduler::SleepAwaiter SimScheduler::sleepFor(
+        std::chrono::nanoseconds duration)
+    {
+        return {*this, std::chrono::steady_clock::now() + duration};
+    }
+
+    //--------------------------------------------------------------------------
+    SimScheduler::FdAwaiter SimScheduler::readable(int fd)
+    {
+        return {*this, fd, false};
+    }
+
+    //--------------------------------------------------------------------------
+    SimScheduler::FdAwaiter SimScheduler::writable(int fd)
+    {
+        return {*this, fd, true};
+    }
+
+    //--------------------------------------------------------------------------
+    bool SimScheduler::SleepAwaiter::await_ready() const noexcept
+    {
+        return wakeTime <= std::chrono::steady_clock::now();
+    }
+
+    //--------------------------------------------------------------------------
+    void SimScheduler::SleepAwaiter::await_suspend(
+        std::coroutine_handle<> handle)
+    {
+        scheduler.timers.push({wakeTime, scheduler.timerSequence++, handle});
+    }
+
+    //--------------------------------------------------------------------------
+    void SimScheduler::FdAwaiter::await_suspend(std::coroutine_handle<> handle)
+    {
+        sFdWaiters& waiters = scheduler.fdWaiters[fd];
+        (bWrite ? waiters.writer : waiters.reader) = handle;
+        scheduler.watch(fd, waiters);
+    }
+
+    //--------------------------------------------------------------------------
+    void SimScheduler::resumeReady()
+    {
+        // Only run what is ready now, tasks made ready meanwhile wait for the
+        // next pass so timers and I/O are not starved
+        for (size_t count = ready.size(); count > 0 && !bStopping; --count)
+        {
+            std::coroutine_handle<> handle = ready.front();
+            ready.pop_front();
+            handle.resume();
+            if (handle.done())
+            {
+                tasks.erase(handle.address());
+                handle.destroy();
+            }
+        }
+    }
+
+    //--------------------------------------------------------------------------
+    void SimScheduler::fireTimers()
+    {
+        const auto now = std::chrono::steady_clock::now();
+        while (!timers.empty() && timers.top().wakeTime <= now)
+        {
+            ready.push_back(timers.top().handle);
+            timers.pop();
+        }
+    }
+
+    //--------------------------------------------------------------------------
+    void SimScheduler::waitForEvents()
+    {
+        // Block until the next timer, or indefinitely if there is none
+        int timeoutMs = -1;
+        if (!timers.empty())
+        {
+            auto remaining =
+                std::chrono::ceil<std::chrono::milliseconds>(
+                    timers.top().wakeTime - std::chrono::steady_clock::now());
+            timeoutMs =
+                static_cast<int>(std::max<int64_t>(remaining.count(), 0));
+        }
+
+        std::array<epoll_event, 256> events;
+        int count =
+            ::epoll_wait(epollFd, events.data(), events.size(), timeoutMs);
+        for (int i = 0; i < count; ++i)
+        {
+            if (events[i].data.fd == wakeFd)
+            {
+                uint64_t value;
+                [[maybe_unused]] ssize_t consumed =
+                    ::read(wakeFd, &value, sizeof(value));
+                continue;
+            }
+
+            int fd = events[i].data.fd;
+            auto it = fdWaiters.find(fd);
+            if (it == fdWaiters.end())
+            {
+                continue;
+            }
+
+            // Errors and hang-ups wake both directions so the task notices
+            const uint32_t happened = events[i].events;
+            const bool bError = happened & (EPOLLERR | EPOLLHUP);
+            sFdWaiters& waiters = it->second;
+            if (waiters.reader && (bError || (happened & EPOLLIN)))
+            {
+                ready.push_back(std::exchange(waiters.reader, nullptr));
+            }
+            if (waiters.writer && (bError || (happened & EPOLLOUT)))
+            {
+                ready.push_back(std::exchange(waiters.writer, nullptr));
+            }
+
+            if (waiters.reader || waiters.writer)
+            {
+                // Re-arm for the direction still waiting
+                watch(fd, waiters);
+            }
+            else
+            {
+                fdWaiters.erase(it);
+            }
+        }
+    }
+
+    //--------------------------------------------------------------------------
+    void SimScheduler::watch(int fd, const sFdWaiters& waiters)
+    {
+        // One-shot, so a descriptor nobody waits on never wakes the loop
+        epoll_event event{};
+        event.events = EPOLLONESHOT;
+        event.events |= waiters.reader ? uint32_t{EPOLLIN} : 0;
+        event.events |= waiters.writer ? uint32_t{EPOLLOUT} : 0;
+        event.data.fd = fd;
+
+        // Closed descriptors leave epoll on their own, so a reused number
+        // may or may not still be registered
+        if (::epoll_ctl(epollFd, EPOLL_CTL_MOD, fd, &event) < 0 &&
+            (errno != ENOENT ||
+                ::epoll_ctl(epollFd, EPOLL_CTL_ADD, fd, &event) < 0))
+        {
+            throw std::runtime_error(
+                "Failed to watch descriptor" +
+                std::string(std::strerror(errno)));
+        }
+    }
+
+    //--------------------------------------------------------------------------
+    // SimRack Implementation
+    //--------------------------------------------------------------------------
+    SimRack::SimRack(SimScheduler& scheduler, sSimRackConfig_t sConfig)
+    : scheduler(scheduler),
+      config(std::move(sConfig)),
+      listenSocket(AF_INET, SOCK_STREAM | SOCK_NONBLOCK, 0),
+      latencyRng(config.seed),
+      sessionsAccepted(0),
+      spSessionsActive(std::make_shared<std::atomic<size_t>>(0)),
+      requestsAnswered(0)
+    {
+        // Set and bind socket to this host
+        sockaddr_in addr
+        {
+            .sin_family = AF_INET,
+            .sin_port = htons(config.port),
+            .sin_addr = {.s_addr = INADDR_ANY}
+        };
+        int opt = 1;
+        ::setsockopt(
+            listenSocket.get(), SOL_SOCKET, SO_REUSEADDR, &opt, sizeof(opt));
+        if (::bind(
+                listenSocket.get(),
+                reinterpret_cast<sockaddr*>(&addr),
+                sizeof(addr)) < 0)
+        {
+            throw std::runtime_error(
+                "Bind failed" + std::string(std::strerror(errno)));
+        }
+
+        if (::listen(listenSocket.get(), SOMAXCONN) < 0)
+        {
+            throw std::runtime_error(
+                "Listen failed" + std::string(std::strerror(errno)));
+        }
+
+        scheduler.spawn(acceptSessions());
+    }
+
+    //--------------------------------------------------------------------------
+    size_t SimRack::activeSessions() const
+    {
+        return *spSessionsActive;
+    }
+
+    //--------------------------------------------------------------------------
+    uint64_t SimRack::requestsServed() const
+    {
+        return requestsAnswered;
+    }
+
+    //--------------------------------------------------------------------------
+    SimTask SimRack::acceptSessions()
+    {
+        while (true)
+        {
+            int clientSocket =
+                ::accept4(
+                    listenSocket.get(), nullptr, nullptr,
+                    SOCK_NONBLOCK | SOCK_CLOEXEC);
+            if (clientSocket >= 0)
+            {
+                scheduler.spawn(
+                    serveSession(Socket(clientSocket), sessionsAccepted++));
+                continue;
+            }
+
+            if (errno != EAGAIN && errno != EWOULDBLOCK && errno != EINTR)
+            {
+                // Typically out of descriptors, let sessions finish and retry
+                std::cerr << "SimRack accept failed: "
+                          << std::strerror(errno)
+                          << std::endl;
+                co_await scheduler.sleepFor(std::chrono::milliseconds(10));
+                continue;
+            }
+
+            co_await scheduler.readable(listenSocket.get());
+        }
+    }
+
+    //--------------------------------------------------------------------------
+    SimTask SimRack::serveSession(Socket clientSocket, uint64_t sessionIndex)
+    {
+        // Counted for as long as the frame exists, so a session the
+        // scheduler destroys while suspended is uncounted too
+        struct sSessionCount
+        {
+            std::shared_ptr<std::atomic<size_t>> spCount;
+            ~sSessionCount() { --*spCount; }
+        };
+        ++*spSessionsActive;
+        sSessionCount sessionCount{spSessionsActive};
+
+        // Quiet construction, a rack of 10,000 DUTs would flood the console
+        DUT dut{{config.sNamePrefix + std::to_string(sessionIndex)}, false};
+
+        std::array<uint8_t, 512> rxBytes{};
+        size_t pendingBytes = 0;
+        std::vector<uint16_t> rawResults;
+
+        while (true)
+        {
+            ssize_t bytes =
+                ::recv(
+                    clientSocket.get(),
+                    rxBytes.data() + pendingBytes,
+                    rxBytes.size() - pendingBytes,
+                    0);
+            if (bytes < 0 && (errno == EAGAIN || errno == EWOULDBLOCK))
+            {
+                co_await scheduler.readable(clientSocket.get());
+                continue;
+            }
+            if (bytes < 0 && errno == EINTR)
+            {
+                continue;
+            }
+            if (bytes <= 0)
+            {
+                // Client closed the session
+                break;
+            }
+            pendingBytes += static_cast<size_t>(bytes);
+
+            // Run the batch in order, as a real DUT would
+            rawResults.clear();
+            size_t offset = 0;
+            for (; offset + sizeof(uint16_t) <= pendingBytes;
+                 offset += sizeof(uint16_t))
+            {
+                uint16_t rawRequest{0};
+                std::memcpy(
+                    &rawRequest, rxBytes.data() + offset, sizeof(rawRequest));
+                eTests testToRun = static_cast<eTests>(rawRequest);
+
+                auto latency = simulatedLatency(testToRun);
+                if (latency.count() > 0)
+                {
+                    co_await scheduler.sleepFor(latency);
+                }
+                rawResults.push_back(
+                    static_cast<uint16_t>(dut.execute(testToRun)));
+            }
+            pendingBytes -= offset;
+            std::memmove(rxBytes.data(), rxBytes.data() + offset, pendingBytes);
+
+            // Answer the batch with one write, waiting out a full socket
+            const auto* pTx =
+                reinterpret_cast<const uint8_t*>(rawResults.data());
+            size_t txRemaining = rawResults.size() * sizeof(uint16_t);
+            while (txRemaining > 0)
+            {
+                ssize_t sent =
+                    ::send(clientSocket.get(), pTx, txRemaining, MSG_NOSIGNAL);
+                if (sent > 0)
+                {
+                    pTx += sent;
+                    txRemaining -= static_cast<size_t>(sent);
+                }
+                else if (sent < 0 && (errno == EAGAIN || errno == EWOULDBLOCK))
+                {
+                    co_await scheduler.writable(clientSocket.get());
+                }
+                else if (!(sent < 0 && errno == EINTR))
+                {
+                    break;
+                }
+            }
+            if (txRemaining > 0)
+            {
+                break;
+            }
+            requestsAnswered += rawResults.size();
+        }
+    }
+
+    //--------------------------------------------------------------------------
+    std::chrono::nanoseconds SimRack::simulatedLatency(eTests test)
+    {
+        auto it = config.latencies.find(test);
+        if (it == config.latencies.end())
+        {
+            return std::chrono::nanoseconds{0};
+        }
+
+        const auto mean = std::chrono::nanoseconds(it->second.mean);
+        const auto jitter = std::chrono::nanoseconds(it->second.jitter);
+        std::uniform_int_distribution<int64_t> dist(
+            (mean - jitter).count(), (mean + jitter).count());
+        return std::chrono::nanoseconds(std::max<int64_t>(dist(latencyRng), 0));
+    }
+
+} // namespace DUTProxy
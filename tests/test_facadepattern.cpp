@@ -23,9 +23,24 @@
     return session.run(argc, argv);
 } */
 
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
 #include <iostream>
 #include <memory>
+#include <numeric>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+#include <sched.h>
+#include "common/tsc_clock.h"
 #include "facadepattern.h"
+#include "facadepattern_generator.h"
+#include "facadepattern_policy.h"
+#include "facadepattern_sampleblock.h"
+#include "common/seqlock.h"
+#include "common/spsc_ring.h"
 
 //-----------------------------------------------------------------------------
 // Unit Test Stub Implementations
@@ -43,9 +58,10 @@ namespace SignalDataFacade
     // Define static variables
     uint16_t ADCDrvStub::testValue = 0;
     bool ADCDrvStub::bFail = false;
+    uint32_t ADCDrvStub::startCount = 0;
 
     //-------------------------------------------------------------------------
-    ADCDrvStub::ADCDrvStub(): bStarted{false}
+    ADCDrvStub::ADCDrvStub(): bStarted{false}, scanList{0}
     {
         // No Body
     }
@@ -53,6 +69,7 @@ namespace SignalDataFacade
     //-------------------------------------------------------------------------
     void ADCDrvStub::start()
     {
+        ++startCount;
         bStarted = bStarted || !bFail;
     }
 
@@ -72,6 +89,33 @@ namespace SignalDataFacade
         return {};
     }
 
+    //-------------------------------------------------------------------------
+    bool ADCDrvStub::configureScan(std::span<const uint8_t> channels)
+    {
+        if (channels.empty())
+            return false;
+        scanList.assign(channels.begin(), channels.end());
+        return true;
+    }
+
+    //-------------------------------------------------------------------------
+    size_t ADCDrvStub::scan(std::span<uint16_t> frames)
+    {
+        // Read only if started
+        if (!bStarted || bFail)
+            return 0;
+        size_t numFrames = frames.size() / scanList.size();
+        for (size_t frame = 0; frame < numFrames; ++frame)
+        {
+            for (size_t i = 0; i < scanList.size(); ++i)
+            {
+                frames[frame * scanList.size() + i] =
+                    static_cast<uint16_t>(testValue + scanList[i]);
+            }
+        }
+        return numFrames;
+    }
+
     //-------------------------------------------------------------------------
     // GPIODrv Stub Implementation
     //-------------------------------------------------------------------------
@@ -157,6 +201,103 @@ TEST_CASE("Test A2D HAL read() fail", "[adc-hal-read-fail]")
     SignalDataFacade::ADCDrvStub::testValue = 0;
 }
 
+//-----------------------------------------------------------------------------
+// readBlock() Unit Tests
+//-----------------------------------------------------------------------------
+
+TEST_CASE("Test A2D HAL readBlock() pass", "[adc-hal-readblock-pass]")
+{
+    SignalDataFacade::ADCDrvStub::testValue = 5;
+    SignalDataFacade::ADCDrvStub::startCount = 0;
+    std::vector<uint16_t> samples(100, 0xFFFF);
+    REQUIRE(upA2dConverterHAL->readBlock(samples) == samples.size());
+    REQUIRE(samples == std::vector<uint16_t>(100, 5));
+    // The converter runs once for the whole block
+    REQUIRE(SignalDataFacade::ADCDrvStub::startCount == 1);
+    // Reset object under test
+    SignalDataFacade::ADCDrvStub::testValue = 0;
+}
+
+TEST_CASE("Test A2D HAL readBlock() fail", "[adc-hal-readblock-fail]")
+{
+    SignalDataFacade::ADCDrvStub::testValue = 9;
+    SignalDataFacade::ADCDrvStub::bFail = true;
+    std::vector<uint16_t> samples(100, 0xFFFF);
+    // Fail will result in no signal
+    REQUIRE(upA2dConverterHAL->readBlock(samples) == 0);
+    REQUIRE(samples == std::vector<uint16_t>(100, 0));
+    // Reset object under test
+    SignalDataFacade::ADCDrvStub::bFail = false;
+    SignalDataFacade::ADCDrvStub::testValue = 0;
+}
+
+//-----------------------------------------------------------------------------
+// scan() Unit Tests
+//-----------------------------------------------------------------------------
+
+TEST_CASE("Test A2D HAL scan() pass", "[adc-hal-scan-pass]")
+{
+    SignalDataFacade::ADCDrvStub::testValue = 100;
+    SignalDataFacade::ADCDrvStub::startCount = 0;
+    const std::vector<uint8_t> channels{3, 0, 7};
+    REQUIRE(upA2dConverterHAL->configureScan(channels));
+    REQUIRE(upA2dConverterHAL->scanChannels() == 3);
+
+    // The trailing partial frame is not converted, only zeroed
+    std::vector<uint16_t> frames(3 * 4 + 2, 0xFFFF);
+    REQUIRE(upA2dConverterHAL->scan(frames) == 4);
+    REQUIRE(frames == std::vector<uint16_t>{
+        103, 100, 107, 103, 100, 107, 103, 100, 107, 103, 100, 107, 0, 0});
+    REQUIRE(SignalDataFacade::ADCDrvStub::startCount == 1);
+
+    // Back to the single channel
+    const std::vector<uint8_t> singleChannel{0};
+    REQUIRE(upA2dConverterHAL->configureScan(singleChannel));
+    REQUIRE(upA2dConverterHAL->read() == 100);
+    // Reset object under test
+    SignalDataFacade::ADCDrvStub::testValue = 0;
+}
+
+TEST_CASE("Test A2D HAL scan() fail", "[adc-hal-scan-fail]")
+{
+    // A rejected list keeps the previous one
+    REQUIRE_FALSE(upA2dConverterHAL->configureScan({}));
+    REQUIRE(upA2dConverterHAL->scanChannels() == 1);
+
+    SignalDataFacade::ADCDrvStub::bFail = true;
+    std::vector<uint16_t> frames(8, 0xFFFF);
+    // Fail will result in no signal
+    REQUIRE(upA2dConverterHAL->scan(frames) == 0);
+    REQUIRE(frames == std::vector<uint16_t>(8, 0));
+    // Reset object under test
+    SignalDataFacade::ADCDrvStub::bFail = false;
+}
+
+//=============================================================================
+// ADC Driver Unit Tests
+//=============================================================================
+
+TEST_CASE("Test ADC Driver scan()", "[adc-driver-scan]")
+{
+    SignalDataFacade::ADCDrv adcDrv;
+
+    // Channels must exist on the converter
+    const std::vector<uint8_t> badChannels{
+        0, SignalDataFacade::ADCDrv::NUM_CHANNELS};
+    REQUIRE_FALSE(adcDrv.configureScan(badChannels));
+    std::vector<uint8_t> allChannels(SignalDataFacade::ADCDrv::NUM_CHANNELS);
+    std::iota(allChannels.begin(), allChannels.end(), 0);
+    REQUIRE(adcDrv.configureScan(allChannels));
+
+    // Several DMA blocks plus a partial one
+    size_t numFrames = 3 * SignalDataFacade::ADCDrv::DMA_BLOCK_FRAMES + 5;
+    std::vector<uint16_t> frames(numFrames * allChannels.size());
+    REQUIRE(adcDrv.scan(frames) == 0);
+    adcDrv.start();
+    REQUIRE(adcDrv.scan(frames) == numFrames);
+    adcDrv.stop();
+}
+
 //=============================================================================
 // GPIO HAL Unit Tests
 //=============================================================================
@@ -184,6 +325,33 @@ TEST_CASE("Test GPIO HAL read() fail", "[gpio-hal-read-fail]")
     SignalDataFacade::GPIODrvStub::testValue = 0;
 }
 
+//-----------------------------------------------------------------------------
+// readBlock() Unit Tests
+//-----------------------------------------------------------------------------
+
+TEST_CASE("Test GPIO HAL readBlock() pass", "[gpio-hal-readblock-pass]")
+{
+    SignalDataFacade::GPIODrvStub::testValue = 11;
+    std::vector<uint16_t> samples(100, 0xFFFF);
+    REQUIRE(upGpioHAL->readBlock(samples) == samples.size());
+    REQUIRE(samples == std::vector<uint16_t>(100, 11));
+    // Reset object under test
+    SignalDataFacade::GPIODrvStub::testValue = 0;
+}
+
+TEST_CASE("Test GPIO HAL readBlock() fail", "[gpio-hal-readblock-fail]")
+{
+    SignalDataFacade::GPIODrvStub::testValue = 13;
+    SignalDataFacade::GPIODrvStub::bFail = true;
+    std::vector<uint16_t> samples(100, 0xFFFF);
+    // Fail will result in no signal
+    REQUIRE(upGpioHAL->readBlock(samples) == 0);
+    REQUIRE(samples == std::vector<uint16_t>(100, 0));
+    // Reset object under test
+    SignalDataFacade::GPIODrvStub::bFail = false;
+    SignalDataFacade::GPIODrvStub::testValue = 0;
+}
+
 //=============================================================================
 // Signal Data Facade Unit Tests
 //=============================================================================
@@ -255,4 +423,1062 @@ TEST_CASE(
     // Reset object under test
     SignalDataFacade::GPIODrvStub::testValue = 0;
     SignalDataFacade::GPIODrvStub::bFail = false;
-}
\ No newline at end of file
+}
+//-----------------------------------------------------------------------------
+// acquireBatch() Unit Tests
+//-----------------------------------------------------------------------------
+
+TEST_CASE(
+    "Test Signal Data Facade acquireBatch() pass",
+    "[signaldata-facade-acquirebatch-pass]")
+{
+    SignalDataFacade::ADCDrvStub::testValue = 17;
+    SignalDataFacade::ADCDrvStub::startCount = 0;
+    SignalDataFacade::GPIODrvStub::testValue = 19;
+    std::vector<SignalDataFacade::SignalData::sAggregateData> samples(
+        64, {0, 0});
+    getSignalDataFacade().acquireBatch(samples);
+    for (const auto& sample : samples)
+    {
+        REQUIRE(sample.analog == 17);
+        REQUIRE(sample.digital == 19);
+    }
+    REQUIRE(SignalDataFacade::ADCDrvStub::startCount == 1);
+    // Reset objects under test
+    SignalDataFacade::ADCDrvStub::testValue = 0;
+    SignalDataFacade::GPIODrvStub::testValue = 0;
+}
+
+TEST_CASE(
+    "Test Signal Data Facade acquireBatch() ADC fail",
+    "[signaldata-facade-acquirebatch-adc-fail]")
+{
+    SignalDataFacade::ADCDrvStub::testValue = 23;
+    SignalDataFacade::ADCDrvStub::bFail = true;
+    SignalDataFacade::GPIODrvStub::testValue = 29;
+    std::vector<SignalDataFacade::SignalData::sAggregateData> samples(
+        64, {1, 1});
+    getSignalDataFacade().acquireBatch(samples);
+    for (const auto& sample : samples)
+    {
+        REQUIRE(sample.analog == 0);
+        REQUIRE(sample.digital == 29);
+    }
+    // Reset objects under test
+    SignalDataFacade::ADCDrvStub::bFail = false;
+    SignalDataFacade::ADCDrvStub::testValue = 0;
+    SignalDataFacade::GPIODrvStub::testValue = 0;
+}
+
+//-----------------------------------------------------------------------------
+// SampleBlock acquisition Unit Tests
+//-----------------------------------------------------------------------------
+
+TEST_CASE(
+    "Test Signal Data Facade acquire() into SampleBlock",
+    "[signaldata-facade-acquire-sampleblock]")
+{
+    SignalDataFacade::ADCDrvStub::testValue = 43;
+    SignalDataFacade::GPIODrvStub::testValue = 47;
+    SignalDataFacade::SampleBlock block;
+    getSignalDataFacade().acquire(block);
+    getSignalDataFacade().acquire(block);
+    REQUIRE(block.size() == 2);
+    REQUIRE(block[1].analog == 43);
+    REQUIRE(block[1].digital == 47);
+    // Reset objects under test
+    SignalDataFacade::ADCDrvStub::testValue = 0;
+    SignalDataFacade::GPIODrvStub::testValue = 0;
+}
+
+TEST_CASE(
+    "Test Signal Data Facade acquireBatch() into SampleBlock",
+    "[signaldata-facade-acquirebatch-sampleblock]")
+{
+    SignalDataFacade::ADCDrvStub::testValue = 53;
+    SignalDataFacade::GPIODrvStub::testValue = 59;
+    SignalDataFacade::ADCDrvStub::startCount = 0;
+    SignalDataFacade::SampleBlock block;
+    block.push_back({1, 2});
+    getSignalDataFacade().acquireBatch(block, 100);
+    // Appended after what the block already held
+    REQUIRE(block.size() == 101);
+    REQUIRE(block[0].analog == 1);
+    for (size_t i = 1; i < block.size(); ++i)
+    {
+        REQUIRE(block[i].analog == 53);
+        REQUIRE(block[i].digital == 59);
+    }
+    REQUIRE(SignalDataFacade::ADCDrvStub::startCount == 1);
+
+    // A failing GPIO zeroes its column only
+    SignalDataFacade::GPIODrvStub::bFail = true;
+    block.clear();
+    getSignalDataFacade().acquireBatch(block, 10);
+    REQUIRE(block[9].analog == 53);
+    REQUIRE(block[9].digital == 0);
+    // Reset objects under test
+    SignalDataFacade::GPIODrvStub::bFail = false;
+    SignalDataFacade::ADCDrvStub::testValue = 0;
+    SignalDataFacade::GPIODrvStub::testValue = 0;
+}
+
+//-----------------------------------------------------------------------------
+// acquireFrames() Unit Tests
+//-----------------------------------------------------------------------------
+
+TEST_CASE(
+    "Test Signal Data Facade acquireFrames()",
+    "[signaldata-facade-acquireframes]")
+{
+    SignalDataFacade::ADCDrvStub::testValue = 200;
+    SignalDataFacade::GPIODrvStub::testValue = 61;
+    SignalDataFacade::SignalData& signalData = getSignalDataFacade();
+    const std::vector<uint8_t> channels{1, 2};
+    REQUIRE(signalData.configureScan(channels));
+    REQUIRE(signalData.scanChannels() == 2);
+
+    // Limited by the digital span
+    std::vector<uint16_t> analogFrames(2 * 10);
+    std::vector<uint16_t> digital(6);
+    REQUIRE(signalData.acquireFrames(analogFrames, digital) == 6);
+    REQUIRE(analogFrames[10] == 201);
+    REQUIRE(analogFrames[11] == 202);
+    REQUIRE(digital[5] == 61);
+
+    // The single-channel path is unchanged
+    const std::vector<uint8_t> singleChannel{0};
+    REQUIRE(signalData.configureScan(singleChannel));
+    REQUIRE(signalData.acquire().analog == 200);
+    // Reset objects under test
+    SignalDataFacade::ADCDrvStub::testValue = 0;
+    SignalDataFacade::GPIODrvStub::testValue = 0;
+}
+
+//=============================================================================
+// Policy-based Signal Data Unit Tests
+//=============================================================================
+
+using StubSignalData = SignalDataFacade::BasicSignalData<
+    SignalDataFacade::AdcPolicyStub,
+    SignalDataFacade::GpioPolicyStub>;
+
+TEST_CASE(
+    "Test BasicSignalData acquire() pass and fail",
+    "[basic-signaldata-acquire]")
+{
+    StubSignalData signalData;
+    SignalDataFacade::ADCDrvStub::testValue = 67;
+    SignalDataFacade::GPIODrvStub::testValue = 71;
+    auto acquiredData = signalData.acquire();
+    REQUIRE(acquiredData.analog == 67);
+    REQUIRE(acquiredData.digital == 71);
+
+    // Fail will result in no signal, as with the runtime facade
+    SignalDataFacade::ADCDrvStub::bFail = true;
+    acquiredData = signalData.acquire();
+    REQUIRE(acquiredData.analog == 0);
+    REQUIRE(acquiredData.digital == 71);
+    SignalDataFacade::ADCDrvStub::bFail = false;
+    SignalDataFacade::GPIODrvStub::bFail = true;
+    REQUIRE(signalData.acquire().digital == 0);
+    // Reset objects under test
+    SignalDataFacade::GPIODrvStub::bFail = false;
+    SignalDataFacade::ADCDrvStub::testValue = 0;
+    SignalDataFacade::GPIODrvStub::testValue = 0;
+}
+
+TEST_CASE(
+    "Test BasicSignalData acquireBatch()",
+    "[basic-signaldata-acquirebatch]")
+{
+    // Empty policies take no space
+    STATIC_REQUIRE(sizeof(SignalDataFacade::BasicSignalData<
+        SignalDataFacade::AdcPolicyStub,
+        SignalDataFacade::GpioPolicyStub>) ==
+            sizeof(SignalDataFacade::AdcPolicyStub));
+
+    StubSignalData signalData;
+    SignalDataFacade::ADCDrvStub::testValue = 73;
+    SignalDataFacade::GPIODrvStub::testValue = 79;
+    SignalDataFacade::ADCDrvStub::startCount = 0;
+
+    std::vector<SignalDataFacade::SignalData::sAggregateData> samples(32);
+    signalData.acquireBatch(samples);
+    REQUIRE(samples[31].analog == 73);
+    REQUIRE(samples[31].digital == 79);
+
+    SignalDataFacade::SampleBlock block;
+    signalData.acquireBatch(block, 32);
+    REQUIRE(block.size() == 32);
+    REQUIRE(block[31].analog == 73);
+    REQUIRE(block[31].digital == 79);
+    REQUIRE(SignalDataFacade::ADCDrvStub::startCount == 2);
+    // Reset objects under test
+    SignalDataFacade::ADCDrvStub::testValue = 0;
+    SignalDataFacade::GPIODrvStub::testValue = 0;
+}
+
+TEST_CASE(
+    "Test SimulatedSignalData acquire()",
+    "[simulated-signaldata-acquire]")
+{
+    SignalDataFacade::SimulatedSignalData signalData;
+    SignalDataFacade::SampleBlock block;
+    signalData.acquireBatch(block, 1000);
+    // Random data, but not all zero (no signal)
+    auto analog = block.analog();
+    REQUIRE(std::any_of(
+        analog.begin(), analog.end(), [](uint16_t v) { return v != 0; }));
+}
+
+//-----------------------------------------------------------------------------
+// Streaming Unit Tests
+//-----------------------------------------------------------------------------
+
+TEST_CASE(
+    "Test Signal Data Facade streaming blocking reads",
+    "[signaldata-facade-stream-blocking]")
+{
+    using namespace std::chrono_literals;
+
+    SignalDataFacade::ADCDrvStub::testValue = 37;
+    SignalDataFacade::GPIODrvStub::testValue = 41;
+    SignalDataFacade::SignalData& signalData = getSignalDataFacade();
+    // Nothing to read before streaming
+    std::vector<SignalDataFacade::SignalData::sAggregateData> samples(1000);
+    REQUIRE(signalData.readStream(samples) == 0);
+
+    SignalDataFacade::ADCDrvStub::startCount = 0;
+    signalData.startStreaming();
+    REQUIRE(signalData.isStreaming());
+    size_t numRead = 0;
+    while (numRead < 10 * samples.size())
+    {
+        size_t count = signalData.readStream(samples, 1s);
+        REQUIRE(count > 0);
+        for (size_t i = 0; i < count; ++i)
+        {
+            REQUIRE(samples[i].analog == 37);
+            REQUIRE(samples[i].digital == 41);
+        }
+        numRead += count;
+    }
+    signalData.stopStreaming();
+    REQUIRE_FALSE(signalData.isStreaming());
+    // The ADC stays started for the whole stream
+    REQUIRE(SignalDataFacade::ADCDrvStub::startCount == 1);
+
+    // Once stopped, blocking reads drain the ring then return immediately
+    while (signalData.readStream(samples, 1s) > 0)
+    {
+    }
+    auto start = std::chrono::steady_clock::now();
+    REQUIRE(signalData.readStream(samples, 1s) == 0);
+    REQUIRE(std::chrono::steady_clock::now() - start < 1s);
+    // Reset objects under test
+    SignalDataFacade::ADCDrvStub::testValue = 0;
+    SignalDataFacade::GPIODrvStub::testValue = 0;
+}
+
+TEST_CASE(
+    "Test Signal Data Facade streaming overruns",
+    "[signaldata-facade-stream-overruns]")
+{
+    using namespace std::chrono_literals;
+
+    constexpr size_t RING_CAPACITY = 1024;
+    SignalDataFacade::SignalData& signalData = getSignalDataFacade();
+    signalData.startStreaming(RING_CAPACITY);
+    // Without a consumer the ring fills up and further samples are dropped
+    while (signalData.streamOverruns() == 0)
+    {
+        std::this_thread::sleep_for(1ms);
+    }
+    std::this_thread::sleep_for(50ms);
+
+    // Blocks lost whole leave no marks, so the first sample pushed once
+    // the ring drains is timestamped when it was acquired, not when the
+    // ring filled
+    std::vector<SignalDataFacade::SignalData::sAggregateData> samples(
+        2 * RING_CAPACITY);
+    uint64_t drainedNs = Metrics::TscClock::nowNs();
+    REQUIRE(signalData.readStream(std::span(samples).first(RING_CAPACITY)) ==
+        RING_CAPACITY);
+    uint64_t firstTimestampNs = 0;
+    REQUIRE(signalData.readStream(
+        std::span(samples).first(1), 1s, firstTimestampNs) == 1);
+    REQUIRE(firstTimestampNs + 10'000'000 > drainedNs);
+    signalData.stopStreaming();
+
+    while (signalData.readStream(samples) > 0)
+    {
+    }
+    REQUIRE(signalData.streamOverruns() > 0);
+
+    // A restart begins with a fresh ring and count
+    signalData.startStreaming(RING_CAPACITY);
+    REQUIRE(signalData.readStream(samples, 1s) > 0);
+    signalData.stopStreaming();
+}
+
+//-----------------------------------------------------------------------------
+// Independent Engine Unit Tests
+//-----------------------------------------------------------------------------
+
+TEST_CASE(
+    "Test independent Signal Data engines",
+    "[signaldata-engines]")
+{
+    using namespace std::chrono_literals;
+
+    // Each engine's ADC holds its own constant level, its GPIO has no lines
+    auto makeEngine = [](uint16_t level)
+    {
+        SignalDataFacade::sWaveformConfig_t config;
+        config.waveform = SignalDataFacade::eWaveform::STEPS;
+        config.numLevels = 1;
+        config.center = level;
+        SignalDataFacade::sGpioGeneratorConfig_t gpioConfig;
+        gpioConfig.lines.clear();
+        return std::make_unique<SignalDataFacade::SignalData>(
+            std::make_unique<SignalDataFacade::A2DConverterHAL>(
+                std::make_unique<SignalDataFacade::SyntheticADCDrv>(config)),
+            std::make_unique<SignalDataFacade::GPIOHAL>(
+                std::make_unique<SignalDataFacade::SyntheticGPIODrv>(
+                    gpioConfig)));
+    };
+    auto upFirst = makeEngine(100);
+    auto upSecond = makeEngine(200);
+    REQUIRE(upFirst.get() != &getSignalDataFacade());
+    REQUIRE(upFirst->acquire().analog == 100);
+    REQUIRE(upSecond->acquire().analog == 200);
+
+    // Both stream at once, each from its own drivers into its own ring
+    upFirst->startStreaming();
+    upSecond->startStreaming();
+    std::vector<SignalDataFacade::SignalData::sAggregateData> samples(1000);
+    for (auto [pEngine, level] :
+        {std::pair{upFirst.get(), 100}, std::pair{upSecond.get(), 200}})
+    {
+        size_t numRead = pEngine->readStream(samples, 1s);
+        REQUIRE(numRead > 0);
+        for (size_t i = 0; i < numRead; ++i)
+        {
+            REQUIRE(samples[i].analog == level);
+            REQUIRE(samples[i].digital == 0);
+        }
+    }
+    upFirst->stopStreaming();
+    REQUIRE(upSecond->isStreaming());
+    upSecond->stopStreaming();
+}
+
+TEST_CASE(
+    "Test Signal Data engine CPU affinity",
+    "[signaldata-engine-affinity]")
+{
+    using namespace std::chrono_literals;
+
+    // Default simulated drivers
+    SignalDataFacade::SignalData engine;
+    int currentCpu = sched_getcpu();
+    REQUIRE(currentCpu >= 0);
+
+    engine.startStreaming(1024, unsigned(currentCpu));
+    REQUIRE(engine.isStreaming());
+    std::vector<SignalDataFacade::SignalData::sAggregateData> samples(256);
+    REQUIRE(engine.readStream(samples, 1s) > 0);
+    engine.stopStreaming();
+
+    // A CPU that cannot exist leaves streaming stopped
+    REQUIRE_THROWS_AS(
+        engine.startStreaming(1024, 1u << 20), std::invalid_argument);
+    REQUIRE_FALSE(engine.isStreaming());
+}
+
+//-----------------------------------------------------------------------------
+// Timing Instrumentation Unit Tests
+//-----------------------------------------------------------------------------
+
+TEST_CASE("Test TscClock tracks steady_clock", "[tsc-clock]")
+{
+    using namespace std::chrono_literals;
+    auto steadyNs = []()
+    {
+        return uint64_t(
+            std::chrono::duration_cast<std::chrono::nanoseconds>(
+                std::chrono::steady_clock::now().time_since_epoch())
+                .count());
+    };
+
+    uint64_t startNs = Metrics::TscClock::nowNs();
+    std::this_thread::sleep_for(20ms);
+    uint64_t endNs = Metrics::TscClock::nowNs();
+    uint64_t steadyEndNs = steadyNs();
+    REQUIRE(endNs - startNs >= 19'000'000);
+    // Same epoch and rate, within calibration error
+    REQUIRE(std::max(endNs, steadyEndNs) - std::min(endNs, steadyEndNs) <
+        1'000'000);
+
+    uint64_t previousNs = Metrics::TscClock::nowNs();
+    for (int i = 0; i < 10000; ++i)
+    {
+        uint64_t nowNs = Metrics::TscClock::nowNs();
+        REQUIRE(nowNs >= previousNs);
+        previousNs = nowNs;
+    }
+}
+
+TEST_CASE(
+    "Test Signal Data engine timing instrumentation",
+    "[signaldata-timing]")
+{
+    SignalDataFacade::SignalData engine;
+    std::vector<SignalDataFacade::SignalData::sAggregateData> samples(100);
+    uint64_t previousNs = 0;
+    for (int i = 0; i < 10; ++i)
+    {
+        uint64_t timestampNs = engine.acquireBatch(samples);
+        REQUIRE(timestampNs > previousNs);
+        previousNs = timestampNs;
+    }
+    REQUIRE(previousNs <= Metrics::TscClock::nowNs());
+
+    auto timing = engine.timingSnapshot();
+    REQUIRE(timing.numBlocks == 10);
+    REQUIRE(timing.numSamples == 1000);
+    REQUIRE(timing.readTime.count() == 10);
+    // Intervals are between blocks
+    REQUIRE(timing.blockInterval.count() == 9);
+    REQUIRE(timing.sampleInterval.count() == 9);
+    REQUIRE(timing.sampleInterval.max() <= timing.blockInterval.max());
+
+    std::string report = engine.timingReport();
+    REQUIRE(report.find("10 blocks, 1000 samples") != std::string::npos);
+    REQUIRE(report.find("driver read") != std::string::npos);
+
+    engine.resetTiming();
+    REQUIRE(engine.timingSnapshot().numBlocks == 0);
+}
+
+TEST_CASE(
+    "Test Signal Data streaming timestamps",
+    "[signaldata-stream-timestamps]")
+{
+    using namespace std::chrono_literals;
+
+    SignalDataFacade::SignalData engine;
+    uint64_t startNs = Metrics::TscClock::nowNs();
+    engine.startStreaming();
+    std::vector<SignalDataFacade::SignalData::sAggregateData> samples(1000);
+    uint64_t previousNs = 0;
+    size_t numRead = 0;
+    while (numRead < 20 * samples.size())
+    {
+        uint64_t timestampNs = 0;
+        size_t count = engine.readStream(samples, 1s, timestampNs);
+        REQUIRE(count > 0);
+        REQUIRE(timestampNs >= startNs);
+        REQUIRE(timestampNs >= previousNs);
+        REQUIRE(timestampNs <= Metrics::TscClock::nowNs());
+        previousNs = timestampNs;
+        numRead += count;
+    }
+    engine.stopStreaming();
+
+    auto timing = engine.timingSnapshot();
+    REQUIRE(timing.numSamples >= numRead);
+    REQUIRE(timing.blockInterval.count() + 1 == timing.numBlocks);
+}
+
+//-----------------------------------------------------------------------------
+// Latest Value Unit Tests
+//-----------------------------------------------------------------------------
+
+TEST_CASE(
+    "Test Signal Data latest value from acquisitions",
+    "[signaldata-latest]")
+{
+    SignalDataFacade::sWaveformConfig_t config;
+    config.waveform = SignalDataFacade::eWaveform::STEPS;
+    config.numLevels = 1;
+    config.center = 1234;
+    SignalDataFacade::SignalData engine{
+        std::make_unique<SignalDataFacade::A2DConverterHAL>(
+            std::make_unique<SignalDataFacade::SyntheticADCDrv>(config)),
+        std::make_unique<SignalDataFacade::GPIOHAL>(
+            std::make_unique<SignalDataFacade::SyntheticGPIODrv>(
+                SignalDataFacade::sGpioGeneratorConfig_t{}))};
+
+    // Nothing to report before the first acquisition
+    REQUIRE_FALSE(engine.latest());
+    REQUIRE(engine.latestVersion() == 0);
+
+    uint64_t startNs = Metrics::TscClock::nowNs();
+    auto sample = engine.acquire();
+    auto latest = engine.latest();
+    REQUIRE(latest);
+    REQUIRE(latest->sample.analog == 1234);
+    REQUIRE(latest->sample.digital == sample.digital);
+    REQUIRE(latest->numAcquired == 1);
+    REQUIRE(latest->timestampNs >= startNs);
+    REQUIRE(latest->timestampNs <= Metrics::TscClock::nowNs());
+
+    // A batch publishes its last sample, once
+    std::vector<SignalDataFacade::SignalData::sAggregateData> samples(100);
+    engine.acquireBatch(samples);
+    latest = engine.latest();
+    REQUIRE(latest->sample.digital == samples.back().digital);
+    REQUIRE(latest->numAcquired == 101);
+    REQUIRE(engine.latestVersion() == 2);
+
+    SignalDataFacade::SampleBlock block{16};
+    engine.acquireBatch(block, 16);
+    REQUIRE(engine.latest()->numAcquired == 117);
+    REQUIRE(engine.latest()->sample.digital == block[15].digital);
+    REQUIRE(engine.latestVersion() == 3);
+}
+
+TEST_CASE(
+    "Test Signal Data latest value with many readers while streaming",
+    "[signaldata-latest-readers]")
+{
+    using namespace std::chrono_literals;
+    constexpr size_t NUM_READERS = 8;
+    constexpr uint64_t STREAM_BLOCK_SIZE =
+        SignalDataFacade::SignalData::STREAM_BLOCK_SIZE;
+
+    SignalDataFacade::sWaveformConfig_t config;
+    config.waveform = SignalDataFacade::eWaveform::STEPS;
+    config.numLevels = 1;
+    config.center = 4321;
+    SignalDataFacade::sGpioGeneratorConfig_t gpioConfig;
+    gpioConfig.lines.clear();
+    SignalDataFacade::SignalData engine{
+        std::make_unique<SignalDataFacade::A2DConverterHAL>(
+            std::make_unique<SignalDataFacade::SyntheticADCDrv>(config)),
+        std::make_unique<SignalDataFacade::GPIOHAL>(
+            std::make_unique<SignalDataFacade::SyntheticGPIODrv>(
+                gpioConfig))};
+
+    // The streaming consumer must see every sample despite the readers
+    engine.startStreaming();
+    std::atomic<bool> bReading{true};
+    std::vector<uint64_t> numSnapshots(NUM_READERS, 0);
+    std::vector<bool> bConsistent(NUM_READERS, true);
+    std::vector<std::thread> readers;
+    for (size_t i = 0; i < NUM_READERS; ++i)
+    {
+        readers.emplace_back([&, i]()
+        {
+            uint64_t previousAcquired = 0;
+            uint64_t previousNs = 0;
+            bool bOk = true;
+            while (bReading.load(std::memory_order_relaxed))
+            {
+                auto latest = engine.latest();
+                if (!latest)
+                {
+                    continue;
+                }
+                // Whole blocks only, never going back in time
+                bOk = bOk &&
+                    latest->sample.analog == 4321 &&
+                    latest->sample.digital == 0 &&
+                    latest->numAcquired % STREAM_BLOCK_SIZE == 0 &&
+                    latest->numAcquired >= previousAcquired &&
+                    latest->timestampNs >= previousNs;
+                previousAcquired = latest->numAcquired;
+                previousNs = latest->timestampNs;
+                ++numSnapshots[i];
+            }
+            bConsistent[i] = bOk;
+        });
+    }
+
+    std::vector<SignalDataFacade::SignalData::sAggregateData> samples(4096);
+    size_t numRead = 0;
+    auto start = std::chrono::steady_clock::now();
+    while (std::chrono::steady_clock::now() - start < 200ms)
+    {
+        size_t count = engine.readStream(samples, 1s);
+        REQUIRE(count > 0);
+        numRead += count;
+    }
+    bReading = false;
+    for (auto& reader : readers)
+    {
+        reader.join();
+    }
+    engine.stopStreaming();
+
+    for (size_t i = 0; i < NUM_READERS; ++i)
+    {
+        REQUIRE(bConsistent[i]);
+        REQUIRE(numSnapshots[i] > 0);
+    }
+    // Every block was published, overruns included
+    auto latest = engine.latest();
+    REQUIRE(latest);
+    REQUIRE(latest->numAcquired >= numRead);
+    REQUIRE(latest->numAcquired ==
+        engine.latestVersion() * STREAM_BLOCK_SIZE);
+}
+
+//=============================================================================
+// SPSC Ring Unit Tests
+//=============================================================================
+
+TEST_CASE("Test SpscRing batches and wrap around", "[spsc-ring-batches]")
+{
+    Concurrency::SpscRing<uint32_t> ring{6};
+    // Rounded up to a power of two
+    REQUIRE(ring.capacity() == 8);
+
+    std::vector<uint32_t> input(8);
+    std::iota(input.begin(), input.end(), 0);
+    std::vector<uint32_t> output(8, 0);
+
+    // Pushes stop when full, pops when empty
+    REQUIRE(ring.push(std::span(input).first(5)) == 5);
+    REQUIRE(ring.pop(std::span(output).first(3)) == 3);
+    REQUIRE(ring.freeSpace() == 6);
+    REQUIRE(ring.push(input) == 6);
+    REQUIRE(ring.size() == 8);
+    REQUIRE(ring.freeSpace() == 0);
+    REQUIRE(ring.push(input) == 0);
+    REQUIRE(ring.pop(output) == 8);
+    REQUIRE(output == std::vector<uint32_t>{3, 4, 0, 1, 2, 3, 4, 5});
+    REQUIRE(ring.pop(output) == 0);
+}
+
+TEST_CASE("Test SpscRing blocking pops", "[spsc-ring-blocking]")
+{
+    using namespace std::chrono_literals;
+
+    Concurrency::SpscRing<uint32_t> ring{16};
+    std::vector<uint32_t> output(16, 0);
+
+    // Times out when nothing arrives
+    auto start = std::chrono::steady_clock::now();
+    REQUIRE(ring.popWait(output, 20ms) == 0);
+    REQUIRE(std::chrono::steady_clock::now() - start >= 20ms);
+
+    // Wakes as soon as the producer pushes
+    std::thread producer([&ring]()
+    {
+        std::this_thread::sleep_for(10ms);
+        uint32_t value = 99;
+        ring.push(std::span(&value, 1));
+    });
+    REQUIRE(ring.popWait(output, 10s) == 1);
+    REQUIRE(output[0] == 99);
+    producer.join();
+
+    // Wakes for good once closed
+    std::thread closer([&ring]()
+    {
+        std::this_thread::sleep_for(10ms);
+        ring.close();
+    });
+    start = std::chrono::steady_clock::now();
+    REQUIRE(ring.popWait(output, 10s) == 0);
+    REQUIRE(std::chrono::steady_clock::now() - start < 10s);
+    closer.join();
+    REQUIRE(ring.closed());
+}
+
+TEST_CASE("Test SpscRing keeps order across threads", "[spsc-ring-order]")
+{
+    using namespace std::chrono_literals;
+
+    constexpr uint32_t NUM_ELEMENTS = 1000000;
+    Concurrency::SpscRing<uint32_t> ring{1024};
+
+    std::thread producer([&ring]()
+    {
+        std::vector<uint32_t> batch(100);
+        uint32_t next = 0;
+        while (next < NUM_ELEMENTS)
+        {
+            std::iota(batch.begin(), batch.end(), next);
+            size_t count = std::min<size_t>(batch.size(), NUM_ELEMENTS - next);
+            next += static_cast<uint32_t>(
+                ring.push(std::span(batch).first(count)));
+        }
+        ring.close();
+    });
+
+    std::vector<uint32_t> batch(77);
+    uint32_t expected = 0;
+    bool bInOrder = true;
+    size_t count;
+    while ((count = ring.popWait(batch, 10s)) > 0)
+    {
+        for (size_t i = 0; i < count; ++i)
+        {
+            bInOrder = bInOrder && batch[i] == expected++;
+        }
+    }
+    producer.join();
+
+    REQUIRE(bInOrder);
+    REQUIRE(expected == NUM_ELEMENTS);
+}
+
+//=============================================================================
+// SeqLock Unit Tests
+//=============================================================================
+
+TEST_CASE("Test SeqLock publish and load", "[seqlock-basic]")
+{
+    struct sValue
+    {
+        uint32_t a;
+        uint16_t b;
+    };
+    Concurrency::SeqLock<sValue> cell;
+    REQUIRE(cell.version() == 0);
+    REQUIRE(cell.load().a == 0);
+    REQUIRE(cell.load().b == 0);
+
+    cell.publish({7, 8});
+    cell.publish({9, 10});
+    REQUIRE(cell.version() == 2);
+    sValue value{};
+    REQUIRE(cell.tryLoad(value));
+    REQUIRE(value.a == 9);
+    REQUIRE(value.b == 10);
+}
+
+TEST_CASE(
+    "Test SeqLock snapshots are never torn under many readers",
+    "[seqlock-stress]")
+{
+    constexpr size_t NUM_READERS = 8;
+    constexpr uint64_t NUM_PUBLISHES = 1000000;
+
+    // Spans several words, every one derived from the same counter, so a
+    // snapshot mixing two publishes shows
+    struct sValue
+    {
+        std::array<uint64_t, 8> words;
+    };
+    Concurrency::SeqLock<sValue> cell;
+
+    std::atomic<bool> bPublishing{true};
+    std::vector<uint64_t> numLoads(NUM_READERS, 0);
+    std::vector<bool> bConsistent(NUM_READERS, true);
+    std::vector<std::thread> readers;
+    for (size_t i = 0; i < NUM_READERS; ++i)
+    {
+        readers.emplace_back([&, i]()
+        {
+            uint64_t previous = 0;
+            bool bOk = true;
+            bool bLast = false;
+            while (!bLast)
+            {
+                // Once the writer is done, one more load sees its last value
+                bLast = !bPublishing.load(std::memory_order_acquire);
+                sValue value = cell.load();
+                for (size_t w = 0; w < value.words.size(); ++w)
+                {
+                    bOk = bOk && value.words[w] == value.words[0] * (w + 1);
+                }
+                bOk = bOk && value.words[0] >= previous;
+                previous = value.words[0];
+                ++numLoads[i];
+            }
+            bConsistent[i] = bOk && previous == NUM_PUBLISHES;
+        });
+    }
+
+    sValue value;
+    for (uint64_t n = 1; n <= NUM_PUBLISHES; ++n)
+    {
+        for (size_t w = 0; w < value.words.size(); ++w)
+        {
+            value.words[w] = n * (w + 1);
+        }
+        cell.publish(value);
+    }
+    bPublishing.store(false, std::memory_order_release);
+    for (auto& reader : readers)
+    {
+        reader.join();
+    }
+
+    REQUIRE(cell.version() == NUM_PUBLISHES);
+    for (size_t i = 0; i < NUM_READERS; ++i)
+    {
+        REQUIRE(bConsistent[i]);
+        REQUIRE(numLoads[i] > 0);
+    }
+}
+
+//-----------------------------------------------------------------------------
+// Benchmarks (hidden, run with: ./test_facadepattern "[benchmark]")
+//-----------------------------------------------------------------------------
+
+TEST_CASE(
+    "Benchmark Signal Data Facade acquire() vs acquireBatch()",
+    "[.][benchmark][signaldata-facade-acquire-benchmark]")
+{
+    constexpr size_t NUM_SAMPLES = 1 << 22;
+    constexpr size_t BATCH_SIZE = 4096;
+    using Clock = std::chrono::steady_clock;
+
+    SignalDataFacade::SignalData& signalData = getSignalDataFacade();
+    std::vector<SignalDataFacade::SignalData::sAggregateData> samples(
+        NUM_SAMPLES, {0, 0});
+
+    auto start = Clock::now();
+    for (auto& sample : samples)
+    {
+        sample = signalData.acquire();
+    }
+    std::chrono::duration<double> perSample = Clock::now() - start;
+
+    start = Clock::now();
+    for (size_t i = 0; i < NUM_SAMPLES; i += BATCH_SIZE)
+    {
+        signalData.acquireBatch(
+            std::span(samples).subspan(i, BATCH_SIZE));
+    }
+    std::chrono::duration<double> batched = Clock::now() - start;
+
+    SignalDataFacade::SampleBlock block{BATCH_SIZE};
+    start = Clock::now();
+    for (size_t i = 0; i < NUM_SAMPLES; i += BATCH_SIZE)
+    {
+        block.clear();
+        signalData.acquireBatch(block, BATCH_SIZE);
+    }
+    std::chrono::duration<double> columns = Clock::now() - start;
+
+    std::cout << "acquire():      "
+              << double(NUM_SAMPLES) / perSample.count()
+              << " samples/s"
+              << std::endl;
+    std::cout << "acquireBatch(): "
+              << double(NUM_SAMPLES) / batched.count()
+              << " samples/s ("
+              << BATCH_SIZE
+              << " per batch)"
+              << std::endl;
+    std::cout << "acquireBatch(SampleBlock&): "
+              << double(NUM_SAMPLES) / columns.count()
+              << " samples/s"
+              << std::endl;
+}
+
+TEST_CASE(
+    "Benchmark Signal Data Facade streaming",
+    "[.][benchmark][signaldata-facade-stream-benchmark]")
+{
+    using namespace std::chrono_literals;
+    constexpr size_t NUM_SAMPLES = 1 << 24;
+
+    SignalDataFacade::SignalData& signalData = getSignalDataFacade();
+    std::vector<SignalDataFacade::SignalData::sAggregateData> samples(4096);
+
+    auto start = std::chrono::steady_clock::now();
+    signalData.startStreaming();
+    size_t numRead = 0;
+    while (numRead < NUM_SAMPLES)
+    {
+        numRead += signalData.readStream(samples, 1s);
+    }
+    signalData.stopStreaming();
+    std::chrono::duration<double> elapsed =
+        std::chrono::steady_clock::now() - start;
+
+    std::cout << "Streaming: "
+              << double(numRead) / elapsed.count()
+              << " samples/s read, "
+              << signalData.streamOverruns()
+              << " overruns"
+              << std::endl;
+}
+
+TEST_CASE(
+    "Benchmark SignalData vs BasicSignalData per-sample cost",
+    "[.][benchmark][basic-signaldata-benchmark]")
+{
+    constexpr size_t NUM_SAMPLES = 1 << 22;
+    using Clock = std::chrono::steady_clock;
+
+    SignalDataFacade::SignalData& runtimeSignalData = getSignalDataFacade();
+    StubSignalData staticSignalData;
+    std::vector<SignalDataFacade::SignalData::sAggregateData> samples(
+        NUM_SAMPLES);
+
+    // Same stub behaviour, so only the dispatch differs
+    auto start = Clock::now();
+    for (auto& sample : samples)
+    {
+        sample = runtimeSignalData.acquire();
+    }
+    std::chrono::duration<double, std::nano> runtimeTime =
+        Clock::now() - start;
+
+    start = Clock::now();
+    for (auto& sample : samples)
+    {
+        sample = staticSignalData.acquire();
+    }
+    std::chrono::duration<double, std::nano> staticTime = Clock::now() - start;
+
+    std::cout << "SignalData::acquire():      "
+              << runtimeTime.count() / NUM_SAMPLES
+              << " ns/sample"
+              << std::endl;
+    std::cout << "BasicSignalData::acquire(): "
+              << staticTime.count() / NUM_SAMPLES
+              << " ns/sample"
+              << std::endl;
+}
+
+TEST_CASE(
+    "Benchmark Signal Data engine scaling",
+    "[.][benchmark][signaldata-engine-scaling-benchmark]")
+{
+    using namespace std::chrono_literals;
+    constexpr auto RUN_TIME = 500ms;
+
+    // Engines are pinned to the CPUs this process may run on, and their
+    // consumers float, so use up to half of them
+    cpu_set_t allowed;
+    REQUIRE(sched_getaffinity(0, sizeof(allowed), &allowed) == 0);
+    std::vector<unsigned> cpus;
+    for (unsigned cpu = 0; cpu < CPU_SETSIZE; ++cpu)
+    {
+        if (CPU_ISSET(cpu, &allowed))
+        {
+            cpus.push_back(cpu);
+        }
+    }
+
+    for (size_t numEngines = 1;
+         numEngines == 1 || 2 * numEngines <= cpus.size();
+         numEngines *= 2)
+    {
+        std::vector<std::unique_ptr<SignalDataFacade::SignalData>> engines;
+        for (size_t i = 0; i < numEngines; ++i)
+        {
+            engines.push_back(std::make_unique<SignalDataFacade::SignalData>());
+        }
+
+        // One cache line per consumer, so counting does not false share
+        struct alignas(Concurrency::CACHE_LINE_BYTES) sConsumerCount
+        {
+            uint64_t numRead{0};
+        };
+        std::atomic<bool> bRunning{true};
+        std::vector<sConsumerCount> counts(numEngines);
+        std::vector<std::thread> consumers;
+        auto start = std::chrono::steady_clock::now();
+        for (size_t i = 0; i < numEngines; ++i)
+        {
+            engines[i]->startStreaming(
+                SignalDataFacade::SignalData::DEFAULT_STREAM_CAPACITY,
+                cpus[i]);
+            consumers.emplace_back([&, i]()
+            {
+                std::vector<SignalDataFacade::SignalData::sAggregateData>
+                    samples(4096);
+                while (bRunning.load(std::memory_order_relaxed))
+                {
+                    counts[i].numRead +=
+                        engines[i]->readStream(samples, 10ms);
+                }
+            });
+        }
+        std::this_thread::sleep_for(RUN_TIME);
+        bRunning = false;
+        // Stopping is not timed, so count the overruns up to here
+        std::chrono::duration<double> elapsed =
+            std::chrono::steady_clock::now() - start;
+        uint64_t numAcquired = 0;
+        for (const auto& upEngine : engines)
+        {
+            numAcquired += upEngine->streamOverruns();
+        }
+        for (auto& consumer : consumers)
+        {
+            consumer.join();
+        }
+        uint64_t numDelivered = 0;
+        for (size_t i = 0; i < numEngines; ++i)
+        {
+            engines[i]->stopStreaming();
+            numDelivered += counts[i].numRead;
+        }
+        numAcquired += numDelivered;
+
+        std::cout << numEngines
+                  << " engine(s): "
+                  << double(numAcquired) / elapsed.count()
+                  << " samples/s acquired, "
+                  << double(numDelivered) / elapsed.count()
+                  << " samples/s delivered"
+                  << std::endl;
+    }
+}
+
+TEST_CASE(
+    "Benchmark Signal Data latest() vs acquire()",
+    "[.][benchmark][signaldata-latest-benchmark]")
+{
+    using namespace std::chrono_literals;
+    constexpr size_t NUM_READS = 1 << 22;
+    using Clock = std::chrono::steady_clock;
+
+    // Default simulated drivers, streaming so latest() races the publisher
+    SignalDataFacade::SignalData engine;
+    auto start = Clock::now();
+    uint64_t checksum = 0;
+    for (size_t i = 0; i < NUM_READS; ++i)
+    {
+        checksum += engine.acquire().analog;
+    }
+    std::chrono::duration<double, std::nano> acquireTime =
+        Clock::now() - start;
+
+    engine.startStreaming();
+    std::atomic<bool> bConsuming{true};
+    std::thread consumer([&]()
+    {
+        std::vector<SignalDataFacade::SignalData::sAggregateData> samples(
+            4096);
+        while (bConsuming)
+        {
+            engine.readStream(samples, 10ms);
+        }
+    });
+    start = Clock::now();
+    for (size_t i = 0; i < NUM_READS; ++i)
+    {
+        checksum += engine.latest()->sample.analog;
+    }
+    std::chrono::duration<double, std::nano> latestTime =
+        Clock::now() - start;
+    bConsuming = false;
+    consumer.join();
+    engine.stopStreaming();
+
+    std::cout << "acquire(): "
+              << acquireTime.count() / NUM_READS
+              << " ns/read"
+              << std::endl;
+    std::cout << "latest():  "
+              << latestTime.count() / NUM_READS
+              << " ns/read while streaming ("
+              << engine.latestVersion()
+              << " publishes, checksum "
+              << checksum
+              << ")"
+              << std::endl;
+}
@@ -0,0 +1,306 @@
+// Copyright (c) 2025 Michael Dello
+//
+// This software is provided under the MIT License.
+// See LICENSE file for details.
+
+//-----------------------------------------------------------------------------
+// GPIO Bit-plane Storage Unit Tests
+//-----------------------------------------------------------------------------
+#define CATCH_CONFIG_MAIN
+// Include EVERYTHING from Catch2 (version 3)
+// This avoids the need to create a main() for unit testing
+#include <catch2/catch_all.hpp>
+// Alternatively, only include what is needed
+// #include <catch2/catch_test_macros.hpp> // Basic test macros
+// #include <catch2/catch_approx.hpp>  // Approximate floating-point comparisons
+// #include <catch2/catch_reporter_console.hpp> // Console reporting
+// #define CATCH_CONFIG_MAIN // Generates Catch2's main function
+// #include <catch2/catch_test_macros.hpp>
+
+// Create a custom main() instead:
+/* int main(int argc, char* argv[]) {
+    Catch::Session session; // Create Catch2 session
+    return session.run(argc, argv);
+} */
+
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+#include <random>
+#include <vector>
+#include "facadepattern_bitplane.h"
+
+//-----------------------------------------------------------------------------
+// Test Helpers
+//-----------------------------------------------------------------------------
+
+namespace
+{
+    constexpr SignalDataFacade::eSimdLevel ALL_LEVELS[] =
+    {
+        SignalDataFacade::eSimdLevel::SCALAR,
+        SignalDataFacade::eSimdLevel::SSE4,
+        SignalDataFacade::eSimdLevel::AVX2
+    };
+
+    //-------------------------------------------------------------------------
+    // Lines that hold for a random number of samples, like real GPIO
+    std::vector<uint16_t> randomWords(size_t count, uint32_t seed)
+    {
+        std::mt19937 rng(seed);
+        std::uniform_int_distribution<uint16_t> dist(0, 65535);
+        std::geometric_distribution<size_t> hold(0.05);
+        std::vector<uint16_t> words(count);
+        uint16_t word = dist(rng);
+        for (size_t i = 0; i < count;)
+        {
+            for (size_t n = hold(rng) + 1; n > 0 && i < count; --n)
+            {
+                words[i++] = word;
+            }
+            word ^= uint16_t(1u << (dist(rng) % 16));
+        }
+        return words;
+    }
+
+    //-------------------------------------------------------------------------
+    bool lineLevel(const std::vector<uint16_t>& words, size_t i, size_t line)
+    {
+        return (words[i] >> line) & 1;
+    }
+
+    //-------------------------------------------------------------------------
+    // Reference edge count over samples [first, first + count)
+    uint64_t referenceEdges(
+        const std::vector<uint16_t>& words,
+        size_t line,
+        SignalDataFacade::eEdge edge,
+        size_t first,
+        size_t count)
+    {
+        uint64_t edges = 0;
+        for (size_t i = first + 1; i < first + count; ++i)
+        {
+            bool bPrevious = lineLevel(words, i - 1, line);
+            bool bCurrent = lineLevel(words, i, line);
+            switch (edge)
+            {
+                case SignalDataFacade::eEdge::RISING:
+                    edges += !bPrevious && bCurrent;
+                    break;
+                case SignalDataFacade::eEdge::FALLING:
+                    edges += bPrevious && !bCurrent;
+                    break;
+                case SignalDataFacade::eEdge::ANY:
+                    edges += bPrevious != bCurrent;
+                    break;
+            }
+        }
+        return edges;
+    }
+
+} // namespace anonymous
+
+//=============================================================================
+// GpioBitPlanes Unit Tests
+//=============================================================================
+
+TEST_CASE("Test bit planes round trip", "[bitplane-round-trip]")
+{
+    auto words = randomWords(1003, 3);
+    for (auto level : ALL_LEVELS)
+    {
+        INFO("Kernel " << SignalDataFacade::toString(level));
+        SignalDataFacade::GpioBitPlanes planes(0xA5F0, level);
+        // Uneven appends cross word boundaries from every offset
+        size_t done = 0;
+        for (size_t chunk = 1; done < words.size(); chunk = chunk * 3 + 1)
+        {
+            size_t count = std::min(chunk, words.size() - done);
+            planes.append({words.data() + done, count});
+            done += count;
+        }
+        REQUIRE(planes.size() == words.size());
+        REQUIRE(planes.plane(4).size() == (words.size() + 63) / 64);
+        REQUIRE(planes.plane(4).back() >> (words.size() % 64) == 0);
+
+        std::vector<uint16_t> unpacked(words.size() - 10);
+        planes.unpack(10, unpacked);
+        for (size_t i = 0; i < unpacked.size(); ++i)
+        {
+            REQUIRE(unpacked[i] == (words[i + 10] & 0xA5F0));
+        }
+        REQUIRE(planes.bit(5, 77) == lineLevel(words, 77, 5));
+    }
+}
+
+TEST_CASE("Test bit planes bounds", "[bitplane-bounds]")
+{
+    SignalDataFacade::GpioBitPlanes planes(0x0001);
+    std::vector<uint16_t> words(10, 1);
+    planes.append(words);
+
+    std::vector<uint16_t> unpacked(5);
+    REQUIRE_THROWS_AS(planes.plane(1), std::out_of_range);
+    REQUIRE_THROWS_AS(planes.plane(16), std::out_of_range);
+    REQUIRE_THROWS_AS(planes.bit(0, 10), std::out_of_range);
+    REQUIRE_THROWS_AS(planes.unpack(6, unpacked), std::out_of_range);
+    REQUIRE_THROWS_AS(planes.countHigh(0, 11), std::out_of_range);
+    REQUIRE(planes.countHigh(0, 8) == 2);
+    REQUIRE(planes.countHigh(0, 10) == 0);
+    REQUIRE(planes.dutyCycle(0, 10) == 0.0);
+
+    planes.clear();
+    REQUIRE(planes.size() == 0);
+    REQUIRE(planes.plane(0).empty());
+    REQUIRE(planes.encodeRuns(0).lengths.empty());
+}
+
+TEST_CASE("Test bit planes known edges", "[bitplane-known-edges]")
+{
+    using SignalDataFacade::eEdge;
+    // Line 0: 0 0 1 1 1 0 1 0, line 1 always high
+    std::vector<uint16_t> words{2, 2, 3, 3, 3, 2, 3, 2};
+    SignalDataFacade::GpioBitPlanes planes(0x0003);
+    planes.append(words);
+
+    REQUIRE(planes.edges(0, eEdge::RISING)[0] == 0b01000100);
+    REQUIRE(planes.edges(0, eEdge::FALLING)[0] == 0b10100000);
+    REQUIRE(planes.edges(0, eEdge::ANY)[0] == 0b11100100);
+    REQUIRE(planes.edges(1, eEdge::ANY)[0] == 0);
+    REQUIRE(planes.countEdges(0, eEdge::RISING) == 2);
+    REQUIRE(planes.countEdges(0, eEdge::FALLING) == 2);
+    REQUIRE(planes.countToggles(0) == 4);
+    // Samples 2..5 hold the 1 -> 0 at sample 5 only
+    REQUIRE(planes.countToggles(0, 2, 4) == 1);
+    REQUIRE(planes.countToggles(0, 2, 1) == 0);
+    REQUIRE(planes.countHigh(0) == 4);
+    REQUIRE(planes.dutyCycle(0) == 0.5);
+    REQUIRE(planes.dutyCycle(1) == 1.0);
+}
+
+TEST_CASE("Test bit planes kernels agree", "[bitplane-kernels-agree]")
+{
+    using SignalDataFacade::eEdge;
+    auto words = randomWords(20011, 11);
+    std::vector<SignalDataFacade::GpioBitPlanes> allPlanes;
+    for (auto level : ALL_LEVELS)
+    {
+        allPlanes.emplace_back(0xFFFF, level);
+        allPlanes.back().append(words);
+    }
+
+    // Ranges inside one word, across a boundary, and over many words
+    const std::pair<size_t, size_t> ranges[] =
+    {
+        {0, words.size()}, {3, 40}, {60, 10}, {64, 64}, {1, 9000},
+        {777, 12345}, {words.size() - 5, 5}
+    };
+    for (const auto& planes : allPlanes)
+    {
+        INFO("Kernel " << SignalDataFacade::toString(planes.simdLevel()));
+        REQUIRE(planes.plane(7).size() == allPlanes[0].plane(7).size());
+        REQUIRE(std::equal(
+            planes.plane(7).begin(),
+            planes.plane(7).end(),
+            allPlanes[0].plane(7).begin()));
+        for (size_t line : {0, 7, 15})
+        {
+            for (auto [first, count] : ranges)
+            {
+                uint64_t high = 0;
+                for (size_t i = first; i < first + count; ++i)
+                {
+                    high += lineLevel(words, i, line);
+                }
+                REQUIRE(planes.countHigh(line, first, count) == high);
+                for (auto edge : {eEdge::RISING, eEdge::FALLING, eEdge::ANY})
+                {
+                    REQUIRE(planes.countEdges(line, edge, first, count) ==
+                        referenceEdges(words, line, edge, first, count));
+                }
+            }
+        }
+    }
+}
+
+TEST_CASE("Test bit planes run-length encoding", "[bitplane-runs]")
+{
+    auto words = randomWords(5000, 5);
+    SignalDataFacade::GpioBitPlanes planes(0x0101);
+    planes.append(words);
+
+    auto runs = planes.encodeRuns(8);
+    REQUIRE(runs.bInitialLevel == lineLevel(words, 0, 8));
+    REQUIRE(runs.lengths.size() == planes.countToggles(8) + 1);
+    auto decoded = SignalDataFacade::GpioBitPlanes::decodeRuns(runs);
+    REQUIRE(std::equal(
+        decoded.begin(), decoded.end(), planes.plane(8).begin(),
+        planes.plane(8).end()));
+
+    // A constant line is a single run
+    std::vector<uint16_t> constant(300, 1);
+    SignalDataFacade::GpioBitPlanes steady(0x0001);
+    steady.append(constant);
+    auto steadyRuns = steady.encodeRuns(0);
+    REQUIRE(steadyRuns.bInitialLevel);
+    REQUIRE(steadyRuns.lengths == std::vector<uint64_t>{300});
+}
+
+TEST_CASE("Test bit planes memory", "[bitplane-memory]")
+{
+    constexpr size_t NUM_SAMPLES = 1 << 16;
+    std::vector<uint16_t> words(NUM_SAMPLES, 0x0001);
+    SignalDataFacade::GpioBitPlanes one(0x0001);
+    one.append(words);
+    SignalDataFacade::GpioBitPlanes all;
+    all.append(words);
+
+    size_t wordBytes = NUM_SAMPLES * sizeof(uint16_t);
+    REQUIRE(one.memoryBytes() == wordBytes / 16);
+    REQUIRE(all.memoryBytes() == wordBytes);
+}
+
+//-----------------------------------------------------------------------------
+// Benchmarks (hidden, run with: ./test_facadepattern_bitplane "[benchmark]")
+//-----------------------------------------------------------------------------
+
+TEST_CASE(
+    "Benchmark bit plane kernels",
+    "[.][benchmark][bitplane-benchmark]")
+{
+    constexpr size_t NUM_SAMPLES = 16 << 20;
+    constexpr int NUM_PASSES = 8;
+    auto words = randomWords(NUM_SAMPLES, 1);
+
+    for (auto level : ALL_LEVELS)
+    {
+        SignalDataFacade::GpioBitPlanes planes(0xFFFF, level);
+        planes.reserve(NUM_SAMPLES);
+        auto start = std::chrono::steady_clock::now();
+        planes.append(words);
+        std::chrono::duration<double> transposed =
+            std::chrono::steady_clock::now() - start;
+
+        uint64_t checksum = 0;
+        start = std::chrono::steady_clock::now();
+        for (int pass = 0; pass < NUM_PASSES; ++pass)
+        {
+            checksum += planes.countToggles(size_t(pass));
+            checksum += planes.countHigh(size_t(pass + 8));
+        }
+        std::chrono::duration<double> counted =
+            std::chrono::steady_clock::now() - start;
+
+        REQUIRE(checksum > 0);
+        std::cout << SignalDataFacade::toString(planes.simdLevel())
+                  << ": transpose "
+                  << double(NUM_SAMPLES * sizeof(uint16_t)) /
+                        transposed.count() / 1e9
+                  << " GB/s of words, edge + popcount "
+                  << double(NUM_SAMPLES) * 2 * NUM_PASSES /
+                        counted.count() / 1e9
+                  << " Gsamples/s"
+                  << std::endl;
+    }
+}
@@ -0,0 +1,431 @@
+// Copyright (c) 2025 Michael Dello
+//
+// This software is provided under the MIT License.
+// See LICENSE file for details.
+
+//-----------------------------------------------------------------------------
+// Calibration Unit Tests
+//-----------------------------------------------------------------------------
+#define CATCH_CONFIG_MAIN
+// Include EVERYTHING from Catch2 (version 3)
+// This avoids the need to create a main() for unit testing
+#include <catch2/catch_all.hpp>
+// Alternatively, only include what is needed
+// #include <catch2/catch_test_macros.hpp> // Basic test macros
+// #include <catch2/catch_approx.hpp>  // Approximate floating-point comparisons
+// #include <catch2/catch_reporter_console.hpp> // Console reporting
+// #define CATCH_CONFIG_MAIN // Generates Catch2's main function
+// #include <catch2/catch_test_macros.hpp>
+
+// Create a custom main() instead:
+/* int main(int argc, char* argv[]) {
+    Catch::Session session; // Create Catch2 session
+    return session.run(argc, argv);
+} */
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <iostream>
+#include <memory>
+#include <random>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+#include "facadepattern_calibration.h"
+
+//-----------------------------------------------------------------------------
+// Test Helpers
+//-----------------------------------------------------------------------------
+
+namespace
+{
+    using SignalDataFacade::CalibrationTable;
+    using SignalDataFacade::sCalibration_t;
+
+    constexpr SignalDataFacade::eSimdLevel ALL_LEVELS[] =
+    {
+        SignalDataFacade::eSimdLevel::SCALAR,
+        SignalDataFacade::eSimdLevel::SSE4,
+        SignalDataFacade::eSimdLevel::AVX2
+    };
+
+    //-------------------------------------------------------------------------
+    std::vector<uint16_t> randomCodes(size_t count, uint64_t seed)
+    {
+        std::mt19937_64 rng(seed);
+        std::vector<uint16_t> codes(count);
+        for (auto& code : codes)
+        {
+            code = uint16_t(rng());
+        }
+        return codes;
+    }
+
+    //-------------------------------------------------------------------------
+    // A 16-bit converter spanning +/-10 V
+    sCalibration_t bipolarVolts()
+    {
+        sCalibration_t calibration;
+        calibration.coefficients = {-10.0, 20.0 / 65535.0};
+        calibration.fixedScale = 1e6;
+        return calibration;
+    }
+
+    //-------------------------------------------------------------------------
+    // Every code's value is its own negation, or the code itself
+    sCalibration_t measuredTable(bool bNegated)
+    {
+        sCalibration_t calibration;
+        calibration.table.resize(CalibrationTable::NUM_CODES);
+        for (size_t code = 0; code < CalibrationTable::NUM_CODES; ++code)
+        {
+            calibration.table[code] = bNegated ? -double(code) : double(code);
+        }
+        return calibration;
+    }
+
+} // namespace anonymous
+
+//=============================================================================
+// CalibrationTable Unit Tests
+//=============================================================================
+
+TEST_CASE("Test calibration of polynomials", "[calibration-polynomial]")
+{
+    // Sizes with leftovers after every kernel's vector width
+    auto codes = randomCodes(1000 + 13, 1);
+    codes[0] = 0;
+    codes[1] = 65535;
+
+    sCalibration_t cubic;
+    cubic.coefficients = {0.5, 1e-3, -2e-8, 3e-13};
+    cubic.fixedScale = 1000.0;
+    auto cubicValue = [](double code)
+    {
+        return 0.5 + 1e-3 * code - 2e-8 * code * code +
+            3e-13 * code * code * code;
+    };
+
+    for (auto level : ALL_LEVELS)
+    {
+        CalibrationTable volts{bipolarVolts(), level};
+        CalibrationTable curve{cubic, level};
+        REQUIRE(volts.isLinear());
+        REQUIRE_FALSE(curve.isLinear());
+        REQUIRE(volts.simdLevel() <= level);
+
+        std::vector<float> outputs(codes.size());
+        std::vector<int32_t> fixedOutputs(codes.size());
+
+        volts.convert(codes, outputs);
+        for (size_t i = 0; i < codes.size(); ++i)
+        {
+            double expected = -10.0 + 20.0 / 65535.0 * codes[i];
+            REQUIRE(volts.value(codes[i]) ==
+                Catch::Approx(expected).margin(1e-6));
+            REQUIRE(outputs[i] == Catch::Approx(expected).margin(1e-5));
+        }
+        REQUIRE(volts.value(0) == -10.0f);
+        REQUIRE(volts.fixedValue(65535) == 10'000'000);
+        volts.convert(codes, fixedOutputs);
+        for (size_t i = 0; i < codes.size(); ++i)
+        {
+            REQUIRE(fixedOutputs[i] == volts.fixedValue(codes[i]));
+        }
+
+        // Looked up, so exactly the table whatever the level
+        curve.convert(codes, outputs);
+        curve.convert(codes, fixedOutputs);
+        for (size_t i = 0; i < codes.size(); ++i)
+        {
+            double expected = cubicValue(codes[i]);
+            REQUIRE(curve.value(codes[i]) ==
+                Catch::Approx(expected).epsilon(1e-6));
+            REQUIRE(outputs[i] == curve.value(codes[i]));
+            REQUIRE(fixedOutputs[i] ==
+                int32_t(std::round(expected * 1000.0)));
+        }
+    }
+}
+
+TEST_CASE("Test calibration from a measured table", "[calibration-table]")
+{
+    auto codes = randomCodes(4096 + 5, 2);
+    sCalibration_t calibration = measuredTable(true);
+    // Saturates rather than wrapping in fixed point
+    calibration.fixedScale = 1e6;
+
+    for (auto level : ALL_LEVELS)
+    {
+        CalibrationTable table{calibration, level};
+        REQUIRE_FALSE(table.isLinear());
+
+        std::vector<float> outputs(codes.size() + 3, 1.0f);
+        std::vector<int32_t> fixedOutputs(codes.size());
+        table.convert(codes, outputs);
+        table.convert(codes, fixedOutputs);
+        for (size_t i = 0; i < codes.size(); ++i)
+        {
+            REQUIRE(outputs[i] == -float(codes[i]));
+            int64_t expected = -int64_t(codes[i]) * 1'000'000;
+            REQUIRE(fixedOutputs[i] == std::max<int64_t>(expected, INT32_MIN));
+        }
+        // Outputs past the codes are left alone
+        REQUIRE(outputs.back() == 1.0f);
+    }
+}
+
+TEST_CASE("Test calibration errors", "[calibration-errors]")
+{
+    sCalibration_t calibration;
+    calibration.coefficients.clear();
+    REQUIRE_THROWS_AS(CalibrationTable{calibration}, std::invalid_argument);
+
+    calibration = {};
+    calibration.table.resize(100);
+    REQUIRE_THROWS_AS(CalibrationTable{calibration}, std::invalid_argument);
+
+    calibration = {};
+    calibration.fixedScale = 0.0;
+    REQUIRE_THROWS_AS(CalibrationTable{calibration}, std::invalid_argument);
+
+    // Overflows float at the top codes
+    calibration = {};
+    calibration.coefficients.assign(10, 0.0);
+    calibration.coefficients.back() = 1.0;
+    REQUIRE_THROWS_AS(CalibrationTable{calibration}, std::invalid_argument);
+
+    calibration = measuredTable(false);
+    calibration.table[7] = NAN;
+    REQUIRE_THROWS_AS(CalibrationTable{calibration}, std::invalid_argument);
+
+    CalibrationTable identity;
+    std::vector<uint16_t> codes(10);
+    std::vector<float> outputs(9);
+    REQUIRE_THROWS_AS(
+        identity.convert(codes, outputs), std::invalid_argument);
+
+    SignalDataFacade::ChannelCalibration channels{2};
+    REQUIRE_THROWS_AS(
+        channels.load(2, bipolarVolts()), std::out_of_range);
+    REQUIRE_THROWS_AS(channels.table(5), std::out_of_range);
+    REQUIRE_THROWS_AS(channels.setTable(0, nullptr), std::invalid_argument);
+    // A failed load keeps the table in place
+    calibration.coefficients.clear();
+    calibration.table.clear();
+    auto spBefore = channels.table(1);
+    REQUIRE_THROWS_AS(channels.load(1, calibration), std::invalid_argument);
+    REQUIRE(channels.table(1) == spBefore);
+    REQUIRE(channels.numSwaps() == 0);
+}
+
+//=============================================================================
+// ChannelCalibration Unit Tests
+//=============================================================================
+
+TEST_CASE("Test per-channel calibration", "[calibration-channels]")
+{
+    SignalDataFacade::ChannelCalibration channels{3};
+    REQUIRE(channels.numChannels() == 3);
+
+    // The identity until loaded
+    std::vector<uint16_t> codes{0, 1, 2, 1000, 65535};
+    std::vector<float> outputs(codes.size());
+    channels.convert(2, codes, outputs);
+    for (size_t i = 0; i < codes.size(); ++i)
+    {
+        REQUIRE(outputs[i] == float(codes[i]));
+    }
+
+    // From the gain and offset recorded in a capture file
+    SignalDataFacade::sCaptureChannel_t captureChannel{"current", 0.5, -3.0};
+    channels.load(0, bipolarVolts());
+    channels.load(1, SignalDataFacade::calibrationOf(captureChannel));
+    auto spMeasured = std::make_shared<const CalibrationTable>(
+        measuredTable(true));
+    channels.setTable(2, spMeasured);
+    REQUIRE(channels.table(2) == spMeasured);
+    REQUIRE(channels.numSwaps() == 3);
+
+    channels.convert(1, codes, outputs);
+    REQUIRE(outputs[3] == 497.0f);
+    std::vector<int32_t> fixedOutputs(codes.size());
+    channels.convert(0, codes, fixedOutputs);
+    REQUIRE(fixedOutputs.front() == -10'000'000);
+    REQUIRE(fixedOutputs.back() == 10'000'000);
+
+    // Frames of all three channels, as acquireFrames() returns them
+    std::vector<uint16_t> frames{0, 10, 20, 65535, 11, 21};
+    std::vector<float> frameOutputs(frames.size());
+    channels.convertFrames(frames, frameOutputs);
+    REQUIRE(frameOutputs == std::vector<float>{
+        -10.0f, 2.0f, -20.0f, 10.0f, 2.5f, -21.0f});
+    REQUIRE_THROWS_AS(
+        channels.convertFrames(std::span(frames).first(4), frameOutputs),
+        std::invalid_argument);
+
+    // Many frames match each channel converted as a column
+    constexpr size_t NUM_FRAMES = 2500;
+    std::vector<uint16_t> manyFrames(3 * NUM_FRAMES);
+    for (size_t i = 0; i < manyFrames.size(); ++i)
+    {
+        manyFrames[i] = uint16_t(i * 40503u);
+    }
+    std::vector<float> manyOutputs(manyFrames.size());
+    channels.convertFrames(manyFrames, manyOutputs);
+    std::vector<uint16_t> column(NUM_FRAMES);
+    std::vector<float> columnOutputs(NUM_FRAMES);
+    for (size_t channel = 0; channel < 3; ++channel)
+    {
+        for (size_t i = 0; i < NUM_FRAMES; ++i)
+        {
+            column[i] = manyFrames[3 * i + channel];
+        }
+        channels.convert(channel, column, columnOutputs);
+        for (size_t i = 0; i < NUM_FRAMES; ++i)
+        {
+            REQUIRE(manyOutputs[3 * i + channel] == columnOutputs[i]);
+        }
+    }
+}
+
+TEST_CASE(
+    "Test calibration hot swap during conversion",
+    "[calibration-hot-swap]")
+{
+    constexpr size_t BLOCK = 4096;
+    constexpr size_t NUM_SWAPS = 200;
+    SignalDataFacade::ChannelCalibration channels{1};
+    auto spPositive = std::make_shared<const CalibrationTable>(
+        measuredTable(false));
+    auto spNegative = std::make_shared<const CalibrationTable>(
+        measuredTable(true));
+    channels.setTable(0, spPositive);
+
+    // Codes 1 and up, so each output shows which table produced it
+    auto codes = randomCodes(BLOCK, 3);
+    for (auto& code : codes)
+    {
+        code = std::max<uint16_t>(code, 1);
+    }
+
+    std::atomic<bool> bConverting{true};
+    uint64_t numBlocks = 0;
+    uint64_t numPositive = 0;
+    bool bWholeBlocks = true;
+    std::thread converter([&]()
+    {
+        std::vector<float> outputs(BLOCK);
+        while (bConverting.load())
+        {
+            channels.convert(0, codes, outputs);
+            bool bPositive = outputs[0] > 0.0f;
+            for (size_t i = 0; i < BLOCK; ++i)
+            {
+                float expected = bPositive ? float(codes[i]) : -float(codes[i]);
+                bWholeBlocks = bWholeBlocks && outputs[i] == expected;
+            }
+            numPositive += bPositive;
+            ++numBlocks;
+        }
+    });
+
+    // Swap back and forth without stopping the converter
+    for (size_t swap = 0; swap < NUM_SWAPS; ++swap)
+    {
+        channels.setTable(0, swap % 2 == 0 ? spNegative : spPositive);
+        std::this_thread::yield();
+    }
+    channels.load(0, measuredTable(true));
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    bConverting = false;
+    converter.join();
+
+    REQUIRE(bWholeBlocks);
+    REQUIRE(numBlocks > 0);
+    REQUIRE(channels.numSwaps() == NUM_SWAPS + 2);
+    // The tables swapped out are freed once no conversion holds them
+    REQUIRE(spPositive.use_count() == 1);
+    REQUIRE(spNegative.use_count() == 1);
+}
+
+//-----------------------------------------------------------------------------
+// Benchmarks (hidden, run with: ./test_facadepattern_calibration "[benchmark]")
+//-----------------------------------------------------------------------------
+
+TEST_CASE(
+    "Benchmark calibrated conversion",
+    "[.][benchmark][calibration-benchmark]")
+{
+    constexpr size_t BLOCK = 1 << 16;
+    constexpr size_t NUM_SAMPLES = 64 << 20;
+    using Clock = std::chrono::steady_clock;
+
+    auto codes = randomCodes(BLOCK, 4);
+    std::vector<float> outputs(BLOCK);
+    std::vector<int32_t> fixedOutputs(BLOCK);
+    sCalibration_t cubic;
+    cubic.coefficients = {0.5, 1e-3, -2e-8, 3e-13};
+
+    auto report = [](const char* pName, Clock::duration elapsed)
+    {
+        std::chrono::duration<double> seconds = elapsed;
+        std::cout << pName
+                  << double(NUM_SAMPLES) / seconds.count() / 1e6
+                  << " Msamples/s"
+                  << std::endl;
+    };
+
+    // What each consumer did before: its own double math per sample
+    auto start = Clock::now();
+    for (size_t done = 0; done < NUM_SAMPLES; done += BLOCK)
+    {
+        for (size_t i = 0; i < BLOCK; ++i)
+        {
+            double code = codes[i];
+            outputs[i] = float(0.5 + code * (1e-3 + code * (-2e-8 +
+                code * 3e-13)));
+        }
+    }
+    report("per-sample polynomial:  ", Clock::now() - start);
+
+    for (auto level : ALL_LEVELS)
+    {
+        CalibrationTable volts{bipolarVolts(), level};
+        CalibrationTable curve{cubic, level};
+        std::cout << SignalDataFacade::toString(volts.simdLevel())
+                  << std::endl;
+
+        start = Clock::now();
+        for (size_t done = 0; done < NUM_SAMPLES; done += BLOCK)
+        {
+            volts.convert(codes, outputs);
+        }
+        report("  linear float:         ", Clock::now() - start);
+
+        start = Clock::now();
+        for (size_t done = 0; done < NUM_SAMPLES; done += BLOCK)
+        {
+            curve.convert(codes, outputs);
+        }
+        report("  table float:          ", Clock::now() - start);
+
+        start = Clock::now();
+        for (size_t done = 0; done < NUM_SAMPLES; done += BLOCK)
+        {
+            curve.convert(codes, fixedOutputs);
+        }
+        report("  table fixed point:    ", Clock::now() - start);
+    }
+
+    start = Clock::now();
+    CalibrationTable rebuilt{cubic};
+    std::chrono::duration<double, std::milli> buildTime =
+        Clock::now() - start;
+    std::cout << "table build: "
+              << buildTime.count()
+              << " ms"
+              << std::endl;
+}
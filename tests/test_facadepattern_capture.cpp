@@ -0,0 +1,451 @@
+// Copyright (c) 2025 Michael Dello
+//
+// This software is provided under the MIT License.
+// See LICENSE file for details.
+
+//-----------------------------------------------------------------------------
+// Signal Data Capture File Unit Tests
+//-----------------------------------------------------------------------------
+#define CATCH_CONFIG_MAIN
+// Include EVERYTHING from Catch2 (version 3)
+// This avoids the need to create a main() for unit testing
+#include <catch2/catch_all.hpp>
+// Alternatively, only include what is needed
+// #include <catch2/catch_test_macros.hpp> // Basic test macros
+// #include <catch2/catch_approx.hpp>  // Approximate floating-point comparisons
+// #include <catch2/catch_reporter_console.hpp> // Console reporting
+// #define CATCH_CONFIG_MAIN // Generates Catch2's main function
+// #include <catch2/catch_test_macros.hpp>
+
+// Create a custom main() instead:
+/* int main(int argc, char* argv[]) {
+    Catch::Session session; // Create Catch2 session
+    return session.run(argc, argv);
+} */
+
+#include <unistd.h>
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include "facadepattern_capture.h"
+
+//-----------------------------------------------------------------------------
+// Test Helpers
+//-----------------------------------------------------------------------------
+
+namespace
+{
+    using Sample = SignalDataFacade::SignalData::sAggregateData;
+
+    //-------------------------------------------------------------------------
+    // A per-process file path, removed again when the test ends
+    class TempCapturePath
+    {
+    public:
+        explicit TempCapturePath(const std::string& sName)
+        : path{std::filesystem::temp_directory_path() /
+            (sName + "." + std::to_string(::getpid()) + ".sdcap")}
+        {
+            std::filesystem::remove(path);
+        }
+        ~TempCapturePath() { std::filesystem::remove(path); }
+        std::string str() const { return path.string(); }
+
+    private:
+        std::filesystem::path path;
+    };
+
+    //-------------------------------------------------------------------------
+    std::vector<Sample> rampSamples(size_t count, uint16_t first = 0)
+    {
+        std::vector<Sample> samples(count);
+        for (size_t i = 0; i < count; ++i)
+        {
+            samples[i].analog = static_cast<uint16_t>(first + i);
+            samples[i].digital = static_cast<uint16_t>((first + i) & 1);
+        }
+        return samples;
+    }
+
+} // namespace anonymous
+
+//=============================================================================
+// Capture File Unit Tests
+//=============================================================================
+
+TEST_CASE("Test capture file round trip", "[capture-round-trip]")
+{
+    TempCapturePath path{"round-trip"};
+    {
+        SignalDataFacade::CaptureWriter writer{
+            path.str(),
+            {.channels = {{"analog", 0.5, -1.0}, {"gpio"}},
+             .sampleRateHz = 1000.0,
+             .startTimeNs = 5'000'000'000,
+             .chunkSamples = 100}};
+        writer.append(rampSamples(250));
+        REQUIRE(writer.samplesWritten() == 250);
+        // Full chunks are committed as they fill
+        REQUIRE(writer.chunksCommitted() == 2);
+    }
+
+    SignalDataFacade::CaptureReader reader{path.str()};
+    REQUIRE(reader.sampleRateHz() == 1000.0);
+    REQUIRE(reader.numChannels() == 2);
+    REQUIRE(reader.channel(0).sName == "analog");
+    REQUIRE(reader.channel(0).gain == 0.5);
+    REQUIRE(reader.channel(0).offset == -1.0);
+    REQUIRE(reader.channel(1).sName == "gpio");
+    REQUIRE(reader.channel(1).gain == 1.0);
+    REQUIRE_THROWS_AS(reader.channel(2), std::out_of_range);
+
+    // The last, partial chunk was committed by the destructor
+    REQUIRE(reader.numChunks() == 3);
+    REQUIRE(reader.numSamples() == 250);
+    REQUIRE(reader.chunkHeader(2).firstSampleIndex == 200);
+    REQUIRE(reader.chunkHeader(2).numSamples == 50);
+    REQUIRE(reader.timestampOf(1, 0) == 5'100'000'000);
+    REQUIRE(reader.timestampOf(2, 49) == 5'249'000'000);
+
+    auto view = reader.chunkView(1);
+    REQUIRE(view.analog.size() == 100);
+    REQUIRE(view.analog[7] == 107);
+    REQUIRE(view.digital[7] == 1);
+    // Columns are aligned in the mapping
+    REQUIRE(reinterpret_cast<uintptr_t>(view.analog.data()) %
+        SignalDataFacade::CAPTURE_COLUMN_ALIGNMENT == 0);
+
+    // Uncompressed files keep the version 1 layout: raw column slots and a
+    // channel table without codecs
+    SignalDataFacade::sCaptureFileHeader header;
+    SignalDataFacade::sCaptureFileChannelV1 channel;
+    {
+        std::ifstream file{path.str(), std::ios::binary};
+        file.read(reinterpret_cast<char*>(&header), sizeof(header));
+        file.seekg(
+            offsetof(SignalDataFacade::sCaptureFileHeader, channels) +
+            sizeof(channel));
+        file.read(reinterpret_cast<char*>(&channel), sizeof(channel));
+    }
+    REQUIRE(header.version == SignalDataFacade::CAPTURE_VERSION_RAW);
+    REQUIRE(header.chunkBytes ==
+        sizeof(SignalDataFacade::sCaptureChunkHeader) + 2 * 256);
+    REQUIRE(std::string(channel.name) == "gpio");
+}
+
+TEST_CASE("Test capture file append and commit", "[capture-append]")
+{
+    TempCapturePath path{"append"};
+    SignalDataFacade::sCaptureConfig_t config{
+        .sampleRateHz = 1000.0, .chunkSamples = 64};
+    {
+        SignalDataFacade::CaptureWriter writer{path.str(), config};
+        writer.append(rampSamples(10));
+
+        // Staged samples are invisible until committed
+        SignalDataFacade::CaptureReader reader{path.str()};
+        REQUIRE(reader.numChunks() == 0);
+        writer.commit();
+        reader.refresh();
+        REQUIRE(reader.numSamples() == 10);
+    }
+    {
+        // Reopening continues the sample index and clock
+        SignalDataFacade::CaptureWriter writer{path.str()};
+        REQUIRE(writer.samplesWritten() == 10);
+        SignalDataFacade::SampleBlock block;
+        block.append(rampSamples(100, 10));
+        writer.append(block.view());
+        writer.sync();
+    }
+
+    SignalDataFacade::CaptureReader reader{path.str()};
+    REQUIRE(reader.numSamples() == 110);
+    REQUIRE(reader.chunkHeader(1).firstSampleIndex == 10);
+    REQUIRE(reader.chunkHeader(1).firstTimestampNs == 10'000'000);
+    size_t expected = 0;
+    for (size_t chunk = 0; chunk < reader.numChunks(); ++chunk)
+    {
+        for (uint16_t value : reader.chunkView(chunk).analog)
+        {
+            REQUIRE(value == expected++);
+        }
+    }
+    REQUIRE(expected == 110);
+}
+
+TEST_CASE("Test capture file time range seeks", "[capture-range]")
+{
+    TempCapturePath path{"range"};
+    {
+        // 1 kHz, so sample n is at n ms
+        SignalDataFacade::CaptureWriter writer{
+            path.str(), {.sampleRateHz = 1000.0, .chunkSamples = 100}};
+        writer.append(rampSamples(1000));
+        // A gap: these continue at 2 s instead of 1 s
+        writer.append(rampSamples(500, 1000), 2'000'000'000);
+    }
+
+    SignalDataFacade::CaptureReader reader{path.str()};
+    REQUIRE(reader.numChunks() == 15);
+    REQUIRE(reader.chunkHeader(10).firstTimestampNs == 2'000'000'000);
+    REQUIRE(reader.findChunk(0) == 0);
+    REQUIRE(reader.findChunk(450'000'000) == 4);
+    REQUIRE(reader.findChunk(1'500'000'000) == 9);
+    REQUIRE(reader.findChunk(2'150'000'000) == 11);
+
+    // [250 ms, 420 ms) spans chunks 2, 3 and 4
+    auto spans = reader.range(250'000'000, 420'000'000);
+    REQUIRE(spans.size() == 3);
+    REQUIRE(spans[0].firstSampleIndex == 250);
+    REQUIRE(spans[0].samples.analog.size() == 50);
+    REQUIRE(spans[0].samples.analog[0] == 250);
+    REQUIRE(spans[2].samples.analog.size() == 20);
+    REQUIRE(spans[2].samples.analog.back() == 419);
+
+    // Across the gap, only samples that exist are returned
+    spans = reader.range(990'000'000, 2'005'000'000);
+    size_t numSamples = 0;
+    for (const auto& span : spans)
+    {
+        numSamples += span.samples.analog.size();
+    }
+    REQUIRE(numSamples == 10 + 5);
+    REQUIRE(spans.back().firstTimestampNs == 2'000'000'000);
+    REQUIRE(spans.back().samples.analog[0] == 1000);
+
+    REQUIRE(reader.range(3'000'000'000, 4'000'000'000).empty());
+}
+
+TEST_CASE("Test capture file multi-channel frames", "[capture-frames]")
+{
+    TempCapturePath path{"frames"};
+    {
+        SignalDataFacade::CaptureWriter writer{
+            path.str(),
+            {.channels = {{"ch0"}, {"ch5"}, {"ch9"}}, .chunkSamples = 4}};
+        // Frames of three channels, the last one splitting across chunks
+        std::vector<uint16_t> frames{
+            1, 2, 3, 11, 12, 13, 21, 22, 23, 31, 32, 33, 41, 42, 43};
+        writer.appendFrames(frames);
+        REQUIRE_THROWS_AS(
+            writer.appendFrames(std::span(frames).first(2)),
+            std::invalid_argument);
+    }
+
+    SignalDataFacade::CaptureReader reader{path.str()};
+    REQUIRE(reader.numChannels() == 3);
+    REQUIRE(reader.numSamples() == 5);
+    REQUIRE(std::vector<uint16_t>(
+        reader.column(0, 2).begin(), reader.column(0, 2).end()) ==
+        std::vector<uint16_t>{3, 13, 23, 33});
+    REQUIRE(reader.column(1, 1)[0] == 42);
+}
+
+TEST_CASE("Test capture file compressed channels", "[capture-compressed]")
+{
+    using SignalDataFacade::eCodec;
+    TempCapturePath path{"compressed"};
+    std::vector<uint16_t> analog(2500);
+    std::vector<uint16_t> digital(2500);
+    std::vector<uint16_t> noise(2500);
+    for (size_t i = 0; i < analog.size(); ++i)
+    {
+        analog[i] = static_cast<uint16_t>(30000 + (i % 200) * 3);
+        digital[i] = static_cast<uint16_t>((i / 300) & 1);
+        noise[i] = static_cast<uint16_t>((i * 2654435761u) >> 7);
+    }
+    std::array<std::span<const uint16_t>, 3> columns{analog, digital, noise};
+    {
+        SignalDataFacade::CaptureWriter writer{
+            path.str(),
+            {.channels = {
+                {"analog", 1.0, 0.0, eCodec::DELTA_BITPACK},
+                {"digital", 1.0, 0.0, eCodec::RLE},
+                {"noise", 1.0, 0.0, eCodec::DELTA_BITPACK}},
+             .chunkSamples = 1000}};
+        writer.appendColumns(columns);
+        writer.commit();
+        REQUIRE(writer.compressionRatio() > 1.5);
+    }
+    {
+        // Appending picks the codecs up from the file
+        SignalDataFacade::CaptureWriter writer{path.str()};
+        writer.appendColumns(columns);
+    }
+
+    SignalDataFacade::CaptureReader reader{path.str()};
+    REQUIRE(reader.channel(1).codec == eCodec::RLE);
+    REQUIRE(reader.numSamples() == 5000);
+    REQUIRE(reader.chunkHeader(0).encoding ==
+        SignalDataFacade::CAPTURE_ENCODING_FRAMES);
+    std::vector<uint16_t> decoded;
+    for (size_t chunk = 0; chunk < reader.numChunks(); ++chunk)
+    {
+        size_t first = reader.chunkHeader(chunk).firstSampleIndex % 2500;
+        for (size_t channel = 0; channel < 3; ++channel)
+        {
+            auto column = reader.column(chunk, channel);
+            reader.decodeColumn(chunk, channel, decoded);
+            REQUIRE(decoded.size() == column.size());
+            REQUIRE(std::equal(
+                column.begin(), column.end(),
+                columns[channel].begin() + first));
+            REQUIRE(std::equal(
+                decoded.begin(), decoded.end(),
+                columns[channel].begin() + first));
+        }
+    }
+    // The noise does not compress, its RAW frames are mapped aligned
+    REQUIRE(reinterpret_cast<uintptr_t>(reader.column(0, 2).data()) %
+        SignalDataFacade::CAPTURE_COLUMN_ALIGNMENT == 0);
+
+    // Spans hold on to their decoded columns, however many there are
+    auto spans = reader.range(0, 1'000'000'000);
+    REQUIRE(spans.size() == reader.numChunks());
+    REQUIRE(2 * spans.size() >
+        SignalDataFacade::CaptureReader::DECODED_COLUMNS_KEPT);
+    for (const auto& span : spans)
+    {
+        size_t first = span.firstSampleIndex % 2500;
+        REQUIRE(std::equal(
+            span.samples.analog.begin(), span.samples.analog.end(),
+            analog.begin() + first));
+        REQUIRE(std::equal(
+            span.samples.digital.begin(), span.samples.digital.end(),
+            digital.begin() + first));
+    }
+}
+
+TEST_CASE("Test capture file errors", "[capture-errors]")
+{
+    TempCapturePath path{"errors"};
+    REQUIRE_THROWS_AS(
+        SignalDataFacade::CaptureReader{path.str()}, std::runtime_error);
+    REQUIRE_THROWS_AS(
+        SignalDataFacade::CaptureWriter(path.str(), {.channels = {}}),
+        std::invalid_argument);
+
+    {
+        std::ofstream notACapture{path.str()};
+        notACapture << std::string(8192, 'x');
+    }
+    REQUIRE_THROWS_AS(
+        SignalDataFacade::CaptureReader{path.str()}, std::runtime_error);
+
+    // Two-channel samples need a two-channel file
+    SignalDataFacade::CaptureWriter writer{
+        path.str(), {.channels = {{"analog"}}}};
+    REQUIRE_THROWS_AS(writer.append(rampSamples(1)), std::invalid_argument);
+}
+
+TEST_CASE("Test capture file corrupt chunks", "[capture-corrupt]")
+{
+    TempCapturePath path{"corrupt"};
+    {
+        SignalDataFacade::CaptureWriter writer{
+            path.str(), {.chunkSamples = 64, .bSyncChunks = true}};
+        writer.append(rampSamples(100));
+    }
+
+    // A chunk claiming more samples than its slot holds must not be mapped
+    {
+        std::fstream file{
+            path.str(), std::ios::in | std::ios::out | std::ios::binary};
+        uint32_t numSamples = 65;
+        file.seekp(
+            SignalDataFacade::CAPTURE_HEADER_BYTES +
+            offsetof(SignalDataFacade::sCaptureChunkHeader, numSamples));
+        file.write(
+            reinterpret_cast<const char*>(&numSamples), sizeof(numSamples));
+    }
+    SignalDataFacade::CaptureReader reader{path.str()};
+    REQUIRE(reader.numChunks() == 2);
+    REQUIRE_THROWS_AS(reader.column(0, 0), std::runtime_error);
+    REQUIRE_THROWS_AS(reader.chunkHeader(0), std::runtime_error);
+    REQUIRE(reader.chunkView(1).analog.size() == 36);
+}
+
+TEST_CASE("Test capture from streaming mode", "[capture-streaming]")
+{
+    using namespace std::chrono_literals;
+    constexpr size_t NUM_SAMPLES = 200000;
+
+    TempCapturePath path{"streaming"};
+    SignalDataFacade::SignalData& signalData =
+        SignalDataFacade::SignalData::getInstance();
+    {
+        SignalDataFacade::CaptureWriter writer{path.str(), {}};
+        std::vector<Sample> samples(4096);
+        signalData.startStreaming();
+        while (writer.samplesWritten() < NUM_SAMPLES)
+        {
+            size_t count = signalData.readStream(samples, 1s);
+            REQUIRE(count > 0);
+            writer.append(std::span(samples).first(count));
+        }
+        signalData.stopStreaming();
+    }
+
+    SignalDataFacade::CaptureReader reader{path.str()};
+    REQUIRE(reader.numSamples() >= NUM_SAMPLES);
+}
+
+//-----------------------------------------------------------------------------
+// Benchmarks (hidden, run with: ./test_facadepattern_capture "[benchmark]")
+//-----------------------------------------------------------------------------
+
+TEST_CASE(
+    "Benchmark capture file write and seek",
+    "[.][benchmark][capture-benchmark]")
+{
+    constexpr size_t NUM_SAMPLES = 64 << 20;
+    constexpr size_t BATCH = 1 << 16;
+    using Clock = std::chrono::steady_clock;
+
+    TempCapturePath path{"benchmark"};
+    auto batch = rampSamples(BATCH);
+    auto start = Clock::now();
+    {
+        SignalDataFacade::CaptureWriter writer{path.str(), {}};
+        for (size_t i = 0; i < NUM_SAMPLES; i += BATCH)
+        {
+            writer.append(batch);
+        }
+    }
+    std::chrono::duration<double> writeTime = Clock::now() - start;
+
+    start = Clock::now();
+    SignalDataFacade::CaptureReader reader{path.str()};
+    std::chrono::duration<double> openTime = Clock::now() - start;
+
+    constexpr int NUM_SEEKS = 100000;
+    uint64_t durationNs = reader.timestampOf(reader.numChunks() - 1, 0);
+    size_t found = 0;
+    start = Clock::now();
+    for (int i = 0; i < NUM_SEEKS; ++i)
+    {
+        uint64_t beginNs = durationNs / NUM_SEEKS * i;
+        found += reader.range(beginNs, beginNs + 1000).size();
+    }
+    std::chrono::duration<double> seekTime = Clock::now() - start;
+
+    REQUIRE(found > 0);
+    std::cout << "Capture write: "
+              << double(NUM_SAMPLES * sizeof(Sample)) / writeTime.count() / 1e9
+              << " GB/s, open: "
+              << openTime.count() * 1e6
+              << " us, range seek: "
+              << seekTime.count() / NUM_SEEKS * 1e9
+              << " ns over "
+              << reader.numChunks()
+              << " chunks"
+              << std::endl;
+}
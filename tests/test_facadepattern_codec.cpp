@@ -0,0 +1,365 @@
+// Copyright (c) 2025 Michael Dello
+//
+// This software is provided under the MIT License.
+// See LICENSE file for details.
+
+//-----------------------------------------------------------------------------
+// Signal Data Codec Unit Tests
+//-----------------------------------------------------------------------------
+#define CATCH_CONFIG_MAIN
+// Include EVERYTHING from Catch2 (version 3)
+// This avoids the need to create a main() for unit testing
+#include <catch2/catch_all.hpp>
+// Alternatively, only include what is needed
+// #include <catch2/catch_test_macros.hpp> // Basic test macros
+// #include <catch2/catch_approx.hpp>  // Approximate floating-point comparisons
+// #include <catch2/catch_reporter_console.hpp> // Console reporting
+// #define CATCH_CONFIG_MAIN // Generates Catch2's main function
+// #include <catch2/catch_test_macros.hpp>
+
+// Create a custom main() instead:
+/* int main(int argc, char* argv[]) {
+    Catch::Session session; // Create Catch2 session
+    return session.run(argc, argv);
+} */
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <iostream>
+#include <random>
+#include <stdexcept>
+#include <vector>
+#include "facadepattern_codec.h"
+#include "facadepattern_generator.h"
+
+//-----------------------------------------------------------------------------
+// Test Helpers
+//-----------------------------------------------------------------------------
+
+namespace
+{
+    using SignalDataFacade::eCodec;
+    using Sample = SignalDataFacade::SignalData::sAggregateData;
+
+    constexpr SignalDataFacade::eSimdLevel ALL_LEVELS[] =
+    {
+        SignalDataFacade::eSimdLevel::SCALAR,
+        SignalDataFacade::eSimdLevel::SSE4,
+        SignalDataFacade::eSimdLevel::AVX2
+    };
+
+    constexpr eCodec ALL_CODECS[] =
+    {
+        eCodec::RAW,
+        eCodec::DELTA_BITPACK,
+        eCodec::RLE
+    };
+
+    //-------------------------------------------------------------------------
+    // A noisy sine with the occasional full-scale jump
+    std::vector<uint16_t> analogSamples(size_t count, uint64_t seed)
+    {
+        SignalDataFacade::SignalGenerator generator{{
+            .waveform = SignalDataFacade::eWaveform::SINE,
+            .sampleRateHz = 1'000'000.0,
+            .frequencyHz = 1000.0,
+            .noiseAmplitude = 40,
+            .glitchProbability = 0.001,
+            .seed = seed}};
+        std::vector<uint16_t> samples(count);
+        generator.generate(samples);
+        return samples;
+    }
+
+    //-------------------------------------------------------------------------
+    std::vector<uint16_t> digitalSamples(size_t count, uint64_t seed)
+    {
+        std::mt19937_64 rng(seed);
+        std::geometric_distribution<size_t> hold(0.002);
+        std::vector<uint16_t> samples(count);
+        uint16_t word = 0;
+        for (size_t i = 0; i < count;)
+        {
+            for (size_t n = hold(rng) + 1; n > 0 && i < count; --n)
+            {
+                samples[i++] = word;
+            }
+            word ^= uint16_t(1u << (rng() % 16));
+        }
+        return samples;
+    }
+
+    //-------------------------------------------------------------------------
+    std::vector<uint16_t> roundTrip(
+        eCodec codec,
+        const std::vector<uint16_t>& samples,
+        SignalDataFacade::eSimdLevel level)
+    {
+        std::vector<std::byte> bytes;
+        size_t frameBytes =
+            SignalDataFacade::encodeFrame(codec, samples, bytes, level);
+        REQUIRE(frameBytes == bytes.size());
+        REQUIRE(frameBytes <= SignalDataFacade::maxFrameBytes(samples.size()));
+
+        std::vector<uint16_t> decoded;
+        REQUIRE(SignalDataFacade::decodeFrame(bytes, decoded, level) ==
+            frameBytes);
+        return decoded;
+    }
+
+} // namespace anonymous
+
+//=============================================================================
+// Codec Frame Unit Tests
+//=============================================================================
+
+TEST_CASE("Test codec frame round trip", "[codec-round-trip]")
+{
+    // Partial blocks, whole blocks, and a mix of both
+    auto analog = analogSamples(10000, 3);
+    auto digital = digitalSamples(10000, 3);
+    for (size_t count : {0, 1, 127, 128, 129, 1000, 10000})
+    {
+        std::vector<uint16_t> analogPart(
+            analog.begin(), analog.begin() + count);
+        std::vector<uint16_t> digitalPart(
+            digital.begin(), digital.begin() + count);
+        for (auto codec : ALL_CODECS)
+        {
+            for (auto level : ALL_LEVELS)
+            {
+                INFO(SignalDataFacade::toString(codec)
+                     << " " << SignalDataFacade::toString(level)
+                     << " " << count);
+                REQUIRE(roundTrip(codec, analogPart, level) == analogPart);
+                REQUIRE(roundTrip(codec, digitalPart, level) == digitalPart);
+            }
+        }
+    }
+}
+
+TEST_CASE("Test codec full scale deltas", "[codec-full-scale]")
+{
+    // Alternating extremes need all 16 bits of zigzag
+    std::vector<uint16_t> samples(1000);
+    for (size_t i = 0; i < samples.size(); ++i)
+    {
+        samples[i] = (i & 1) ? 65535 : 0;
+    }
+    samples[500] = 32768;
+    for (auto level : ALL_LEVELS)
+    {
+        REQUIRE(roundTrip(eCodec::DELTA_BITPACK, samples, level) == samples);
+    }
+}
+
+TEST_CASE("Test codec kernels agree", "[codec-kernels-agree]")
+{
+    auto analog = analogSamples(5001, 5);
+    auto digital = digitalSamples(5001, 5);
+    for (auto codec : ALL_CODECS)
+    {
+        std::vector<std::byte> expected;
+        SignalDataFacade::encodeFrame(
+            codec, codec == eCodec::RLE ? digital : analog, expected,
+            SignalDataFacade::eSimdLevel::SCALAR);
+        for (auto level : ALL_LEVELS)
+        {
+            INFO(SignalDataFacade::toString(codec)
+                 << " " << SignalDataFacade::toString(level));
+            std::vector<std::byte> bytes;
+            SignalDataFacade::encodeFrame(
+                codec, codec == eCodec::RLE ? digital : analog, bytes, level);
+            REQUIRE(bytes == expected);
+        }
+    }
+}
+
+TEST_CASE("Test codec compression and fallback", "[codec-fallback]")
+{
+    auto analog = analogSamples(65536, 7);
+    auto digital = digitalSamples(65536, 7);
+    std::vector<std::byte> bytes;
+    SignalDataFacade::encodeFrame(eCodec::DELTA_BITPACK, analog, bytes);
+    REQUIRE(SignalDataFacade::peekFrame(bytes).codec == eCodec::DELTA_BITPACK);
+    REQUIRE(bytes.size() < analog.size() * sizeof(uint16_t) * 3 / 4);
+
+    bytes.clear();
+    SignalDataFacade::encodeFrame(eCodec::RLE, digital, bytes);
+    REQUIRE(bytes.size() < digital.size() / 20);
+
+    // Written in place, the same frame and nothing past it
+    std::vector<std::byte> room(
+        SignalDataFacade::maxFrameBytes(digital.size()), std::byte{0xA5});
+    size_t frameBytes = SignalDataFacade::encodeFrame(
+        eCodec::RLE, digital, std::span<std::byte>(room));
+    REQUIRE(frameBytes == bytes.size());
+    REQUIRE(std::equal(bytes.begin(), bytes.end(), room.begin()));
+    REQUIRE(std::all_of(
+        room.begin() + frameBytes, room.end(),
+        [](std::byte value) { return value == std::byte{0xA5}; }));
+
+    // Samples that do not shrink are stored raw
+    std::mt19937 rng(7);
+    std::vector<uint16_t> noise(1000);
+    for (uint16_t& sample : noise)
+    {
+        sample = uint16_t(rng());
+    }
+    for (auto codec : {eCodec::DELTA_BITPACK, eCodec::RLE})
+    {
+        bytes.clear();
+        SignalDataFacade::encodeFrame(codec, noise, bytes);
+        auto header = SignalDataFacade::peekFrame(bytes);
+        REQUIRE(header.codec == eCodec::RAW);
+        REQUIRE(bytes.size() ==
+            SignalDataFacade::maxFrameBytes(noise.size()));
+    }
+}
+
+TEST_CASE("Test codec corrupt frames", "[codec-corrupt]")
+{
+    auto digital = digitalSamples(1000, 9);
+    std::vector<std::byte> bytes;
+    SignalDataFacade::encodeFrame(eCodec::RLE, digital, bytes);
+    std::vector<uint16_t> samples(1000);
+
+    // Too little room, truncated, and mangled frames
+    REQUIRE_THROWS_AS(
+        SignalDataFacade::decodeFrame(
+            bytes, std::span(samples).first(999)),
+        std::out_of_range);
+    REQUIRE_THROWS_AS(
+        SignalDataFacade::decodeFrame(
+            std::span(bytes).first(bytes.size() - 1), samples),
+        std::runtime_error);
+    auto badCodec = bytes;
+    badCodec[0] = std::byte{99};
+    REQUIRE_THROWS_AS(
+        SignalDataFacade::peekFrame(badCodec), std::runtime_error);
+    auto badCount = bytes;
+    badCount[4] = std::byte(uint8_t(badCount[4]) + 1);
+    REQUIRE_THROWS_AS(
+        SignalDataFacade::decodeFrame(badCount, samples), std::runtime_error);
+
+    bytes.clear();
+    SignalDataFacade::encodeFrame(
+        eCodec::DELTA_BITPACK, analogSamples(1000, 9), bytes);
+    // The first block's bit width
+    bytes[sizeof(SignalDataFacade::sCodecFrameHeader)] = std::byte{17};
+    REQUIRE_THROWS_AS(
+        SignalDataFacade::decodeFrame(bytes, samples), std::runtime_error);
+    REQUIRE_THROWS_AS(
+        SignalDataFacade::encodeFrame(eCodec(7), samples, bytes),
+        std::invalid_argument);
+
+    // Frames written in place need room for the largest one
+    std::vector<std::byte> room(SignalDataFacade::maxFrameBytes(1000) - 1);
+    REQUIRE_THROWS_AS(
+        SignalDataFacade::encodeFrame(
+            eCodec::RLE, digital, std::span<std::byte>(room)),
+        std::out_of_range);
+}
+
+TEST_CASE("Test sample stream codec", "[codec-stream]")
+{
+    auto analog = analogSamples(20000, 11);
+    auto digital = digitalSamples(20000, 11);
+    std::vector<Sample> samples(analog.size());
+    for (size_t i = 0; i < samples.size(); ++i)
+    {
+        samples[i] = {analog[i], digital[i]};
+    }
+
+    // Two batches concatenated into one stream
+    SignalDataFacade::SampleStreamCodec codec;
+    std::vector<std::byte> stream;
+    size_t firstBytes = codec.encode(std::span(samples).first(7000), stream);
+    codec.encode(std::span(samples).subspan(7000), stream);
+    REQUIRE(codec.compressionRatio() > 2.0);
+    REQUIRE(codec.encodeGBps() > 0.0);
+
+    std::vector<Sample> decoded;
+    REQUIRE(codec.decode(stream, decoded) == firstBytes);
+    codec.decode(std::span(stream).subspan(firstBytes), decoded);
+    REQUIRE(decoded.size() == samples.size());
+    for (size_t i = 0; i < samples.size(); ++i)
+    {
+        REQUIRE(decoded[i].analog == samples[i].analog);
+        REQUIRE(decoded[i].digital == samples[i].digital);
+    }
+    REQUIRE(codec.decodeGBps() > 0.0);
+
+    codec.resetTotals();
+    REQUIRE(codec.compressionRatio() == 1.0);
+}
+
+//-----------------------------------------------------------------------------
+// Benchmarks (hidden, run with: ./test_facadepattern_codec "[benchmark]")
+//-----------------------------------------------------------------------------
+
+TEST_CASE(
+    "Benchmark codec throughput",
+    "[.][benchmark][codec-benchmark]")
+{
+    constexpr size_t NUM_SAMPLES = 16 << 20;
+    constexpr size_t FRAME_SAMPLES = 65536;
+    constexpr int NUM_PASSES = 4;
+    using Clock = std::chrono::steady_clock;
+
+    auto analog = analogSamples(NUM_SAMPLES, 1);
+    auto digital = digitalSamples(NUM_SAMPLES, 1);
+    for (auto codec : {eCodec::DELTA_BITPACK, eCodec::RLE})
+    {
+        const auto& samples = codec == eCodec::RLE ? digital : analog;
+        for (auto level : ALL_LEVELS)
+        {
+            std::vector<std::byte> bytes;
+            bytes.reserve(SignalDataFacade::maxFrameBytes(NUM_SAMPLES) * 2);
+            auto start = Clock::now();
+            for (int pass = 0; pass < NUM_PASSES; ++pass)
+            {
+                bytes.clear();
+                for (size_t i = 0; i < NUM_SAMPLES; i += FRAME_SAMPLES)
+                {
+                    SignalDataFacade::encodeFrame(
+                        codec,
+                        std::span(samples).subspan(i, FRAME_SAMPLES),
+                        bytes,
+                        level);
+                }
+            }
+            std::chrono::duration<double> encodeTime = Clock::now() - start;
+
+            std::vector<uint16_t> decoded(NUM_SAMPLES);
+            start = Clock::now();
+            for (int pass = 0; pass < NUM_PASSES; ++pass)
+            {
+                size_t offset = 0;
+                for (size_t i = 0; i < NUM_SAMPLES; i += FRAME_SAMPLES)
+                {
+                    offset += SignalDataFacade::decodeFrame(
+                        std::span(bytes).subspan(offset),
+                        std::span(decoded).subspan(i),
+                        level);
+                }
+            }
+            std::chrono::duration<double> decodeTime = Clock::now() - start;
+
+            REQUIRE(decoded == samples);
+            double rawBytes = double(NUM_SAMPLES * sizeof(uint16_t));
+            std::cout << SignalDataFacade::toString(codec)
+                      << " "
+                      << SignalDataFacade::toString(level)
+                      << ": ratio "
+                      << rawBytes / double(bytes.size())
+                      << ", encode "
+                      << rawBytes * NUM_PASSES / encodeTime.count() / 1e9
+                      << " GB/s, decode "
+                      << rawBytes * NUM_PASSES / decodeTime.count() / 1e9
+                      << " GB/s"
+                      << std::endl;
+        }
+    }
+}
@@ -0,0 +1,393 @@
+// Copyright (c) 2025 Michael Dello
+//
+// This software is provided under the MIT License.
+// See LICENSE file for details.
+
+//-----------------------------------------------------------------------------
+// Derived Channels Unit Tests
+//-----------------------------------------------------------------------------
+#define CATCH_CONFIG_MAIN
+// Include EVERYTHING from Catch2 (version 3)
+// This avoids the need to create a main() for unit testing
+#include <catch2/catch_all.hpp>
+// Alternatively, only include what is needed
+// #include <catch2/catch_test_macros.hpp> // Basic test macros
+// #include <catch2/catch_approx.hpp>  // Approximate floating-point comparisons
+// #include <catch2/catch_reporter_console.hpp> // Console reporting
+// #define CATCH_CONFIG_MAIN // Generates Catch2's main function
+// #include <catch2/catch_test_macros.hpp>
+
+// Create a custom main() instead:
+/* int main(int argc, char* argv[]) {
+    Catch::Session session; // Create Catch2 session
+    return session.run(argc, argv);
+} */
+
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+#include <memory>
+#include <random>
+#include <stdexcept>
+#include <vector>
+#include "facadepattern_derived.h"
+#include "facadepattern_generator.h"
+
+//-----------------------------------------------------------------------------
+// Test Helpers
+//-----------------------------------------------------------------------------
+
+namespace
+{
+    using SignalDataFacade::DerivedChannel;
+    using SignalDataFacade::DerivedChannels;
+
+    constexpr SignalDataFacade::eSimdLevel ALL_LEVELS[] =
+    {
+        SignalDataFacade::eSimdLevel::SCALAR,
+        SignalDataFacade::eSimdLevel::SSE4,
+        SignalDataFacade::eSimdLevel::AVX2
+    };
+
+    //-------------------------------------------------------------------------
+    std::vector<uint16_t> randomColumn(size_t count, uint64_t seed)
+    {
+        std::mt19937_64 rng(seed);
+        std::vector<uint16_t> column(count);
+        for (auto& sample : column)
+        {
+            sample = uint16_t(rng());
+        }
+        return column;
+    }
+
+    //-------------------------------------------------------------------------
+    // Trailing mean over the whole stream, the window shrunk at its start
+    std::vector<double> referenceMovingAverage(
+        const std::vector<double>& values,
+        size_t window)
+    {
+        std::vector<double> averages(values.size());
+        for (size_t i = 0; i < values.size(); ++i)
+        {
+            size_t first = i + 1 >= window ? i + 1 - window : 0;
+            double sum = 0.0;
+            for (size_t j = first; j <= i; ++j)
+            {
+                sum += values[j];
+            }
+            averages[i] = sum / double(i + 1 - first);
+        }
+        return averages;
+    }
+
+} // namespace anonymous
+
+//=============================================================================
+// DerivedChannels Unit Tests
+//=============================================================================
+
+TEST_CASE("Test derived element-wise channels", "[derived-elementwise]")
+{
+    // Several tiles and a tail no kernel width divides
+    constexpr size_t LENGTH = 3 * DerivedChannels::TILE_SAMPLES + 37;
+    auto analog = randomColumn(LENGTH, 1);
+    auto digital = randomColumn(LENGTH, 2);
+    auto reference = randomColumn(LENGTH, 3);
+
+    for (auto level : ALL_LEVELS)
+    {
+        DerivedChannels graph{3, level};
+        REQUIRE(graph.simdLevel() <= level);
+        DerivedChannel raw = graph.source(DerivedChannels::ANALOG_SOURCE);
+        DerivedChannel volts = graph.scaled(raw, 20.0f / 65535.0f, -10.0f);
+        DerivedChannel gated = graph.masked(
+            volts, DerivedChannels::DIGITAL_SOURCE, 3);
+        DerivedChannel gatedLow = graph.masked(
+            raw, DerivedChannels::DIGITAL_SOURCE, 0, false);
+        DerivedChannel error = graph.difference(
+            graph.scaled(graph.scaled(raw, 2.0f), 0.5f, 1.0f),
+            graph.source(2));
+        // Nested differences need more than one tile of stack
+        DerivedChannel nested = graph.difference(
+            raw, graph.difference(graph.source(2), gated));
+
+        const std::span<const uint16_t> columns[] = {
+            analog, digital, reference};
+        graph.setSources(columns);
+        auto voltsValues = graph.read(volts);
+        auto gatedValues = graph.read(gated);
+        auto gatedLowValues = graph.read(gatedLow);
+        auto errorValues = graph.read(error);
+        auto nestedValues = graph.read(nested);
+        REQUIRE(voltsValues.size() == LENGTH);
+        for (size_t i = 0; i < LENGTH; ++i)
+        {
+            double expectedVolts = analog[i] * (20.0 / 65535.0) - 10.0;
+            double expectedGated = (digital[i] & 0x8) ? expectedVolts : 0.0;
+            REQUIRE(voltsValues[i] ==
+                Catch::Approx(expectedVolts).margin(1e-5));
+            REQUIRE(gatedValues[i] ==
+                Catch::Approx(expectedGated).margin(1e-5));
+            REQUIRE(gatedLowValues[i] ==
+                ((digital[i] & 1) ? 0.0f : float(analog[i])));
+            REQUIRE(errorValues[i] ==
+                Catch::Approx(double(analog[i]) + 1.0 - reference[i]));
+            REQUIRE(nestedValues[i] == Catch::Approx(
+                double(analog[i]) - reference[i] + expectedGated)
+                .margin(1e-2));
+        }
+    }
+}
+
+TEST_CASE("Test derived moving averages across blocks", "[derived-average]")
+{
+    constexpr size_t WINDOW = 100;
+    auto analog = randomColumn(20000, 4);
+    auto digital = randomColumn(analog.size(), 5);
+
+    std::vector<double> gated(analog.size());
+    for (size_t i = 0; i < analog.size(); ++i)
+    {
+        gated[i] = (digital[i] & 1) ? 0.5 * analog[i] : 0.0;
+    }
+    auto expected = referenceMovingAverage(gated, WINDOW);
+    // An average of an average, and a difference with one
+    auto expectedSmoothed = referenceMovingAverage(expected, 10);
+
+    for (auto level : ALL_LEVELS)
+    {
+        DerivedChannels graph{2, level};
+        DerivedChannel average = graph.movingAverage(
+            graph.masked(
+                graph.scaled(graph.source(0), 0.5f),
+                DerivedChannels::DIGITAL_SOURCE,
+                0),
+            WINDOW);
+        DerivedChannel smoothed = graph.movingAverage(average, 10);
+        DerivedChannel detrended = graph.difference(graph.source(0), average);
+
+        // Blocks of varying size, shorter and longer than the window, and
+        // the averages only read every other block
+        std::mt19937_64 rng(6);
+        size_t first = 0;
+        for (size_t block = 0; first < analog.size(); ++block)
+        {
+            size_t count = std::min<size_t>(
+                analog.size() - first, 1 + rng() % (3 * WINDOW));
+            graph.setBlock({
+                std::span(analog).subspan(first, count),
+                std::span(digital).subspan(first, count)});
+            if (block % 2 == 0)
+            {
+                auto averages = graph.read(average);
+                auto smoothedValues = graph.read(smoothed);
+                auto detrendedValues = graph.read(detrended);
+                for (size_t i = 0; i < count; ++i)
+                {
+                    REQUIRE(averages[i] == Catch::Approx(expected[first + i])
+                        .margin(1e-3));
+                    REQUIRE(smoothedValues[i] ==
+                        Catch::Approx(expectedSmoothed[first + i])
+                            .margin(1e-3));
+                    REQUIRE(detrendedValues[i] == Catch::Approx(
+                        analog[first + i] - expected[first + i])
+                        .margin(1e-2));
+                }
+            }
+            first += count;
+        }
+
+        // A new stream starts with an empty window
+        graph.reset();
+        graph.setBlock({
+            std::span(analog).first(10), std::span(digital).first(10)});
+        auto averages = graph.read(average);
+        for (size_t i = 0; i < 10; ++i)
+        {
+            REQUIRE(averages[i] == Catch::Approx(expected[i]).margin(1e-3));
+        }
+    }
+}
+
+TEST_CASE("Test derived channel caching", "[derived-caching]")
+{
+    auto analog = randomColumn(1000, 7);
+    auto digital = randomColumn(1000, 8);
+    auto reference = randomColumn(1000, 9);
+
+    DerivedChannels graph{3};
+    DerivedChannel volts = graph.scaled(graph.source(0), 0.001f);
+    // Declared twice, stored once
+    REQUIRE(graph.scaled(graph.source(0), 0.001f) == volts);
+    REQUIRE(graph.numChannels() == 2);
+    REQUIRE(graph.op(volts) == SignalDataFacade::eDerivedOp::SCALED);
+    DerivedChannel gated = graph.masked(volts, 1, 2);
+    DerivedChannel error = graph.difference(volts, graph.source(2));
+
+    const std::span<const uint16_t> columns[] = {analog, digital, reference};
+    graph.setSources(columns);
+    REQUIRE(graph.evaluations() == 0);
+
+    // Computed on first read only
+    auto voltsValues = graph.read(volts);
+    graph.read(volts);
+    REQUIRE(graph.evaluations() == 1);
+    // Built on the cached subexpression
+    graph.read(gated);
+    graph.read(error);
+    REQUIRE(graph.evaluations() == 3);
+    graph.read(gated);
+    REQUIRE(graph.evaluations() == 3);
+
+    // A new reference only invalidates what depends on it
+    auto newReference = randomColumn(1000, 10);
+    graph.setSource(2, newReference);
+    graph.read(volts);
+    graph.read(gated);
+    REQUIRE(graph.evaluations() == 3);
+    auto errorValues = graph.read(error);
+    REQUIRE(graph.evaluations() == 4);
+    REQUIRE(errorValues[5] == voltsValues[5] - float(newReference[5]));
+
+    // A whole new block invalidates everything. Shared by gated and
+    // error, volts is computed once for both rather than fused into each.
+    graph.setSources(columns);
+    graph.read(gated);
+    REQUIRE(graph.evaluations() == 6);
+    graph.read(error);
+    graph.read(volts);
+    REQUIRE(graph.evaluations() == 7);
+}
+
+TEST_CASE("Test derived channel errors", "[derived-errors]")
+{
+    REQUIRE_THROWS_AS(DerivedChannels{0}, std::invalid_argument);
+    REQUIRE_THROWS_AS(
+        DerivedChannels{DerivedChannels::MAX_SOURCES + 1},
+        std::invalid_argument);
+
+    DerivedChannels graph;
+    DerivedChannel raw = graph.source(0);
+    REQUIRE_THROWS_AS(graph.source(2), std::out_of_range);
+    REQUIRE_THROWS_AS(graph.scaled(7, 1.0f), std::out_of_range);
+    REQUIRE_THROWS_AS(graph.masked(raw, 2, 0), std::out_of_range);
+    REQUIRE_THROWS_AS(graph.masked(raw, 1, 16), std::invalid_argument);
+    REQUIRE_THROWS_AS(graph.movingAverage(raw, 0), std::invalid_argument);
+    REQUIRE_THROWS_AS(graph.read(9), std::out_of_range);
+    REQUIRE_THROWS_AS(graph.setSource(2, {}), std::out_of_range);
+    const std::span<const uint16_t> oneColumn[1] = {};
+    REQUIRE_THROWS_AS(graph.setSources(oneColumn), std::invalid_argument);
+
+    // Nothing set yet reads as empty
+    REQUIRE(graph.read(raw).empty());
+
+    std::vector<uint16_t> longer(10);
+    std::vector<uint16_t> shorter(9);
+    graph.setBlock({longer, shorter});
+    REQUIRE(graph.read(raw).size() == 10);
+    REQUIRE_THROWS_AS(
+        graph.read(graph.masked(raw, 1, 0)), std::invalid_argument);
+}
+
+TEST_CASE(
+    "Test derived channels over acquired blocks",
+    "[derived-acquisition]")
+{
+    SignalDataFacade::sWaveformConfig_t config;
+    config.waveform = SignalDataFacade::eWaveform::SQUARE;
+    SignalDataFacade::SignalData engine{
+        std::make_unique<SignalDataFacade::A2DConverterHAL>(
+            std::make_unique<SignalDataFacade::SyntheticADCDrv>(config)),
+        std::make_unique<SignalDataFacade::GPIOHAL>(
+            std::make_unique<SignalDataFacade::SyntheticGPIODrv>(
+                SignalDataFacade::sGpioGeneratorConfig_t{}))};
+
+    DerivedChannels graph;
+    DerivedChannel volts = graph.scaled(
+        graph.source(DerivedChannels::ANALOG_SOURCE), 1e-4f);
+    DerivedChannel gated = graph.masked(
+        volts, DerivedChannels::DIGITAL_SOURCE, 0);
+
+    SignalDataFacade::SampleBlock block{4096};
+    for (int cycle = 0; cycle < 5; ++cycle)
+    {
+        block.clear();
+        engine.acquireBatch(block, 4096);
+        graph.setBlock(block.view());
+        auto values = graph.read(gated);
+        REQUIRE(values.size() == block.size());
+        for (size_t i = 0; i < block.size(); ++i)
+        {
+            float expected = (block.digital()[i] & 1) ?
+                float(block.analog()[i]) * 1e-4f : 0.0f;
+            REQUIRE(values[i] == Catch::Approx(expected));
+        }
+    }
+}
+
+//-----------------------------------------------------------------------------
+// Benchmarks (hidden, run with: ./test_facadepattern_derived "[benchmark]")
+//-----------------------------------------------------------------------------
+
+TEST_CASE(
+    "Benchmark derived channels",
+    "[.][benchmark][derived-benchmark]")
+{
+    constexpr size_t BLOCK = 1 << 16;
+    constexpr size_t NUM_BLOCKS = 256;
+    using Clock = std::chrono::steady_clock;
+
+    auto analog = randomColumn(BLOCK, 11);
+    auto digital = randomColumn(BLOCK, 12);
+    auto reference = randomColumn(BLOCK, 13);
+    const std::span<const uint16_t> columns[] = {analog, digital, reference};
+
+    auto report = [](const char* pName, Clock::duration elapsed)
+    {
+        std::chrono::duration<double> seconds = elapsed;
+        std::cout << pName
+                  << double(BLOCK * NUM_BLOCKS) / seconds.count() / 1e6
+                  << " Msamples/s"
+                  << std::endl;
+    };
+
+    // Ad hoc loops, one full pass and intermediate column per operation
+    std::vector<float> volts(BLOCK);
+    std::vector<float> gated(BLOCK);
+    std::vector<float> error(BLOCK);
+    auto start = Clock::now();
+    for (size_t block = 0; block < NUM_BLOCKS; ++block)
+    {
+        for (size_t i = 0; i < BLOCK; ++i)
+        {
+            volts[i] = float(analog[i]) * 3e-4f - 10.0f;
+        }
+        for (size_t i = 0; i < BLOCK; ++i)
+        {
+            gated[i] = (digital[i] & 4) ? volts[i] : 0.0f;
+        }
+        for (size_t i = 0; i < BLOCK; ++i)
+        {
+            error[i] = gated[i] - float(reference[i]) * 3e-4f;
+        }
+    }
+    report("separate passes: ", Clock::now() - start);
+
+    for (auto level : ALL_LEVELS)
+    {
+        DerivedChannels graph{3, level};
+        DerivedChannel channel = graph.difference(
+            graph.masked(
+                graph.scaled(graph.source(0), 3e-4f, -10.0f), 1, 2),
+            graph.scaled(graph.source(2), 3e-4f));
+        start = Clock::now();
+        for (size_t block = 0; block < NUM_BLOCKS; ++block)
+        {
+            graph.setSources(columns);
+            graph.read(channel);
+        }
+        std::cout << SignalDataFacade::toString(graph.simdLevel()) << " ";
+        report("fused graph: ", Clock::now() - start);
+    }
+}
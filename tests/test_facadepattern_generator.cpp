@@ -0,0 +1,372 @@
+// Copyright (c) 2025 Michael Dello
+//
+// This software is provided under the MIT License.
+// See LICENSE file for details.
+
+//-----------------------------------------------------------------------------
+// Synthetic Signal Generator Unit Tests
+//-----------------------------------------------------------------------------
+#define CATCH_CONFIG_MAIN
+// Include EVERYTHING from Catch2 (version 3)
+// This avoids the need to create a main() for unit testing
+#include <catch2/catch_all.hpp>
+// Alternatively, only include what is needed
+// #include <catch2/catch_test_macros.hpp> // Basic test macros
+// #include <catch2/catch_approx.hpp>  // Approximate floating-point comparisons
+// #include <catch2/catch_reporter_console.hpp> // Console reporting
+// #define CATCH_CONFIG_MAIN // Generates Catch2's main function
+// #include <catch2/catch_test_macros.hpp>
+
+// Create a custom main() instead:
+/* int main(int argc, char* argv[]) {
+    Catch::Session session; // Create Catch2 session
+    return session.run(argc, argv);
+} */
+
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+#include <memory>
+#include <numeric>
+#include <stdexcept>
+#include <vector>
+#include "common/xoshiro.h"
+#include "facadepattern_generator.h"
+
+//-----------------------------------------------------------------------------
+// Test Helpers
+//-----------------------------------------------------------------------------
+
+namespace
+{
+    std::vector<uint16_t> generateSamples(
+        const SignalDataFacade::sWaveformConfig_t& config,
+        size_t count)
+    {
+        SignalDataFacade::SignalGenerator generator(config);
+        std::vector<uint16_t> samples(count);
+        generator.generate(samples);
+        return samples;
+    }
+
+    //-------------------------------------------------------------------------
+    // Upward crossings of the center in [begin, end)
+    size_t risingCrossings(
+        const std::vector<uint16_t>& samples,
+        size_t begin,
+        size_t end,
+        uint16_t center)
+    {
+        size_t count = 0;
+        for (size_t i = begin + 1; i < end; ++i)
+        {
+            count += samples[i - 1] < center && samples[i] >= center;
+        }
+        return count;
+    }
+
+} // namespace anonymous
+
+//=============================================================================
+// Xoshiro256pp Unit Tests
+//=============================================================================
+
+TEST_CASE("Test Xoshiro256pp reference outputs", "[xoshiro-reference]")
+{
+    // From the reference implementation, with state {1, 2, 3, 4}
+    auto rng = Random::Xoshiro256pp::fromState({1, 2, 3, 4});
+    REQUIRE(rng() == 41943041);
+    REQUIRE(rng() == 58720359);
+    REQUIRE(rng() == 3588806011781223);
+}
+
+TEST_CASE("Test Xoshiro256pp seeding and jump", "[xoshiro-seeding]")
+{
+    Random::Xoshiro256pp first(42);
+    Random::Xoshiro256pp second(42);
+    Random::Xoshiro256pp other(43);
+    bool bAnyDifferent = false;
+    for (int i = 0; i < 100; ++i)
+    {
+        uint64_t value = first();
+        REQUIRE(value == second());
+        bAnyDifferent |= value != other();
+    }
+    REQUIRE(bAnyDifferent);
+
+    // A jumped generator starts a distinct stream
+    Random::Xoshiro256pp jumped(42);
+    jumped.jump();
+    REQUIRE(jumped() != Random::Xoshiro256pp(42)());
+
+    for (int i = 0; i < 1000; ++i)
+    {
+        double uniform = first.nextDouble();
+        REQUIRE(uniform >= 0.0);
+        REQUIRE(uniform < 1.0);
+    }
+}
+
+//=============================================================================
+// SignalGenerator Unit Tests
+//=============================================================================
+
+TEST_CASE("Test SignalGenerator determinism", "[generator-determinism]")
+{
+    SignalDataFacade::sWaveformConfig_t config;
+    config.waveform = SignalDataFacade::eWaveform::STEPS;
+    config.frequencyHz = 10'000.0;
+    config.noiseAmplitude = 100;
+    config.glitchProbability = 0.001;
+    config.seed = 7;
+
+    auto expected = generateSamples(config, 100'000);
+
+    SECTION("Equal seeds give equal streams, whatever the block sizes")
+    {
+        SignalDataFacade::SignalGenerator generator(config);
+        std::vector<uint16_t> samples(expected.size());
+        size_t done = 0;
+        for (size_t blockSize = 1; done < samples.size(); blockSize += 37)
+        {
+            size_t count = std::min(blockSize, samples.size() - done);
+            generator.generate(std::span(samples).subspan(done, count));
+            done += count;
+        }
+        REQUIRE(samples == expected);
+
+        generator.reset();
+        REQUIRE(generator.next() == expected[0]);
+        REQUIRE(generator.next() == expected[1]);
+    }
+
+    SECTION("Different seeds give different streams")
+    {
+        config.seed = 8;
+        REQUIRE(generateSamples(config, expected.size()) != expected);
+    }
+}
+
+TEST_CASE("Test SignalGenerator periodic waveforms", "[generator-periodic]")
+{
+    SignalDataFacade::sWaveformConfig_t config;
+    // A power of two samples per period, so phases are exact
+    config.sampleRateHz = 128'000.0;
+    config.frequencyHz = 1'000.0;
+    config.center = 30000;
+    config.amplitude = 10000;
+
+    SECTION("Sine")
+    {
+        auto samples = generateSamples(config, 1024);
+        // 128 samples per period
+        REQUIRE(samples[0] == 30000);
+        REQUIRE(samples[32] == 40000);
+        REQUIRE(samples[96] == 20000);
+        REQUIRE(*std::min_element(samples.begin(), samples.end()) >= 20000);
+        REQUIRE(*std::max_element(samples.begin(), samples.end()) <= 40000);
+        REQUIRE(risingCrossings(samples, 0, samples.size(), 30000) == 7);
+    }
+
+    SECTION("Square")
+    {
+        config.waveform = SignalDataFacade::eWaveform::SQUARE;
+        config.dutyCycle = 0.25;
+        auto samples = generateSamples(config, 12'800);
+        size_t numHigh = std::count(samples.begin(), samples.end(), 40000);
+        size_t numLow = std::count(samples.begin(), samples.end(), 20000);
+        REQUIRE(numHigh + numLow == samples.size());
+        REQUIRE(numHigh == 3'200);
+        REQUIRE(samples[31] == 40000);
+        REQUIRE(samples[32] == 20000);
+    }
+
+    SECTION("Chirp")
+    {
+        config.waveform = SignalDataFacade::eWaveform::CHIRP;
+        config.chirpEndHz = 10'000.0;
+        config.sweepSeconds = 0.1;
+        auto samples = generateSamples(config, 25'600);
+        // Frequency rises through each 12800 sample sweep, then restarts
+        size_t early = risingCrossings(samples, 0, 2'560, 30000);
+        size_t late = risingCrossings(samples, 10'240, 12'800, 30000);
+        size_t restarted = risingCrossings(samples, 12'800, 15'360, 30000);
+        REQUIRE(late > 3 * early);
+        REQUIRE(restarted < late);
+    }
+}
+
+TEST_CASE("Test SignalGenerator random waveforms", "[generator-random]")
+{
+    SignalDataFacade::sWaveformConfig_t config;
+    config.center = 1000;
+    config.amplitude = 500;
+
+    SECTION("Noise stays within its amplitude")
+    {
+        config.waveform = SignalDataFacade::eWaveform::NOISE;
+        auto samples = generateSamples(config, 100'000);
+        REQUIRE(*std::min_element(samples.begin(), samples.end()) >= 500);
+        REQUIRE(*std::max_element(samples.begin(), samples.end()) <= 1500);
+        double mean =
+            std::accumulate(samples.begin(), samples.end(), 0.0) /
+            samples.size();
+        REQUIRE(mean == Catch::Approx(1000.0).margin(5.0));
+    }
+
+    SECTION("Steps hold evenly spaced levels")
+    {
+        config.waveform = SignalDataFacade::eWaveform::STEPS;
+        config.frequencyHz = 10'000.0;
+        config.numLevels = 5;
+        auto samples = generateSamples(config, 10'000);
+        // 100 samples per step
+        for (size_t i = 0; i < samples.size(); ++i)
+        {
+            REQUIRE((samples[i] - 500) % 250 == 0);
+            REQUIRE(samples[i] == samples[i / 100 * 100]);
+        }
+    }
+
+    SECTION("Glitches occur at the configured rate")
+    {
+        config.waveform = SignalDataFacade::eWaveform::STEPS;
+        config.numLevels = 1;
+        config.glitchProbability = 0.01;
+        auto samples = generateSamples(config, 100'000);
+        size_t numGlitches = std::count_if(
+            samples.begin(),
+            samples.end(),
+            [](uint16_t sample) { return sample != 1000; });
+        REQUIRE(numGlitches > 800);
+        REQUIRE(numGlitches < 1200);
+    }
+}
+
+TEST_CASE("Test SignalGenerator invalid configuration", "[generator-invalid]")
+{
+    SignalDataFacade::sWaveformConfig_t config;
+    config.frequencyHz = config.sampleRateHz / 2;
+    REQUIRE_THROWS_AS(
+        SignalDataFacade::SignalGenerator(config), std::invalid_argument);
+
+    config = {};
+    config.waveform = SignalDataFacade::eWaveform::SQUARE;
+    config.dutyCycle = 1.5;
+    REQUIRE_THROWS_AS(
+        SignalDataFacade::SignalGenerator(config), std::invalid_argument);
+
+    config = {};
+    config.glitchProbability = -0.1;
+    REQUIRE_THROWS_AS(
+        SignalDataFacade::SignalGenerator(config), std::invalid_argument);
+
+    SignalDataFacade::sGpioGeneratorConfig_t gpioConfig;
+    gpioConfig.lines.resize(17);
+    REQUIRE_THROWS_AS(
+        SignalDataFacade::SyntheticGPIODrv(gpioConfig),
+        std::invalid_argument);
+}
+
+//=============================================================================
+// Synthetic Driver Unit Tests
+//=============================================================================
+
+TEST_CASE("Test synthetic drivers through the HALs", "[generator-drivers]")
+{
+    SignalDataFacade::sWaveformConfig_t config;
+    config.noiseAmplitude = 50;
+    config.seed = 3;
+    auto expected = generateSamples(config, 300);
+
+    SECTION("ADC readBlock() follows the generator")
+    {
+        SignalDataFacade::A2DConverterHAL hal(
+            std::make_unique<SignalDataFacade::SyntheticADCDrv>(config));
+        std::vector<uint16_t> samples(expected.size());
+        REQUIRE(hal.readBlock(std::span(samples).first(100)) == 100);
+        REQUIRE(hal.readBlock(std::span(samples).subspan(100)) == 200);
+        REQUIRE(samples == expected);
+    }
+
+    SECTION("ADC reads only while started, scans replicate channels")
+    {
+        SignalDataFacade::SyntheticADCDrv adc(config);
+        REQUIRE_FALSE(adc.read().has_value());
+
+        std::vector<uint8_t> channels{0, 1, 2};
+        REQUIRE(adc.configureScan(channels));
+        std::vector<uint16_t> frames(3 * expected.size());
+        adc.start();
+        REQUIRE(adc.scan(frames) == expected.size());
+        for (size_t i = 0; i < expected.size(); ++i)
+        {
+            REQUIRE(frames[3 * i] == expected[i]);
+            REQUIRE(frames[3 * i + 2] == expected[i]);
+        }
+    }
+
+    SECTION("GPIO lines are square waves")
+    {
+        SignalDataFacade::sGpioGeneratorConfig_t gpioConfig;
+        gpioConfig.sampleRateHz = 1024.0;
+        gpioConfig.lines = {{128.0, 0.5}, {64.0, 0.25}};
+        SignalDataFacade::GPIOHAL hal(
+            std::make_unique<SignalDataFacade::SyntheticGPIODrv>(gpioConfig));
+        std::vector<uint16_t> samples(32);
+        hal.readBlock(samples);
+        for (size_t i = 0; i < samples.size(); ++i)
+        {
+            uint16_t expectedWord =
+                (i % 8 < 4 ? 1 : 0) | (i % 16 < 4 ? 2 : 0);
+            REQUIRE(samples[i] == expectedWord);
+        }
+        REQUIRE(hal.read() == 3);
+    }
+}
+
+//-----------------------------------------------------------------------------
+// Benchmarks (hidden, run with: ./test_facadepattern_generator "[benchmark]")
+//-----------------------------------------------------------------------------
+
+TEST_CASE(
+    "Benchmark SignalGenerator waveforms",
+    "[.][benchmark][generator-benchmark]")
+{
+    constexpr size_t NUM_SAMPLES = 64 << 20;
+    constexpr size_t BLOCK_SIZE = 4096;
+    constexpr SignalDataFacade::eWaveform WAVEFORMS[] =
+    {
+        SignalDataFacade::eWaveform::SINE,
+        SignalDataFacade::eWaveform::SQUARE,
+        SignalDataFacade::eWaveform::CHIRP,
+        SignalDataFacade::eWaveform::NOISE,
+        SignalDataFacade::eWaveform::STEPS
+    };
+
+    std::vector<uint16_t> block(BLOCK_SIZE);
+    for (auto waveform : WAVEFORMS)
+    {
+        SignalDataFacade::sWaveformConfig_t config;
+        config.waveform = waveform;
+        config.glitchProbability = 1e-6;
+        SignalDataFacade::SignalGenerator generator(config);
+
+        uint64_t checksum = 0;
+        auto start = std::chrono::steady_clock::now();
+        for (size_t done = 0; done < NUM_SAMPLES; done += BLOCK_SIZE)
+        {
+            generator.generate(block);
+            checksum += block[done % BLOCK_SIZE];
+        }
+        std::chrono::duration<double> elapsed =
+            std::chrono::steady_clock::now() - start;
+
+        REQUIRE(checksum > 0);
+        std::cout << SignalDataFacade::toString(waveform)
+                  << ": "
+                  << double(NUM_SAMPLES) / elapsed.count() / 1e6
+                  << " Msamples/s"
+                  << std::endl;
+    }
+}
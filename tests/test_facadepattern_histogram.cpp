@@ -0,0 +1,457 @@
+// Copyright (c) 2025 Michael Dello
+//
+// This software is provided under the MIT License.
+// See LICENSE file for details.
+
+//-----------------------------------------------------------------------------
+// Streaming Histogram and Quantile Sketch Unit Tests
+//-----------------------------------------------------------------------------
+#define CATCH_CONFIG_MAIN
+// Include EVERYTHING from Catch2 (version 3)
+// This avoids the need to create a main() for unit testing
+#include <catch2/catch_all.hpp>
+// Alternatively, only include what is needed
+// #include <catch2/catch_test_macros.hpp> // Basic test macros
+// #include <catch2/catch_approx.hpp>  // Approximate floating-point comparisons
+// #include <catch2/catch_reporter_console.hpp> // Console reporting
+// #define CATCH_CONFIG_MAIN // Generates Catch2's main function
+// #include <catch2/catch_test_macros.hpp>
+
+// Create a custom main() instead:
+/* int main(int argc, char* argv[]) {
+    Catch::Session session; // Create Catch2 session
+    return session.run(argc, argv);
+} */
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <iostream>
+#include <numeric>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+#include "facadepattern_generator.h"
+#include "facadepattern_histogram.h"
+#include "facadepattern_sampleblock.h"
+
+//-----------------------------------------------------------------------------
+// Test Helpers
+//-----------------------------------------------------------------------------
+
+namespace
+{
+    using SignalDataFacade::QuantileSketch;
+    using SignalDataFacade::SampleHistogram;
+
+    constexpr double MONITORED_QUANTILES[] = {0.01, 0.5, 0.99};
+
+    //-------------------------------------------------------------------------
+    // A noisy sine with a few outliers, like a monitored analog channel
+    std::vector<uint16_t> testSignal(size_t count, uint64_t seed)
+    {
+        SignalDataFacade::SignalGenerator generator{{
+            .waveform = SignalDataFacade::eWaveform::SINE,
+            .sampleRateHz = 1'000'000.0,
+            .frequencyHz = 1234.0,
+            .noiseAmplitude = 500,
+            .glitchProbability = 0.001,
+            .seed = seed}};
+        std::vector<uint16_t> samples(count);
+        generator.generate(samples);
+        return samples;
+    }
+
+    //-------------------------------------------------------------------------
+    // Quantile by sorting, the definition the histogram implements
+    uint16_t sortedQuantile(std::vector<uint16_t> samples, double q)
+    {
+        std::sort(samples.begin(), samples.end());
+        auto rank = static_cast<size_t>(std::ceil(q * double(samples.size())));
+        return samples[std::clamp<size_t>(rank, 1, samples.size()) - 1];
+    }
+
+    //-------------------------------------------------------------------------
+    // Distance of q from the exact ranks of value, 0 when value is a valid
+    // q-quantile of the histogram's samples
+    double rankError(const SampleHistogram& exact, double value, double q)
+    {
+        auto code = static_cast<uint16_t>(value);
+        double n = double(exact.count());
+        double above = double(exact.rank(code)) / n;
+        double below = code ? double(exact.rank(uint16_t(code - 1))) / n : 0.0;
+        return std::max({below - q, q - above, 0.0});
+    }
+
+} // namespace anonymous
+
+//-----------------------------------------------------------------------------
+// Exact Histogram
+//-----------------------------------------------------------------------------
+
+TEST_CASE("Test exact sample histogram", "[histogram-exact]")
+{
+    auto samples = testSignal(100000, 1);
+    SampleHistogram histogram;
+    histogram.add(samples);
+
+    REQUIRE(histogram.count() == samples.size());
+    REQUIRE(histogram.min() ==
+            *std::min_element(samples.begin(), samples.end()));
+    REQUIRE(histogram.max() ==
+            *std::max_element(samples.begin(), samples.end()));
+    double sum = std::accumulate(samples.begin(), samples.end(), 0.0);
+    REQUIRE(histogram.mean() ==
+            Catch::Approx(sum / double(samples.size())));
+    REQUIRE(histogram.countOf(samples[0]) ==
+            size_t(std::count(samples.begin(), samples.end(), samples[0])));
+    REQUIRE(histogram.rank(32768) ==
+            size_t(std::count_if(
+                samples.begin(),
+                samples.end(),
+                [](uint16_t s) { return s <= 32768; })));
+
+    for (double q : {0.0, 0.001, 0.01, 0.25, 0.5, 0.75, 0.99, 0.999, 1.0})
+    {
+        REQUIRE(histogram.quantile(q) == sortedQuantile(samples, q));
+    }
+    // Asked out of order, answered in order
+    std::vector<double> qs{0.99, 0.01, 0.5, 0.01};
+    auto results = histogram.quantiles(qs);
+    for (size_t i = 0; i < qs.size(); ++i)
+    {
+        REQUIRE(results[i] == histogram.quantile(qs[i]));
+    }
+
+    // Single samples and edge codes
+    SampleHistogram edges;
+    edges.add(uint16_t{0});
+    edges.add(uint16_t{65535});
+    REQUIRE(edges.min() == 0);
+    REQUIRE(edges.max() == 65535);
+    REQUIRE(edges.quantile(0.5) == 0);
+    REQUIRE(edges.quantile(0.51) == 65535);
+
+    histogram.reset();
+    REQUIRE(histogram.count() == 0);
+    REQUIRE(histogram.quantile(0.5) == 0);
+    REQUIRE(histogram.min() == 0);
+    REQUIRE(histogram.max() == 0);
+    REQUIRE(histogram.mean() == 0.0);
+    REQUIRE_THROWS_AS(histogram.quantile(1.5), std::invalid_argument);
+    REQUIRE_THROWS_AS(histogram.quantile(-0.1), std::invalid_argument);
+    REQUIRE_THROWS_AS(histogram.quantile(std::nan("")), std::invalid_argument);
+}
+
+TEST_CASE("Test histogram merge across threads", "[histogram-merge]")
+{
+    constexpr size_t NUM_SHARDS = 4;
+    constexpr size_t SHARD_SAMPLES = 50000;
+    auto samples = testSignal(NUM_SHARDS * SHARD_SAMPLES, 2);
+
+    std::vector<SampleHistogram> shards(NUM_SHARDS);
+    std::vector<std::thread> threads;
+    for (size_t i = 0; i < NUM_SHARDS; ++i)
+    {
+        threads.emplace_back([&, i]
+        {
+            shards[i].add(
+                std::span(samples).subspan(i * SHARD_SAMPLES, SHARD_SAMPLES));
+        });
+    }
+    for (auto& thread : threads)
+    {
+        thread.join();
+    }
+
+    SampleHistogram merged;
+    for (const auto& shard : shards)
+    {
+        merged.merge(shard);
+    }
+    SampleHistogram whole;
+    whole.add(samples);
+
+    REQUIRE(merged.count() == whole.count());
+    for (size_t code = 0; code < SampleHistogram::NUM_BINS; ++code)
+    {
+        auto value = uint16_t(code);
+        REQUIRE(merged.countOf(value) == whole.countOf(value));
+    }
+}
+
+//-----------------------------------------------------------------------------
+// Quantile Sketch
+//-----------------------------------------------------------------------------
+
+TEST_CASE("Test quantile sketch accuracy", "[histogram-sketch]")
+{
+    constexpr size_t NUM_SAMPLES = 1'000'000;
+    auto samples = testSignal(NUM_SAMPLES, 3);
+    SampleHistogram exact;
+    exact.add(samples);
+
+    for (uint32_t k : {100u, QuantileSketch::DEFAULT_K, 400u})
+    {
+        QuantileSketch sketch(k);
+        // Uneven blocks, as a stream delivers them
+        for (size_t first = 0; first < NUM_SAMPLES; first += 7919)
+        {
+            size_t count = std::min<size_t>(7919, NUM_SAMPLES - first);
+            sketch.add(std::span(samples).subspan(first, count));
+        }
+
+        REQUIRE(sketch.count() == NUM_SAMPLES);
+        REQUIRE(sketch.min() == exact.min());
+        REQUIRE(sketch.max() == exact.max());
+        REQUIRE(sketch.quantile(0.0) == exact.min());
+        REQUIRE(sketch.quantile(1.0) == exact.max());
+        // O(k log(n / k)) retained samples, far fewer than n
+        REQUIRE(sketch.numRetained() < 4 * k);
+
+        // Rank error well within the bound of about 1.7 / k
+        double tolerance = 2.5 / k;
+        for (double q = 0.01; q < 1.0; q += 0.01)
+        {
+            REQUIRE(rankError(exact, sketch.quantile(q), q) <= tolerance);
+        }
+        for (uint16_t code : {exact.quantile(0.1), exact.quantile(0.9)})
+        {
+            double rank = double(exact.rank(code)) / double(NUM_SAMPLES);
+            REQUIRE(std::abs(sketch.rank(code) - rank) <= tolerance);
+        }
+    }
+
+    // Doubles, such as calibrated values
+    QuantileSketch volts;
+    std::vector<double> values(NUM_SAMPLES);
+    std::transform(
+        samples.begin(),
+        samples.end(),
+        values.begin(),
+        [](uint16_t s) { return s * 5.0 / 65535.0; });
+    volts.add(values);
+    REQUIRE(volts.quantile(0.5) ==
+            Catch::Approx(exact.quantile(0.5) * 5.0 / 65535.0).margin(0.05));
+
+    // Small inputs are kept whole, so quantiles are exact
+    QuantileSketch small;
+    for (double value : {5.0, 1.0, 4.0, 2.0, 3.0})
+    {
+        small.add(value);
+    }
+    REQUIRE(small.numLevels() == 1);
+    REQUIRE(small.quantile(0.5) == 3.0);
+    REQUIRE(small.quantile(0.2) == 1.0);
+    REQUIRE(small.rank(2.5) == Catch::Approx(0.4));
+
+    small.reset();
+    REQUIRE(small.count() == 0);
+    REQUIRE(small.quantile(0.5) == 0.0);
+    REQUIRE_THROWS_AS(small.quantile(2.0), std::invalid_argument);
+    REQUIRE_THROWS_AS(QuantileSketch(4), std::invalid_argument);
+}
+
+TEST_CASE("Test quantile sketch merge across threads", "[histogram-sketch]")
+{
+    constexpr size_t NUM_SHARDS = 8;
+    constexpr size_t SHARD_SAMPLES = 125000;
+    auto samples = testSignal(NUM_SHARDS * SHARD_SAMPLES, 4);
+    SampleHistogram exact;
+    exact.add(samples);
+
+    std::vector<QuantileSketch> shards;
+    for (size_t i = 0; i < NUM_SHARDS; ++i)
+    {
+        // Separate coin flips per shard
+        shards.emplace_back(QuantileSketch::DEFAULT_K, i + 1);
+    }
+    std::vector<std::thread> threads;
+    for (size_t i = 0; i < NUM_SHARDS; ++i)
+    {
+        threads.emplace_back([&, i]
+        {
+            shards[i].add(
+                std::span(samples).subspan(i * SHARD_SAMPLES, SHARD_SAMPLES));
+        });
+    }
+    for (auto& thread : threads)
+    {
+        thread.join();
+    }
+
+    // Merge as a tree, as shards of shards would be
+    for (size_t stride = 1; stride < NUM_SHARDS; stride *= 2)
+    {
+        for (size_t i = 0; i + stride < NUM_SHARDS; i += 2 * stride)
+        {
+            shards[i].merge(shards[i + stride]);
+        }
+    }
+    const QuantileSketch& merged = shards[0];
+
+    REQUIRE(merged.count() == samples.size());
+    REQUIRE(merged.min() == exact.min());
+    REQUIRE(merged.max() == exact.max());
+    REQUIRE(merged.numRetained() < 4 * merged.k());
+    double tolerance = 2.5 / merged.k();
+    auto results = merged.quantiles(MONITORED_QUANTILES);
+    for (size_t i = 0; i < std::size(MONITORED_QUANTILES); ++i)
+    {
+        REQUIRE(rankError(exact, results[i], MONITORED_QUANTILES[i]) <=
+                tolerance);
+    }
+
+    // Merging into itself doubles every count
+    QuantileSketch doubled = merged;
+    doubled.merge(doubled);
+    REQUIRE(doubled.count() == 2 * samples.size());
+    REQUIRE(rankError(exact, doubled.quantile(0.5), 0.5) <= tolerance);
+
+    QuantileSketch other(100);
+    REQUIRE_THROWS_AS(doubled.merge(other), std::invalid_argument);
+}
+
+TEST_CASE("Test per-window monitoring quantiles", "[histogram-windows]")
+{
+    // One window per "second", summarised exactly and kept in a long-term
+    // sketch, as a monitor of one channel would
+    constexpr size_t WINDOW_SAMPLES = 20000;
+    constexpr size_t NUM_WINDOWS = 10;
+    auto samples = testSignal(WINDOW_SAMPLES * NUM_WINDOWS, 5);
+
+    SignalDataFacade::SampleBlock block;
+    SampleHistogram window;
+    SampleHistogram total;
+    QuantileSketch longTerm;
+    QuantileSketch folded;
+    for (size_t w = 0; w < NUM_WINDOWS; ++w)
+    {
+        auto windowSamples =
+            std::span(samples).subspan(w * WINDOW_SAMPLES, WINDOW_SAMPLES);
+        block.clear();
+        size_t first = block.appendUninitialized(WINDOW_SAMPLES);
+        std::copy(
+            windowSamples.begin(),
+            windowSamples.end(),
+            block.analog().begin() + first);
+
+        window.reset();
+        window.add(block.analog());
+        longTerm.add(block.analog());
+        folded.add(window);
+        total.merge(window);
+
+        std::vector<uint16_t> copy(windowSamples.begin(), windowSamples.end());
+        auto results = window.quantiles(MONITORED_QUANTILES);
+        for (size_t i = 0; i < std::size(MONITORED_QUANTILES); ++i)
+        {
+            REQUIRE(results[i] == sortedQuantile(copy, MONITORED_QUANTILES[i]));
+        }
+    }
+
+    REQUIRE(total.count() == samples.size());
+    REQUIRE(longTerm.count() == samples.size());
+    REQUIRE(folded.count() == samples.size());
+    REQUIRE(folded.min() == total.min());
+    REQUIRE(folded.max() == total.max());
+    REQUIRE(total.quantile(0.5) == sortedQuantile(samples, 0.5));
+    for (double q : MONITORED_QUANTILES)
+    {
+        REQUIRE(rankError(total, longTerm.quantile(q), q) <=
+                2.5 / longTerm.k());
+        REQUIRE(rankError(total, folded.quantile(q), q) <= 2.5 / folded.k());
+    }
+
+    // A histogram small enough for the sketch is kept exactly
+    SampleHistogram few;
+    few.add(std::span(samples).first(10));
+    QuantileSketch exact;
+    exact.add(few);
+    REQUIRE(exact.quantile(0.5) == few.quantile(0.5));
+}
+
+//-----------------------------------------------------------------------------
+// Benchmarks (hidden, run with: ./test_facadepattern_histogram "[benchmark]")
+//-----------------------------------------------------------------------------
+
+TEST_CASE(
+    "Benchmark histogram and sketch updates",
+    "[.][benchmark][histogram-benchmark]")
+{
+    constexpr size_t NUM_SAMPLES = 16 << 20;
+    constexpr size_t BATCH = 1 << 16;
+    auto samples = testSignal(NUM_SAMPLES, 1);
+
+    auto report = [](const char* pName, double seconds)
+    {
+        std::cout << pName
+                  << ": "
+                  << double(NUM_SAMPLES) / seconds / 1e6
+                  << " Msamples/s"
+                  << std::endl;
+    };
+
+    {
+        SampleHistogram histogram;
+        auto start = std::chrono::steady_clock::now();
+        for (size_t first = 0; first < NUM_SAMPLES; first += BATCH)
+        {
+            histogram.add(std::span(samples).subspan(first, BATCH));
+        }
+        std::chrono::duration<double> elapsed =
+            std::chrono::steady_clock::now() - start;
+        REQUIRE(histogram.count() == NUM_SAMPLES);
+        report("Exact histogram", elapsed.count());
+
+        start = std::chrono::steady_clock::now();
+        auto results = histogram.quantiles(MONITORED_QUANTILES);
+        elapsed = std::chrono::steady_clock::now() - start;
+        std::cout << "p1/p50/p99 query: " << elapsed.count() * 1e6 << " us ("
+                  << results[0] << ", " << results[1] << ", " << results[2]
+                  << ")" << std::endl;
+    }
+
+    {
+        QuantileSketch sketch;
+        auto start = std::chrono::steady_clock::now();
+        for (size_t first = 0; first < NUM_SAMPLES; first += BATCH)
+        {
+            sketch.add(std::span(samples).subspan(first, BATCH));
+        }
+        std::chrono::duration<double> elapsed =
+            std::chrono::steady_clock::now() - start;
+        REQUIRE(sketch.count() == NUM_SAMPLES);
+        report("KLL sketch", elapsed.count());
+        std::cout << "Sketch retains " << sketch.numRetained()
+                  << " samples in " << sketch.numLevels() << " levels"
+                  << std::endl;
+    }
+
+    {
+        // Exact per-window histograms folded into the sketch
+        constexpr size_t WINDOW = 1 << 20;
+        SampleHistogram window;
+        QuantileSketch sketch;
+        auto start = std::chrono::steady_clock::now();
+        for (size_t first = 0; first < NUM_SAMPLES; first += WINDOW)
+        {
+            window.reset();
+            window.add(std::span(samples).subspan(first, WINDOW));
+            sketch.add(window);
+        }
+        std::chrono::duration<double> elapsed =
+            std::chrono::steady_clock::now() - start;
+        REQUIRE(sketch.count() == NUM_SAMPLES);
+        report("KLL sketch from 1M-sample histograms", elapsed.count());
+    }
+
+    {
+        auto start = std::chrono::steady_clock::now();
+        std::vector<uint16_t> window(samples.begin(), samples.end());
+        std::sort(window.begin(), window.end());
+        std::chrono::duration<double> elapsed =
+            std::chrono::steady_clock::now() - start;
+        report("Sorting (reference)", elapsed.count());
+    }
+}
@@ -0,0 +1,573 @@
+// Copyright (c) 2025 Michael Dello
+//
+// This software is provided under the MIT License.
+// See LICENSE file for details.
+
+//-----------------------------------------------------------------------------
+// Pyramid Index Unit Tests
+//-----------------------------------------------------------------------------
+#define CATCH_CONFIG_MAIN
+// Include EVERYTHING from Catch2 (version 3)
+// This avoids the need to create a main() for unit testing
+#include <catch2/catch_all.hpp>
+// Alternatively, only include what is needed
+// #include <catch2/catch_test_macros.hpp> // Basic test macros
+// #include <catch2/catch_approx.hpp>  // Approximate floating-point comparisons
+// #include <catch2/catch_reporter_console.hpp> // Console reporting
+// #define CATCH_CONFIG_MAIN // Generates Catch2's main function
+// #include <catch2/catch_test_macros.hpp>
+
+// Create a custom main() instead:
+/* int main(int argc, char* argv[]) {
+    Catch::Session session; // Create Catch2 session
+    return session.run(argc, argv);
+} */
+
+#include <unistd.h>
+#include <algorithm>
+#include <chrono>
+#include <filesystem>
+#include <iostream>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include "facadepattern_capture.h"
+#include "facadepattern_pyramid.h"
+
+//-----------------------------------------------------------------------------
+// Test Helpers
+//-----------------------------------------------------------------------------
+
+namespace
+{
+    using SignalDataFacade::SamplePyramid;
+    using SignalDataFacade::sRangeSummary;
+
+    constexpr size_t FAN_OUT = SamplePyramid::FAN_OUT;
+
+    constexpr SignalDataFacade::eSimdLevel ALL_LEVELS[] =
+    {
+        SignalDataFacade::eSimdLevel::SCALAR,
+        SignalDataFacade::eSimdLevel::SSE4,
+        SignalDataFacade::eSimdLevel::AVX2
+    };
+
+    //-------------------------------------------------------------------------
+    // A per-process file path
+    std::string tempPath(const std::string& sName)
+    {
+        return std::filesystem::temp_directory_path() /
+            (sName + "." + std::to_string(::getpid()));
+    }
+
+    //-------------------------------------------------------------------------
+    // A file path removed again when the test ends
+    class TempPath
+    {
+    public:
+        explicit TempPath(const std::string& sPath)
+        : path{sPath}
+        {
+            std::filesystem::remove(path);
+        }
+        ~TempPath() { std::filesystem::remove(path); }
+        std::string str() const { return path.string(); }
+
+    private:
+        std::filesystem::path path;
+    };
+
+    //-------------------------------------------------------------------------
+    std::vector<uint16_t> randomColumn(size_t count, uint64_t seed)
+    {
+        std::mt19937_64 rng(seed);
+        std::vector<uint16_t> column(count);
+        for (auto& sample : column)
+        {
+            sample = uint16_t(rng());
+        }
+        return column;
+    }
+
+    //-------------------------------------------------------------------------
+    // The summary of [begin, end) widened to whole nodes, by brute force
+    sRangeSummary referenceSummary(
+        const std::vector<uint16_t>& samples,
+        uint64_t begin,
+        uint64_t end)
+    {
+        uint64_t total = samples.size();
+        uint64_t first = std::min(begin, total) / FAN_OUT * FAN_OUT;
+        uint64_t last = std::min(
+            (std::min(end, total) + FAN_OUT - 1) / FAN_OUT * FAN_OUT, total);
+        if (std::min(end, total) <= begin)
+        {
+            last = first;
+        }
+
+        sRangeSummary summary;
+        summary.firstSample = first;
+        if (last <= first)
+        {
+            return summary;
+        }
+        uint64_t sum = 0;
+        summary.min = UINT16_MAX;
+        for (uint64_t i = first; i < last; ++i)
+        {
+            sum += samples[i];
+            summary.min = std::min(summary.min, samples[i]);
+            summary.max = std::max(summary.max, samples[i]);
+        }
+        summary.numSamples = last - first;
+        summary.mean = double(sum) / double(summary.numSamples);
+        return summary;
+    }
+
+    //-------------------------------------------------------------------------
+    void requireEqual(const sRangeSummary& actual, const sRangeSummary& expect)
+    {
+        REQUIRE(actual.firstSample == expect.firstSample);
+        REQUIRE(actual.numSamples == expect.numSamples);
+        REQUIRE(actual.min == expect.min);
+        REQUIRE(actual.max == expect.max);
+        REQUIRE(actual.mean == Catch::Approx(expect.mean).epsilon(1e-12));
+    }
+
+    //-------------------------------------------------------------------------
+    // Random ranges, plus the whole capture and its edges
+    void requireSummaries(
+        const SamplePyramid& pyramid,
+        const std::vector<uint16_t>& samples,
+        uint64_t seed)
+    {
+        uint64_t total = samples.size();
+        requireEqual(
+            pyramid.summarize(0, total), referenceSummary(samples, 0, total));
+        requireEqual(
+            pyramid.summarize(total - 1, total + 100),
+            referenceSummary(samples, total - 1, total + 100));
+        requireEqual(
+            pyramid.summarize(total + 100, total + 200),
+            referenceSummary(samples, total + 100, total + 200));
+
+        std::mt19937_64 rng(seed);
+        for (int i = 0; i < 200; ++i)
+        {
+            uint64_t a = rng() % (total + 1);
+            uint64_t b = rng() % (total + 1);
+            uint64_t begin = std::min(a, b);
+            uint64_t end = std::max(a, b);
+            requireEqual(
+                pyramid.summarize(begin, end),
+                referenceSummary(samples, begin, end));
+        }
+    }
+
+} // namespace anonymous
+
+//=============================================================================
+// Sample Pyramid Unit Tests
+//=============================================================================
+
+//-----------------------------------------------------------------------------
+TEST_CASE("Test pyramid summaries", "[pyramid-summaries]")
+{
+    // Three full levels above level 0, and an incomplete node
+    constexpr size_t COUNT = FAN_OUT * FAN_OUT * FAN_OUT * 3 + 37;
+    auto samples = randomColumn(COUNT, 1);
+
+    for (auto level : ALL_LEVELS)
+    {
+        SamplePyramid pyramid{level};
+        REQUIRE(pyramid.numSamples() == 0);
+        requireEqual(pyramid.summarize(0, 100), sRangeSummary{});
+
+        pyramid.append(samples);
+        REQUIRE(pyramid.numSamples() == COUNT);
+        REQUIRE(pyramid.numLevels() == 3);
+        REQUIRE(pyramid.numNodes(0) == COUNT / FAN_OUT);
+        REQUIRE(pyramid.numNodes(1) == COUNT / FAN_OUT / FAN_OUT);
+        REQUIRE(pyramid.numNodes(2) == 3);
+        requireSummaries(pyramid, samples, 2);
+    }
+
+    SECTION("Extreme samples")
+    {
+        std::vector<uint16_t> extremes(FAN_OUT * 3, UINT16_MAX);
+        extremes[5] = 0;
+        for (auto level : ALL_LEVELS)
+        {
+            SamplePyramid pyramid{level};
+            pyramid.append(extremes);
+            requireEqual(
+                pyramid.summarize(0, extremes.size()),
+                referenceSummary(extremes, 0, extremes.size()));
+            requireEqual(
+                pyramid.summarize(FAN_OUT, extremes.size()),
+                referenceSummary(extremes, FAN_OUT, extremes.size()));
+        }
+    }
+}
+
+//-----------------------------------------------------------------------------
+TEST_CASE("Test pyramid incremental appends", "[pyramid-incremental]")
+{
+    auto samples = randomColumn(FAN_OUT * FAN_OUT * 5 + 11, 3);
+
+    SamplePyramid whole;
+    whole.append(samples);
+
+    // Appends of every alignment, from single samples to several levels
+    SamplePyramid pieces;
+    std::mt19937_64 rng(4);
+    const size_t sizes[] = {1, 7, 63, 64, 65, 1000, FAN_OUT * FAN_OUT + 3};
+    size_t offset = 0;
+    while (offset < samples.size())
+    {
+        size_t count = std::min(
+            sizes[rng() % std::size(sizes)], samples.size() - offset);
+        pieces.append(std::span(samples).subspan(offset, count));
+        offset += count;
+        REQUIRE(pieces.numSamples() == offset);
+    }
+
+    REQUIRE(pieces.numLevels() == whole.numLevels());
+    for (size_t level = 0; level < whole.numLevels(); ++level)
+    {
+        REQUIRE(pieces.numNodes(level) == whole.numNodes(level));
+    }
+    requireSummaries(pieces, samples, 5);
+
+    pieces.clear();
+    REQUIRE(pieces.numSamples() == 0);
+    REQUIRE(pieces.numLevels() == 1);
+    REQUIRE(pieces.summarize(0, samples.size()).numSamples == 0);
+}
+
+//-----------------------------------------------------------------------------
+TEST_CASE("Test pyramid bucketed summaries", "[pyramid-buckets]")
+{
+    auto samples = randomColumn(FAN_OUT * 1000 + 20, 6);
+    SamplePyramid pyramid;
+    pyramid.append(samples);
+
+    SECTION("Buckets tile the range")
+    {
+        const uint64_t begin = 1234;
+        const uint64_t end = 50'000;
+        auto buckets = pyramid.summarize(begin, end, 100);
+        REQUIRE(buckets.size() == 100);
+
+        sRangeSummary whole = pyramid.summarize(begin, end);
+        REQUIRE(buckets.front().firstSample == whole.firstSample);
+        uint64_t next = whole.firstSample;
+        double sum = 0.0;
+        for (const auto& bucket : buckets)
+        {
+            REQUIRE(bucket.firstSample == next);
+            REQUIRE(bucket.numSamples > 0);
+            REQUIRE(bucket.numSamples % FAN_OUT == 0);
+            requireEqual(
+                bucket,
+                referenceSummary(
+                    samples,
+                    bucket.firstSample,
+                    bucket.firstSample + bucket.numSamples));
+            next += bucket.numSamples;
+            sum += bucket.mean * double(bucket.numSamples);
+        }
+        REQUIRE(next == whole.firstSample + whole.numSamples);
+        REQUIRE(sum / double(whole.numSamples) ==
+                Catch::Approx(whole.mean).epsilon(1e-12));
+    }
+
+    SECTION("At most one bucket per node")
+    {
+        auto buckets = pyramid.summarize(0, samples.size(), 1'000'000);
+        REQUIRE(buckets.size() == 1001);
+        REQUIRE(buckets.back().numSamples == 20);
+        requireEqual(
+            buckets.back(),
+            referenceSummary(samples, FAN_OUT * 1000, samples.size()));
+    }
+
+    SECTION("Empty ranges")
+    {
+        REQUIRE(pyramid.summarize(500, 500, 10).empty());
+        REQUIRE(pyramid.summarize(500, 500).numSamples == 0);
+        REQUIRE(pyramid.summarize(500, 500).firstSample == 448);
+        REQUIRE(pyramid.summarize(samples.size() + 1, UINT64_MAX, 10).empty());
+    }
+}
+
+//-----------------------------------------------------------------------------
+TEST_CASE("Test pyramid persistence", "[pyramid-persistence]")
+{
+    using namespace SignalDataFacade;
+
+    TempPath capturePath{tempPath("test_pyramid.sdcap")};
+    TempPath pyramidFile{pyramidPath(capturePath.str(), 0)};
+    const std::string sPyramidPath = pyramidFile.str();
+
+    // Indexed as it is recorded, in blocks that do not align with nodes
+    auto analog = randomColumn(100'000, 7);
+    auto digital = randomColumn(analog.size(), 8);
+    SamplePyramid recorded;
+    {
+        sCaptureConfig_t config;
+        config.chunkSamples = 4096;
+        CaptureWriter writer{capturePath.str(), config};
+        for (size_t offset = 0; offset < analog.size(); offset += 3000)
+        {
+            size_t count = std::min<size_t>(3000, analog.size() - offset);
+            sSampleBlockView block{
+                std::span(analog).subspan(offset, count),
+                std::span(digital).subspan(offset, count)};
+            writer.append(block);
+            recorded.append(block.analog);
+        }
+    }
+    recorded.save(sPyramidPath);
+    // Replaced through a temporary file, which is gone once renamed
+    recorded.save(sPyramidPath);
+    REQUIRE_FALSE(std::filesystem::exists(sPyramidPath + ".tmp"));
+
+    SECTION("Loaded pyramid answers the same")
+    {
+        SamplePyramid loaded{sPyramidPath};
+        REQUIRE(loaded.numSamples() == analog.size());
+        REQUIRE(loaded.numLevels() == recorded.numLevels());
+        requireSummaries(loaded, analog, 9);
+
+        // And keeps growing where it left off
+        auto more = randomColumn(5000, 10);
+        loaded.append(more);
+        analog.insert(analog.end(), more.begin(), more.end());
+        requireSummaries(loaded, analog, 11);
+    }
+
+    SECTION("Rebuilt from the capture")
+    {
+        CaptureReader reader{capturePath.str()};
+        SamplePyramid rebuilt;
+        rebuilt.append(reader, 0);
+        requireSummaries(rebuilt, analog, 12);
+        REQUIRE_THROWS_AS(rebuilt.append(reader, 2), std::out_of_range);
+    }
+
+    SECTION("Corrupt files are rejected")
+    {
+        REQUIRE_THROWS_AS(
+            SamplePyramid{capturePath.str()}, std::runtime_error);
+        REQUIRE_THROWS_AS(
+            SamplePyramid{sPyramidPath + ".missing"}, std::runtime_error);
+
+        std::filesystem::resize_file(
+            sPyramidPath, std::filesystem::file_size(sPyramidPath) - 1);
+        REQUIRE_THROWS_AS(SamplePyramid{sPyramidPath}, std::runtime_error);
+    }
+}
+
+//-----------------------------------------------------------------------------
+TEST_CASE(
+    "Test pyramids maintained by the capture writer",
+    "[pyramid-capture]")
+{
+    using namespace SignalDataFacade;
+
+    TempPath capturePath{tempPath("test_pyramid_writer.sdcap")};
+    TempPath analogPyramid{pyramidPath(capturePath.str(), 0)};
+    TempPath digitalPyramid{pyramidPath(capturePath.str(), 1)};
+
+    auto analog = randomColumn(50'000, 16);
+    auto digital = randomColumn(analog.size(), 17);
+    auto record = [&](CaptureWriter& writer, size_t first, size_t last)
+    {
+        for (size_t offset = first; offset < last; offset += 3000)
+        {
+            size_t count = std::min<size_t>(3000, last - offset);
+            writer.append(sSampleBlockView{
+                std::span(analog).subspan(offset, count),
+                std::span(digital).subspan(offset, count)});
+        }
+    };
+
+    // Chunks are indexed as they are committed, staged samples on save
+    sCaptureConfig_t config;
+    config.chunkSamples = 4096;
+    {
+        CaptureWriter writer{capturePath.str(), config};
+        CapturePyramids pyramids{writer, capturePath.str()};
+        REQUIRE(pyramids.numChannels() == 2);
+        record(writer, 0, 20'000);
+        REQUIRE(pyramids.pyramid(0).numSamples() == 4 * 4096);
+        pyramids.save();
+        REQUIRE(pyramids.pyramid(1).numSamples() == 20'000);
+        REQUIRE_THROWS_AS(pyramids.pyramid(2), std::out_of_range);
+    }
+    std::vector<uint16_t> recorded(analog.begin(), analog.begin() + 20'000);
+    requireSummaries(SamplePyramid{analogPyramid.str()}, recorded, 18);
+
+    // Appending picks up the saved pyramids...
+    {
+        CaptureWriter writer{capturePath.str()};
+        CapturePyramids pyramids{writer, capturePath.str()};
+        REQUIRE(pyramids.pyramid(0).numSamples() == 20'000);
+        record(writer, 20'000, 30'000);
+        pyramids.save();
+        requireSummaries(
+            pyramids.pyramid(1),
+            std::vector<uint16_t>(digital.begin(), digital.begin() + 30'000),
+            19);
+    }
+
+    // ...or rebuilds them from the capture when missing or behind it
+    std::filesystem::remove(analogPyramid.str());
+    {
+        CaptureWriter writer{capturePath.str()};
+        record(writer, 30'000, 40'000);
+    }
+    {
+        CaptureWriter writer{capturePath.str()};
+        CapturePyramids pyramids{writer, capturePath.str()};
+        REQUIRE(pyramids.pyramid(0).numSamples() == 40'000);
+        REQUIRE(pyramids.pyramid(1).numSamples() == 40'000);
+        record(writer, 40'000, analog.size());
+        pyramids.save();
+        requireSummaries(pyramids.pyramid(0), analog, 20);
+        requireSummaries(pyramids.pyramid(1), digital, 21);
+    }
+    requireSummaries(SamplePyramid{digitalPyramid.str()}, digital, 22);
+}
+
+//-----------------------------------------------------------------------------
+TEST_CASE("Test pyramid errors", "[pyramid-errors]")
+{
+    SamplePyramid pyramid;
+    pyramid.append(randomColumn(1000, 13));
+
+    REQUIRE_THROWS_AS(pyramid.summarize(10, 5), std::invalid_argument);
+    REQUIRE_THROWS_AS(pyramid.summarize(10, 5, 4), std::invalid_argument);
+    REQUIRE_THROWS_AS(pyramid.summarize(0, 10, 0), std::invalid_argument);
+    REQUIRE_THROWS_AS(pyramid.numNodes(5), std::out_of_range);
+    REQUIRE_THROWS_AS(
+        pyramid.save("/nonexistent/dir/pyramid.pyr"), std::runtime_error);
+}
+
+//=============================================================================
+// Benchmarks (hidden, run with: ./test_facadepattern_pyramid "[benchmark]")
+//=============================================================================
+
+//-----------------------------------------------------------------------------
+TEST_CASE(
+    "Benchmark pyramid over a billion samples",
+    "[.][benchmark][pyramid-benchmark]")
+{
+    using namespace SignalDataFacade;
+    constexpr size_t BLOCK = 1 << 20;
+    constexpr size_t NUM_BLOCKS = 954;
+    constexpr size_t NUM_QUERIES = 10'000;
+    using Clock = std::chrono::steady_clock;
+
+    // A billion samples recorded to a capture file (about 2 GB), as blocks
+    // of a repeating random signal, indexed as they are committed
+    TempPath capturePath{tempPath("benchmark_pyramid.sdcap")};
+    TempPath pyramidFile{pyramidPath(capturePath.str(), 0)};
+    auto block = randomColumn(BLOCK, 14);
+    const uint64_t total = uint64_t(BLOCK) * NUM_BLOCKS;
+    {
+        sCaptureConfig_t config;
+        config.channels = {{"analog"}};
+        config.chunkSamples = BLOCK;
+        CaptureWriter writer{capturePath.str(), config};
+        CapturePyramids pyramids{writer, capturePath.str()};
+        auto start = Clock::now();
+        for (size_t i = 0; i < NUM_BLOCKS; ++i)
+        {
+            const std::span<const uint16_t> columns[] = {block};
+            writer.appendColumns(columns);
+        }
+        pyramids.save();
+        std::chrono::duration<double> seconds = Clock::now() - start;
+        std::cout << "record and index: "
+                  << double(total) / seconds.count() / 1e6
+                  << " Msamples/s" << std::endl;
+    }
+
+    CaptureReader reader{capturePath.str()};
+    REQUIRE(reader.numSamples() == total);
+    for (auto level : ALL_LEVELS)
+    {
+        // Rebuilt from the capture, as for one recorded without a pyramid
+        SamplePyramid pyramid{level};
+        auto start = Clock::now();
+        pyramid.append(reader, 0);
+        std::chrono::duration<double> seconds = Clock::now() - start;
+        std::cout << SignalDataFacade::toString(pyramid.simdLevel())
+                  << " build from the capture: "
+                  << double(total) / seconds.count() / 1e6
+                  << " Msamples/s, "
+                  << pyramid.numLevels() << " levels, "
+                  << pyramid.indexBytes() / (1 << 20) << " MiB"
+                  << std::endl;
+        if (level != SignalDataFacade::eSimdLevel::AVX2)
+        {
+            continue;
+        }
+
+        // The pyramid saved while recording, as a viewer opens it
+        start = Clock::now();
+        SamplePyramid saved{pyramidFile.str()};
+        seconds = Clock::now() - start;
+        std::cout << "load saved pyramid: " << seconds.count() * 1e3
+                  << " ms" << std::endl;
+        REQUIRE(saved.numSamples() == total);
+
+        // Random ranges of any length, one summary each
+        std::mt19937_64 rng(15);
+        uint64_t checksum = 0;
+        start = Clock::now();
+        for (size_t i = 0; i < NUM_QUERIES; ++i)
+        {
+            uint64_t a = rng() % total;
+            uint64_t b = rng() % total;
+            auto summary = saved.summarize(std::min(a, b), std::max(a, b));
+            checksum += summary.max;
+        }
+        seconds = Clock::now() - start;
+        std::cout << "range summary: "
+                  << seconds.count() / NUM_QUERIES * 1e6
+                  << " us/query (" << checksum << ")" << std::endl;
+
+        // A whole-capture view 2000 pixels wide
+        start = Clock::now();
+        auto buckets = saved.summarize(0, total, 2000);
+        seconds = Clock::now() - start;
+        std::cout << "2000 buckets over the capture: "
+                  << seconds.count() * 1e3 << " ms" << std::endl;
+        REQUIRE(buckets.size() == 2000);
+
+        // Brute force over the same billion samples, mapped from the file
+        start = Clock::now();
+        uint64_t sum = 0;
+        uint16_t max = 0;
+        for (size_t chunk = 0; chunk < reader.numChunks(); ++chunk)
+        {
+            for (uint16_t sample : reader.column(chunk, 0))
+            {
+                sum += sample;
+                max = std::max(max, sample);
+            }
+        }
+        seconds = Clock::now() - start;
+        std::cout << "brute-force scan of the capture: "
+                  << seconds.count() * 1e3 << " ms (" << max << ")"
+                  << std::endl;
+        auto whole = saved.summarize(0, total);
+        REQUIRE(whole.max == max);
+        REQUIRE(whole.mean == Catch::Approx(double(sum) / double(total)));
+        REQUIRE(pyramid.summarize(0, total).max == max);
+    }
+}
@@ -0,0 +1,446 @@
+// Copyright (c) 2025 Michael Dello
+//
+// This software is provided under the MIT License.
+// See LICENSE file for details.
+
+//-----------------------------------------------------------------------------
+// Window Query Engine Unit Tests
+//-----------------------------------------------------------------------------
+#define CATCH_CONFIG_MAIN
+// Include EVERYTHING from Catch2 (version 3)
+// This avoids the need to create a main() for unit testing
+#include <catch2/catch_all.hpp>
+// Alternatively, only include what is needed
+// #include <catch2/catch_test_macros.hpp> // Basic test macros
+// #include <catch2/catch_approx.hpp>  // Approximate floating-point comparisons
+// #include <catch2/catch_reporter_console.hpp> // Console reporting
+// #define CATCH_CONFIG_MAIN // Generates Catch2's main function
+// #include <catch2/catch_test_macros.hpp>
+
+// Create a custom main() instead:
+/* int main(int argc, char* argv[]) {
+    Catch::Session session; // Create Catch2 session
+    return session.run(argc, argv);
+} */
+
+#include <unistd.h>
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <filesystem>
+#include <iostream>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+#include "common/thread_pool.h"
+#include "facadepattern_capture.h"
+#include "facadepattern_query.h"
+
+//-----------------------------------------------------------------------------
+// Test Helpers
+//-----------------------------------------------------------------------------
+
+namespace
+{
+    using SignalDataFacade::sWindowAggregate;
+    using SignalDataFacade::sWindowQuery_t;
+    using SignalDataFacade::sWindowQueryResult;
+    using SignalDataFacade::WindowQueryEngine;
+
+    constexpr SignalDataFacade::eSimdLevel ALL_LEVELS[] =
+    {
+        SignalDataFacade::eSimdLevel::SCALAR,
+        SignalDataFacade::eSimdLevel::SSE4,
+        SignalDataFacade::eSimdLevel::AVX2
+    };
+
+    //-------------------------------------------------------------------------
+    // A per-process file path, removed again when the test ends
+    class TempCapturePath
+    {
+    public:
+        explicit TempCapturePath(const std::string& sName)
+        : path{std::filesystem::temp_directory_path() /
+            (sName + "." + std::to_string(::getpid()) + ".sdcap")}
+        {
+            std::filesystem::remove(path);
+        }
+        ~TempCapturePath() { std::filesystem::remove(path); }
+        std::string str() const { return path.string(); }
+
+    private:
+        std::filesystem::path path;
+    };
+
+    //-------------------------------------------------------------------------
+    std::vector<uint16_t> randomColumn(size_t count, uint64_t seed)
+    {
+        std::mt19937_64 rng(seed);
+        std::vector<uint16_t> column(count);
+        for (auto& sample : column)
+        {
+            sample = uint16_t(rng());
+        }
+        return column;
+    }
+
+    //-------------------------------------------------------------------------
+    // GPIO lines toggling in runs, so duty cycles vary by window
+    std::vector<uint16_t> gpioColumn(size_t count, uint64_t seed)
+    {
+        std::mt19937_64 rng(seed);
+        std::vector<uint16_t> column(count);
+        uint16_t lines = 0;
+        for (auto& sample : column)
+        {
+            if (rng() % 50 == 0)
+            {
+                lines ^= uint16_t(1u << (rng() % 16));
+            }
+            sample = lines;
+        }
+        return column;
+    }
+
+    //-------------------------------------------------------------------------
+    void writeCapture(
+        const std::string& sPath,
+        const std::vector<uint16_t>& analog,
+        const std::vector<uint16_t>& gpio,
+        const SignalDataFacade::sCaptureConfig_t& config)
+    {
+        SignalDataFacade::CaptureWriter writer{sPath, config};
+        std::array<std::span<const uint16_t>, 2> columns{analog, gpio};
+        writer.appendColumns(columns);
+    }
+
+    //-------------------------------------------------------------------------
+    // The windows of a query, one sample at a time
+    sWindowQueryResult referenceQuery(
+        const std::vector<uint16_t>& analog,
+        const std::vector<uint16_t>& gpio,
+        const sWindowQuery_t& query)
+    {
+        sWindowQueryResult result;
+        uint64_t end = std::min<uint64_t>(query.endSample, analog.size());
+        uint64_t totalSum = 0;
+        uint64_t totalHigh = 0;
+        result.total.firstSample = query.firstSample;
+        for (uint64_t first = query.firstSample;
+             first < end;
+             first += query.windowSamples)
+        {
+            sWindowAggregate window;
+            window.firstSample = first;
+            uint64_t last = std::min(first + query.windowSamples, end);
+            uint64_t sum = 0;
+            uint64_t numHigh = 0;
+            for (uint64_t i = first; i < last; ++i)
+            {
+                sum += analog[i];
+                window.numAboveThreshold += analog[i] > query.threshold;
+                numHigh += (gpio[i] >> query.gpioLine) & 1;
+            }
+            window.numSamples = last - first;
+            window.mean = double(sum) / double(window.numSamples);
+            window.dutyCycle = double(numHigh) / double(window.numSamples);
+            result.windows.push_back(window);
+
+            totalSum += sum;
+            totalHigh += numHigh;
+            result.total.numSamples += window.numSamples;
+            result.total.numAboveThreshold += window.numAboveThreshold;
+        }
+        if (result.total.numSamples > 0)
+        {
+            result.total.mean =
+                double(totalSum) / double(result.total.numSamples);
+            result.total.dutyCycle =
+                double(totalHigh) / double(result.total.numSamples);
+        }
+        return result;
+    }
+
+    //-------------------------------------------------------------------------
+    void requireEqual(
+        const sWindowAggregate& actual,
+        const sWindowAggregate& expect)
+    {
+        REQUIRE(actual.firstSample == expect.firstSample);
+        REQUIRE(actual.numSamples == expect.numSamples);
+        REQUIRE(actual.numAboveThreshold == expect.numAboveThreshold);
+        REQUIRE(actual.mean == Catch::Approx(expect.mean).epsilon(1e-12));
+        REQUIRE(actual.dutyCycle == Catch::Approx(expect.dutyCycle));
+    }
+
+    //-------------------------------------------------------------------------
+    void requireEqual(
+        const sWindowQueryResult& actual,
+        const sWindowQueryResult& expect)
+    {
+        REQUIRE(actual.windows.size() == expect.windows.size());
+        for (size_t i = 0; i < expect.windows.size(); ++i)
+        {
+            requireEqual(actual.windows[i], expect.windows[i]);
+        }
+        requireEqual(actual.total, expect.total);
+        REQUIRE(actual.bytesScanned == expect.total.numSamples * 4);
+    }
+
+    //-------------------------------------------------------------------------
+    // Windows shorter and longer than a chunk, out of step with chunks,
+    // over part of the capture, and extreme thresholds
+    std::vector<sWindowQuery_t> testQueries()
+    {
+        return {
+            {.threshold = 32768, .gpioLine = 0, .windowSamples = 1000},
+            {.threshold = 1000, .gpioLine = 7, .windowSamples = 4096},
+            {.threshold = 0, .gpioLine = 15, .windowSamples = 10'007},
+            {.threshold = 65535,
+             .gpioLine = 3,
+             .windowSamples = 777,
+             .firstSample = 1234,
+             .endSample = 90'001},
+            {.threshold = 40000,
+             .gpioLine = 9,
+             .windowSamples = 5,
+             .firstSample = 4090,
+             .endSample = 4200}};
+    }
+
+} // namespace anonymous
+
+//=============================================================================
+// Thread Pool Unit Tests
+//=============================================================================
+
+//-----------------------------------------------------------------------------
+TEST_CASE("Test thread pool", "[thread-pool]")
+{
+    Concurrency::ThreadPool pool{4};
+    REQUIRE(pool.size() == 4);
+
+    SECTION("Every task runs once")
+    {
+        for (size_t numTasks : {size_t{0}, size_t{1}, size_t{3}, size_t{1000}})
+        {
+            std::vector<std::atomic<int>> runs(numTasks);
+            std::atomic<bool> bBadWorker{false};
+            pool.run(numTasks, [&](size_t task, size_t worker)
+            {
+                runs[task].fetch_add(1);
+                if (worker >= pool.size())
+                {
+                    bBadWorker = true;
+                }
+            });
+            for (const auto& count : runs)
+            {
+                REQUIRE(count.load() == 1);
+            }
+            REQUIRE_FALSE(bBadWorker.load());
+        }
+    }
+
+    SECTION("Exceptions reach the caller")
+    {
+        std::atomic<size_t> numRun{0};
+        REQUIRE_THROWS_AS(
+            pool.run(1000, [&](size_t task, size_t)
+            {
+                ++numRun;
+                if (task == 10)
+                {
+                    throw std::runtime_error("task failed");
+                }
+            }),
+            std::runtime_error);
+        REQUIRE(numRun.load() < 1000);
+
+        // And the pool still works
+        numRun = 0;
+        pool.run(100, [&](size_t, size_t) { ++numRun; });
+        REQUIRE(numRun.load() == 100);
+    }
+
+    SECTION("A pool of one runs inline")
+    {
+        Concurrency::ThreadPool inlinePool{0};
+        REQUIRE(inlinePool.size() == 1);
+        std::thread::id caller = std::this_thread::get_id();
+        bool bInline = true;
+        inlinePool.run(10, [&](size_t, size_t worker)
+        {
+            bInline = bInline && worker == 0 &&
+                std::this_thread::get_id() == caller;
+        });
+        REQUIRE(bInline);
+    }
+}
+
+//=============================================================================
+// Window Query Engine Unit Tests
+//=============================================================================
+
+//-----------------------------------------------------------------------------
+TEST_CASE("Test window query aggregates", "[query-windows]")
+{
+    TempCapturePath path{"query_windows"};
+    auto analog = randomColumn(100'000, 1);
+    auto gpio = gpioColumn(analog.size(), 2);
+    writeCapture(path.str(), analog, gpio, {.chunkSamples = 4096});
+    SignalDataFacade::CaptureReader reader{path.str()};
+
+    for (size_t numThreads : {1, 4})
+    {
+        for (auto level : ALL_LEVELS)
+        {
+            WindowQueryEngine engine{numThreads, level};
+            REQUIRE(engine.numThreads() == numThreads);
+            for (const auto& query : testQueries())
+            {
+                auto result = engine.run(reader, query);
+                REQUIRE(result.numThreads == numThreads);
+                requireEqual(result, referenceQuery(analog, gpio, query));
+            }
+        }
+    }
+}
+
+//-----------------------------------------------------------------------------
+TEST_CASE("Test window query over compressed chunks", "[query-compressed]")
+{
+    using SignalDataFacade::eCodec;
+    TempCapturePath path{"query_compressed"};
+    // A slow ramp, so the analog channel compresses too
+    std::vector<uint16_t> analog(50'000);
+    for (size_t i = 0; i < analog.size(); ++i)
+    {
+        analog[i] = uint16_t(20000 + (i % 3000) * 7);
+    }
+    auto gpio = gpioColumn(analog.size(), 3);
+    writeCapture(
+        path.str(),
+        analog,
+        gpio,
+        {.channels = {
+            {"analog", 1.0, 0.0, eCodec::DELTA_BITPACK},
+            {"gpio", 1.0, 0.0, eCodec::RLE}},
+         .chunkSamples = 2000});
+    SignalDataFacade::CaptureReader reader{path.str()};
+
+    WindowQueryEngine engine{3};
+    for (const auto& query : testQueries())
+    {
+        requireEqual(
+            engine.run(reader, query), referenceQuery(analog, gpio, query));
+    }
+}
+
+//-----------------------------------------------------------------------------
+TEST_CASE("Test window query across time gaps", "[query-gaps]")
+{
+    TempCapturePath path{"query_gaps"};
+    auto analog = randomColumn(30'000, 4);
+    auto gpio = gpioColumn(analog.size(), 5);
+    {
+        // Each gap starts a new, partial chunk
+        SignalDataFacade::CaptureWriter writer{
+            path.str(), {.chunkSamples = 4096}};
+        for (size_t offset = 0; offset < analog.size(); offset += 2500)
+        {
+            SignalDataFacade::sSampleBlockView block{
+                std::span(analog).subspan(offset, 2500),
+                std::span(gpio).subspan(offset, 2500)};
+            writer.append(block, uint64_t(offset) * 10'000);
+        }
+    }
+    SignalDataFacade::CaptureReader reader{path.str()};
+    REQUIRE(reader.numChunks() > analog.size() / 4096 + 1);
+
+    WindowQueryEngine engine{2};
+    for (const auto& query : testQueries())
+    {
+        requireEqual(
+            engine.run(reader, query), referenceQuery(analog, gpio, query));
+    }
+}
+
+//-----------------------------------------------------------------------------
+TEST_CASE("Test window query errors", "[query-errors]")
+{
+    TempCapturePath path{"query_errors"};
+    auto analog = randomColumn(5000, 6);
+    writeCapture(path.str(), analog, analog, {.chunkSamples = 1024});
+    SignalDataFacade::CaptureReader reader{path.str()};
+    WindowQueryEngine engine{2};
+
+    REQUIRE_THROWS_AS(
+        engine.run(reader, {.analogChannel = 2}), std::out_of_range);
+    REQUIRE_THROWS_AS(
+        engine.run(reader, {.gpioChannel = 2}), std::out_of_range);
+    REQUIRE_THROWS_AS(
+        engine.run(reader, {.windowSamples = 0}), std::invalid_argument);
+    REQUIRE_THROWS_AS(
+        engine.run(reader, {.gpioLine = 16}), std::invalid_argument);
+
+    // Empty ranges
+    auto result = engine.run(reader, {.firstSample = 5000});
+    REQUIRE(result.windows.empty());
+    REQUIRE(result.total.numSamples == 0);
+    REQUIRE(result.bytesScanned == 0);
+    result = engine.run(reader, {.firstSample = 100, .endSample = 50});
+    REQUIRE(result.windows.empty());
+}
+
+//=============================================================================
+// Benchmarks (hidden, run with: ./test_facadepattern_query "[benchmark]")
+//=============================================================================
+
+//-----------------------------------------------------------------------------
+TEST_CASE(
+    "Benchmark window query scan throughput",
+    "[.][benchmark][query-benchmark]")
+{
+    // 128 Msamples of two channels, 512 MB
+    constexpr size_t BLOCK = 1 << 20;
+    constexpr size_t NUM_BLOCKS = 128;
+    TempCapturePath path{"query_benchmark"};
+    auto analog = randomColumn(BLOCK, 7);
+    auto gpio = gpioColumn(BLOCK, 8);
+    {
+        SignalDataFacade::CaptureWriter writer{path.str(), {}};
+        std::array<std::span<const uint16_t>, 2> columns{analog, gpio};
+        for (size_t i = 0; i < NUM_BLOCKS; ++i)
+        {
+            writer.appendColumns(columns);
+        }
+    }
+    SignalDataFacade::CaptureReader reader{path.str()};
+    const sWindowQuery_t query{.threshold = 40000, .windowSamples = 1000};
+
+    auto report = [&](WindowQueryEngine& engine)
+    {
+        // The first run pages the capture in
+        engine.run(reader, query);
+        auto result = engine.run(reader, query);
+        std::cout << SignalDataFacade::toString(engine.simdLevel()) << " "
+                  << engine.numThreads() << " thread(s): "
+                  << result.gigabytesPerSecond() << " GB/s, "
+                  << result.windows.size() << " windows"
+                  << std::endl;
+        REQUIRE(result.total.numSamples == BLOCK * NUM_BLOCKS);
+    };
+
+    WindowQueryEngine scalar{1, SignalDataFacade::eSimdLevel::SCALAR};
+    report(scalar);
+    size_t numCores = std::max(1u, std::thread::hardware_concurrency());
+    for (size_t numThreads = 1; numThreads <= std::max<size_t>(numCores, 4);
+         numThreads *= 2)
+    {
+        WindowQueryEngine engine{numThreads};
+        report(engine);
+    }
+}
@@ -0,0 +1,146 @@
+// Copyright (c) 2025 Michael Dello
+//
+// This software is provided under the MIT License.
+// See LICENSE file for details.
+
+//-----------------------------------------------------------------------------
+// Signal Data Sample Block Unit Tests
+//-----------------------------------------------------------------------------
+#define CATCH_CONFIG_MAIN
+// Include EVERYTHING from Catch2 (version 3)
+// This avoids the need to create a main() for unit testing
+#include <catch2/catch_all.hpp>
+// Alternatively, only include what is needed
+// #include <catch2/catch_test_macros.hpp> // Basic test macros
+// #include <catch2/catch_approx.hpp>  // Approximate floating-point comparisons
+// #include <catch2/catch_reporter_console.hpp> // Console reporting
+// #define CATCH_CONFIG_MAIN // Generates Catch2's main function
+// #include <catch2/catch_test_macros.hpp>
+
+// Create a custom main() instead:
+/* int main(int argc, char* argv[]) {
+    Catch::Session session; // Create Catch2 session
+    return session.run(argc, argv);
+} */
+
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include "facadepattern_sampleblock.h"
+#include "facadepattern_stats.h"
+
+//=============================================================================
+// sAggregateData Unit Tests
+//=============================================================================
+
+TEST_CASE("Test sAggregateData is a plain record", "[aggregate-data-trivial]")
+{
+    using Sample = SignalDataFacade::SignalData::sAggregateData;
+    STATIC_REQUIRE(std::is_trivially_copyable_v<Sample>);
+    STATIC_REQUIRE(std::is_trivially_default_constructible_v<Sample>);
+
+    // Arrays of samples can be copied bytewise
+    std::vector<Sample> source{{1, 2}, {3, 4}};
+    std::vector<Sample> copy(source.size());
+    std::memcpy(copy.data(), source.data(), source.size() * sizeof(Sample));
+    REQUIRE(copy[1].analog == 3);
+    REQUIRE(copy[1].digital == 4);
+}
+
+//=============================================================================
+// SampleBlock Unit Tests
+//=============================================================================
+
+TEST_CASE("Test SampleBlock append and views", "[sampleblock-append]")
+{
+    SignalDataFacade::SampleBlock block;
+    REQUIRE(block.empty());
+    REQUIRE(block.capacity() == 0);
+
+    block.push_back({1, 10});
+    std::vector<SignalDataFacade::SignalData::sAggregateData> samples{
+        {2, 20}, {3, 30}};
+    block.append(samples);
+
+    REQUIRE(block.size() == 3);
+    REQUIRE(block[2].analog == 3);
+    REQUIRE(block[2].digital == 30);
+    REQUIRE(std::vector<uint16_t>(block.analog().begin(), block.analog().end())
+        == std::vector<uint16_t>{1, 2, 3});
+    REQUIRE(
+        std::vector<uint16_t>(block.digital().begin(), block.digital().end())
+        == std::vector<uint16_t>{10, 20, 30});
+
+    // Columns can be written in place
+    block.analog()[0] = 100;
+    REQUIRE(block.view().analog[0] == 100);
+
+    // Views feed the statistics kernels directly
+    auto stats = SignalDataFacade::computeStats(block.view());
+    REQUIRE(stats.digital.count == 3);
+    REQUIRE(stats.digital.mean == Catch::Approx(20.0));
+}
+
+TEST_CASE("Test SampleBlock aligned columns", "[sampleblock-aligned]")
+{
+    SignalDataFacade::SampleBlock block{1};
+    for (size_t i = 0; i < 1000; ++i)
+    {
+        block.push_back({static_cast<uint16_t>(i), 0});
+        REQUIRE(reinterpret_cast<uintptr_t>(block.analog().data()) %
+            SignalDataFacade::SampleBlock::ALIGNMENT == 0);
+        REQUIRE(reinterpret_cast<uintptr_t>(block.digital().data()) %
+            SignalDataFacade::SampleBlock::ALIGNMENT == 0);
+    }
+    // Growth keeps the samples
+    REQUIRE(block[999].analog == 999);
+    REQUIRE(block[0].analog == 0);
+}
+
+TEST_CASE("Test SampleBlock capacity reuse", "[sampleblock-capacity]")
+{
+    SignalDataFacade::SampleBlock block{100};
+    size_t capacity = block.capacity();
+    REQUIRE(capacity >= 100);
+    const uint16_t* pAnalog = nullptr;
+
+    for (int cycle = 0; cycle < 3; ++cycle)
+    {
+        block.clear();
+        REQUIRE(block.empty());
+        block.resize(100);
+        if (pAnalog != nullptr)
+        {
+            // Refilling never reallocates
+            REQUIRE(block.analog().data() == pAnalog);
+        }
+        pAnalog = block.analog().data();
+        REQUIRE(block.capacity() == capacity);
+    }
+
+    // New samples from resize() are zeroed
+    block.resize(2);
+    block.analog()[1] = 7;
+    block.resize(4);
+    REQUIRE(block[1].analog == 7);
+    REQUIRE(block[3].analog == 0);
+    REQUIRE(block[3].digital == 0);
+}
+
+TEST_CASE("Test SampleBlock move", "[sampleblock-move]")
+{
+    SignalDataFacade::SampleBlock block;
+    block.push_back({5, 6});
+    const uint16_t* pAnalog = block.analog().data();
+
+    SignalDataFacade::SampleBlock moved{std::move(block)};
+    REQUIRE(moved.size() == 1);
+    REQUIRE(moved.analog().data() == pAnalog);
+    REQUIRE(block.size() == 0);
+    REQUIRE(block.capacity() == 0);
+
+    block = std::move(moved);
+    REQUIRE(block[0].digital == 6);
+}
@@ -0,0 +1,362 @@
+// Copyright (c) 2025 Michael Dello
+//
+// This software is provided under the MIT License.
+// See LICENSE file for details.
+
+//-----------------------------------------------------------------------------
+// Spectral Analysis Unit Tests
+//-----------------------------------------------------------------------------
+#define CATCH_CONFIG_MAIN
+// Include EVERYTHING from Catch2 (version 3)
+// This avoids the need to create a main() for unit testing
+#include <catch2/catch_all.hpp>
+// Alternatively, only include what is needed
+// #include <catch2/catch_test_macros.hpp> // Basic test macros
+// #include <catch2/catch_approx.hpp>  // Approximate floating-point comparisons
+// #include <catch2/catch_reporter_console.hpp> // Console reporting
+// #define CATCH_CONFIG_MAIN // Generates Catch2's main function
+// #include <catch2/catch_test_macros.hpp>
+
+// Create a custom main() instead:
+/* int main(int argc, char* argv[]) {
+    Catch::Session session; // Create Catch2 session
+    return session.run(argc, argv);
+} */
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <complex>
+#include <iostream>
+#include <memory>
+#include <numbers>
+#include <numeric>
+#include <random>
+#include <stdexcept>
+#include <vector>
+#include "facadepattern_generator.h"
+#include "facadepattern_spectrum.h"
+
+//-----------------------------------------------------------------------------
+// Test Helpers
+//-----------------------------------------------------------------------------
+
+namespace
+{
+    using SignalDataFacade::eWindow;
+    using SignalDataFacade::RealFFT;
+    using SignalDataFacade::SpectrumAnalyzer;
+
+    constexpr SignalDataFacade::eSimdLevel ALL_LEVELS[] =
+    {
+        SignalDataFacade::eSimdLevel::SCALAR,
+        SignalDataFacade::eSimdLevel::SSE4,
+        SignalDataFacade::eSimdLevel::AVX2
+    };
+
+    //-------------------------------------------------------------------------
+    // Direct O(n^2) DFT in double precision, bins from DC to Nyquist
+    std::vector<std::complex<double>> referenceDFT(
+        const std::vector<float>& samples)
+    {
+        size_t n = samples.size();
+        std::vector<std::complex<double>> spectrum(n / 2 + 1);
+        for (size_t k = 0; k < spectrum.size(); ++k)
+        {
+            for (size_t t = 0; t < n; ++t)
+            {
+                // Reduced mod n, so the angle stays exact for large k t
+                double angle = -2.0 * std::numbers::pi *
+                    double((k * t) % n) / double(n);
+                spectrum[k] += double(samples[t]) *
+                    std::complex<double>(std::cos(angle), std::sin(angle));
+            }
+        }
+        return spectrum;
+    }
+
+    //-------------------------------------------------------------------------
+    // A 10 kHz tone of amplitude 8000 codes, a -60 dB spur at 123 kHz and
+    // some noise, sampled at 1 MHz
+    std::vector<uint16_t> spurSignal(size_t count, uint64_t seed)
+    {
+        std::mt19937_64 rng(seed);
+        std::uniform_real_distribution<double> noise(-50.0, 50.0);
+        std::vector<uint16_t> samples(count);
+        for (size_t i = 0; i < count; ++i)
+        {
+            double t = double(i) / 1e6;
+            double value = 32768.0 +
+                8000.0 * std::sin(2.0 * std::numbers::pi * 10'000.0 * t) +
+                8.0 * std::sin(2.0 * std::numbers::pi * 123'000.0 * t) +
+                noise(rng);
+            samples[i] = uint16_t(std::lround(value));
+        }
+        return samples;
+    }
+
+} // namespace anonymous
+
+//-----------------------------------------------------------------------------
+// Real FFT
+//-----------------------------------------------------------------------------
+
+TEST_CASE("Test real FFT against a direct DFT", "[spectrum-fft]")
+{
+    std::mt19937_64 rng(1);
+    std::uniform_real_distribution<float> uniform(-1.0f, 1.0f);
+
+    // Even and odd powers of two, so with and without the radix-2 pass
+    for (size_t size : {8u, 16u, 32u, 64u, 128u, 512u, 2048u, 4096u})
+    {
+        std::vector<float> samples(size);
+        std::generate(
+            samples.begin(), samples.end(), [&] { return uniform(rng); });
+        auto expected = referenceDFT(samples);
+
+        for (auto level : ALL_LEVELS)
+        {
+            RealFFT fft(size, level);
+            REQUIRE(fft.size() == size);
+            REQUIRE(fft.numBins() == size / 2 + 1);
+
+            std::vector<std::complex<float>> spectrum(fft.numBins());
+            std::vector<float> power(fft.numBins());
+            fft.forward(samples, spectrum);
+            fft.power(samples, power);
+
+            // Float rounding grows with log(size) times the spectrum's scale
+            double tolerance = 1e-5 * std::sqrt(double(size)) *
+                std::log2(double(size));
+            for (size_t k = 0; k < spectrum.size(); ++k)
+            {
+                REQUIRE(std::abs(std::complex<double>(spectrum[k]) -
+                                 expected[k]) <= tolerance);
+                REQUIRE(power[k] ==
+                        Catch::Approx(std::norm(spectrum[k])).epsilon(1e-5)
+                            .margin(1e-6));
+            }
+        }
+    }
+}
+
+TEST_CASE("Test real FFT of pure tones", "[spectrum-fft]")
+{
+    constexpr size_t SIZE = 1024;
+    for (auto level : ALL_LEVELS)
+    {
+        RealFFT fft(SIZE, level);
+        std::vector<std::complex<float>> spectrum(fft.numBins());
+        for (size_t bin : {0u, 1u, 5u, 100u, 511u, 512u})
+        {
+            std::vector<float> samples(SIZE);
+            for (size_t t = 0; t < SIZE; ++t)
+            {
+                samples[t] = float(std::cos(
+                    2.0 * std::numbers::pi * double(bin * t) / double(SIZE)));
+            }
+            fft.forward(samples, spectrum);
+
+            // All of a bin-centred cosine lands in its bin, which holds
+            // size / 2, or size at DC and Nyquist
+            double expected = bin == 0 || bin == SIZE / 2 ? SIZE : SIZE / 2;
+            for (size_t k = 0; k < spectrum.size(); ++k)
+            {
+                REQUIRE(std::abs(spectrum[k]) ==
+                        Catch::Approx(k == bin ? expected : 0.0).margin(0.01));
+            }
+        }
+    }
+}
+
+TEST_CASE("Test FFT configuration errors", "[spectrum-errors]")
+{
+    for (size_t size : {0u, 1u, 4u, 12u, 1000u})
+    {
+        REQUIRE_THROWS_AS(RealFFT(size), std::invalid_argument);
+    }
+
+    RealFFT fft(64);
+    std::vector<float> samples(64);
+    std::vector<std::complex<float>> spectrum(33);
+    std::vector<float> power(32);
+    REQUIRE_THROWS_AS(
+        fft.forward(std::span(samples).first(32), spectrum),
+        std::invalid_argument);
+    REQUIRE_THROWS_AS(fft.power(samples, power), std::invalid_argument);
+
+    REQUIRE_THROWS_AS(
+        SpectrumAnalyzer({.fftSize = 100}), std::invalid_argument);
+    REQUIRE_THROWS_AS(
+        SpectrumAnalyzer({.overlap = 1.0}), std::invalid_argument);
+    REQUIRE_THROWS_AS(
+        SpectrumAnalyzer({.overlap = -0.5}), std::invalid_argument);
+    REQUIRE_THROWS_AS(
+        SpectrumAnalyzer({.sampleRateHz = 0.0}), std::invalid_argument);
+}
+
+//-----------------------------------------------------------------------------
+// Windows and Welch Averaging
+//-----------------------------------------------------------------------------
+
+TEST_CASE("Test window coefficients", "[spectrum-windows]")
+{
+    constexpr size_t SIZE = 256;
+    auto rectangular = windowCoefficients(eWindow::RECTANGULAR, SIZE);
+    auto hann = windowCoefficients(eWindow::HANN, SIZE);
+    auto blackman = windowCoefficients(eWindow::BLACKMAN, SIZE);
+    REQUIRE(hann.size() == SIZE);
+
+    auto sum = [](const std::vector<float>& window)
+    {
+        return std::accumulate(window.begin(), window.end(), 0.0);
+    };
+    REQUIRE(sum(rectangular) == Catch::Approx(SIZE));
+    // Periodic windows: coherent gains of exactly 0.5 and 0.42
+    REQUIRE(sum(hann) == Catch::Approx(0.5 * SIZE));
+    REQUIRE(sum(blackman) == Catch::Approx(0.42 * SIZE));
+    REQUIRE(hann[0] == Catch::Approx(0.0).margin(1e-7));
+    REQUIRE(hann[SIZE / 2] == Catch::Approx(1.0));
+    REQUIRE(blackman[SIZE / 2] == Catch::Approx(1.0));
+    for (size_t i = 1; i < SIZE; ++i)
+    {
+        REQUIRE(hann[i] == Catch::Approx(hann[SIZE - i]).margin(1e-6));
+    }
+}
+
+TEST_CASE("Test Welch spectrum finds spurs", "[spectrum-welch]")
+{
+    constexpr size_t NUM_SAMPLES = 1 << 18;
+    auto samples = spurSignal(NUM_SAMPLES, 1);
+
+    for (auto level : ALL_LEVELS)
+    {
+        SpectrumAnalyzer analyzer(
+            {.fftSize = 4096, .window = eWindow::BLACKMAN}, level);
+        REQUIRE(analyzer.numBins() == 2049);
+        REQUIRE(analyzer.binWidthHz() == Catch::Approx(1e6 / 4096));
+        REQUIRE(analyzer.powerSpectralDensity() ==
+                std::vector<double>(2049, 0.0));
+
+        // Batches that do not line up with segments
+        for (size_t first = 0; first < NUM_SAMPLES; first += 1000)
+        {
+            size_t count = std::min<size_t>(1000, NUM_SAMPLES - first);
+            analyzer.process(std::span(samples).subspan(first, count));
+        }
+        // Half-overlapping segments
+        REQUIRE(analyzer.segmentsAveraged() ==
+                (NUM_SAMPLES - 4096) / 2048 + 1);
+
+        // The tone, then the spur 60 dB below it, each within a bin
+        auto peaks = analyzer.findPeaks(2);
+        REQUIRE(peaks.size() == 2);
+        REQUIRE(std::abs(peaks[0].frequencyHz - 10'000.0) <=
+                analyzer.binWidthHz());
+        REQUIRE(std::abs(peaks[1].frequencyHz - 123'000.0) <=
+                analyzer.binWidthHz());
+        double ratioDb = 10.0 * std::log10(peaks[0].density / peaks[1].density);
+        REQUIRE(ratioDb == Catch::Approx(60.0).margin(1.0));
+
+        // Parseval: the density integrates to the variance of the signal,
+        // about 8000^2 / 2 from the tone
+        auto density = analyzer.powerSpectralDensity();
+        double variance = std::accumulate(density.begin(), density.end(), 0.0)
+            * analyzer.binWidthHz();
+        REQUIRE(variance == Catch::Approx(8000.0 * 8000.0 / 2.0).epsilon(0.01));
+
+        // The same stream in one call gives the same estimate
+        SpectrumAnalyzer whole(
+            {.fftSize = 4096, .window = eWindow::BLACKMAN}, level);
+        whole.process(samples);
+        REQUIRE(whole.segmentsAveraged() == analyzer.segmentsAveraged());
+        auto wholeDensity = whole.powerSpectralDensity();
+        for (size_t k = 0; k < density.size(); ++k)
+        {
+            REQUIRE(wholeDensity[k] == density[k]);
+        }
+
+        analyzer.reset();
+        REQUIRE(analyzer.segmentsAveraged() == 0);
+    }
+
+    // A Hann window leaks more, but still separates the spur
+    SpectrumAnalyzer hann({.fftSize = 8192, .overlap = 0.75});
+    hann.process(samples);
+    REQUIRE(hann.segmentsAveraged() == (NUM_SAMPLES - 8192) / 2048 + 1);
+    auto peaks = hann.findPeaks(2);
+    REQUIRE(std::abs(peaks[1].frequencyHz - 123'000.0) <= hann.binWidthHz());
+}
+
+TEST_CASE("Test spectrum on the acquisition stream", "[spectrum-streaming]")
+{
+    using namespace std::chrono_literals;
+    SignalDataFacade::sWaveformConfig_t waveform{
+        .frequencyHz = 25'000.0,
+        .noiseAmplitude = 100};
+    SignalDataFacade::SignalData engine{
+        std::make_unique<SignalDataFacade::A2DConverterHAL>(
+            std::make_unique<SignalDataFacade::SyntheticADCDrv>(waveform)),
+        std::make_unique<SignalDataFacade::GPIOHAL>(
+            std::make_unique<SignalDataFacade::SyntheticGPIODrv>(
+                SignalDataFacade::sGpioGeneratorConfig_t{}))};
+
+    SpectrumAnalyzer analyzer({.fftSize = 2048});
+    std::vector<SignalDataFacade::SignalData::sAggregateData> samples(4096);
+    engine.startStreaming();
+    while (analyzer.segmentsAveraged() < 32)
+    {
+        size_t count = engine.readStream(samples, 1s);
+        REQUIRE(count > 0);
+        analyzer.process(std::span(samples).first(count));
+    }
+    engine.stopStreaming();
+
+    auto peaks = analyzer.findPeaks(1);
+    REQUIRE(peaks.size() == 1);
+    REQUIRE(std::abs(peaks[0].frequencyHz - 25'000.0) <=
+            analyzer.binWidthHz());
+}
+
+//-----------------------------------------------------------------------------
+// Benchmarks (hidden, run with: ./test_facadepattern_spectrum "[benchmark]")
+//-----------------------------------------------------------------------------
+
+TEST_CASE(
+    "Benchmark real FFT throughput",
+    "[.][benchmark][spectrum-benchmark]")
+{
+    std::mt19937_64 rng(1);
+    std::uniform_real_distribution<float> uniform(-1.0f, 1.0f);
+
+    for (size_t size = 1024; size <= 65536; size *= 2)
+    {
+        std::vector<float> samples(size);
+        std::generate(
+            samples.begin(), samples.end(), [&] { return uniform(rng); });
+        std::vector<float> power(size / 2 + 1);
+        // About 64M samples per measurement
+        size_t repeats = std::max<size_t>(16, (64u << 20) / size);
+
+        for (auto level : ALL_LEVELS)
+        {
+            RealFFT fft(size, level);
+            auto start = std::chrono::steady_clock::now();
+            for (size_t i = 0; i < repeats; ++i)
+            {
+                fft.power(samples, power);
+            }
+            std::chrono::duration<double> elapsed =
+                std::chrono::steady_clock::now() - start;
+
+            REQUIRE(power[0] >= 0.0f);
+            std::cout << size
+                      << " points, "
+                      << SignalDataFacade::toString(fft.simdLevel())
+                      << ": "
+                      << double(repeats) / elapsed.count()
+                      << " FFTs/s"
+                      << std::endl;
+        }
+    }
+}
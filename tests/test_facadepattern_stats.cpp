@@ -0,0 +1,181 @@
+// Copyright (c) 2025 Michael Dello
+//
+// This software is provided under the MIT License.
+// See LICENSE file for details.
+
+//-----------------------------------------------------------------------------
+// Signal Data Statistics Unit Tests
+//-----------------------------------------------------------------------------
+#define CATCH_CONFIG_MAIN
+// Include EVERYTHING from Catch2 (version 3)
+// This avoids the need to create a main() for unit testing
+#include <catch2/catch_all.hpp>
+// Alternatively, only include what is needed
+// #include <catch2/catch_test_macros.hpp> // Basic test macros
+// #include <catch2/catch_approx.hpp>  // Approximate floating-point comparisons
+// #include <catch2/catch_reporter_console.hpp> // Console reporting
+// #define CATCH_CONFIG_MAIN // Generates Catch2's main function
+// #include <catch2/catch_test_macros.hpp>
+
+// Create a custom main() instead:
+/* int main(int argc, char* argv[]) {
+    Catch::Session session; // Create Catch2 session
+    return session.run(argc, argv);
+} */
+
+#include <chrono>
+#include <cmath>
+#include <iostream>
+#include <random>
+#include <vector>
+#include "facadepattern_stats.h"
+
+//-----------------------------------------------------------------------------
+// Test Helpers
+//-----------------------------------------------------------------------------
+
+namespace
+{
+    constexpr SignalDataFacade::eSimdLevel ALL_LEVELS[] =
+    {
+        SignalDataFacade::eSimdLevel::SCALAR,
+        SignalDataFacade::eSimdLevel::SSE4,
+        SignalDataFacade::eSimdLevel::AVX2
+    };
+
+    //-------------------------------------------------------------------------
+    std::vector<uint16_t> randomSamples(size_t count, uint32_t seed)
+    {
+        std::mt19937 rng(seed);
+        std::uniform_int_distribution<uint16_t> dist(0, 65535);
+        std::vector<uint16_t> samples(count);
+        for (uint16_t& sample : samples)
+        {
+            sample = dist(rng);
+        }
+        return samples;
+    }
+
+} // namespace anonymous
+
+//=============================================================================
+// computeStats() Unit Tests
+//=============================================================================
+
+TEST_CASE("Test computeStats() empty block", "[stats-empty]")
+{
+    for (auto level : ALL_LEVELS)
+    {
+        auto stats = SignalDataFacade::computeStats({}, level);
+        REQUIRE(stats.count == 0);
+        REQUIRE(stats.min == 0);
+        REQUIRE(stats.max == 0);
+        REQUIRE(stats.mean == 0.0);
+        REQUIRE(stats.rms == 0.0);
+        REQUIRE(stats.variance == 0.0);
+    }
+}
+
+TEST_CASE("Test computeStats() known values", "[stats-known-values]")
+{
+    std::vector<uint16_t> samples{4, 1, 3, 2};
+    for (auto level : ALL_LEVELS)
+    {
+        auto stats = SignalDataFacade::computeStats(samples, level);
+        REQUIRE(stats.count == 4);
+        REQUIRE(stats.min == 1);
+        REQUIRE(stats.max == 4);
+        REQUIRE(stats.mean == Catch::Approx(2.5));
+        REQUIRE(stats.rms == Catch::Approx(std::sqrt(7.5)));
+        REQUIRE(stats.variance == Catch::Approx(1.25));
+    }
+}
+
+TEST_CASE("Test computeStats() kernels agree", "[stats-kernels-agree]")
+{
+    // Odd length leaves a scalar tail after the vector loop
+    auto samples = randomSamples(100003, 7);
+    samples[5000] = 0;
+    samples[90000] = 65535;
+    auto expected = SignalDataFacade::computeStats(
+        samples, SignalDataFacade::eSimdLevel::SCALAR);
+    REQUIRE(expected.min == 0);
+    REQUIRE(expected.max == 65535);
+
+    for (auto level : ALL_LEVELS)
+    {
+        INFO("Kernel " << SignalDataFacade::toString(level));
+        auto stats = SignalDataFacade::computeStats(samples, level);
+        REQUIRE(stats.count == expected.count);
+        REQUIRE(stats.min == expected.min);
+        REQUIRE(stats.max == expected.max);
+        REQUIRE(stats.mean == expected.mean);
+        REQUIRE(stats.rms == expected.rms);
+        REQUIRE(stats.variance == expected.variance);
+    }
+}
+
+TEST_CASE("Test computeStats() full scale sums", "[stats-full-scale]")
+{
+    // Long enough for the kernels to widen their lane sums several times
+    std::vector<uint16_t> samples(1 << 20, 65535);
+    for (auto level : ALL_LEVELS)
+    {
+        INFO("Kernel " << SignalDataFacade::toString(level));
+        auto stats = SignalDataFacade::computeStats(samples, level);
+        REQUIRE(stats.min == 65535);
+        REQUIRE(stats.max == 65535);
+        REQUIRE(stats.mean == 65535.0);
+        REQUIRE(stats.rms == Catch::Approx(65535.0));
+        REQUIRE(stats.variance == Catch::Approx(0.0).margin(1e-6));
+    }
+}
+
+TEST_CASE("Test computeStats() sample block", "[stats-sample-block]")
+{
+    std::vector<uint16_t> analog{10, 20, 30};
+    std::vector<uint16_t> digital{1, 1};
+    auto stats = SignalDataFacade::computeStats(
+        SignalDataFacade::sSampleBlockView{analog, digital});
+    REQUIRE(stats.analog.count == 3);
+    REQUIRE(stats.analog.mean == Catch::Approx(20.0));
+    REQUIRE(stats.digital.count == 2);
+    REQUIRE(stats.digital.max == 1);
+}
+
+//-----------------------------------------------------------------------------
+// Benchmarks (hidden, run with: ./test_facadepattern_stats "[benchmark]")
+//-----------------------------------------------------------------------------
+
+TEST_CASE(
+    "Benchmark computeStats() kernels",
+    "[.][benchmark][stats-benchmark]")
+{
+    constexpr size_t NUM_SAMPLES = 32 << 20;
+    constexpr int NUM_PASSES = 4;
+    auto samples = randomSamples(NUM_SAMPLES, 1);
+
+    std::cout << "Detected kernel: "
+              << SignalDataFacade::toString(
+                    SignalDataFacade::detectedSimdLevel())
+              << std::endl;
+    for (auto level : ALL_LEVELS)
+    {
+        double checksum = 0.0;
+        auto start = std::chrono::steady_clock::now();
+        for (int pass = 0; pass < NUM_PASSES; ++pass)
+        {
+            checksum += SignalDataFacade::computeStats(samples, level).mean;
+        }
+        std::chrono::duration<double> elapsed =
+            std::chrono::steady_clock::now() - start;
+
+        REQUIRE(checksum > 0.0);
+        std::cout << SignalDataFacade::toString(level)
+                  << ": "
+                  << double(NUM_SAMPLES * sizeof(uint16_t) * NUM_PASSES) /
+                        elapsed.count() / 1e9
+                  << " GB/s"
+                  << std::endl;
+    }
+}
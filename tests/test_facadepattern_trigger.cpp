@@ -0,0 +1,440 @@
+// Copyright (c) 2025 Michael Dello
+//
+// This software is provided under the MIT License.
+// See LICENSE file for details.
+
+//-----------------------------------------------------------------------------
+// Trigger Engine Unit Tests
+//-----------------------------------------------------------------------------
+#define CATCH_CONFIG_MAIN
+// Include EVERYTHING from Catch2 (version 3)
+// This avoids the need to create a main() for unit testing
+#include <catch2/catch_all.hpp>
+// Alternatively, only include what is needed
+// #include <catch2/catch_test_macros.hpp> // Basic test macros
+// #include <catch2/catch_approx.hpp>  // Approximate floating-point comparisons
+// #include <catch2/catch_reporter_console.hpp> // Console reporting
+// #define CATCH_CONFIG_MAIN // Generates Catch2's main function
+// #include <catch2/catch_test_macros.hpp>
+
+// Create a custom main() instead:
+/* int main(int argc, char* argv[]) {
+    Catch::Session session; // Create Catch2 session
+    return session.run(argc, argv);
+} */
+
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+#include <memory>
+#include <random>
+#include <stdexcept>
+#include <vector>
+#include "facadepattern_generator.h"
+#include "facadepattern_trigger.h"
+
+//-----------------------------------------------------------------------------
+// Test Helpers
+//-----------------------------------------------------------------------------
+
+namespace
+{
+    using SignalDataFacade::eCombine;
+    using SignalDataFacade::eEdge;
+    using SignalDataFacade::eTriggerSource;
+    using SignalDataFacade::sTriggerCondition_t;
+    using SignalDataFacade::sTriggerCapture;
+
+    constexpr SignalDataFacade::eSimdLevel ALL_LEVELS[] =
+    {
+        SignalDataFacade::eSimdLevel::SCALAR,
+        SignalDataFacade::eSimdLevel::SSE4,
+        SignalDataFacade::eSimdLevel::AVX2
+    };
+
+    //-------------------------------------------------------------------------
+    // A noisy sine and slowly toggling GPIO lines
+    struct sTestSignal
+    {
+        std::vector<uint16_t> analog;
+        std::vector<uint16_t> digital;
+
+        SignalDataFacade::sSampleBlockView view(
+            size_t first,
+            size_t count) const
+        {
+            return {
+                std::span(analog).subspan(first, count),
+                std::span(digital).subspan(first, count)};
+        }
+    };
+
+    sTestSignal testSignal(size_t count, uint64_t seed)
+    {
+        SignalDataFacade::SignalGenerator generator{{
+            .waveform = SignalDataFacade::eWaveform::SINE,
+            .sampleRateHz = 1'000'000.0,
+            .frequencyHz = 3000.0,
+            .noiseAmplitude = 2000,
+            .seed = seed}};
+        sTestSignal signal{std::vector<uint16_t>(count), {}};
+        generator.generate(signal.analog);
+
+        std::mt19937_64 rng(seed);
+        std::geometric_distribution<size_t> hold(0.01);
+        uint16_t word = 0;
+        while (signal.digital.size() < count)
+        {
+            signal.digital.resize(
+                std::min(count, signal.digital.size() + hold(rng) + 1), word);
+            word ^= uint16_t(1u << (rng() % 4));
+        }
+        return signal;
+    }
+
+    //-------------------------------------------------------------------------
+    // Whether a condition holds at sample i > 0, one sample at a time
+    bool referenceCondition(
+        const sTriggerCondition_t& condition,
+        const sTestSignal& signal,
+        size_t i)
+    {
+        auto crossed = [&](bool bBefore, bool bNow)
+        {
+            switch (condition.edge)
+            {
+                case eEdge::RISING:
+                    return !bBefore && bNow;
+                case eEdge::FALLING:
+                    return bBefore && !bNow;
+                default:
+                    return bBefore != bNow;
+            }
+        };
+        int before = signal.analog[i - 1];
+        int now = signal.analog[i];
+        uint16_t bit = uint16_t(1u << condition.line);
+        switch (condition.source)
+        {
+            case eTriggerSource::ANALOG_LEVEL:
+                return crossed(
+                    before >= condition.threshold,
+                    now >= condition.threshold);
+            case eTriggerSource::ANALOG_SLOPE:
+                return (condition.edge != eEdge::FALLING &&
+                        now - before >= condition.threshold) ||
+                       (condition.edge != eEdge::RISING &&
+                        before - now >= condition.threshold);
+            case eTriggerSource::GPIO_EDGE:
+                return crossed(
+                    signal.digital[i - 1] & bit, signal.digital[i] & bit);
+            case eTriggerSource::GPIO_PATTERN:
+                return (signal.digital[i] & condition.mask) == condition.value;
+        }
+        return false;
+    }
+
+    //-------------------------------------------------------------------------
+    std::vector<uint64_t> referenceFirings(
+        const SignalDataFacade::sTriggerConfig_t& config,
+        const sTestSignal& signal)
+    {
+        std::vector<uint64_t> firings;
+        bool bPrevious = true;
+        for (size_t i = 1; i < signal.analog.size(); ++i)
+        {
+            bool bCombined = config.combine == eCombine::AND;
+            for (const auto& condition : config.conditions)
+            {
+                bool bHolds = referenceCondition(condition, signal, i);
+                bCombined = config.combine == eCombine::AND ?
+                    bCombined && bHolds : bCombined || bHolds;
+            }
+            if (bCombined && !bPrevious)
+            {
+                firings.push_back(i);
+            }
+            bPrevious = bCombined;
+        }
+        return firings;
+    }
+
+    //-------------------------------------------------------------------------
+    std::vector<uint64_t> engineFirings(
+        SignalDataFacade::TriggerEngine& engine,
+        const sTestSignal& signal,
+        size_t batch)
+    {
+        std::vector<uint64_t> firings;
+        for (size_t first = 0; first < signal.analog.size(); first += batch)
+        {
+            auto view = signal.view(
+                first, std::min(batch, signal.analog.size() - first));
+            auto fired = engine.evaluate(view);
+            firings.insert(firings.end(), fired.begin(), fired.end());
+            engine.process(view, 0);
+        }
+        return firings;
+    }
+
+} // namespace anonymous
+
+//=============================================================================
+// TriggerEngine Unit Tests
+//=============================================================================
+
+TEST_CASE("Test trigger conditions", "[trigger-conditions]")
+{
+    auto signal = testSignal(20000, 3);
+    const sTriggerCondition_t conditions[] =
+    {
+        {.source = eTriggerSource::ANALOG_LEVEL, .threshold = 40000},
+        {.source = eTriggerSource::ANALOG_LEVEL, .threshold = 30000,
+         .edge = eEdge::FALLING},
+        {.source = eTriggerSource::ANALOG_LEVEL, .threshold = 65535,
+         .edge = eEdge::ANY},
+        {.source = eTriggerSource::ANALOG_SLOPE, .threshold = 3000},
+        {.source = eTriggerSource::ANALOG_SLOPE, .threshold = 3500,
+         .edge = eEdge::ANY},
+        {.source = eTriggerSource::GPIO_EDGE, .line = 2},
+        {.source = eTriggerSource::GPIO_EDGE, .edge = eEdge::FALLING,
+         .line = 0},
+        {.source = eTriggerSource::GPIO_PATTERN, .mask = 0x0003,
+         .value = 0x0002}
+    };
+
+    for (const auto& condition : conditions)
+    {
+        SignalDataFacade::sTriggerConfig_t config{.conditions = {condition}};
+        auto expected = referenceFirings(config, signal);
+        for (auto level : ALL_LEVELS)
+        {
+            INFO(SignalDataFacade::toString(condition.source)
+                 << " " << SignalDataFacade::toString(level));
+            SignalDataFacade::TriggerEngine engine{
+                config, [](sTriggerCapture&&) {}, level};
+            // Batches that split groups at every offset
+            REQUIRE(engineFirings(engine, signal, 1000) == expected);
+            engine.reset();
+            REQUIRE(engineFirings(engine, signal, 77) == expected);
+        }
+    }
+}
+
+TEST_CASE("Test trigger combinations", "[trigger-combinations]")
+{
+    auto signal = testSignal(20000, 5);
+    sTriggerCondition_t rising{
+        .source = eTriggerSource::ANALOG_LEVEL, .threshold = 35000};
+    sTriggerCondition_t pattern{
+        .source = eTriggerSource::GPIO_PATTERN, .mask = 0x0001, .value = 1};
+    sTriggerCondition_t edge{
+        .source = eTriggerSource::GPIO_EDGE, .edge = eEdge::ANY, .line = 1};
+
+    for (auto combine : {eCombine::AND, eCombine::OR})
+    {
+        SignalDataFacade::sTriggerConfig_t config{
+            .conditions = {rising, pattern, edge}, .combine = combine};
+        if (combine == eCombine::AND)
+        {
+            config.conditions.pop_back();
+        }
+        auto expected = referenceFirings(config, signal);
+        REQUIRE(!expected.empty());
+        for (auto level : ALL_LEVELS)
+        {
+            INFO(SignalDataFacade::toString(combine)
+                 << " " << SignalDataFacade::toString(level));
+            SignalDataFacade::TriggerEngine engine{
+                config, [](sTriggerCapture&&) {}, level};
+            REQUIRE(engineFirings(engine, signal, 333) == expected);
+        }
+    }
+}
+
+TEST_CASE("Test trigger capture windows", "[trigger-windows]")
+{
+    constexpr size_t PRE = 100;
+    constexpr size_t POST = 300;
+    auto signal = testSignal(20000, 7);
+    SignalDataFacade::sTriggerConfig_t config{
+        .conditions = {{
+            .source = eTriggerSource::GPIO_EDGE,
+            .edge = eEdge::RISING,
+            .line = 3}},
+        .preSamples = PRE,
+        .postSamples = POST,
+        .sampleRateHz = 1000.0};
+
+    std::vector<sTriggerCapture> captures;
+    SignalDataFacade::TriggerEngine engine{
+        config,
+        [&](sTriggerCapture&& capture)
+        {
+            captures.push_back(std::move(capture));
+        }};
+    for (size_t first = 0; first < signal.analog.size(); first += 250)
+    {
+        // 1 ms per sample
+        engine.process(
+            signal.view(first, 250), 5'000'000'000 + first * 1'000'000);
+    }
+    engine.flush();
+    REQUIRE(engine.samplesProcessed() == signal.analog.size());
+    REQUIRE(engine.triggerCount() == captures.size());
+    REQUIRE(captures.size() > 5);
+
+    // Every firing that is not inside an earlier window is captured
+    auto expected = referenceFirings(config, signal);
+    std::vector<uint64_t> armed;
+    for (uint64_t index : expected)
+    {
+        if (armed.empty() || index >= armed.back() + POST)
+        {
+            armed.push_back(index);
+        }
+    }
+    REQUIRE(captures.size() == armed.size());
+    for (size_t i = 0; i < captures.size(); ++i)
+    {
+        const sTriggerCapture& capture = captures[i];
+        uint64_t trigger = capture.triggerSampleIndex;
+        REQUIRE(trigger == armed[i]);
+        REQUIRE(capture.triggerTimestampNs ==
+            5'000'000'000 + trigger * 1'000'000);
+        REQUIRE(capture.firstSampleIndex ==
+            trigger - std::min<uint64_t>(PRE, trigger));
+        REQUIRE(capture.firstTimestampNs ==
+            5'000'000'000 + capture.firstSampleIndex * 1'000'000);
+
+        size_t expectedSize = std::min<size_t>(
+            trigger - capture.firstSampleIndex + POST,
+            signal.analog.size() - capture.firstSampleIndex);
+        REQUIRE(capture.samples.size() == expectedSize);
+        REQUIRE(std::equal(
+            capture.samples.analog().begin(),
+            capture.samples.analog().end(),
+            signal.analog.begin() + capture.firstSampleIndex));
+        REQUIRE(std::equal(
+            capture.samples.digital().begin(),
+            capture.samples.digital().end(),
+            signal.digital.begin() + capture.firstSampleIndex));
+    }
+
+    // Starting over counts from 0 again
+    engine.reset();
+    REQUIRE(engine.samplesProcessed() == 0);
+    REQUIRE(engine.triggerCount() == 0);
+}
+
+TEST_CASE("Test trigger configuration errors", "[trigger-errors]")
+{
+    auto ignore = [](sTriggerCapture&&) {};
+    REQUIRE_THROWS_AS(
+        SignalDataFacade::TriggerEngine({}, ignore), std::invalid_argument);
+    REQUIRE_THROWS_AS(
+        SignalDataFacade::TriggerEngine(
+            {.conditions = {{.source = eTriggerSource::GPIO_EDGE,
+                             .line = 16}}},
+            ignore),
+        std::invalid_argument);
+    REQUIRE_THROWS_AS(
+        SignalDataFacade::TriggerEngine(
+            {.conditions = {{.source = eTriggerSource::ANALOG_SLOPE,
+                             .threshold = 0}}},
+            ignore),
+        std::invalid_argument);
+
+    SignalDataFacade::TriggerEngine engine{{.conditions = {{}}}, ignore};
+    std::vector<uint16_t> analog(10);
+    std::vector<uint16_t> digital(9);
+    REQUIRE_THROWS_AS(
+        engine.process({analog, digital}, 0), std::invalid_argument);
+}
+
+TEST_CASE("Test trigger on the acquisition stream", "[trigger-streaming]")
+{
+    using namespace std::chrono_literals;
+    // GPIO line 0 toggles at 1 kHz
+    SignalDataFacade::sGpioGeneratorConfig_t gpioConfig;
+    SignalDataFacade::SignalData engine{
+        std::make_unique<SignalDataFacade::A2DConverterHAL>(
+            std::make_unique<SignalDataFacade::SyntheticADCDrv>(
+                SignalDataFacade::sWaveformConfig_t{})),
+        std::make_unique<SignalDataFacade::GPIOHAL>(
+            std::make_unique<SignalDataFacade::SyntheticGPIODrv>(
+                gpioConfig))};
+
+    std::vector<sTriggerCapture> captures;
+    SignalDataFacade::TriggerEngine trigger{
+        {.conditions = {{
+            .source = eTriggerSource::GPIO_EDGE,
+            .edge = eEdge::RISING}},
+         .preSamples = 50,
+         .postSamples = 50},
+        [&](sTriggerCapture&& capture)
+        {
+            captures.push_back(std::move(capture));
+        }};
+
+    std::vector<SignalDataFacade::SignalData::sAggregateData> samples(4096);
+    engine.startStreaming();
+    while (trigger.samplesProcessed() < 100000)
+    {
+        uint64_t timestampNs = 0;
+        size_t count = engine.readStream(samples, 1s, timestampNs);
+        REQUIRE(count > 0);
+        trigger.process(std::span(samples).first(count), timestampNs);
+    }
+    engine.stopStreaming();
+
+    // One rising edge per 1000 samples, the line low before and high after
+    REQUIRE(captures.size() >= 99);
+    for (const auto& capture : captures)
+    {
+        REQUIRE(capture.samples.size() == 100);
+        REQUIRE((capture.samples.digital()[49] & 1) == 0);
+        REQUIRE((capture.samples.digital()[50] & 1) == 1);
+    }
+}
+
+//-----------------------------------------------------------------------------
+// Benchmarks (hidden, run with: ./test_facadepattern_trigger "[benchmark]")
+//-----------------------------------------------------------------------------
+
+TEST_CASE(
+    "Benchmark trigger evaluation",
+    "[.][benchmark][trigger-benchmark]")
+{
+    constexpr size_t NUM_SAMPLES = 16 << 20;
+    constexpr size_t BATCH = 1 << 16;
+    auto signal = testSignal(NUM_SAMPLES, 1);
+    SignalDataFacade::sTriggerConfig_t config{
+        .conditions = {
+            {.source = eTriggerSource::ANALOG_LEVEL, .threshold = 45000},
+            {.source = eTriggerSource::GPIO_PATTERN, .mask = 0x0003,
+             .value = 0x0003}}};
+
+    for (auto level : ALL_LEVELS)
+    {
+        size_t numCaptured = 0;
+        SignalDataFacade::TriggerEngine engine{
+            config, [&](sTriggerCapture&&) { ++numCaptured; }, level};
+        auto start = std::chrono::steady_clock::now();
+        for (size_t first = 0; first < NUM_SAMPLES; first += BATCH)
+        {
+            engine.process(signal.view(first, BATCH), 0);
+        }
+        std::chrono::duration<double> elapsed =
+            std::chrono::steady_clock::now() - start;
+
+        REQUIRE(engine.samplesProcessed() == NUM_SAMPLES);
+        std::cout << SignalDataFacade::toString(engine.simdLevel())
+                  << ": "
+                  << double(NUM_SAMPLES) / elapsed.count() / 1e6
+                  << " Msamples/s, "
+                  << numCaptured
+                  << " captures"
+                  << std::endl;
+    }
+}
@@ -23,6 +23,15 @@
     return session.run(argc, argv);
 } */
 
+#include <fcntl.h>
+#include <unistd.h>
+#include <chrono>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <thread>
+#include <vector>
 #include "proxypattern.h"
 
 //=============================================================================
@@ -223,3 +232,375 @@ TEST_CASE("Test proxy overall results", "[proxy-overall-results]")
     expectedValue = DUTProxy::eTestResults::NONE;
     REQUIRE(dutProxy.execute(DUTProxy::eTests::STOP_TESTING) == expectedValue);
 }
+
+//-----------------------------------------------------------------------------
+// Shared Client Unit Tests
+//-----------------------------------------------------------------------------
+
+TEST_CASE(
+    "Test proxy execute() shared across threads",
+    "[proxy-execute-shared]")
+{
+    // DUT params
+    std::string sDutName{"EX-DUT-1"};
+    std::string sDutIpAddr{"127.0.0.1"};
+
+    DUTProxy::DUT localDut{{sDutName}};
+    DUTProxy::DUTProxyServer proxyServer{localDut};
+    DUTProxy::DUTProxyClient dutProxy{{sDutName, sDutIpAddr}};
+
+    // Each thread runs a different test, so a response routed to the wrong
+    // caller shows up as a wrong result
+    const std::vector<std::pair<DUTProxy::eTests, DUTProxy::eTestResults>>
+        testsAndResults{
+            {DUTProxy::eTests::TEST_PASSINGFEATURE,
+                DUTProxy::eTestResults::PASS},
+            {DUTProxy::eTests::TEST_FAILINGFEATURE,
+                DUTProxy::eTestResults::FAIL},
+            {DUTProxy::eTests::TEST_INCOMPLETEFEATURE,
+                DUTProxy::eTestResults::AMBIGUOUS}};
+    constexpr int NUM_THREADS_PER_TEST = 4;
+    constexpr int NUM_REQUESTS_PER_THREAD = 25;
+
+    std::atomic<int> mismatches{0};
+    std::vector<std::thread> callers;
+    for (const auto& [test, expectedValue] : testsAndResults)
+    {
+        for (int i = 0; i < NUM_THREADS_PER_TEST; ++i)
+        {
+            callers.emplace_back([&, test, expectedValue]()
+            {
+                for (int j = 0; j < NUM_REQUESTS_PER_THREAD; ++j)
+                {
+                    if (dutProxy.execute(test) != expectedValue)
+                    {
+                        ++mismatches;
+                    }
+                }
+            });
+        }
+    }
+    for (auto& caller : callers)
+    {
+        caller.join();
+    }
+
+    REQUIRE(mismatches == 0);
+    // Any failing test latches the overall result
+    REQUIRE(
+        dutProxy.execute(DUTProxy::eTests::STOP_TESTING) ==
+            DUTProxy::eTestResults::FAILED);
+}
+
+//-----------------------------------------------------------------------------
+// Result Subscription Unit Tests
+//-----------------------------------------------------------------------------
+
+TEST_CASE("Test proxy result subscription", "[proxy-subscribe-results]")
+{
+    using namespace std::chrono_literals;
+
+    // DUT params
+    std::string sDutName{"EX-DUT-1"};
+    std::string sDutIpAddr{"127.0.0.1"};
+
+    DUTProxy::DUT localDut{{sDutName}};
+    // Wide window so the request bursts below always coalesce
+    DUTProxy::DUTProxyServer proxyServer{localDut, {.eventWindow = 200ms}};
+    DUTProxy::DUTResultSubscriber subscriber{{sDutName, sDutIpAddr}};
+    DUTProxy::DUTProxyClient dutProxy{{sDutName, sDutIpAddr}};
+
+    // Subscribing reports the current state first
+    REQUIRE(subscriber.nextEvent(2s) == DUTProxy::eTestResults::NONE);
+
+    // A burst of changes is pushed as one event carrying the latest result
+    dutProxy.execute(DUTProxy::eTests::TEST_PASSINGFEATURE);
+    dutProxy.execute(DUTProxy::eTests::TEST_FAILINGFEATURE);
+    REQUIRE(subscriber.nextEvent(2s) == DUTProxy::eTestResults::FAILED);
+    REQUIRE_FALSE(subscriber.nextEvent(400ms).has_value());
+
+    // Results that do not change the running result push nothing
+    dutProxy.execute(DUTProxy::eTests::TEST_PASSINGFEATURE);
+    REQUIRE_FALSE(subscriber.nextEvent(400ms).has_value());
+
+    // Stopping resets the running result
+    REQUIRE(
+        dutProxy.execute(DUTProxy::eTests::STOP_TESTING) ==
+            DUTProxy::eTestResults::FAILED);
+    REQUIRE(subscriber.nextEvent(2s) == DUTProxy::eTestResults::NONE);
+}
+
+TEST_CASE("Test DUT currentResult()", "[dut-current-result]")
+{
+    DUTProxy::DUT dut{{"EX-DUT-1"}};
+    REQUIRE(dut.currentResult() == DUTProxy::eTestResults::NONE);
+    dut.execute(DUTProxy::eTests::TEST_PASSINGFEATURE);
+    // Viewing the running result does not reset it
+    REQUIRE(dut.currentResult() == DUTProxy::eTestResults::PASSED);
+    REQUIRE(dut.currentResult() == DUTProxy::eTestResults::PASSED);
+    REQUIRE(
+        dut.execute(DUTProxy::eTests::STOP_TESTING) ==
+            DUTProxy::eTestResults::PASSED);
+    REQUIRE(dut.currentResult() == DUTProxy::eTestResults::NONE);
+}
+
+//-----------------------------------------------------------------------------
+// Artifact Fetch Unit Tests
+//-----------------------------------------------------------------------------
+
+namespace
+{
+    //-------------------------------------------------------------------------
+    // Create an artifact directory holding one file with a known pattern
+    std::filesystem::path makeArtifactDir(
+        const std::string& sArtifactName,
+        size_t size)
+    {
+        auto artifactDir =
+            std::filesystem::temp_directory_path() / "dutproxy-artifacts";
+        std::filesystem::create_directories(artifactDir);
+        std::ofstream artifact(
+            artifactDir / sArtifactName, std::ios::binary | std::ios::trunc);
+        for (size_t i = 0; i < size; ++i)
+        {
+            artifact.put(static_cast<char>(i * 31 + (i >> 12)));
+        }
+        return artifactDir;
+    }
+
+    //-------------------------------------------------------------------------
+    std::vector<std::byte> readFile(const std::filesystem::path& path)
+    {
+        std::ifstream file(path, std::ios::binary);
+        std::vector<char> contents(
+            (std::istreambuf_iterator<char>(file)),
+            std::istreambuf_iterator<char>());
+        std::vector<std::byte> bytes(contents.size());
+        std::memcpy(bytes.data(), contents.data(), contents.size());
+        return bytes;
+    }
+
+} // namespace anonymous
+
+TEST_CASE(
+    "Test proxy fetchArtifact() buffer",
+    "[proxy-fetch-artifact-buffer]")
+{
+    // DUT params
+    std::string sDutName{"EX-DUT-1"};
+    std::string sDutIpAddr{"127.0.0.1"};
+
+    // Several chunks plus a partial one
+    constexpr size_t ARTIFACT_SIZE = (3 << 20) + 12345;
+    auto artifactDir = makeArtifactDir("waveform.bin", ARTIFACT_SIZE);
+    auto expected = readFile(artifactDir / "waveform.bin");
+
+    DUTProxy::DUT localDut{{sDutName}};
+    DUTProxy::DUTProxyServer proxyServer{
+        localDut, {.sArtifactDir = artifactDir.string()}};
+    DUTProxy::DUTProxyClient dutProxy{{sDutName, sDutIpAddr}};
+
+    std::vector<std::byte> buffer(ARTIFACT_SIZE);
+    REQUIRE(dutProxy.fetchArtifact("waveform.bin", buffer) == ARTIFACT_SIZE);
+    REQUIRE(buffer == expected);
+
+    // Too small a buffer fails, but leaves the connection usable
+    std::vector<std::byte> smallBuffer(ARTIFACT_SIZE - 1);
+    REQUIRE_FALSE(
+        dutProxy.fetchArtifact("waveform.bin", smallBuffer).has_value());
+
+    // Missing artifacts and paths out of the artifact directory are refused
+    REQUIRE_FALSE(dutProxy.fetchArtifact("missing.bin", buffer).has_value());
+    REQUIRE_FALSE(
+        dutProxy.fetchArtifact("../waveform.bin", buffer).has_value());
+
+    REQUIRE(
+        dutProxy.execute(DUTProxy::eTests::TEST_PASSINGFEATURE) ==
+            DUTProxy::eTestResults::PASS);
+
+    std::filesystem::remove_all(artifactDir);
+}
+
+TEST_CASE("Test proxy fetchArtifact() fd", "[proxy-fetch-artifact-fd]")
+{
+    // DUT params
+    std::string sDutName{"EX-DUT-1"};
+    std::string sDutIpAddr{"127.0.0.1"};
+
+    constexpr size_t ARTIFACT_SIZE = (2 << 20) + 777;
+    auto artifactDir = makeArtifactDir("dut.log", ARTIFACT_SIZE);
+    auto expected = readFile(artifactDir / "dut.log");
+
+    DUTProxy::DUT localDut{{sDutName}};
+    DUTProxy::DUTProxyServer proxyServer{
+        localDut, {.sArtifactDir = artifactDir.string()}};
+    DUTProxy::DUTProxyClient dutProxy{{sDutName, sDutIpAddr}};
+
+    auto copyPath = artifactDir / "dut.log.copy";
+    int copyFd =
+        ::open(
+            copyPath.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+    REQUIRE(copyFd >= 0);
+    REQUIRE(dutProxy.fetchArtifact("dut.log", copyFd) == ARTIFACT_SIZE);
+    ::close(copyFd);
+    REQUIRE(readFile(copyPath) == expected);
+
+    REQUIRE(
+        dutProxy.execute(DUTProxy::eTests::TEST_FAILINGFEATURE) ==
+            DUTProxy::eTestResults::FAIL);
+
+    std::filesystem::remove_all(artifactDir);
+}
+
+//-----------------------------------------------------------------------------
+// Benchmarks (hidden, run with: ./test_proxypattern "[benchmark]")
+//-----------------------------------------------------------------------------
+
+TEST_CASE(
+    "Benchmark proxy fetchArtifact() loopback throughput",
+    "[.][benchmark][proxy-fetch-artifact-benchmark]")
+{
+    // DUT params
+    std::string sDutName{"EX-DUT-1"};
+    std::string sDutIpAddr{"127.0.0.1"};
+
+    constexpr size_t ARTIFACT_SIZE = 256 << 20;
+    constexpr int NUM_FETCHES = 8;
+    auto artifactDir = makeArtifactDir("bench.bin", ARTIFACT_SIZE);
+
+    DUTProxy::DUT localDut{{sDutName}};
+    DUTProxy::DUTProxyServer proxyServer{
+        localDut, {.sArtifactDir = artifactDir.string()}};
+    DUTProxy::DUTProxyClient dutProxy{{sDutName, sDutIpAddr}};
+
+    int nullFd = ::open("/dev/null", O_WRONLY | O_CLOEXEC);
+    std::vector<std::byte> buffer(ARTIFACT_SIZE);
+
+    auto measure = [&](const char* sMode, auto&& fetch)
+    {
+        auto start = std::chrono::steady_clock::now();
+        for (int i = 0; i < NUM_FETCHES; ++i)
+        {
+            REQUIRE(fetch() == ARTIFACT_SIZE);
+        }
+        std::chrono::duration<double> elapsed =
+            std::chrono::steady_clock::now() - start;
+        std::cout << "fetchArtifact() into "
+                  << sMode
+                  << ": "
+                  << (double(ARTIFACT_SIZE) * NUM_FETCHES / 1e9) /
+                        elapsed.count()
+                  << " GB/s"
+                  << std::endl;
+    };
+
+    measure("buffer", [&]()
+    {
+        return dutProxy.fetchArtifact("bench.bin", buffer);
+    });
+    measure("fd (splice)", [&]()
+    {
+        return dutProxy.fetchArtifact("bench.bin", nullFd);
+    });
+
+    ::close(nullFd);
+    std::filesystem::remove_all(artifactDir);
+}
+
+//-----------------------------------------------------------------------------
+// Latency Statistics Unit Tests
+//-----------------------------------------------------------------------------
+
+TEST_CASE("Test latency histogram", "[latency-histogram]")
+{
+    Metrics::LatencyHistogram histogram;
+    REQUIRE(histogram.count() == 0);
+    REQUIRE(histogram.percentile(50) == 0);
+
+    // Small values are exact
+    for (uint64_t value = 0; value < 10; ++value)
+    {
+        histogram.record(value);
+    }
+    REQUIRE(histogram.count() == 10);
+    REQUIRE(histogram.min() == 0);
+    REQUIRE(histogram.max() == 9);
+    REQUIRE(histogram.percentile(50) == 4);
+    REQUIRE(histogram.mean() == Catch::Approx(4.5));
+
+    // Large values stay within the bucket precision
+    Metrics::LatencyHistogram large;
+    for (uint64_t value = 1; value <= 1000; ++value)
+    {
+        large.record(value * 1000);
+    }
+    const double precision =
+        1.0 / Metrics::LatencyHistogram::SUB_BUCKETS;
+    REQUIRE(
+        large.percentile(50) ==
+            Catch::Approx(500000).epsilon(precision));
+    REQUIRE(
+        large.percentile(99) ==
+            Catch::Approx(990000).epsilon(precision));
+    REQUIRE(large.percentile(100) == 1000000);
+
+    // Merging combines counts and extremes
+    histogram.merge(large);
+    REQUIRE(histogram.count() == 1010);
+    REQUIRE(histogram.min() == 0);
+    REQUIRE(histogram.max() == 1000000);
+
+    // Out of range values are clamped, not lost
+    histogram.record(UINT64_MAX);
+    REQUIRE(histogram.max() == Metrics::LatencyHistogram::MAX_VALUE);
+}
+
+TEST_CASE("Test latency histogram buckets", "[latency-histogram-buckets]")
+{
+    // Every value maps to a bucket whose range contains it
+    using Metrics::LatencyHistogram;
+    for (uint64_t value : std::initializer_list<uint64_t>{
+            0, 1, 15, 16, 17, 31, 32, 1000, 123456789,
+            LatencyHistogram::MAX_VALUE})
+    {
+        size_t index = LatencyHistogram::bucketIndex(value);
+        REQUIRE(index < LatencyHistogram::NUM_BUCKETS);
+        REQUIRE(LatencyHistogram::bucketHighestValue(index) >= value);
+        if (index > 0)
+        {
+            REQUIRE(LatencyHistogram::bucketHighestValue(index - 1) < value);
+        }
+    }
+}
+
+TEST_CASE("Test proxy fetchStats()", "[proxy-fetch-stats]")
+{
+    // DUT params
+    std::string sDutName{"EX-DUT-1"};
+    std::string sDutIpAddr{"127.0.0.1"};
+
+    DUTProxy::DUT localDut{{sDutName}};
+    DUTProxy::DUTProxyServer proxyServer{localDut};
+    DUTProxy::DUTProxyClient dutProxy{{sDutName, sDutIpAddr}};
+
+    for (int i = 0; i < 5; ++i)
+    {
+        dutProxy.execute(DUTProxy::eTests::TEST_PASSINGFEATURE);
+    }
+    for (int i = 0; i < 3; ++i)
+    {
+        dutProxy.execute(DUTProxy::eTests::TEST_FAILINGFEATURE);
+    }
+
+    auto sReport = dutProxy.fetchStats();
+    REQUIRE(sReport.has_value());
+    REQUIRE(sReport->find("(1 connections)") != std::string::npos);
+    REQUIRE(sReport->find("PASSING: 5 requests") != std::string::npos);
+    REQUIRE(sReport->find("FAILING: 3 requests") != std::string::npos);
+    REQUIRE(sReport->find("execute") != std::string::npos);
+
+    // The connection keeps working after the snapshot
+    REQUIRE(
+        dutProxy.execute(DUTProxy::eTests::STOP_TESTING) ==
+            DUTProxy::eTestResults::FAILED);
+}
@@ -0,0 +1,302 @@
+// Copyright (c) 2025 Michael Dello
+//
+// This software is provided under the MIT License.
+// See LICENSE file for details.
+
+//-----------------------------------------------------------------------------
+// Simulated DUT Rack Unit Tests
+//-----------------------------------------------------------------------------
+#define CATCH_CONFIG_MAIN
+// Include EVERYTHING from Catch2 (version 3)
+// This avoids the need to create a main() for unit testing
+#include <catch2/catch_all.hpp>
+// Alternatively, only include what is needed
+// #include <catch2/catch_test_macros.hpp> // Basic test macros
+// #include <catch2/catch_approx.hpp>  // Approximate floating-point comparisons
+// #include <catch2/catch_reporter_console.hpp> // Console reporting
+// #define CATCH_CONFIG_MAIN // Generates Catch2's main function
+// #include <catch2/catch_test_macros.hpp>
+
+// Create a custom main() instead:
+/* int main(int argc, char* argv[]) {
+    Catch::Session session; // Create Catch2 session
+    return session.run(argc, argv);
+} */
+
+#include <sys/resource.h>
+#include <sys/socket.h>
+#include <netinet/in.h>
+#include <arpa/inet.h>
+#include <chrono>
+#include <iostream>
+#include <memory>
+#include <thread>
+#include <vector>
+#include "proxypattern_simrack.h"
+
+//-----------------------------------------------------------------------------
+// Test Helpers
+//-----------------------------------------------------------------------------
+
+namespace
+{
+    // Away from the real proxy port
+    constexpr uint16_t SIM_RACK_TEST_PORT = 42142;
+
+    struct sLoadResults
+    {
+        int clientsDone{0};
+        int mismatches{0};
+        int failures{0};
+    };
+
+    //-------------------------------------------------------------------------
+    // A non-blocking proxy client running as a coroutine on the same
+    // scheduler as the rack. The last client to finish stops the scheduler.
+    DUTProxy::SimTask simClient(
+        DUTProxy::SimScheduler& scheduler,
+        int numClients,
+        int numRequests,
+        sLoadResults& results)
+    {
+        DUTProxy::Socket socket(AF_INET, SOCK_STREAM | SOCK_NONBLOCK, 0);
+        sockaddr_in addr
+        {
+            .sin_family = AF_INET,
+            .sin_port = htons(SIM_RACK_TEST_PORT),
+            .sin_addr = {.s_addr = inet_addr("127.0.0.1")}
+        };
+        int connected = ::connect(
+            socket.get(), reinterpret_cast<sockaddr*>(&addr), sizeof(addr));
+        if (connected < 0 && errno == EINPROGRESS)
+        {
+            co_await scheduler.writable(socket.get());
+            int error = 0;
+            socklen_t errorLength = sizeof(error);
+            ::getsockopt(
+                socket.get(), SOL_SOCKET, SO_ERROR, &error, &errorLength);
+            connected = error == 0 ? 0 : -1;
+        }
+
+        for (int i = 0; connected == 0 && i < numRequests; ++i)
+        {
+            // Results of the simulated DUT mirror the test value
+            uint16_t request = static_cast<uint16_t>(i % 3);
+            if (::send(socket.get(), &request, sizeof(request), 0) !=
+                    sizeof(request))
+            {
+                connected = -1;
+                break;
+            }
+
+            uint16_t response{0};
+            ssize_t received;
+            while ((received =
+                        ::recv(socket.get(), &response, sizeof(response), 0))
+                    < 0 && errno == EAGAIN)
+            {
+                co_await scheduler.readable(socket.get());
+            }
+            if (received != sizeof(response))
+            {
+                connected = -1;
+                break;
+            }
+            if (response != request)
+            {
+                ++results.mismatches;
+            }
+        }
+
+        if (connected != 0)
+        {
+            ++results.failures;
+        }
+        if (++results.clientsDone == numClients)
+        {
+            scheduler.stop();
+        }
+    }
+
+    //-------------------------------------------------------------------------
+    DUTProxy::SimTask sleeper(
+        DUTProxy::SimScheduler& scheduler,
+        int milliseconds,
+        std::vector<int>& wakeOrder)
+    {
+        co_await scheduler.sleepFor(std::chrono::milliseconds(milliseconds));
+        wakeOrder.push_back(milliseconds);
+    }
+
+} // namespace anonymous
+
+//=============================================================================
+// SimScheduler Unit Tests
+//=============================================================================
+
+TEST_CASE("Test SimScheduler timers", "[simscheduler-timers]")
+{
+    DUTProxy::SimScheduler scheduler;
+    std::vector<int> wakeOrder;
+    for (int milliseconds : {30, 10, 20, 0})
+    {
+        scheduler.spawn(sleeper(scheduler, milliseconds, wakeOrder));
+    }
+    REQUIRE(scheduler.liveTasks() == 4);
+
+    auto start = std::chrono::steady_clock::now();
+    // Returns once every task has finished
+    scheduler.run();
+    auto elapsed = std::chrono::steady_clock::now() - start;
+
+    REQUIRE(scheduler.liveTasks() == 0);
+    REQUIRE(wakeOrder == std::vector<int>{0, 10, 20, 30});
+    REQUIRE(elapsed >= std::chrono::milliseconds(30));
+}
+
+//=============================================================================
+// SimRack Unit Tests
+//=============================================================================
+
+TEST_CASE("Test SimRack many sessions on one thread", "[simrack-sessions]")
+{
+    constexpr int NUM_CLIENTS = 200;
+    constexpr int NUM_REQUESTS = 10;
+
+    DUTProxy::SimScheduler scheduler;
+    DUTProxy::SimRack rack{scheduler, {.port = SIM_RACK_TEST_PORT}};
+
+    sLoadResults results;
+    for (int i = 0; i < NUM_CLIENTS; ++i)
+    {
+        scheduler.spawn(
+            simClient(scheduler, NUM_CLIENTS, NUM_REQUESTS, results));
+    }
+    scheduler.run();
+
+    REQUIRE(results.clientsDone == NUM_CLIENTS);
+    REQUIRE(results.failures == 0);
+    REQUIRE(results.mismatches == 0);
+    REQUIRE(rack.requestsServed() == uint64_t{NUM_CLIENTS} * NUM_REQUESTS);
+}
+
+TEST_CASE(
+    "Test SimRack sessions destroyed with the scheduler",
+    "[simrack-teardown]")
+{
+    auto upScheduler = std::make_unique<DUTProxy::SimScheduler>();
+    DUTProxy::SimRack rack{*upScheduler, {.port = SIM_RACK_TEST_PORT}};
+
+    // The client stops the scheduler with its session still suspended
+    sLoadResults results;
+    upScheduler->spawn(simClient(*upScheduler, 1, 3, results));
+    upScheduler->run();
+    REQUIRE(results.failures == 0);
+    REQUIRE(rack.activeSessions() == 1);
+
+    // Destroying the suspended frame uncounts its session
+    upScheduler.reset();
+    REQUIRE(rack.activeSessions() == 0);
+}
+
+TEST_CASE("Test SimRack latency model", "[simrack-latency]")
+{
+    using namespace std::chrono_literals;
+
+    // DUT params
+    std::string sDutName{"SIM-DUT-0"};
+    std::string sDutIpAddr{"127.0.0.1"};
+
+    DUTProxy::SimScheduler scheduler;
+    DUTProxy::SimRack rack{
+        scheduler,
+        {.latencies = {
+            {DUTProxy::eTests::TEST_PASSINGFEATURE, {.mean = 20ms}}}}};
+    std::thread rackThread([&scheduler]() { scheduler.run(); });
+
+    {
+        // A regular blocking proxy client against the simulated rack
+        DUTProxy::DUTProxyClient dutProxy{{sDutName, sDutIpAddr}};
+
+        auto start = std::chrono::steady_clock::now();
+        REQUIRE(
+            dutProxy.execute(DUTProxy::eTests::TEST_PASSINGFEATURE) ==
+                DUTProxy::eTestResults::PASS);
+        REQUIRE(std::chrono::steady_clock::now() - start >= 20ms);
+
+        // Tests without a model answer immediately
+        REQUIRE(
+            dutProxy.execute(DUTProxy::eTests::TEST_FAILINGFEATURE) ==
+                DUTProxy::eTestResults::FAIL);
+        REQUIRE(
+            dutProxy.execute(DUTProxy::eTests::STOP_TESTING) ==
+                DUTProxy::eTestResults::FAILED);
+    }
+
+    scheduler.stop();
+    rackThread.join();
+    REQUIRE(rack.requestsServed() == 3);
+}
+
+//-----------------------------------------------------------------------------
+// Benchmarks (hidden, run with: ./test_proxypattern_simrack "[benchmark]")
+//-----------------------------------------------------------------------------
+
+TEST_CASE(
+    "Benchmark SimRack 10,000 sessions",
+    "[.][benchmark][simrack-benchmark]")
+{
+    using namespace std::chrono_literals;
+
+    // Each session needs a client and a server descriptor
+    int numClients = 10000;
+    rlimit fileLimit{};
+    ::getrlimit(RLIMIT_NOFILE, &fileLimit);
+    fileLimit.rlim_cur = fileLimit.rlim_max;
+    ::setrlimit(RLIMIT_NOFILE, &fileLimit);
+    if (fileLimit.rlim_cur < rlim_t(2 * numClients + 64))
+    {
+        numClients = static_cast<int>((fileLimit.rlim_cur - 64) / 2);
+        std::cout << "Descriptor limit allows only "
+                  << numClients
+                  << " sessions"
+                  << std::endl;
+    }
+    constexpr int NUM_REQUESTS = 20;
+
+    DUTProxy::SimScheduler scheduler;
+    DUTProxy::SimRack rack{
+        scheduler,
+        {.port = SIM_RACK_TEST_PORT,
+         .latencies = {
+            {DUTProxy::eTests::TEST_INCOMPLETEFEATURE,
+                {.mean = 1ms, .jitter = 500us}},
+            {DUTProxy::eTests::TEST_FAILINGFEATURE,
+                {.mean = 2ms, .jitter = 1ms}},
+            {DUTProxy::eTests::TEST_PASSINGFEATURE,
+                {.mean = 500us, .jitter = 250us}}}}};
+
+    sLoadResults results;
+    for (int i = 0; i < numClients; ++i)
+    {
+        scheduler.spawn(
+            simClient(scheduler, numClients, NUM_REQUESTS, results));
+    }
+
+    auto start = std::chrono::steady_clock::now();
+    scheduler.run();
+    std::chrono::duration<double> elapsed =
+        std::chrono::steady_clock::now() - start;
+
+    REQUIRE(results.failures == 0);
+    REQUIRE(results.mismatches == 0);
+    std::cout << numClients
+              << " simulated DUT sessions, "
+              << rack.requestsServed()
+              << " requests in "
+              << elapsed.count()
+              << " s ("
+              << double(rack.requestsServed()) / elapsed.count()
+              << " requests/s on one thread)"
+              << std::endl;
+}